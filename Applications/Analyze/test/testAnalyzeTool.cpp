@@ -36,6 +36,9 @@ using namespace std;
 
 void testTutorialOne();
 
+// Fast replay must give the same results as the normal replay.
+void testFastReplay();
+
 // Test different default activations are respected when activation
 // states are not provided.
 void testTugOfWar(const string& dataFileName, const double& defaultAct);
@@ -49,6 +52,11 @@ int main()
         cout << e.what() << endl; failures.push_back("testTutorialOne");
     }
 
+    try { testFastReplay(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl; failures.push_back("testFastReplay");
+    }
+
     // produce passive force-length curve
     try { testTugOfWar("Tug_of_War_ConstantVelocity.sto", 0.01); }
     catch (const std::exception& e) {
@@ -104,6 +112,23 @@ void testTutorialOne() {
     cout << "testAnalyzeTutorialOne passed" << endl;
 }
 
+void testFastReplay() {
+    for (bool fastReplay : {false, true}) {
+        AnalyzeTool analyze("PlotterTool.xml");
+        analyze.setName(fastReplay ? "BothLegsFastReplay" : "BothLegsReplay");
+        analyze.setFastReplay(fastReplay);
+        analyze.run();
+    }
+    Storage replay("testPlotterTool/BothLegsReplay__FiberLength.sto");
+    Storage fastReplay("testPlotterTool/BothLegsFastReplay__FiberLength.sto");
+    ASSERT(fastReplay.getSize() == replay.getSize(), __FILE__, __LINE__,
+        "Fast replay recorded a different number of frames.");
+    CHECK_STORAGE_AGAINST_STANDARD(fastReplay, replay,
+        std::vector<double>(replay.getSmallestNumberOfStates(), 1e-6),
+        __FILE__, __LINE__, "Fast replay differs from the normal replay");
+    cout << "testFastReplay passed" << endl;
+}
+
 void testTugOfWar(const string& dataFileName, const double& defaultAct) {
     AnalyzeTool analyze("Tug_of_War_Setup_Analyze.xml");
     analyze.setCoordinatesFileName("");
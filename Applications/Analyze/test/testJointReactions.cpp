@@ -24,13 +24,22 @@
 // INCLUDE
 #include <OpenSim/OpenSim.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <chrono>
 
 using namespace OpenSim;
 using namespace std;
 
+void testReactionsOnParentAndChild();
+void testParallelFrames();
+void testParallelFramesWithControls();
+
 int main()
 {
     try {
+        testReactionsOnParentAndChild();
+        testParallelFrames();
+        testParallelFramesWithControls();
+
         AnalyzeTool analyze("SinglePin_Setup_JointReaction.xml");
         analyze.run();
         Storage result1("SinglePin_JointReaction_ReactionLoads.sto"), standard1("std_SinglePin_JointReaction_ReactionLoads.sto");
@@ -70,3 +79,159 @@ int main()
     cout << "Done" << endl;
     return 0;
 }
+
+// The reaction loads, all computed from one set of mobilizer reactions, must
+// match those computed by each Joint.
+void testReactionsOnParentAndChild()
+{
+    Model model("DoublePendulum3D.osim");
+    Array<std::string> jointNames("", 4);
+    Array<std::string> onBodies("", 4);
+    Array<std::string> inFrames("ground", 1);
+    const JointSet& joints = model.getJointSet();
+    for (int i = 0; i < 2; ++i) {
+        jointNames[2*i] = jointNames[2*i+1] = joints[i].getName();
+        onBodies[2*i] = "child";
+        onBodies[2*i+1] = "parent";
+    }
+    JointReaction* jr = new JointReaction(&model);
+    jr->setJointNames(jointNames);
+    jr->setOnBody(onBodies);
+    jr->setInFrame(inFrames);
+    jr->setModel(model);
+    model.addAnalysis(jr);
+
+    SimTK::State& s = model.initSystem();
+    for (int i = 0; i < s.getNQ(); ++i) s.updQ()[i] = 0.3*(i + 1);
+    for (int i = 0; i < s.getNU(); ++i) s.updU()[i] = -0.7*(i + 1);
+    model.realizeVelocity(s);
+    jr->begin(s);
+
+    SimTK::State sRef(s);
+    model.realizeAcceleration(sRef);
+    Array<double> loads(0.0, 9*jointNames.getSize());
+    jr->getReactionLoadsStorage().getDataAtTime(s.getTime(),
+            9*jointNames.getSize(), loads);
+    for (int i = 0; i < 2; ++i) {
+        const Joint& joint = joints[i];
+        SimTK::SpatialVec onChild =
+                joint.calcReactionOnChildExpressedInGround(sRef);
+        SimTK::SpatialVec onParent =
+                joint.calcReactionOnParentExpressedInGround(sRef);
+        for (int j = 0; j < 3; ++j) {
+            ASSERT_EQUAL(onChild[1][j], loads[9*(2*i) + j], 1e-9, __FILE__,
+                __LINE__, "Force on child of " + joint.getName() + " differs.");
+            ASSERT_EQUAL(onChild[0][j], loads[9*(2*i) + 3 + j], 1e-9,
+                __FILE__, __LINE__,
+                "Moment on child of " + joint.getName() + " differs.");
+            ASSERT_EQUAL(onParent[1][j], loads[9*(2*i+1) + j], 1e-9, __FILE__,
+                __LINE__, "Force on parent of " + joint.getName() + " differs.");
+            ASSERT_EQUAL(onParent[0][j], loads[9*(2*i+1) + 3 + j], 1e-9,
+                __FILE__, __LINE__,
+                "Moment on parent of " + joint.getName() + " differs.");
+        }
+    }
+    cout << "Reactions on parent and child passed" << endl;
+}
+
+// Computing the frames in parallel must give the same results as computing
+// them as they are replayed.
+void testParallelFrames()
+{
+    double times[2];
+    for (int numThreads : {1, 4}) {
+        AnalyzeTool analyze("DoublePendulum3D_Setup_JointReaction.xml");
+        analyze.setNumThreads(numThreads);
+        auto start = std::chrono::steady_clock::now();
+        analyze.run();
+        times[numThreads == 1 ? 0 : 1] = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+        Storage result("DoublePendulum3D_JointReaction_ReactionLoads.sto"),
+            standard("std_DoublePendulum3D_JointReaction_ReactionLoads.sto");
+        CHECK_STORAGE_AGAINST_STANDARD(result, standard,
+            std::vector<double>(standard.getSmallestNumberOfStates(), 1e-5),
+            __FILE__, __LINE__, "DoublePendulum3D with " +
+            std::to_string(numThreads) + " threads failed");
+    }
+    cout << "DoublePendulum3D in parallel passed" << endl;
+    cout << "AnalyzeTool with JointReaction: " << times[0] << " s serially, "
+         << times[1] << " s with 4 threads" << endl;
+}
+
+// Frames computed in parallel must use the controls of a ControlSetController
+// and the discrete variables (here, an overriding actuation) of each frame.
+void testParallelFramesWithControls()
+{
+    Model model("DoublePendulum3D.osim");
+    model.finalizeFromProperties();
+    std::vector<std::string> coordNames;
+    for (int i = 0; i < model.getCoordinateSet().getSize(); ++i)
+        coordNames.push_back(model.getCoordinateSet()[i].getName());
+
+    ControlSet* controls = new ControlSet();
+    for (size_t i = 0; i < coordNames.size(); ++i) {
+        CoordinateActuator* act = new CoordinateActuator(coordNames[i]);
+        act->setName("act_" + coordNames[i]);
+        act->setOptimalForce(10);
+        model.addForce(act);
+        ControlLinear* control = new ControlLinear();
+        control->setName(act->getName());
+        for (int k = 0; k <= 10; ++k)
+            control->setControlValue(0.01*k, sin(k + 1.3*i));
+        controls->adoptAndAppend(control);
+    }
+    ControlSetController* controller = new ControlSetController();
+    controller->setControlSet(controls);
+    model.addController(controller);
+
+    const JointSet& joints = model.getJointSet();
+    Array<std::string> jointNames("", joints.getSize());
+    for (int i = 0; i < joints.getSize(); ++i)
+        jointNames[i] = joints[i].getName();
+    JointReaction* jr = new JointReaction(&model);
+    jr->setJointNames(jointNames);
+    jr->setOnBody(Array<std::string>("child", 1));
+    jr->setInFrame(Array<std::string>("ground", 1));
+    jr->setModel(model);
+    jr->setNumThreads(4);
+    model.addAnalysis(jr);
+
+    SimTK::State& s = model.initSystem();
+    const auto& overridden =
+            model.getComponent<CoordinateActuator>("act_" + coordNames[0]);
+    overridden.overrideActuation(s, true);
+
+    // Record frames whose states and overriding actuation differ, and the
+    // reactions computed directly from each frame's state.
+    const int numFrames = 20;
+    std::vector<SimTK::SpatialVec> expected;
+    for (int f = 0; f < numFrames; ++f) {
+        s.updTime() = 0.005*f;
+        for (int i = 0; i < s.getNQ(); ++i) s.updQ()[i] = 0.3*(i + 1) + 0.01*f;
+        for (int i = 0; i < s.getNU(); ++i) s.updU()[i] = -0.7*(i + 1);
+        overridden.setOverrideActuation(s, 5*cos(0.7*f));
+        model.realizeAcceleration(s);
+        for (int i = 0; i < joints.getSize(); ++i)
+            expected.push_back(joints[i].calcReactionOnChildExpressedInGround(s));
+        if (f == 0) jr->begin(s);
+        else if (f < numFrames - 1) jr->step(s, f);
+        else jr->end(s);
+    }
+
+    const Storage& loads = jr->getReactionLoadsStorage();
+    ASSERT(loads.getSize() == numFrames, __FILE__, __LINE__,
+           "Expected a row of reaction loads per frame.");
+    for (int f = 0; f < numFrames; ++f) {
+        const Array<double>& row = loads.getStateVector(f)->getData();
+        for (int i = 0; i < joints.getSize(); ++i) {
+            const SimTK::SpatialVec& onChild = expected[f*joints.getSize() + i];
+            for (int j = 0; j < 3; ++j) {
+                ASSERT_EQUAL(onChild[1][j], row[9*i + j], 1e-9, __FILE__,
+                    __LINE__, "Force on " + joints[i].getName() + " differs.");
+                ASSERT_EQUAL(onChild[0][j], row[9*i + 3 + j], 1e-9, __FILE__,
+                    __LINE__, "Moment on " + joints[i].getName() + " differs.");
+            }
+        }
+    }
+    cout << "Parallel frames with controls passed" << endl;
+}
@@ -26,6 +26,7 @@
 #include <OpenSim/Tools/AnalyzeTool.h>
 #include <OpenSim/Analyses/StaticOptimization.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <chrono>
 
 using namespace OpenSim;
 using namespace std;
@@ -42,6 +43,8 @@ void testLapackErrorDLASD4();
 
 void testModelWithPassiveForces();
 
+void testParallelFrames();
+
 int main()
 {
     Array<string> muscleModelNames;
@@ -85,6 +88,14 @@ int main()
         failures.push_back("testLapackErrorDLASD4");
     }
 
+    try {
+        testParallelFrames();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testParallelFrames");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -219,3 +230,52 @@ void testLapackErrorDLASD4() {
     analyze.setResultsDir("Results_subject01_StaticOptimization_LapackError");
     analyze.run();
 }
+
+// Solving the frames in parallel, with warm starts, must give the same
+// results as solving them as they are replayed, up to the tolerances of the
+// standard.
+void testParallelFrames()
+{
+    const string muscName = "Thelen2003Muscle_Deprecated";
+    Object::renameType("Thelen2003Muscle", muscName);
+    Storage stdActivations("std_" + muscName +
+                           "_arm26_StaticOptimization_activation.sto");
+    Storage stdForces("std_" + muscName +
+                      "_arm26_StaticOptimization_force.sto");
+
+    double times[2];
+    int numFrames = 0, numForceRows = 0;
+    for (int numThreads : {1, 4}) {
+        const string resultsDir =
+            "Results_parallel_" + std::to_string(numThreads);
+        AnalyzeTool analyze("arm26_Setup_StaticOptimization.xml");
+        analyze.setResultsDir(resultsDir);
+        analyze.setNumThreads(numThreads);
+        auto start = std::chrono::steady_clock::now();
+        analyze.run();
+        times[numThreads == 1 ? 0 : 1] = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+
+        Storage activations(resultsDir+"/arm26_StaticOptimization_activation.sto");
+        Storage forces(resultsDir+"/arm26_StaticOptimization_force.sto");
+        if (numThreads == 1) {
+            numFrames = activations.getSize();
+            numForceRows = forces.getSize();
+        }
+        ASSERT(activations.getSize() == numFrames &&
+               forces.getSize() == numForceRows, __FILE__, __LINE__,
+               "Number of frames with " + std::to_string(numThreads) +
+               " threads differs.");
+        CHECK_STORAGE_AGAINST_STANDARD(activations, stdActivations,
+            std::vector<double>(6, 0.005), __FILE__, __LINE__,
+            "Arm26 activations with " + std::to_string(numThreads) +
+            " threads failed");
+        CHECK_STORAGE_AGAINST_STANDARD(forces, stdForces,
+            std::vector<double>(6, 0.5), __FILE__, __LINE__,
+            "Arm26 forces with " + std::to_string(numThreads) +
+            " threads failed");
+    }
+    cout << "Arm26 in parallel passed" << endl;
+    cout << "AnalyzeTool with StaticOptimization: " << times[0]
+         << " s serially, " << times[1] << " s with 4 threads" << endl;
+}
@@ -34,6 +34,7 @@
 #include <OpenSim/Simulation/Model/MarkerSet.h>
 #include <OpenSim/Simulation/Model/ForceSet.h>
 #include <OpenSim/Simulation/Model/Ligament.h>
+#include <OpenSim/Simulation/Model/Muscle.h>
 #include <OpenSim/Simulation/Model/PhysicalOffsetFrame.h>
 #include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
@@ -46,6 +47,7 @@
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Tools/GenericModelMaker.h>
+#include <chrono>
 
 using namespace OpenSim;
 using std::cout; using std::endl;
@@ -61,6 +63,9 @@ void scalePhysicalOffsetFrames();
 // Test scaling EllipsoidJoint, CustomJoint, and CoordinateCouplerConstraint.
 void scaleJointsAndConstraints();
 
+// Test scaling several subjects concurrently from one generic model.
+void scaleBatch();
+
 int main()
 {
     try {
@@ -69,6 +74,7 @@ int main()
         scaleModelWithLigament();
         scalePhysicalOffsetFrames();
         scaleJointsAndConstraints();
+        scaleBatch();
     }
     catch (const std::exception& e) {
         cout << e.what() << endl;
@@ -807,3 +813,87 @@ void scaleJointsAndConstraints()
             "SliderJoint has incorrect Coordinate value after scaling.");
     }
 }
+
+void scaleBatch()
+{
+    ScaleTool setup("subject01_Setup_Scale.xml");
+    std::unique_ptr<Model> genericModel(setup.createModel());
+
+    // Subjects that differ in mass.
+    const std::vector<double> masses{72.6, 60.0, 85.0, 95.0};
+    std::vector<std::unique_ptr<ScaleTool>> tools;
+    std::vector<const ScaleTool*> subjects;
+    for (size_t i = 0; i < masses.size(); ++i) {
+        tools.emplace_back(new ScaleTool(setup));
+        tools.back()->setName("subject" + std::to_string(i));
+        tools.back()->setPathToSubject(setup.getPathToSubject());
+        tools.back()->setPrintResultFiles(false);
+        tools.back()->setSubjectMass(masses[i]);
+        subjects.push_back(tools.back().get());
+    }
+
+    // Scale the subjects one after the other.
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::unique_ptr<Model>> serialModels;
+    for (const auto& tool : tools) {
+        ScalingPhaseTimes times;
+        serialModels.emplace_back(genericModel->clone());
+        serialModels.back()->setName(tool->getName());
+        ASSERT(tool->processModel(*serialModels.back(), times));
+    }
+    double serialTime = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    std::vector<ScalingPhaseTimes> times;
+    auto models = ScaleTool::runBatch(*genericModel, subjects, 0, &times);
+    double batchTime = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+
+    ASSERT(models.size() == masses.size() && times.size() == masses.size());
+    for (size_t i = 0; i < models.size(); ++i) {
+        ASSERT(models[i] != nullptr, __FILE__, __LINE__,
+               "Failed to scale subject " + std::to_string(i) + ".");
+        ASSERT(models[i]->getName() == subjects[i]->getName());
+        SimTK::State& s = models[i]->initSystem();
+        ASSERT_EQUAL(masses[i], models[i]->getTotalMass(s), 1e-9*masses[i],
+                     __FILE__, __LINE__, "Scaled model has the wrong mass.");
+
+        // The batch produces the same models as scaling the subjects
+        // one after the other.
+        const Model& serialModel = *serialModels[i];
+        for (const auto& body : serialModel.getComponentList<Body>()) {
+            const Body& batchBody = models[i]->getComponent<Body>(
+                    body.getAbsolutePathString());
+            ASSERT_EQUAL(body.getMass(), batchBody.getMass(), 1e-12,
+                         __FILE__, __LINE__, "Masses differ.");
+            ASSERT_EQUAL(body.getMassCenter(), batchBody.getMassCenter(),
+                         1e-12, __FILE__, __LINE__, "Mass centers differ.");
+        }
+        for (const auto& muscle : serialModel.getComponentList<Muscle>()) {
+            const Muscle& batchMuscle = models[i]->getComponent<Muscle>(
+                    muscle.getAbsolutePathString());
+            ASSERT_EQUAL(muscle.getOptimalFiberLength(),
+                         batchMuscle.getOptimalFiberLength(), 1e-12,
+                         __FILE__, __LINE__, "Optimal fiber lengths differ.");
+            ASSERT_EQUAL(muscle.getTendonSlackLength(),
+                         batchMuscle.getTendonSlackLength(), 1e-12,
+                         __FILE__, __LINE__, "Tendon slack lengths differ.");
+        }
+        for (const auto& marker : serialModel.getComponentList<Marker>()) {
+            const Marker& batchMarker = models[i]->getComponent<Marker>(
+                    marker.getAbsolutePathString());
+            ASSERT_EQUAL(marker.get_location(), batchMarker.get_location(),
+                         1e-9, __FILE__, __LINE__, "Marker locations differ.");
+        }
+
+        cout << subjects[i]->getName() << ": copy model "
+             << times[i].createModel << " s, scale factors "
+             << times[i].computeScaleFactors << " s, scale model "
+             << times[i].scaleModel << " s, place markers "
+             << times[i].placeMarkers << " s." << endl;
+    }
+    cout << "Scaled " << models.size() << " subjects one after the other in "
+         << serialTime << " s and concurrently in " << batchTime << " s."
+         << endl;
+}
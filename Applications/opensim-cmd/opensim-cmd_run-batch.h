@@ -0,0 +1,580 @@
+#ifndef OPENSIM_CMD_RUN_BATCH_H_
+#define OPENSIM_CMD_RUN_BATCH_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  opensim-cmd_run-batch.h                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <docopt.h>
+#include "parse_arguments.h"
+
+#include <OpenSim/OpenSim.h>
+
+static const char HELP_RUN_BATCH[] =
+R"(Run many tools (e.g., Inverse Kinematics) from XML setup files in a single process.
+
+Usage:
+  opensim-cmd [options]... run-batch [--jobs=<n>] [--list=<file>] [--summary=<file>] [<setup-xml-file>...]
+  opensim-cmd run-batch -h | --help
+
+Options:
+  -L <path>, --library <path>  Load a plugin.
+  -j <n>, --jobs <n>  The number of setup files to run at the same time. By
+                 default, this is the number of processor cores.
+  -l <file>, --list <file>  A text file listing setup files, one per line,
+                 in addition to any given as arguments. Blank lines and lines
+                 starting with '#' are ignored. Relative paths are relative to
+                 the directory containing the list file.
+  -s <file>, --summary <file>  Write the status and timing of each setup
+                 file to this file, as JSON if its extension is .json and as
+                 CSV otherwise.
+
+Description:
+  Each setup file is run as with `opensim-cmd run-tool`. Models are loaded
+  once per batch: a model file used by multiple setup files is parsed the
+  first time it is needed, and subsequent setup files receive a copy of it.
+  The cached model is keyed by the model file's path and a hash of its
+  contents, so a model file that changes during the batch is loaded again.
+
+  Tools change the working directory while they run, so only setup files in
+  the same directory are run concurrently, while directories are processed
+  one after another. Furthermore, the Forward, Analyze, CMC and RRA tools
+  (and any tool other than Inverse Kinematics, Inverse Dynamics and Scale)
+  set the precision of the numbers written to all result files, so each of
+  these setup files runs by itself. The output of each setup file is printed, in the order of
+  the setup files, once all of the setup files in its directory have run.
+  The batch continues if a setup file fails, and the command fails if any of
+  the setup files failed.
+
+  Use a --list file or your shell's wildcards (e.g., *_Setup.xml) to run many
+  setup files.
+
+Examples:
+  opensim-cmd run-batch subject01/*_Setup.xml
+  opensim-cmd run-batch --jobs=8 --summary=summary.json --list=nightly.txt
+  opensim-cmd -L C:\Plugins\osimMyCustomForce.dll run-batch -j 4 IK_setup.xml ID_setup.xml
+)";
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(const Clock::time_point& start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+bool isAbsolutePath(const std::string& path) {
+    return !path.empty() && (path[0] == '/' || path[0] == '\\' ||
+            (path.size() > 1 && path[1] == ':'));
+}
+
+// Interpret `path` relative to `directory` (which has a trailing separator,
+// as returned by IO::getParentDirectory()) unless it is absolute.
+std::string resolvePath(const std::string& directory, const std::string& path) {
+    if (path.empty() || isAbsolutePath(path)) return path;
+    return directory + path;
+}
+
+// Status and timing of one setup file, as written to the summary.
+struct BatchJob {
+    std::string setupFile;
+    std::string tool;
+    std::string modelFile;
+    std::string status = "pending";
+    std::string message;
+    bool modelFromCache = false;
+    double loadTime = 0;
+    double runTime = 0;
+    // The console output of the job, logged once the jobs in its directory
+    // have finished.
+    std::string out;
+    std::string err;
+};
+
+// Models that have been loaded during the batch, keyed by the model file's
+// absolute path and a hash of its contents. Each job receives its own copy,
+// since the tools build a system for (and may edit) the model they run.
+class ModelCache {
+public:
+    // Returns a copy of the model in the given file, loading the model if it
+    // has not been loaded yet. `fromCache` is set to true if the file did
+    // not have to be parsed.
+    std::unique_ptr<OpenSim::Model> getModel(const std::string& modelFile,
+                                             bool& fromCache) {
+        std::ifstream file(modelFile, std::ios::binary);
+        if (!file) {
+            throw OpenSim::Exception("Could not open model file '" +
+                    modelFile + "'.");
+        }
+        std::stringstream contents;
+        contents << file.rdbuf();
+
+        std::shared_ptr<Entry> entry;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto& ptr = _entries[modelFile + "#" + hash(contents.str())];
+            if (!ptr) ptr = std::make_shared<Entry>();
+            entry = ptr;
+        }
+
+        // Only the first job that needs a model loads it; other jobs that
+        // need the same model wait for it.
+        std::lock_guard<std::mutex> lock(entry->mutex);
+        fromCache = entry->loaded;
+        if (!entry->loaded) {
+            entry->loaded = true;
+            try {
+                entry->model.reset(new OpenSim::Model(modelFile));
+            } catch (const std::exception& e) {
+                entry->error = e.what();
+            }
+        }
+        if (!entry->model) throw OpenSim::Exception(entry->error);
+        return std::unique_ptr<OpenSim::Model>(entry->model->clone());
+    }
+
+    int getNumModels() const { return (int)_entries.size(); }
+
+private:
+    struct Entry {
+        std::mutex mutex;
+        bool loaded = false;
+        std::unique_ptr<OpenSim::Model> model;
+        std::string error;
+    };
+
+    // 64-bit FNV-1a hash, as a hexadecimal string.
+    static std::string hash(const std::string& contents) {
+        std::uint64_t h = 14695981039346656037ull;
+        for (unsigned char c : contents) {
+            h ^= c;
+            h *= 1099511628211ull;
+        }
+        std::ostringstream os;
+        os << std::hex << std::setw(16) << std::setfill('0') << h;
+        return os.str();
+    }
+
+    std::mutex _mutex;
+    std::map<std::string, std::shared_ptr<Entry>> _entries;
+};
+
+// Lets jobs run concurrently unless one of them needs to run by itself.
+// Jobs that change OpenSim's global output settings (e.g., tools calling
+// IO::SetPrecision()) take the lock exclusively, since the other jobs read
+// these settings while they write their results.
+class JobLock {
+public:
+    void lockShared() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _changed.wait(lock, [this]() {
+            return !_exclusive && _numWaitingExclusive == 0;
+        });
+        ++_numShared;
+    }
+    void unlockShared() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (--_numShared == 0) _changed.notify_all();
+    }
+    void lockExclusive() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        ++_numWaitingExclusive;
+        _changed.wait(lock, [this]() {
+            return !_exclusive && _numShared == 0;
+        });
+        --_numWaitingExclusive;
+        _exclusive = true;
+    }
+    void unlockExclusive() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _exclusive = false;
+        _changed.notify_all();
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _changed;
+    int _numShared = 0;
+    int _numWaitingExclusive = 0;
+    bool _exclusive = false;
+};
+
+// Holds a JobLock while a job runs. An exclusive job also restores the
+// output precision it may have changed, so that the jobs after it write
+// their results as they would when run on their own.
+class JobLockGuard {
+public:
+    JobLockGuard(JobLock& lock, bool exclusive) :
+            _lock(lock), _exclusive(exclusive) {
+        if (_exclusive) {
+            _lock.lockExclusive();
+            _precision = OpenSim::IO::GetPrecision();
+        } else {
+            _lock.lockShared();
+        }
+    }
+    ~JobLockGuard() {
+        if (_exclusive) {
+            OpenSim::IO::SetPrecision(_precision);
+            _lock.unlockExclusive();
+        } else {
+            _lock.unlockShared();
+        }
+    }
+    JobLockGuard(const JobLockGuard&) = delete;
+    JobLockGuard& operator=(const JobLockGuard&) = delete;
+
+private:
+    JobLock& _lock;
+    bool _exclusive;
+    int _precision = 0;
+};
+
+// Give an AbstractTool (constructed without loading its model) a copy of its
+// model from the cache, mimicking what the tool's constructor does when it
+// loads the model itself.
+std::unique_ptr<OpenSim::Model> setCachedModel(OpenSim::AbstractTool& tool,
+        const std::string& setupFile, ModelCache& cache, BatchJob& job) {
+    using namespace OpenSim;
+    if (tool.getModelFilename().empty()) {
+        // This throws an informative exception.
+        tool.loadModel(setupFile);
+    }
+    job.modelFile = resolvePath(IO::getParentDirectory(setupFile),
+                                tool.getModelFilename());
+    auto model = cache.getModel(job.modelFile, job.modelFromCache);
+    model->finalizeFromProperties();
+    if (auto* rra = dynamic_cast<RRATool*>(&tool)) {
+        rra->setOriginalForceSet(model->getForceSet());
+    } else if (auto* cmc = dynamic_cast<CMCTool*>(&tool)) {
+        cmc->setOriginalForceSet(model->getForceSet());
+    }
+    tool.updateModelForces(*model, setupFile);
+    tool.setModel(*model);
+    tool.setToolOwnsModel(false);
+    return model;
+}
+
+// Run a single setup file; this is the counterpart of run_tool(), except
+// that models come from the cache. The setup file path must be absolute.
+void runBatchJob(BatchJob& job, ModelCache& cache, JobLock& jobLock) {
+    using namespace OpenSim;
+
+    const auto start = Clock::now();
+    const auto& setupFile = job.setupFile;
+    auto obj = std::unique_ptr<Object>(Object::makeObjectFromFile(setupFile));
+    if (obj == nullptr) {
+        throw Exception( "A problem occurred when trying to load file '" +
+                setupFile + "'.");
+    }
+    job.tool = obj->getConcreteClassName();
+
+    // The model must outlive the tool that uses it.
+    std::unique_ptr<Model> model;
+    std::function<bool ()> run;
+    // Whether the job must run by itself; only the Inverse Kinematics,
+    // Inverse Dynamics and Scale tools are known to leave the global output
+    // settings alone.
+    bool exclusive = true;
+    std::unique_ptr<AbstractTool> concreteTool;
+    if (auto* tool = dynamic_cast<AbstractTool*>(obj.get())) {
+        if        (dynamic_cast<RRATool*>(tool)) {
+            concreteTool.reset(new RRATool(setupFile, false));
+        } else if (dynamic_cast<CMCTool*>(tool)) {
+            concreteTool.reset(new CMCTool(setupFile, false));
+        } else if (dynamic_cast<ForwardTool*>(tool)) {
+            concreteTool.reset(new ForwardTool(setupFile, true, false));
+        } else if (dynamic_cast<AnalyzeTool*>(tool)) {
+            auto* analyze = new AnalyzeTool(setupFile, false);
+            // We still want the tool to load its input files.
+            analyze->setLoadModelAndInput(true);
+            concreteTool.reset(analyze);
+        }
+        if (concreteTool) {
+            model = setCachedModel(*concreteTool, setupFile, cache, job);
+        } else {
+            std::cout << "Detected an AbstractTool that is not RRA, "
+                "CMC, Forward, or Analyze; custom tools may not get "
+                "constructed properly." << std::endl;
+            concreteTool.reset(tool->clone());
+        }
+        run = [&]() { return concreteTool->run(); };
+    } else if (auto* tool = dynamic_cast<Tool*>(obj.get())) {
+        std::string modelFile;
+        if (auto* ik = dynamic_cast<InverseKinematicsTool*>(tool)) {
+            modelFile = ik->getModelFileName();
+        } else if (auto* id = dynamic_cast<DynamicsTool*>(tool)) {
+            modelFile = id->getModelFileName();
+        }
+        if (!modelFile.empty()) {
+            job.modelFile = resolvePath(IO::getParentDirectory(setupFile),
+                                        modelFile);
+            model = cache.getModel(job.modelFile, job.modelFromCache);
+            if (auto* ik = dynamic_cast<InverseKinematicsTool*>(tool)) {
+                ik->setModel(*model);
+            } else {
+                dynamic_cast<DynamicsTool*>(tool)->setModel(*model);
+            }
+        }
+        exclusive = !dynamic_cast<InverseKinematicsTool*>(tool) &&
+                    !dynamic_cast<DynamicsTool*>(tool);
+        run = [=]() { return tool->run(); };
+    } else if (auto* scale = dynamic_cast<ScaleTool*>(obj.get())) {
+        // ScaleTool loads (and edits) the generic model itself.
+        run = [=]() { return scale->run(); };
+        exclusive = false;
+    } else {
+        throw Exception("The provided file '" + setupFile + "' does not "
+                "define an OpenSim Tool. Did you intend to load a plugin?");
+    }
+    job.loadTime = secondsSince(start);
+
+    JobLockGuard guard(jobLock, exclusive);
+    std::cout << "Preparing to run " << job.tool << " (" << setupFile << ")."
+              << std::endl;
+    const auto runStart = Clock::now();
+    const bool success = run();
+    job.runTime = secondsSince(runStart);
+    job.status = success ? "success" : "failure";
+}
+
+std::string escapeJSON(const std::string& str) {
+    std::ostringstream os;
+    for (char c : str) {
+        switch (c) {
+        case '"':  os << "\\\""; break;
+        case '\\': os << "\\\\"; break;
+        case '\n': os << "\\n"; break;
+        case '\r': os << "\\r"; break;
+        case '\t': os << "\\t"; break;
+        default:
+            if ((unsigned char)c < 0x20) {
+                os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                   << (int)(unsigned char)c << std::dec;
+            } else {
+                os << c;
+            }
+        }
+    }
+    return os.str();
+}
+
+std::string escapeCSV(const std::string& str) {
+    if (str.find_first_of(",\"\n\r") == std::string::npos) return str;
+    std::string escaped = "\"";
+    for (char c : str) {
+        if (c == '"') escaped += '"';
+        escaped += c;
+    }
+    return escaped + "\"";
+}
+
+void writeBatchSummary(const std::string& fileName,
+        const std::vector<BatchJob>& jobs, int numJobs, double totalTime) {
+    std::ofstream out(fileName);
+    if (!out) {
+        throw OpenSim::Exception("Could not open summary file '" + fileName +
+                "' for writing.");
+    }
+    out << std::setprecision(6);
+    std::string ext = fileName.size() >= 5 ?
+            OpenSim::IO::Lowercase(fileName.substr(fileName.size() - 5)) : "";
+    if (ext == ".json") {
+        out << "{\n"
+            << "  \"num_jobs\": " << numJobs << ",\n"
+            << "  \"total_time\": " << totalTime << ",\n"
+            << "  \"setup_files\": [";
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            const auto& job = jobs[i];
+            out << (i == 0 ? "\n" : ",\n")
+                << "    {\"setup_file\": \"" << escapeJSON(job.setupFile)
+                << "\", \"tool\": \"" << escapeJSON(job.tool)
+                << "\", \"model_file\": \"" << escapeJSON(job.modelFile)
+                << "\", \"model_from_cache\": "
+                << (job.modelFromCache ? "true" : "false")
+                << ", \"status\": \"" << job.status
+                << "\", \"load_time\": " << job.loadTime
+                << ", \"run_time\": " << job.runTime
+                << ", \"message\": \"" << escapeJSON(job.message) << "\"}";
+        }
+        out << "\n  ]\n}\n";
+    } else {
+        out << "setup_file,tool,model_file,model_from_cache,status,"
+               "load_time,run_time,message\n";
+        for (const auto& job : jobs) {
+            out << escapeCSV(job.setupFile) << ","
+                << escapeCSV(job.tool) << ","
+                << escapeCSV(job.modelFile) << ","
+                << (job.modelFromCache ? "true" : "false") << ","
+                << job.status << ","
+                << job.loadTime << ","
+                << job.runTime << ","
+                << escapeCSV(job.message) << "\n";
+        }
+    }
+}
+
+} // anonymous namespace
+
+int run_batch(int argc, const char** argv) {
+
+    using namespace OpenSim;
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_RUN_BATCH, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    int numJobs = std::max(1u, std::thread::hardware_concurrency());
+    if (args["--jobs"]) {
+        const auto& str = args["--jobs"].asString();
+        try {
+            numJobs = std::stoi(str);
+        } catch (const std::exception&) {
+            numJobs = 0;
+        }
+        if (numJobs < 1) {
+            throw Exception("Expected --jobs to be a positive integer, but "
+                    "got '" + str + "'.");
+        }
+    }
+
+    // Gather the setup files, as absolute paths.
+    // ------------------------------------------
+    const std::string cwd = IO::getCwd() + "/";
+    std::vector<std::string> setupFiles;
+    if (args["--list"]) {
+        const auto listFile = resolvePath(cwd, args["--list"].asString());
+        std::ifstream list(listFile);
+        if (!list) {
+            throw Exception("Could not open list file '" + listFile + "'.");
+        }
+        const auto listDir = IO::getParentDirectory(listFile);
+        std::string line;
+        while (std::getline(list, line)) {
+            IO::TrimWhitespace(line);
+            if (line.empty() || line[0] == '#') continue;
+            setupFiles.push_back(resolvePath(listDir, line));
+        }
+    }
+    for (const auto& setupFile : args["<setup-xml-file>"].asStringList()) {
+        setupFiles.push_back(resolvePath(cwd, setupFile));
+    }
+    if (setupFiles.empty()) {
+        std::cout << "No setup files provided." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<BatchJob> jobs(setupFiles.size());
+    // Group the jobs by the directory of their setup file, preserving the
+    // order in which the directories first appear.
+    std::vector<std::string> directories;
+    std::map<std::string, std::vector<int>> jobsInDirectory;
+    for (size_t i = 0; i < setupFiles.size(); ++i) {
+        jobs[i].setupFile = setupFiles[i];
+        const auto dir = IO::getParentDirectory(setupFiles[i]);
+        if (jobsInDirectory.count(dir) == 0) directories.push_back(dir);
+        jobsInDirectory[dir].push_back((int)i);
+    }
+
+    // Run the jobs.
+    // -------------
+    ModelCache cache;
+    JobLock jobLock;
+    const auto start = Clock::now();
+    for (const auto& dir : directories) {
+        const auto& indices = jobsInDirectory[dir];
+        // The tools change into this directory, and back to the directory
+        // they started from; starting from this directory ensures that
+        // concurrent jobs agree on the working directory.
+        IO::chDir(dir);
+        std::atomic<size_t> next(0);
+        auto worker = [&]() {
+            size_t i;
+            while ((i = next++) < indices.size()) {
+                auto& job = jobs[indices[i]];
+                const auto jobStart = Clock::now();
+                // Tools write to the console as they run.
+                LogCapture capture(job.out, job.err);
+                try {
+                    runBatchJob(job, cache, jobLock);
+                } catch (const std::exception& e) {
+                    job.status = "error";
+                    job.message = e.what();
+                    if (job.loadTime == 0) {
+                        job.loadTime = secondsSince(jobStart);
+                    } else {
+                        job.runTime = secondsSince(jobStart) - job.loadTime;
+                    }
+                    std::cerr << job.setupFile << ": " << e.what()
+                              << std::endl;
+                }
+            }
+        };
+        const int numWorkers = std::min(numJobs, (int)indices.size());
+        std::vector<std::thread> workers;
+        for (int i = 1; i < numWorkers; ++i) workers.emplace_back(worker);
+        worker();
+        for (auto& thread : workers) thread.join();
+        for (int i : indices) LogCapture::write(jobs[i].out, jobs[i].err);
+    }
+    IO::chDir(cwd);
+    const double totalTime = secondsSince(start);
+
+    // Report.
+    // -------
+    int numSucceeded = 0;
+    std::cout << "\nBatch summary:" << std::endl;
+    for (const auto& job : jobs) {
+        if (job.status == "success") ++numSucceeded;
+        std::cout << "  " << std::left << std::setw(8) << job.status
+                  << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(10) << job.loadTime << " s load"
+                  << std::setw(10) << job.runTime << " s run  "
+                  << job.setupFile << std::endl;
+    }
+    std::cout << numSucceeded << " of " << jobs.size()
+              << " setup files succeeded in " << totalTime << " s ("
+              << cache.getNumModels() << " models loaded, " << numJobs
+              << " jobs at a time)." << std::defaultfloat << std::endl;
+
+    if (args["--summary"]) {
+        const auto summaryFile = args["--summary"].asString();
+        writeBatchSummary(summaryFile, jobs, numJobs, totalTime);
+        std::cout << "Wrote summary to '" << summaryFile << "'." << std::endl;
+    }
+
+    if (numSucceeded == (int)jobs.size()) return EXIT_SUCCESS;
+    return EXIT_FAILURE;
+}
+
+#endif // OPENSIM_CMD_RUN_BATCH_H_
@@ -23,9 +23,12 @@
 
 #include <SimTKcommon/Testing.h>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <regex>
+#include <sstream>
 // We do *not* include OpenSim headers, since we are only interacting with
 // OpenSim through its command-line interface. But we do use Simbody's testing
 // macros.
@@ -323,6 +326,127 @@ void testRunTool() {
     testLoadPluginLibraries("run-tool");
 }
 
+void testRunBatch() {
+    // Help.
+    // =====
+    {
+        StartsWith output("Run many tools ");
+        testCommand("run-batch -h", EXIT_SUCCESS, output);
+        testCommand("run-batch -help", EXIT_SUCCESS, output);
+    }
+
+    // Error messages.
+    // ===============
+    testCommand("run-batch", EXIT_FAILURE, "No setup files provided.\n");
+    testCommand("run-batch --jobs=0 x.xml", EXIT_FAILURE,
+            "Expected --jobs to be a positive integer, but got '0'.\n");
+    testCommand("run-batch --list=putes.txt", EXIT_FAILURE,
+            std::regex("(Could not open list file ')" + RE_ANY +
+                       "(putes.txt'.)\n"));
+    // The batch continues after a setup file fails, and reports each file.
+    testCommand("print-xml cmc testrunbatch_cmc_setup.xml", EXIT_SUCCESS,
+            "Printing 'testrunbatch_cmc_setup.xml'.\n");
+    testCommand("print-xml Model testrunbatch_Model.xml", EXIT_SUCCESS,
+            "Printing 'testrunbatch_Model.xml'.\n");
+    testCommand("run-batch -j 1 --summary=testrunbatch_summary.csv "
+                "testrunbatch_cmc_setup.xml testrunbatch_Model.xml",
+            EXIT_FAILURE,
+            std::regex(RE_ANY + "(No model file was specified)" + RE_ANY +
+                       "(does not define an OpenSim Tool)" + RE_ANY +
+                       "(0 of 2 setup files succeeded)" + RE_ANY +
+                       "(Wrote summary to 'testrunbatch_summary.csv'.)\n"));
+
+    // Successful jobs.
+    // ================
+    // Three short forward simulations of the same model, each with its own
+    // output precision. ForwardTool sets the precision used by all files
+    // that are written, so these jobs run one at a time even with -j 3.
+    // The output of each job is printed in the order of the setup files.
+    const std::map<std::string, int> precisions{{"a", 3}, {"b", 8}, {"c", 13}};
+    for (const auto& it : precisions) {
+        const auto& name = it.first;
+        std::ofstream setup("testrunbatch_forward_" + name + ".xml");
+        setup << "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n"
+              << "<OpenSimDocument Version=\"30000\">\n"
+              << "  <ForwardTool name=\"testrunbatch_" << name << "\">\n"
+              << "    <model_file>arm26.osim</model_file>\n"
+              << "    <results_directory>testrunbatch_results_" << name
+              << "</results_directory>\n"
+              << "    <output_precision>" << it.second
+              << "</output_precision>\n"
+              << "    <initial_time>0</initial_time>\n"
+              << "    <final_time>0.01</final_time>\n"
+              << "  </ForwardTool>\n"
+              << "</OpenSimDocument>\n";
+    }
+    testCommand("run-batch -j 3 --summary=testrunbatch_summary.json "
+                "testrunbatch_forward_a.xml testrunbatch_forward_b.xml "
+                "testrunbatch_forward_c.xml",
+            EXIT_SUCCESS,
+            std::regex(RE_ANY +
+                "(Preparing to run ForwardTool \\()" + RE_ANY +
+                "(testrunbatch_forward_a.xml\\)\\.)" + RE_ANY +
+                "(Preparing to run ForwardTool \\()" + RE_ANY +
+                "(testrunbatch_forward_b.xml\\)\\.)" + RE_ANY +
+                "(Preparing to run ForwardTool \\()" + RE_ANY +
+                "(testrunbatch_forward_c.xml\\)\\.)" + RE_ANY +
+                "(3 of 3 setup files succeeded)" + RE_ANY +
+                "(1 models loaded, 3 jobs at a time)" + RE_ANY +
+                "(Wrote summary to 'testrunbatch_summary.json'.)\n"));
+    {
+        std::ifstream file("testrunbatch_summary.json");
+        std::stringstream contents;
+        contents << file.rdbuf();
+        const std::string summary = contents.str();
+        auto count = [&](const std::string& str) {
+            int n = 0;
+            for (size_t pos = summary.find(str); pos != std::string::npos;
+                    pos = summary.find(str, pos + 1)) ++n;
+            return n;
+        };
+        SimTK_TEST(count("\"num_jobs\": 3,") == 1);
+        SimTK_TEST(count("\"tool\": \"ForwardTool\"") == 3);
+        SimTK_TEST(count("\"status\": \"success\"") == 3);
+        SimTK_TEST(count("arm26.osim\"") == 3);
+        // The model is parsed by the first job that needs it; the other
+        // jobs get a copy from the cache.
+        SimTK_TEST(count("\"model_from_cache\": false") == 1);
+        SimTK_TEST(count("\"model_from_cache\": true") == 2);
+        // The setup files are listed in the order they were given.
+        const size_t a = summary.find("testrunbatch_forward_a.xml");
+        const size_t b = summary.find("testrunbatch_forward_b.xml");
+        const size_t c = summary.find("testrunbatch_forward_c.xml");
+        SimTK_TEST(a != std::string::npos && a < b && b < c &&
+                   c != std::string::npos);
+    }
+    // Each job wrote its states with its own number of decimal places.
+    for (const auto& it : precisions) {
+        const auto& name = it.first;
+        std::ifstream states("testrunbatch_results_" + name +
+                             "/testrunbatch_" + name + "_states.sto");
+        SimTK_TEST(states.good());
+        std::string line;
+        while (std::getline(states, line) && line != "endheader") {}
+        std::getline(states, line); // Column labels.
+        int numValues = 0;
+        while (std::getline(states, line)) {
+            std::istringstream values(line);
+            std::string value;
+            while (values >> value) {
+                const size_t point = value.find('.');
+                SimTK_TEST(point != std::string::npos);
+                SimTK_TEST((int)(value.size() - point - 1) == it.second);
+                ++numValues;
+            }
+        }
+        SimTK_TEST(numValues > 0);
+    }
+
+    // Library option.
+    // ===============
+    testLoadPluginLibraries("run-batch");
+}
+
 void testPrintXML() {
     // Help.
     // =====
@@ -462,6 +586,7 @@ int main() {
     SimTK_START_TEST("testCommandLineInterface");
         SimTK_SUBTEST(testNoCommand);
         SimTK_SUBTEST(testRunTool);
+        SimTK_SUBTEST(testRunBatch);
         SimTK_SUBTEST(testPrintXML);
         SimTK_SUBTEST(testInfo);
         SimTK_SUBTEST(testUpdateFile);
@@ -41,6 +41,7 @@
 
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 #include <OpenSim/Common/ModelDisplayHints.h>
+#include <OpenSim/Common/ComponentProfiler.h>
 #include <OpenSim/Common/Component.h>
 
 #include <OpenSim/Common/MarkerData.h>
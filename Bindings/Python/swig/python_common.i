@@ -288,6 +288,132 @@ note: ## is a "glue" operator: `a ## b` --> `ab`.
     }
 }
 
+// NumPy views and bulk setters
+// ============================
+// See "NumPy views" in python_simbody.i. The bulk setters receive the address
+// of a contiguous NumPy array of doubles, and copy its contents in C++.
+%extend OpenSim::DataTable_<double, double> {
+    size_t _getIndependentColumnAddress() const {
+        if ($self->getNumRows() == 0) return 0;
+        return reinterpret_cast<size_t>($self->getIndependentColumn().data());
+    }
+    void _appendRowFromAddress(double indRow, size_t address, int ncol) {
+        const double* values = reinterpret_cast<const double*>(address);
+        $self->appendRow(indRow, SimTK::RowVector(ncol, values));
+    }
+    void _appendRowsFromAddress(size_t indAddress, size_t depAddress,
+                                int nrow, int ncol) {
+        const double* ind = reinterpret_cast<const double*>(indAddress);
+        const double* dep = reinterpret_cast<const double*>(depAddress);
+        // The NumPy array is row-major.
+        SimTK::Matrix depRows(nrow, ncol);
+        for (int i = 0; i < nrow; ++i)
+            for (int j = 0; j < ncol; ++j)
+                depRows(i, j) = dep[i * ncol + j];
+        $self->appendRows(std::vector<double>(ind, ind + nrow), depRows);
+    }
+    void _setDependentColumnFromAddress(const std::string& columnLabel,
+                                        size_t address, int nrow) {
+        OPENSIM_THROW_IF(static_cast<size_t>(nrow) != $self->getNumRows(),
+                         IncorrectNumRows,
+                         $self->getNumRows(), static_cast<size_t>(nrow));
+        const double* values = reinterpret_cast<const double*>(address);
+        SimTK::VectorView column = $self->updDependentColumn(columnLabel);
+        for (int i = 0; i < nrow; ++i)
+            column[i] = values[i];
+    }
+%pythoncode %{
+    def getMatrixAsNumPy(self):
+        """Get a 2D NumPy array (rows by columns) that shares its memory
+        with the dependent columns of this table. If the table shares its
+        data with copies of it, it first gets its own copy of the data (see
+        updMatrix()), so that writing to the array changes only this table.
+        The array must not be used after the table is destroyed, copied, or
+        rows or columns are added to or removed from it."""
+        return _common_matrix_as_numpy(self, self.updMatrix())
+
+    def getDependentColumnAsNumPy(self, columnLabel):
+        """Get a NumPy array that shares its memory with the dependent
+        column with the given label. See getMatrixAsNumPy()."""
+        return _common_vector_as_numpy(self,
+                                       self.updDependentColumn(columnLabel))
+
+    def getIndependentColumnAsNumPy(self):
+        """Get a read-only NumPy array that shares its memory with the
+        independent column of this table. See getMatrixAsNumPy()."""
+        return _common_numpy_view(self, self._getIndependentColumnAddress(),
+                                  (self.getNumRows(),), (1,), readonly=True)
+
+    def appendRowFromNumPy(self, indRow, depRow):
+        """Append a row, given as a 1D sequence or NumPy array, with the
+        given value of the independent column."""
+        import numpy
+        depRow = numpy.ascontiguousarray(depRow, dtype=numpy.float64)
+        self._appendRowFromAddress(indRow, depRow.ctypes.data,
+                                   depRow.size)
+
+    def appendRowsFromNumPy(self, indRows, depRows):
+        """Append the rows of a 2D NumPy array (or nested sequence), with
+        the values of the independent column given by the 1D array indRows.
+        The rows are appended at once; see appendRows()."""
+        import numpy
+        indRows = numpy.ascontiguousarray(indRows, dtype=numpy.float64)
+        depRows = numpy.ascontiguousarray(depRows, dtype=numpy.float64)
+        if depRows.ndim != 2:
+            raise ValueError('Expected a 2D array of rows.')
+        if indRows.ndim != 1 or indRows.size != depRows.shape[0]:
+            raise ValueError('Expected one independent value per row.')
+        self._appendRowsFromAddress(indRows.ctypes.data, depRows.ctypes.data,
+                                    depRows.shape[0], depRows.shape[1])
+
+    def setDependentColumnFromNumPy(self, columnLabel, values):
+        """Set all the values of the dependent column with the given label
+        from a 1D sequence or NumPy array."""
+        import numpy
+        values = numpy.ascontiguousarray(values, dtype=numpy.float64)
+        self._setDependentColumnFromAddress(columnLabel, values.ctypes.data,
+                                            values.size)
+%}
+}
+
+%extend OpenSim::Storage {
+    void _copyDataToAddress(size_t timeAddress, size_t dataAddress,
+                            int ncol) const {
+        double* time = reinterpret_cast<double*>(timeAddress);
+        double* data = reinterpret_cast<double*>(dataAddress);
+        for (int i = 0; i < $self->getSize(); ++i) {
+            const OpenSim::StateVector* row = $self->getStateVector(i);
+            const OpenSim::Array<double>& values = row->getData();
+            time[i] = row->getTime();
+            for (int j = 0; j < ncol; ++j)
+                data[i * ncol + j] =
+                    j < values.getSize() ? values[j] : SimTK::NaN;
+        }
+    }
+%pythoncode %{
+    def getDataAsNumPy(self):
+        """Get the time column and the data (rows by columns, excluding
+        time) of this Storage as a tuple of NumPy arrays. The rows of a
+        Storage are stored separately, so the data are copied; missing values
+        are NaN."""
+        import numpy
+        ncol = self.getColumnLabels().getSize() - 1
+        if ncol < 0:
+            ncol = self.getSmallestNumberOfStates()
+        time = numpy.empty(self.getSize())
+        data = numpy.empty((self.getSize(), ncol))
+        if self.getSize() > 0:
+            self._copyDataToAddress(time.ctypes.data, data.ctypes.data, ncol)
+        return time, data
+%}
+}
+
+%pythoncode %{
+from .simbody import _numpy_view as _common_numpy_view
+from .simbody import _vector_as_numpy as _common_vector_as_numpy
+from .simbody import _matrix_as_numpy as _common_matrix_as_numpy
+%}
+
 // Include all the OpenSim code.
 // =============================
 %include <Bindings/preliminaries.i>
@@ -149,3 +149,156 @@ These typemaps work, though.
     }
 };
 
+
+// NumPy views
+// ===========
+// The data of vectors and matrices can be viewed as NumPy arrays without
+// copying. The address and layout of the data are obtained here, and the
+// NumPy array is created in Python with the array interface protocol, so that
+// NumPy is needed only when these methods are used. The address of every
+// element is checked; a stride of 0 means the elements are not evenly spaced
+// in memory, and the data are copied instead.
+%extend SimTK::VectorBase<double> {
+    size_t _getDataAddress() const {
+        if ($self->size() == 0) return 0;
+        return reinterpret_cast<size_t>(&$self->getElt(0, 0));
+    }
+    int _getDataStride() const {
+        const int n = $self->size();
+        if (n < 2) return 1;
+        const double* first = &$self->getElt(0, 0);
+        const int stride = static_cast<int>(&$self->getElt(1, 0) - first);
+        for (int i = 2; i < n; ++i)
+            if (&$self->getElt(i, 0) != first + i * stride) return 0;
+        return stride;
+    }
+%pythoncode %{
+    def getAsNumPy(self):
+        """Get a NumPy array that shares its memory with this vector, if the
+        elements are evenly spaced in memory, and a copy otherwise. The array
+        must not be used after the vector is destroyed or resized."""
+        return _vector_as_numpy(self, self)
+%}
+};
+%extend SimTK::RowVectorBase<double> {
+    size_t _getDataAddress() const {
+        if ($self->size() == 0) return 0;
+        return reinterpret_cast<size_t>(&$self->getElt(0, 0));
+    }
+    int _getDataStride() const {
+        const int n = $self->size();
+        if (n < 2) return 1;
+        const double* first = &$self->getElt(0, 0);
+        const int stride = static_cast<int>(&$self->getElt(0, 1) - first);
+        for (int j = 2; j < n; ++j)
+            if (&$self->getElt(0, j) != first + j * stride) return 0;
+        return stride;
+    }
+%pythoncode %{
+    def getAsNumPy(self):
+        """Get a NumPy array that shares its memory with this row vector, if
+        the elements are evenly spaced in memory, and a copy otherwise. The
+        array must not be used after the row vector is destroyed or
+        resized."""
+        return _vector_as_numpy(self, self)
+%}
+};
+%extend SimTK::MatrixBase<double> {
+    size_t _getDataAddress() const {
+        if ($self->nrow() == 0 || $self->ncol() == 0) return 0;
+        return reinterpret_cast<size_t>(&$self->getElt(0, 0));
+    }
+    // Row stride and column stride, in elements.
+    std::vector<int> _getDataStrides() const {
+        const int nr = $self->nrow();
+        const int nc = $self->ncol();
+        if (nr == 0 || nc == 0) return {1, 1};
+        const double* first = &$self->getElt(0, 0);
+        const int rowStride = nr < 2 ? 1 :
+                static_cast<int>(&$self->getElt(1, 0) - first);
+        const int colStride = nc < 2 ? 1 :
+                static_cast<int>(&$self->getElt(0, 1) - first);
+        for (int i = 0; i < nr; ++i)
+            for (int j = 0; j < nc; ++j)
+                if (&$self->getElt(i, j) !=
+                        first + i * rowStride + j * colStride)
+                    return {0, 0};
+        return {rowStride, colStride};
+    }
+%pythoncode %{
+    def getAsNumPy(self):
+        """Get a 2D NumPy array that shares its memory with this matrix, if
+        the elements are evenly spaced in memory, and a copy otherwise. The
+        array must not be used after the matrix is destroyed or resized."""
+        return _matrix_as_numpy(self, self)
+%}
+};
+
+// The Q, U and Y vectors of a State are read-only views; set them with
+// setQ(), setU() and setY() so that the State is invalidated properly.
+%extend SimTK::State {
+%pythoncode %{
+    def getQAsNumPy(self):
+        """Get a read-only NumPy array that shares its memory with the
+        generalized coordinates of this State. The array reflects later
+        changes to the State, and must not be used after the State is
+        destroyed or its topology is changed."""
+        return _vector_as_numpy(self, self.getQ(), readonly=True)
+
+    def getUAsNumPy(self):
+        """Get a read-only NumPy array that shares its memory with the
+        generalized speeds of this State. See getQAsNumPy()."""
+        return _vector_as_numpy(self, self.getU(), readonly=True)
+
+    def getYAsNumPy(self):
+        """Get a read-only NumPy array that shares its memory with all the
+        continuous state variables (Q, U and Z) of this State. See
+        getQAsNumPy()."""
+        return _vector_as_numpy(self, self.getY(), readonly=True)
+%}
+};
+
+%pythoncode %{
+class _NumPyArrayInterface(object):
+    """Exposes memory owned by a C++ object through NumPy's array interface
+    protocol, and keeps the Python object that owns the memory alive for as
+    long as the NumPy array that uses it."""
+    def __init__(self, owner, address, shape, strides, readonly):
+        self.owner = owner
+        self.__array_interface__ = {
+            'version': 3,
+            'typestr': '<f8',
+            'shape': tuple(shape),
+            'strides': tuple(8 * stride for stride in strides),
+            'data': (address, readonly),
+        }
+
+def _numpy_view(owner, address, shape, strides, readonly=False):
+    import numpy
+    if address == 0:
+        return numpy.empty(shape)
+    return numpy.asarray(
+            _NumPyArrayInterface(owner, address, shape, strides, readonly))
+
+def _vector_as_numpy(owner, vector, readonly=False):
+    import numpy
+    stride = vector._getDataStride()
+    if stride == 0:
+        values = numpy.array([vector[i] for i in range(vector.size())])
+        values.setflags(write=not readonly)
+        return values
+    return _numpy_view(owner, vector._getDataAddress(), (vector.size(),),
+                       (stride,), readonly)
+
+def _matrix_as_numpy(owner, matrix, readonly=False):
+    import numpy
+    nrow, ncol = matrix.nrow(), matrix.ncol()
+    strides = matrix._getDataStrides()
+    if strides[0] == 0:
+        values = numpy.array([[matrix.getElt(i, j) for j in range(ncol)]
+                              for i in range(nrow)])
+        values.setflags(write=not readonly)
+        return values
+    return _numpy_view(owner, matrix._getDataAddress(), (nrow, ncol),
+                       (strides[0], strides[1]), readonly)
+%}
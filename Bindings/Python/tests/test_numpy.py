@@ -0,0 +1,168 @@
+"""
+Test the NumPy views of vectors, matrices, tables and states, and the bulk
+setters of tables, and compare their speed to element-by-element access.
+"""
+import os, time, unittest
+import opensim as osim
+
+try:
+    import numpy as np
+except ImportError:
+    np = None
+
+test_dir = os.path.join(os.path.dirname(os.path.abspath(osim.__file__)),
+                        'tests')
+
+@unittest.skipIf(np is None, 'NumPy is not installed.')
+class TestNumPy(unittest.TestCase):
+    def test_vector(self):
+        vec = osim.Vector([1.0, 2.0, 3.0, 4.0])
+        arr = vec.getAsNumPy()
+        assert arr.shape == (4,)
+        assert np.all(arr == [1, 2, 3, 4])
+        # The array shares its memory with the vector.
+        arr[2] = 10
+        assert vec[2] == 10
+        vec[0] = -1
+        assert arr[0] == -1
+
+        row = osim.RowVector([5.0, 6.0, 7.0])
+        assert np.all(row.getAsNumPy() == [5, 6, 7])
+
+        assert osim.Vector().getAsNumPy().shape == (0,)
+
+    def test_matrix(self):
+        mat = osim.Matrix(3, 4)
+        for i in range(3):
+            for j in range(4):
+                mat.set(i, j, 10 * i + j)
+        arr = mat.getAsNumPy()
+        assert arr.shape == (3, 4)
+        for i in range(3):
+            for j in range(4):
+                assert arr[i, j] == 10 * i + j
+        arr[1, 2] = -5
+        assert mat.get(1, 2) == -5
+
+    def test_table(self):
+        table = osim.TimeSeriesTable()
+        table.setColumnLabels(('a', 'b', 'c'))
+        table.appendRowFromNumPy(0.0, np.array([0.0, 1.0, 2.0]))
+        table.appendRowsFromNumPy([0.1, 0.2],
+                                  np.array([[10.0, 11.0, 12.0],
+                                            [20.0, 21.0, 22.0]]))
+        assert table.getNumRows() == 3
+
+        assert np.all(table.getIndependentColumnAsNumPy() == [0, 0.1, 0.2])
+        mat = table.getMatrixAsNumPy()
+        assert np.all(mat == [[0, 1, 2], [10, 11, 12], [20, 21, 22]])
+        assert np.all(table.getDependentColumnAsNumPy('b') == [1, 11, 21])
+
+        # The views share memory with the table.
+        mat[2, 0] = 100
+        assert table.getMatrix().get(2, 0) == 100
+        assert table.getDependentColumnAsNumPy('a')[2] == 100
+
+        table.setDependentColumnFromNumPy('c', [-1, -2, -3])
+        assert np.all(mat[:, 2] == [-1, -2, -3])
+
+        # Writing to the views of a copy does not change the original table,
+        # with which the copy shared its data.
+        copy = osim.TimeSeriesTable(table)
+        copy_mat = copy.getMatrixAsNumPy()
+        copy_mat[0, 0] = 50
+        copy.getDependentColumnAsNumPy('b')[0] = 51
+        assert copy.getMatrix().get(0, 0) == 50
+        assert copy.getMatrix().get(0, 1) == 51
+        assert table.getMatrix().get(0, 0) == 0
+        assert table.getMatrix().get(0, 1) == 1
+        assert mat[0, 0] == 0
+
+        # The independent column is read-only.
+        time_col = table.getIndependentColumnAsNumPy()
+        with self.assertRaises(ValueError):
+            time_col[0] = 1
+
+        # Invalid rows are rejected.
+        with self.assertRaises(RuntimeError):
+            table.appendRowFromNumPy(0.3, [1.0, 2.0])
+        with self.assertRaises(RuntimeError):
+            table.appendRowsFromNumPy([0.3, 0.25], np.zeros((2, 3)))
+        assert table.getNumRows() == 3
+
+    def test_storage(self):
+        sto = osim.Storage(os.path.join(test_dir, 'storage.sto'))
+        time_col, data = sto.getDataAsNumPy()
+        assert time_col.shape == (sto.getSize(),)
+        assert data.shape[0] == sto.getSize()
+        assert time_col[-1] == sto.getLastTime()
+        column = osim.ArrayDouble()
+        sto.getDataColumn(sto.getColumnLabels().get(1), column)
+        for i in range(sto.getSize()):
+            assert data[i, 0] == column.get(i)
+
+    def test_state(self):
+        model = osim.Model()
+        body = osim.Body('body', 1.0, osim.Vec3(0), osim.Inertia(1))
+        joint = osim.PinJoint()
+        joint.setName('joint')
+        joint.connectSocket_parent_frame(model.getGround())
+        joint.connectSocket_child_frame(body)
+        model.addBody(body)
+        model.addJoint(joint)
+        state = model.initSystem()
+        coord = model.getCoordinateSet().get(0)
+        coord.setValue(state, 0.5)
+        coord.setSpeedValue(state, -0.25)
+
+        q = state.getQAsNumPy()
+        assert q.shape == (1,) and q[0] == 0.5
+        assert state.getUAsNumPy()[0] == -0.25
+        assert np.all(state.getYAsNumPy()[:2] == [0.5, -0.25])
+        with self.assertRaises(ValueError):
+            q[0] = 1
+        # The view reflects changes to the state.
+        coord.setValue(state, 0.75)
+        assert q[0] == 0.75
+
+    def test_benchmark(self):
+        print()
+        nrow, ncol = 2000, 30
+        values = np.arange(nrow * ncol, dtype=float).reshape(nrow, ncol)
+        times = np.linspace(0, 1, nrow)
+        labels = tuple('col%i' % j for j in range(ncol))
+
+        # Fill a table row by row, element by element.
+        start = time.time()
+        table_elt = osim.TimeSeriesTable()
+        table_elt.setColumnLabels(labels)
+        for i in range(nrow):
+            row = osim.RowVector(ncol)
+            for j in range(ncol):
+                row[j] = values[i, j]
+            table_elt.appendRow(times[i], row)
+        fill_elt = time.time() - start
+
+        start = time.time()
+        table_np = osim.TimeSeriesTable()
+        table_np.setColumnLabels(labels)
+        table_np.appendRowsFromNumPy(times, values)
+        fill_np = time.time() - start
+
+        # Read the tables back.
+        start = time.time()
+        mat = table_elt.getMatrix()
+        read = [[mat.getElt(i, j) for j in range(ncol)] for i in range(nrow)]
+        read_elt = time.time() - start
+
+        start = time.time()
+        read_np = table_np.getMatrixAsNumPy()
+        read_np_time = time.time() - start
+
+        assert np.all(np.array(read) == values)
+        assert np.all(read_np == values)
+
+        print('Fill %i x %i table: element-by-element %f s, NumPy %f s' %
+              (nrow, ncol, fill_elt, fill_np))
+        print('Read %i x %i table: element-by-element %f s, NumPy %f s' %
+              (nrow, ncol, read_elt, read_np_time))
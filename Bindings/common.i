@@ -69,6 +69,12 @@ namespace OpenSim {
 // Used in Component::generateDecorations.
 %include <OpenSim/Common/ModelDisplayHints.h>
 
+// Used by Component::getProfiler() and Model::setProfilingEnabled().
+namespace OpenSim {
+    %ignore ComponentProfiler::Scope;
+}
+%include <OpenSim/Common/ComponentProfiler.h>
+
 namespace OpenSim {
     %ignore Output::downcast(AbstractOutput&); // suppress warning 509.
 }
@@ -409,6 +409,13 @@ computeActuation(const SimTK::State& s) const
 
 void Millard2012EquilibriumMuscle::
 computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
+{
+    solveFiberEquilibrium(s, solveForVelocity, false);
+}
+
+void Millard2012EquilibriumMuscle::
+solveFiberEquilibrium(SimTK::State& s, bool solveForVelocity,
+                      bool warmStart) const
 {
     if(get_ignore_tendon_compliance()) {                    // rigid tendon
         return;
@@ -430,17 +437,39 @@ computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
     double pathSpeed = solveForVelocity ? getLengtheningSpeed(s) : 0;
     double activation = getActivation(s);
 
+    // A warm start begins close to the solution, so it should converge in a
+    // few iterations; otherwise, fall back to the cold start.
+    const int maxWarmStartIter = 20;
+    double prevFiberLength = SimTK::NaN;
+    double prevFiberVelocity = 0.0;
+    warmStart = warmStart &&
+        getPreviousEquilibriumSolution(s, prevFiberLength, prevFiberVelocity);
+
     try {
         std::pair<StatusFromEstimateMuscleFiberState,
-                  ValuesFromEstimateMuscleFiberState> result =
-            estimateMuscleFiberState(activation, pathLength, pathSpeed,
-                tol, maxIter, solveForVelocity);
+                  ValuesFromEstimateMuscleFiberState> result;
+        int iterations = 0;
+
+        if(warmStart) {
+            result = estimateMuscleFiberState(activation, pathLength,
+                pathSpeed, tol, maxWarmStartIter, solveForVelocity,
+                prevFiberLength, prevFiberVelocity);
+            iterations += (int)result.second["iterations"];
+        }
+        if(!warmStart || result.first !=
+                StatusFromEstimateMuscleFiberState::Success_Converged) {
+            result = estimateMuscleFiberState(activation, pathLength,
+                pathSpeed, tol, maxIter, solveForVelocity);
+            iterations += (int)result.second["iterations"];
+        }
 
         switch(result.first) {
 
         case StatusFromEstimateMuscleFiberState::Success_Converged:
             setActuation(s, result.second["tendon_force"]);
             setFiberLength(s, result.second["fiber_length"]);
+            setEquilibriumSolution(s, result.second["fiber_length"],
+                result.second["fiber_velocity"], iterations);
             break;
 
         case StatusFromEstimateMuscleFiberState::Warning_FiberAtLowerBound:
@@ -449,6 +478,8 @@ computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
                    getName().c_str(), result.second["fiber_length"]);
             setActuation(s, result.second["tendon_force"]);
             setFiberLength(s, result.second["fiber_length"]);
+            setEquilibriumSolution(s, result.second["fiber_length"],
+                result.second["fiber_velocity"], iterations);
             break;
 
         case StatusFromEstimateMuscleFiberState::Failure_MaxIterationsReached:
@@ -1238,7 +1269,9 @@ Millard2012EquilibriumMuscle::estimateMuscleFiberState(
                                     const double pathLengtheningSpeed,
                                     const double aSolTolerance,
                                     const int aMaxIterations,
-                                    bool staticSolution) const
+                                    bool staticSolution,
+                                    const double aFiberLengthGuess,
+                                    const double aFiberVelocityGuess) const
 {
     // If seeking a static solution, set velocities to zero and avoid the
     // velocity-sharing algorithm below, as it can produce nonzero fiber and
@@ -1394,6 +1427,12 @@ Millard2012EquilibriumMuscle::estimateMuscleFiberState(
     //*******************************
     //Initialize the loop
     int iter = 0;
+    const bool warmStart = !SimTK::isNaN(aFiberLengthGuess);
+
+    // Start from the provided fiber length, if any
+    if (warmStart) {
+        lce = clampFiberLength(aFiberLengthGuess);
+    }
 
     // Estimate the position level quantities (lengths, angles) of the muscle
     positionFunc();
@@ -1401,8 +1440,14 @@ Millard2012EquilibriumMuscle::estimateMuscleFiberState(
     // Multipliers based on initial fiber-length estimate
     multipliersFunc();
 
-    // Starting guess at the force-velocity multiplier is static
+    // Starting guess at the force-velocity multiplier is static, unless a
+    // fiber velocity guess is available
     fv = 1.0;
+    if (warmStart && !staticSolution) {
+        dlce = aFiberVelocityGuess;
+        dlceN = dlce / (vmax*ofl);
+        fv = get_ForceVelocityCurve().calcValue(dlceN);
+    }
 
     fiberForceV = calcFiberForce(fiso, ma, fal, fv, fpe, dlceN);
     Fm = fiberForceV[0];
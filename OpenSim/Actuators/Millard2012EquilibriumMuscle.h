@@ -431,6 +431,18 @@ public:
         computeFiberEquilibrium(s, false);
     }
 
+    /** Same as computeInitialFiberEquilibrium(), but the Newton iteration
+    starts from the fiber length and velocity of the previous equilibrium
+    solution stored in the state, if any. If the warm-started iteration does
+    not converge within a few iterations, the solve is repeated from the
+    usual cold starting point.
+        @param[in,out] s The state of the system.
+        @throws MuscleCannotEquilibrate
+    */
+    void computeWarmStartedFiberEquilibrium(SimTK::State& s) const override {
+        solveFiberEquilibrium(s, false, true);
+    }
+
     /** Computes the fiber length such that the fiber and tendon are developing
         the same force, either assuming muscle-tendon velocity as provided
         by the state or zero as designated by the useZeroVelocity flag.
@@ -554,6 +566,9 @@ protected:
     void computeStateVariableDerivatives(const SimTK::State& s) const override;
 
 private:
+    // Fills the length and velocity caches of many muscles at once.
+    friend class Millard2012MuscleGroupEvaluator;
+
     // The name used to access the activation state.
     static const std::string STATE_ACTIVATION_NAME;
     // The name used to access the fiber length state.
@@ -734,6 +749,13 @@ private:
     // length.
     double clampFiberLength(double lce) const;
 
+    // Implements computeFiberEquilibrium() and
+    // computeWarmStartedFiberEquilibrium(). If warmStart is true and the state
+    // holds a previous equilibrium solution, the Newton iteration starts from
+    // it and falls back to the cold start on failure.
+    void solveFiberEquilibrium(SimTK::State& s, bool solveForVelocity,
+                               bool warmStart) const;
+
     // Status flag returned by estimateMuscleFiberState().
     enum StatusFromEstimateMuscleFiberState {
         Success_Converged,
@@ -759,6 +781,12 @@ private:
            give up attempting to initialize the model
     @param staticSolution set to true to calculate the static equilibrium
            solution, setting fiber and tendon velocities to zero
+    @param aFiberLengthGuess initial guess for the fiber length; if NaN, the
+           iteration starts from a fiber length for which the tendon is
+           slightly stretched
+    @param aFiberVelocityGuess initial guess for the fiber velocity, used to
+           estimate the starting force-velocity multiplier (ignored for
+           static solutions or if aFiberLengthGuess is NaN)
     */
     std::pair<StatusFromEstimateMuscleFiberState,
               ValuesFromEstimateMuscleFiberState>
@@ -767,7 +795,9 @@ private:
                                  const double pathLengtheningSpeed,
                                  const double aSolTolerance,
                                  const int aMaxIterations,
-                                 bool staticSolution=false) const;
+                                 bool staticSolution=false,
+                                 const double aFiberLengthGuess=SimTK::NaN,
+                                 const double aFiberVelocityGuess=0.0) const;
 
 };
 } //end of namespace OpenSim
@@ -0,0 +1,347 @@
+/* -------------------------------------------------------------------------- *
+ *               OpenSim:  Millard2012MuscleGroupEvaluator.cpp                *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+#include "Millard2012MuscleGroupEvaluator.h"
+#include "Millard2012EquilibriumMuscle.h"
+#include <OpenSim/Simulation/Model/Model.h>
+
+using namespace std;
+using namespace OpenSim;
+using namespace SimTK;
+
+namespace {
+    // Two curves are interchangeable if they are of the same type and all of
+    // their properties have the same values. Names are not compared.
+    bool haveSameProperties(const OpenSim::Function& a,
+                            const OpenSim::Function& b)
+    {
+        if(a.getConcreteClassName() != b.getConcreteClassName() ||
+           a.getNumProperties() != b.getNumProperties())
+            return false;
+        for(int i=0; i < a.getNumProperties(); ++i) {
+            if(!(a.getPropertyByIndex(i) == b.getPropertyByIndex(i)))
+                return false;
+        }
+        return true;
+    }
+
+    // Evaluate curves[k] at in[indices[k]] for each k, storing the result in
+    // out[indices[k]].
+    void calcValuesAt(const vector<int>& indices,
+                      const vector<const SmoothSegmentedFunction*>& curves,
+                      const vector<double>& in, vector<double>& out,
+                      vector<double>& batchIn, vector<double>& batchOut,
+                      vector<double>& work)
+    {
+        const int n = (int)indices.size();
+        for(int k=0; k < n; ++k)
+            batchIn[k] = in[indices[k]];
+        SmoothSegmentedFunction::calcValues(n, curves.data(), batchIn.data(),
+                                            batchOut.data(), work);
+        for(int k=0; k < n; ++k)
+            out[indices[k]] = batchOut[k];
+    }
+}
+
+//==============================================================================
+// CONSTRUCTION
+//==============================================================================
+Millard2012MuscleGroupEvaluator::
+Millard2012MuscleGroupEvaluator(const Model& model)
+{
+    for(const Millard2012EquilibriumMuscle& muscle :
+            model.getComponentList<Millard2012EquilibriumMuscle>()) {
+
+        // Derived classes may compute their caches differently.
+        if(muscle.getConcreteClassName() !=
+                Millard2012EquilibriumMuscle::getClassName())
+            continue;
+
+        const MuscleFixedWidthPennationModel& penMdl =
+            muscle.getPennationModel();
+        const int index = (int)m_muscles.size();
+        m_muscles.push_back(&muscle);
+
+        m_maxIsometricForce.push_back(muscle.getMaxIsometricForce());
+        m_optimalFiberLength.push_back(muscle.getOptimalFiberLength());
+        m_tendonSlackLength.push_back(muscle.getTendonSlackLength());
+        m_maxContractionVelocity.push_back(
+            muscle.getMaxContractionVelocity());
+        m_minimumFiberLength.push_back(muscle.getMinimumFiberLength());
+        m_parallelogramHeight.push_back(penMdl.getParallelogramHeight());
+        m_maximumPennationAngle.push_back(
+            penMdl.get_maximum_pennation_angle());
+        m_maximumSinPennation.push_back(
+            sin(penMdl.get_maximum_pennation_angle()));
+        m_pennatedMinFiberLength.push_back(penMdl.getMinimumFiberLength());
+        m_pennatedMinFiberLengthAlongTendon.push_back(
+            penMdl.getMinimumFiberLengthAlongTendon());
+        m_isPennated.push_back(
+            penMdl.get_pennation_angle_at_optimal() > SimTK::Eps ? 1.0 : 0.0);
+        m_isRigidTendon.push_back(
+            muscle.get_ignore_tendon_compliance() ? 1.0 : 0.0);
+        m_fiberDamping.push_back(muscle.getFiberDamping());
+
+        m_falCurve.push_back(m_curves[findOrAddCurve(
+            muscle.get_ActiveForceLengthCurve())].get());
+        m_fpeCurve.push_back(m_curves[findOrAddCurve(
+            muscle.get_FiberForceLengthCurve())].get());
+
+        if(muscle.get_ignore_tendon_compliance()) {
+            m_rigid.push_back(index);
+            m_fvCurveRigid.push_back(m_curves[findOrAddCurve(
+                muscle.get_ForceVelocityCurve())].get());
+        } else {
+            m_elastic.push_back(index);
+            m_fseCurveElastic.push_back(m_curves[findOrAddCurve(
+                muscle.get_TendonForceLengthCurve())].get());
+            if(muscle.getUseFiberDamping()) {
+                m_damped.push_back(index);
+                m_fvCurveDamped.push_back(m_curves[findOrAddCurve(
+                    muscle.get_ForceVelocityCurve())].get());
+            } else {
+                m_undamped.push_back(index);
+                m_fvInvCurveUndamped.push_back(m_curves[findOrAddCurve(
+                    muscle.fvInvCurve)].get());
+            }
+        }
+    }
+
+    const size_t n = m_muscles.size();
+    for(vector<double>* buffer : {&m_muscleLength, &m_lengtheningSpeed,
+            &m_fiberLength, &m_activation, &m_normFiberLength,
+            &m_pennationAngle, &m_cosPennationAngle, &m_sinPennationAngle,
+            &m_tendonLength, &m_normTendonLength, &m_fal, &m_fpe, &m_fse,
+            &m_fv, &m_fiberVelocity, &m_normFiberVelocity,
+            &m_batchIn, &m_batchOut})
+        buffer->assign(n, SimTK::NaN);
+}
+
+int Millard2012MuscleGroupEvaluator::
+findOrAddCurve(const OpenSim::Function& curve)
+{
+    for(size_t i=0; i < m_curveSources.size(); ++i) {
+        if(haveSameProperties(*m_curveSources[i], curve))
+            return (int)i;
+    }
+    m_curveSources.push_back(&curve);
+    m_curves.emplace_back(
+        static_cast<SmoothSegmentedFunction*>(curve.createSimTKFunction()));
+    return (int)m_curves.size()-1;
+}
+
+const Millard2012EquilibriumMuscle& Millard2012MuscleGroupEvaluator::
+getMuscle(int index) const
+{
+    OPENSIM_THROW_IF(index < 0 || index >= getNumMuscles(), IndexOutOfRange,
+                     (size_t)index, 0, (size_t)getNumMuscles()-1);
+    return *m_muscles[index];
+}
+
+//==============================================================================
+// EVALUATION
+//==============================================================================
+void Millard2012MuscleGroupEvaluator::computeMuscleInfo(const SimTK::State& s)
+{
+    const int n = getNumMuscles();
+
+    // Gather the path lengths and speeds, and the muscle states.
+    for(int i=0; i < n; ++i) {
+        const Millard2012EquilibriumMuscle& muscle = *m_muscles[i];
+        m_muscleLength[i]     = muscle.getLength(s);
+        m_lengtheningSpeed[i] = muscle.getLengtheningSpeed(s);
+    }
+    for(int i : m_elastic) {
+        const Millard2012EquilibriumMuscle& muscle = *m_muscles[i];
+        m_fiberLength[i] = muscle.getStateVariableValue(s,
+            Millard2012EquilibriumMuscle::STATE_FIBER_LENGTH_NAME);
+        const double a = muscle.get_ignore_activation_dynamics()
+            ? muscle.getControl(s)
+            : muscle.getStateVariableValue(s,
+                Millard2012EquilibriumMuscle::STATE_ACTIVATION_NAME);
+        m_activation[i] = muscle.getActivationModel().clampActivation(a);
+    }
+
+    //==========================================================================
+    // Length level (see Millard2012EquilibriumMuscle::calcMuscleLengthInfo).
+    //==========================================================================
+    for(int i=0; i < n; ++i) {
+        // Rigid tendon: the fiber length follows from the path length.
+        const double h     = m_parallelogramHeight[i];
+        const double lceAT = m_muscleLength[i] - m_tendonSlackLength[i];
+        const double lceRigid =
+            (lceAT >= m_pennatedMinFiberLengthAlongTendon[i])
+            ? sqrt(h*h + lceAT*lceAT) : m_pennatedMinFiberLength[i];
+        const double lce = max(
+            m_isRigidTendon[i] > 0.5 ? lceRigid : m_fiberLength[i],
+            m_minimumFiberLength[i]);
+
+        const double sinPhi = h/lce;
+        const double phiPennated =
+            (lce > m_pennatedMinFiberLength[i] &&
+             sinPhi < m_maximumSinPennation[i])
+            ? asin(sinPhi) : m_maximumPennationAngle[i];
+        const double phi = m_isPennated[i] > 0.5 ? phiPennated : 0.0;
+
+        m_fiberLength[i]       = lce;
+        m_normFiberLength[i]   = lce/m_optimalFiberLength[i];
+        m_pennationAngle[i]    = phi;
+        m_cosPennationAngle[i] = cos(phi);
+        m_sinPennationAngle[i] = sin(phi);
+        m_tendonLength[i]      = m_muscleLength[i] - lce*m_cosPennationAngle[i];
+        m_normTendonLength[i]  = m_tendonLength[i]/m_tendonSlackLength[i];
+    }
+
+    SmoothSegmentedFunction::calcValues(n, m_fpeCurve.data(),
+        m_normFiberLength.data(), m_fpe.data(), m_work);
+    SmoothSegmentedFunction::calcValues(n, m_falCurve.data(),
+        m_normFiberLength.data(), m_fal.data(), m_work);
+
+    for(int i=0; i < n; ++i) {
+        const Millard2012EquilibriumMuscle& muscle = *m_muscles[i];
+        Millard2012EquilibriumMuscle::MuscleLengthInfo& mli =
+            muscle.updMuscleLengthInfo(s);
+        mli.fiberLength            = m_fiberLength[i];
+        mli.normFiberLength        = m_normFiberLength[i];
+        mli.pennationAngle         = m_pennationAngle[i];
+        mli.cosPennationAngle      = m_cosPennationAngle[i];
+        mli.sinPennationAngle      = m_sinPennationAngle[i];
+        mli.fiberLengthAlongTendon = m_fiberLength[i]*m_cosPennationAngle[i];
+        mli.tendonLength           = m_tendonLength[i];
+        mli.normTendonLength       = m_normTendonLength[i];
+        mli.tendonStrain           = mli.normTendonLength - 1.0;
+        mli.fiberPassiveForceLengthMultiplier = m_fpe[i];
+        mli.fiberActiveForceLengthMultiplier  = m_fal[i];
+        muscle.markCacheVariableValid(s, "lengthInfo");
+    }
+
+    //==========================================================================
+    // Velocity level (see Millard2012EquilibriumMuscle::calcFiberVelocityInfo).
+    //==========================================================================
+    // Rigid tendon: the fiber velocity follows from the path speed, unless
+    // the tendon is buckling.
+    for(int i : m_rigid) {
+        const bool buckling = m_tendonLength[i] <
+                              m_tendonSlackLength[i] - SimTK::SignificantReal;
+        m_fiberVelocity[i] = buckling ? 0.0
+            : m_lengtheningSpeed[i]*m_cosPennationAngle[i];
+        m_normFiberVelocity[i] = m_fiberVelocity[i]
+            / (m_optimalFiberLength[i]*m_maxContractionVelocity[i]);
+    }
+    calcValuesAt(m_rigid, m_fvCurveRigid, m_normFiberVelocity, m_fv,
+                 m_batchIn, m_batchOut, m_work);
+    for(int i : m_rigid) {
+        if(m_tendonLength[i] < m_tendonSlackLength[i]-SimTK::SignificantReal)
+            m_fv[i] = 1.0;
+    }
+
+    // Elastic tendon: the equilibrium equation is solved for the fiber
+    // velocity, given the tendon force.
+    calcValuesAt(m_elastic, m_fseCurveElastic, m_normTendonLength, m_fse,
+                 m_batchIn, m_batchOut, m_work);
+
+    // Without damping, this amounts to inverting the force-velocity curve.
+    for(int i : m_undamped) {
+        const char* singularity =
+              m_cosPennationAngle[i] <= SimTK::SignificantReal
+            ? "Pennation angle is 90 degrees"
+            : m_activation[i] <= SimTK::SignificantReal
+            ? "Activation is 0"
+            : m_fal[i] <= SimTK::SignificantReal
+            ? "Active-force-length factor is 0" : nullptr;
+        if(singularity) {
+            throw OpenSim::Exception("Millard2012MuscleGroupEvaluator: "
+                + m_muscles[i]->getName() + ": " + singularity
+                + ", causing a singularity");
+        }
+    }
+    for(int i : m_undamped) {
+        m_fv[i] = (m_fse[i]/m_cosPennationAngle[i] - m_fpe[i])
+                  / (m_activation[i]*m_fal[i]);
+    }
+    calcValuesAt(m_undamped, m_fvInvCurveUndamped, m_fv, m_normFiberVelocity,
+                 m_batchIn, m_batchOut, m_work);
+
+    // Elastic tendon, with damping: the Newton solve for fiber velocity is
+    // done muscle by muscle.
+    for(int i : m_damped) {
+        const Millard2012EquilibriumMuscle& muscle = *m_muscles[i];
+        SimTK::Vec3 fiberVelocityV = muscle.calcDampedNormFiberVelocity(
+            m_maxIsometricForce[i], m_activation[i], m_fal[i], m_fpe[i],
+            m_fse[i], m_fiberDamping[i], m_cosPennationAngle[i]);
+        if(fiberVelocityV[2] < 0.5) {
+            throw OpenSim::Exception("Millard2012MuscleGroupEvaluator: "
+                + muscle.getName()
+                + " Fiber velocity Newton method did not converge");
+        }
+        m_normFiberVelocity[i] = fiberVelocityV[0];
+    }
+    calcValuesAt(m_damped, m_fvCurveDamped, m_normFiberVelocity, m_fv,
+                 m_batchIn, m_batchOut, m_work);
+
+    for(int i : m_elastic) {
+        m_fiberVelocity[i] = m_normFiberVelocity[i]
+            * m_maxContractionVelocity[i]*m_optimalFiberLength[i];
+    }
+
+    for(int i=0; i < n; ++i) {
+        const Millard2012EquilibriumMuscle& muscle = *m_muscles[i];
+        const bool rigid = m_isRigidTendon[i] > 0.5;
+        const double lce    = m_fiberLength[i];
+        const double cosPhi = m_cosPennationAngle[i];
+        const double sinPhi = m_sinPennationAngle[i];
+        const double dmcldt = m_lengtheningSpeed[i];
+
+        double fv    = m_fv[i];
+        double dlceN = m_normFiberVelocity[i];
+        double dlce  = m_fiberVelocity[i];
+        double dphidt = (m_isPennated[i] > 0.5)
+                        ? -(dlce/lce)*tan(m_pennationAngle[i]) : 0.0;
+        double dlceAT = dlce*cosPhi - lce*sinPhi*dphidt;
+        double dtl = rigid ? 0.0 : dmcldt - dlce*cosPhi + lce*sinPhi*dphidt;
+
+        // Check to see whether the fiber state is clamped.
+        const double lceMin = m_minimumFiberLength[i];
+        double fiberStateClamped = 0.0;
+        if((lce <= lceMin && dlce <= 0) || lce < lceMin) {
+            dlce   = 0.0;
+            dlceN  = 0.0;
+            dlceAT = 0.0;
+            dphidt = 0.0;
+            dtl    = dmcldt;
+            fv     = 1.0;
+            fiberStateClamped = 1.0;
+        }
+
+        Millard2012EquilibriumMuscle::FiberVelocityInfo& fvi =
+            muscle.updFiberVelocityInfo(s);
+        fvi.fiberVelocity                = dlce;
+        fvi.normFiberVelocity            = dlceN;
+        fvi.fiberVelocityAlongTendon     = dlceAT;
+        fvi.pennationAngularVelocity     = dphidt;
+        fvi.tendonVelocity               = dtl;
+        fvi.normTendonVelocity           = dtl/m_tendonSlackLength[i];
+        fvi.fiberForceVelocityMultiplier = fv;
+        fvi.userDefinedVelocityExtras.resize(1);
+        fvi.userDefinedVelocityExtras[0] = fiberStateClamped;
+        muscle.markCacheVariableValid(s, "velInfo");
+    }
+}
@@ -0,0 +1,169 @@
+#ifndef OPENSIM_Millard2012MuscleGroupEvaluator_h__
+#define OPENSIM_Millard2012MuscleGroupEvaluator_h__
+/* -------------------------------------------------------------------------- *
+ *                OpenSim:  Millard2012MuscleGroupEvaluator.h                 *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+#include <OpenSim/Actuators/osimActuatorsDLL.h>
+#include <OpenSim/Common/SmoothSegmentedFunction.h>
+#include <memory>
+#include <vector>
+
+namespace OpenSim {
+
+class Function;
+class Model;
+class Millard2012EquilibriumMuscle;
+
+//==============================================================================
+//                      MILLARD 2012 MUSCLE GROUP EVALUATOR
+//==============================================================================
+/** Computes the MuscleLengthInfo and FiberVelocityInfo of all of the
+Millard2012EquilibriumMuscle%s in a Model at once. This is an opt-in
+alternative to letting each muscle fill its own caches the first time they are
+requested.
+
+On construction, the parameters of each muscle (optimal fiber length, tendon
+slack length, pennation, etc.) are gathered into structure-of-arrays buffers
+with one entry per muscle. The muscle curves are copied, and muscles whose
+curves have identical properties share a copy. computeMuscleInfo() then
+evaluates the length- and velocity-level equations of the muscle model in
+loops across muscles, evaluates each of the active-force-length, passive
+force-length, force-velocity and tendon force-length curves for all muscles
+with SmoothSegmentedFunction::calcValues(), and writes the results into the
+cache of each muscle. Subsequent requests for these quantities (e.g.,
+Muscle::getFiberLength() or Muscle::computeActuation()) read the cache.
+
+For muscles with an elastic tendon and fiber damping, the fiber velocity
+requires a Newton iteration that is still performed muscle by muscle. Because
+the muscle properties are copied when the evaluator is constructed, construct
+a new evaluator after editing the muscles or calling Model::initSystem()
+again.
+
+@code
+Model model("subject01.osim");
+SimTK::State& state = model.initSystem();
+Millard2012MuscleGroupEvaluator evaluator(model);
+
+model.realizeVelocity(state);
+evaluator.computeMuscleInfo(state);
+model.realizeDynamics(state); // Muscles read the values computed above.
+@endcode */
+class OSIMACTUATORS_API Millard2012MuscleGroupEvaluator {
+public:
+    /** Gather the Millard2012EquilibriumMuscle%s of the given model. The
+    model must have a system (i.e., Model::initSystem() has been called), and
+    it must outlive the evaluator. */
+    explicit Millard2012MuscleGroupEvaluator(const Model& model);
+
+    Millard2012MuscleGroupEvaluator(
+            const Millard2012MuscleGroupEvaluator&) = delete;
+    Millard2012MuscleGroupEvaluator& operator=(
+            const Millard2012MuscleGroupEvaluator&) = delete;
+
+    /** The number of muscles gathered by this evaluator. */
+    int getNumMuscles() const { return (int)m_muscles.size(); }
+
+    /** The muscle at the given index, in the order of the model's component
+    list. */
+    const Millard2012EquilibriumMuscle& getMuscle(int index) const;
+
+    /** The number of distinct curves shared by the gathered muscles. */
+    int getNumCurves() const { return (int)m_curves.size(); }
+
+    /** Compute the MuscleLengthInfo and FiberVelocityInfo of every gathered
+    muscle and store them in each muscle's cache. The state must be realized
+    to Stage::Velocity.
+    @throws OpenSim::Exception if a muscle reaches a singularity in the
+    force-velocity equilibrium equation (zero activation, zero
+    active-force-length multiplier, or a pennation angle of 90 degrees), if
+    the fiber velocity of a damped muscle cannot be found, or if a curve
+    cannot be evaluated (see SmoothSegmentedFunction::calcValues()). */
+    void computeMuscleInfo(const SimTK::State& s);
+
+private:
+    // Returns the index into m_curves of a copy of the given curve, adding
+    // the copy if no gathered curve has the same properties.
+    int findOrAddCurve(const Function& curve);
+
+    std::vector<const Millard2012EquilibriumMuscle*> m_muscles;
+
+    // Curve copies, and the OpenSim::Function each one was built from.
+    std::vector<std::unique_ptr<SmoothSegmentedFunction>> m_curves;
+    std::vector<const Function*> m_curveSources;
+
+    // Muscle parameters, one entry per muscle.
+    std::vector<double> m_maxIsometricForce;
+    std::vector<double> m_optimalFiberLength;
+    std::vector<double> m_tendonSlackLength;
+    std::vector<double> m_maxContractionVelocity;
+    std::vector<double> m_minimumFiberLength;
+    std::vector<double> m_parallelogramHeight;
+    std::vector<double> m_maximumPennationAngle;
+    std::vector<double> m_maximumSinPennation;
+    std::vector<double> m_pennatedMinFiberLength;
+    std::vector<double> m_pennatedMinFiberLengthAlongTendon;
+    std::vector<double> m_isPennated;
+    std::vector<double> m_isRigidTendon;
+    std::vector<double> m_fiberDamping;
+
+    // Curves of each muscle.
+    std::vector<const SmoothSegmentedFunction*> m_falCurve;
+    std::vector<const SmoothSegmentedFunction*> m_fpeCurve;
+
+    // Muscles with rigid tendons, and with elastic tendons with and without
+    // fiber damping, and the curves that are evaluated only for one of these
+    // groups.
+    std::vector<int> m_rigid;
+    std::vector<int> m_elastic;
+    std::vector<int> m_undamped;
+    std::vector<int> m_damped;
+    std::vector<const SmoothSegmentedFunction*> m_fvCurveRigid;
+    std::vector<const SmoothSegmentedFunction*> m_fseCurveElastic;
+    std::vector<const SmoothSegmentedFunction*> m_fvInvCurveUndamped;
+    std::vector<const SmoothSegmentedFunction*> m_fvCurveDamped;
+
+    // Per-muscle working buffers of computeMuscleInfo().
+    std::vector<double> m_muscleLength;
+    std::vector<double> m_lengtheningSpeed;
+    std::vector<double> m_fiberLength;
+    std::vector<double> m_activation;
+    std::vector<double> m_normFiberLength;
+    std::vector<double> m_pennationAngle;
+    std::vector<double> m_cosPennationAngle;
+    std::vector<double> m_sinPennationAngle;
+    std::vector<double> m_tendonLength;
+    std::vector<double> m_normTendonLength;
+    std::vector<double> m_fal;
+    std::vector<double> m_fpe;
+    std::vector<double> m_fse;
+    std::vector<double> m_fv;
+    std::vector<double> m_fiberVelocity;
+    std::vector<double> m_normFiberVelocity;
+    std::vector<double> m_batchIn;
+    std::vector<double> m_batchOut;
+    std::vector<double> m_work;
+
+//==============================================================================
+};  // END of class Millard2012MuscleGroupEvaluator
+//==============================================================================
+} // end of namespace OpenSim
+
+#endif // OPENSIM_Millard2012MuscleGroupEvaluator_h__
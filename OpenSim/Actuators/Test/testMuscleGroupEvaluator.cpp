@@ -0,0 +1,167 @@
+/* -------------------------------------------------------------------------- *
+ *                 OpenSim:  testMuscleGroupEvaluator.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Compares Millard2012MuscleGroupEvaluator, which fills the length and
+velocity caches of all Millard2012EquilibriumMuscles at once, against the
+per-muscle computation, and reports the time taken by each. */
+
+#include "Simbody.h"
+#include "OpenSim/OpenSim.h"
+#include <OpenSim/Actuators/Millard2012MuscleGroupEvaluator.h>
+#include <chrono>
+#include <memory>
+
+using namespace std;
+using namespace OpenSim;
+using namespace SimTK;
+
+void testCalcValues();
+void testAgainstPerMuscleComputation();
+
+int main()
+{
+    SimTK_START_TEST("testMuscleGroupEvaluator");
+        SimTK_SUBTEST(testCalcValues);
+        SimTK_SUBTEST(testAgainstPerMuscleComputation);
+    SimTK_END_TEST();
+}
+
+// SmoothSegmentedFunction::calcValues() must give the same values as
+// calcValue(), whose arithmetic and Newton iteration it repeats, both in the
+// Bezier sections and in the linear extrapolation regions, for a mix of curves
+// in a single batch.
+void testCalcValues()
+{
+    auto copyCurve = [](const OpenSim::Function& curve) {
+        return unique_ptr<SmoothSegmentedFunction>(
+            static_cast<SmoothSegmentedFunction*>(
+                curve.createSimTKFunction()));
+    };
+    auto fal = copyCurve(ActiveForceLengthCurve());
+    auto fpe = copyCurve(FiberForceLengthCurve());
+    auto fse = copyCurve(TendonForceLengthCurve());
+
+    const int n = 600;
+    vector<const SmoothSegmentedFunction*> curves(n);
+    vector<double> x(n), y(n);
+    vector<double> work;
+    for (int i = 0; i < n; ++i) {
+        curves[i] = (i%3 == 0) ? fal.get()
+                  : (i%3 == 1) ? fpe.get() : fse.get();
+        x[i] = 0.2 + 1.6*i/(n-1);
+    }
+    SmoothSegmentedFunction::calcValues(n, curves.data(), x.data(), y.data(),
+                                        work);
+    for (int i = 0; i < n; ++i)
+        SimTK_TEST(y[i] == curves[i]->calcValue(x[i]));
+}
+
+void testAgainstPerMuscleComputation()
+{
+    Model model("gait10dof18musc_subject01.osim");
+
+    // Exercise the rigid-tendon code path, and the elastic-tendon code paths
+    // with and without fiber damping.
+    int count = 0;
+    for (auto& muscle :
+            model.updComponentList<Millard2012EquilibriumMuscle>()) {
+        if (count % 3 == 0)
+            muscle.set_ignore_tendon_compliance(true);
+        else if (count % 3 == 1)
+            muscle.set_fiber_damping(0.0);
+        ++count;
+    }
+
+    SimTK::State& s = model.initSystem();
+    model.equilibrateMuscles(s);
+    for (int i = 0; i < s.getNU(); ++i)
+        s.updU()[i] = 0.5*std::sin(double(i));
+
+    Millard2012MuscleGroupEvaluator evaluator(model);
+    cout << "Gathered " << evaluator.getNumMuscles() << " muscles sharing "
+         << evaluator.getNumCurves() << " curves." << endl;
+    SimTK_TEST(evaluator.getNumMuscles() == count);
+
+    // The per-muscle computation.
+    SimTK::State sRef = s;
+    model.realizeDynamics(sRef);
+
+    // The batched computation; the muscles use the cached values to compute
+    // their forces.
+    model.realizeVelocity(s);
+    evaluator.computeMuscleInfo(s);
+    model.realizeDynamics(s);
+
+    const double tol = 1e-9;
+    for (int i = 0; i < evaluator.getNumMuscles(); ++i) {
+        const Millard2012EquilibriumMuscle& m = evaluator.getMuscle(i);
+        SimTK_TEST_EQ_TOL(m.getFiberLength(s), m.getFiberLength(sRef), tol);
+        SimTK_TEST_EQ_TOL(m.getPennationAngle(s), m.getPennationAngle(sRef),
+                          tol);
+        SimTK_TEST_EQ_TOL(m.getTendonLength(s), m.getTendonLength(sRef), tol);
+        SimTK_TEST_EQ_TOL(m.getActiveForceLengthMultiplier(s),
+                          m.getActiveForceLengthMultiplier(sRef), tol);
+        SimTK_TEST_EQ_TOL(m.getPassiveForceMultiplier(s),
+                          m.getPassiveForceMultiplier(sRef), tol);
+        SimTK_TEST_EQ_TOL(m.getFiberVelocity(s), m.getFiberVelocity(sRef), tol);
+        SimTK_TEST_EQ_TOL(m.getForceVelocityMultiplier(s),
+                          m.getForceVelocityMultiplier(sRef), tol);
+        SimTK_TEST_EQ_TOL(m.getTendonVelocity(s), m.getTendonVelocity(sRef),
+                          tol);
+        SimTK_TEST_EQ_TOL(m.getPennationAngularVelocity(s),
+                          m.getPennationAngularVelocity(sRef), tol);
+        SimTK_TEST_EQ_TOL(m.getTendonForce(s), m.getTendonForce(sRef),
+                          tol*m.getMaxIsometricForce());
+    }
+
+    // Time both paths. The path lengths and speeds remain cached, so only
+    // the muscle computations are measured.
+    const int numReps = 2000;
+    auto invalidate = [&]() {
+        for (int i = 0; i < evaluator.getNumMuscles(); ++i) {
+            evaluator.getMuscle(i).markCacheVariableInvalid(s, "lengthInfo");
+            evaluator.getMuscle(i).markCacheVariableInvalid(s, "velInfo");
+        }
+    };
+
+    double perMuscleTime = 0;
+    double batchTime = 0;
+    for (int rep = 0; rep < numReps; ++rep) {
+        invalidate();
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < evaluator.getNumMuscles(); ++i)
+            evaluator.getMuscle(i).getFiberVelocity(s);
+        perMuscleTime += chrono::duration<double>(
+                chrono::steady_clock::now() - start).count();
+
+        invalidate();
+        start = chrono::steady_clock::now();
+        evaluator.computeMuscleInfo(s);
+        batchTime += chrono::duration<double>(
+                chrono::steady_clock::now() - start).count();
+    }
+    cout << "Per-muscle computation: " << 1e6*perMuscleTime/numReps
+         << " us per evaluation of all muscles." << endl;
+    cout << "Batched computation:    " << 1e6*batchTime/numReps
+         << " us per evaluation of all muscles." << endl;
+    cout << "Speedup: " << perMuscleTime/batchTime << endl;
+}
@@ -330,6 +330,18 @@ double  Thelen2003Muscle::computeActuation(const SimTK::State& s) const
 }
 
 void Thelen2003Muscle::computeInitialFiberEquilibrium(SimTK::State& s) const
+{
+    solveFiberEquilibrium(s, false);
+}
+
+void Thelen2003Muscle::
+computeWarmStartedFiberEquilibrium(SimTK::State& s) const
+{
+    solveFiberEquilibrium(s, true);
+}
+
+void Thelen2003Muscle::solveFiberEquilibrium(SimTK::State& s,
+                                             bool warmStart) const
 {
     //Initial activation and fiber length from input State, s.
     _model->getMultibodySystem().realize(s, SimTK::Stage::Velocity);
@@ -341,10 +353,28 @@ void Thelen2003Muscle::computeInitialFiberEquilibrium(SimTK::State& s) const
 
     int maxIter = 20;  //Should this be user settable?
 
+    // A warm start begins close to the solution, so it should converge in a
+    // few iterations; otherwise, fall back to the cold start.
+    const int maxWarmStartIter = 10;
+    double prevFiberLength = SimTK::NaN;
+    double prevFiberVelocity = 0.0;
+    warmStart = warmStart &&
+        getPreviousEquilibriumSolution(s, prevFiberLength, prevFiberVelocity);
+
     std::pair<StatusFromInitMuscleState, ValuesFromInitMuscleState> result;
+    int iterations = 0;
 
     try {
-         result = initMuscleState(s, activation, tol, maxIter);
+        if (warmStart) {
+            result = initMuscleState(s, activation, tol, maxWarmStartIter,
+                                     prevFiberLength);
+            iterations += (int)result.second["iterations"];
+        }
+        if (!warmStart ||
+                result.first != StatusFromInitMuscleState::Success_Converged) {
+            result = initMuscleState(s, activation, tol, maxIter);
+            iterations += (int)result.second["iterations"];
+        }
     }
     catch (const std::exception& x) {
         OPENSIM_THROW_FRMOBJ(MuscleCannotEquilibrate, x.what());
@@ -355,6 +385,8 @@ void Thelen2003Muscle::computeInitialFiberEquilibrium(SimTK::State& s) const
     case StatusFromInitMuscleState::Success_Converged:
         setActuation(s, result.second["tendon_force"]);
         setFiberLength(s, result.second["fiber_length"]);
+        setEquilibriumSolution(s, result.second["fiber_length"],
+            result.second["fiber_velocity"], iterations);
         break;
 
     case StatusFromInitMuscleState::Warning_FiberAtLowerBound:
@@ -363,6 +395,8 @@ void Thelen2003Muscle::computeInitialFiberEquilibrium(SimTK::State& s) const
                getName().c_str(), result.second["fiber_length"]);
         setActuation(s, result.second["tendon_force"]);
         setFiberLength(s, result.second["fiber_length"]);
+        setEquilibriumSolution(s, result.second["fiber_length"],
+            result.second["fiber_velocity"], iterations);
         break;
 
     case StatusFromInitMuscleState::Failure_MaxIterationsReached:
@@ -721,7 +755,8 @@ std::pair<Thelen2003Muscle::StatusFromInitMuscleState,
 Thelen2003Muscle::initMuscleState(const SimTK::State& s,
                                   const double aActivation,
                                   const double aSolTolerance,
-                                  const int aMaxIterations) const
+                                  const int aMaxIterations,
+                                  const double aFiberLengthGuess) const
 {
     // Using short variable names to facilitate writing out long equations
     const double ma = aActivation;
@@ -864,6 +899,11 @@ Thelen2003Muscle::initMuscleState(const SimTK::State& s,
     //Initialize the loop
     int iter = 0;
 
+    // Start from the provided fiber length, if any
+    if (!SimTK::isNaN(aFiberLengthGuess)) {
+        lce = max(aFiberLengthGuess, getMinimumFiberLength());
+    }
+
     // Estimate the position level quantities (lengths, angles) of the muscle
     positionFunc();
 
@@ -949,6 +989,7 @@ Thelen2003Muscle::initMuscleState(const SimTK::State& s,
         resultValues["solution_error"] = ferr;
         resultValues["iterations"]     = (double)iter;
         resultValues["fiber_length"]   = lce;
+        resultValues["fiber_velocity"] = dlce;
         resultValues["passive_force"]  = fpe*fiso;
         resultValues["tendon_force"]   = fse*fiso;
 
@@ -971,6 +1012,7 @@ Thelen2003Muscle::initMuscleState(const SimTK::State& s,
         resultValues["solution_error"] = ferr;
         resultValues["iterations"]     = (double)iter;
         resultValues["fiber_length"]   = lce;
+        resultValues["fiber_velocity"] = 0;
         resultValues["passive_force"]  = fpe*fiso;
         resultValues["tendon_force"]   = fse*fiso;
 
@@ -981,6 +1023,7 @@ Thelen2003Muscle::initMuscleState(const SimTK::State& s,
     resultValues["solution_error"] = ferr;
     resultValues["iterations"]     = (double)iter;
     resultValues["fiber_length"]   = SimTK::NaN;
+    resultValues["fiber_velocity"] = SimTK::NaN;
     resultValues["passive_force"]  = SimTK::NaN;
     resultValues["tendon_force"]   = SimTK::NaN;
 
@@ -227,6 +227,15 @@ public:
         @throws MuscleCannotEquilibrate
     */
     void computeInitialFiberEquilibrium(SimTK::State& s) const override;
+
+    /** Same as computeInitialFiberEquilibrium(), but the Newton iteration
+        starts from the fiber length of the previous equilibrium solution
+        stored in the state, if any, and falls back to the cold start if
+        it does not converge.
+
+        @throws MuscleCannotEquilibrate
+    */
+    void computeWarmStartedFiberEquilibrium(SimTK::State& s) const override;
        
     ///@cond DEPRECATED
     /*  Once the ignore_tendon_compliance flag is implemented correctly get rid 
@@ -309,8 +318,8 @@ private:
     };
 
     // Associative array of values returned by initMuscleState():
-    // solution_error, iterations, fiber_length, passive_force, and
-    // tendon_force.
+    // solution_error, iterations, fiber_length, fiber_velocity, passive_force,
+    // and tendon_force.
     typedef std::map<std::string, double> ValuesFromInitMuscleState;
 
     /* Calculate the muscle state such that the fiber and tendon are developing
@@ -322,12 +331,20 @@ private:
            solution
     @param aMaxIterations the maximum number of Newton steps allowed before we
            give up attempting to initialize the model
+    @param aFiberLengthGuess initial guess for the fiber length; if NaN, the
+           iteration starts from a fiber length for which the tendon is
+           slightly stretched
     */
     std::pair<StatusFromInitMuscleState, ValuesFromInitMuscleState>
         initMuscleState(const SimTK::State& s,
                         const double aActivation,
                         const double aSolTolerance,
-                        const int aMaxIterations) const;
+                        const int aMaxIterations,
+                        const double aFiberLengthGuess = SimTK::NaN) const;
+
+    // Implements computeInitialFiberEquilibrium() and
+    // computeWarmStartedFiberEquilibrium().
+    void solveFiberEquilibrium(SimTK::State& s, bool warmStart) const;
 
     double calcFm(double ma, double fal, double fv, 
                  double fpe, double fiso) const;
@@ -28,6 +28,7 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/Actuator.h>
 #include "JointReaction.h"
+#include <algorithm>
 
 using namespace OpenSim;
 using namespace std;
@@ -143,6 +144,15 @@ operator=(const JointReaction &aJointReaction)
     _inFrame = aJointReaction._inFrame;
     _useForceStorage = aJointReaction._useForceStorage;
     _storeActuation = NULL;
+    _overriddenActuators.clear();
+    _actuatorColumns.clear();
+    _hasWorkingState = false;
+    _discreteVariables.clear();
+    _numThreads = aJointReaction._numThreads;
+    _queuedTimes.clear();
+    _queuedY.clear();
+    _queuedDiscreteValues.clear();
+    _queuedForces.clear();
     return(*this);
 }
 
@@ -168,6 +178,8 @@ setNull()
     _inFrame[0] = "ground";
 
     _storeActuation = NULL;
+    _hasWorkingState = false;
+    _numThreads = 1;
 
 }
 //_____________________________________________________________________________
@@ -438,6 +450,19 @@ void JointReaction::loadForcesFromFile()
         if(_containsAllActuators) {
             if(storeSize> actuatorSetSize) cout << "\nWARNING:  The forces file contains actuators that are not in the model's actuator set." << endl;
             _useForceStorage = true;
+            // Find the column of each actuator once, rather than at each frame.
+            _overriddenActuators.clear();
+            _actuatorColumns.clear();
+            for (int i = 0; i < actuatorSetSize; ++i) {
+                const auto* act = dynamic_cast<const ScalarActuator*>(
+                        &_model->getActuators().get(i));
+                if (act) {
+                    _overriddenActuators.push_back(act);
+                    _actuatorColumns.push_back(
+                            _storeActuation->getStateIndex(act->getName(), 0));
+                }
+            }
+            _storedForces.setSize(storeSize);
             cout << "WARNING:  Ignoring fiber lengths and activations from the states since " << _forcesFileNameProp.getName() << " is also set." << endl;
             cout << "Actuator forces will be constructed from " << _forcesFileName << "." << endl;
         }
@@ -497,6 +522,7 @@ setModel(Model& aModel)
     Analysis::setModel(aModel);
 
     // UPDATE VARIABLES IN THIS CLASS
+    _hasWorkingState = false;
     setupReactionList();
     constructDescription();
     constructColumnLabels();
@@ -527,94 +553,256 @@ setModel(Model& aModel)
 int JointReaction::
 record(const SimTK::State& s)
 {
+    if(!_hasWorkingState) setupWorkingState(s);
+
     /** if a forces file is specified replace the computed actuation with the 
         forces from storage.*/
-    SimTK::State s_analysis = s;
-
-    _model->updMultibodySystem().realize(s_analysis, s.getSystemStage());
-    if(_useForceStorage){
-        const auto& actuatorSet = _model->getActuators();
-        int nA = actuatorSet.getSize();
-        Array<double> forces(0,nA);
-        _storeActuation->getDataAtTime(s.getTime(),nA,forces);
-        int storageIndex = -1;
-        for(int actuatorIndex=0;actuatorIndex<nA;actuatorIndex++)
-        {
-            //Actuator* act = dynamic_cast<Actuator*>(&_forceSet->get(actuatorIndex));
-            std::string actuatorName = actuatorSet.get(actuatorIndex).getName();
-            storageIndex = _storeActuation->getStateIndex(actuatorName, 0);
-            if(storageIndex == -1){
-                cout << "The actuator, " << actuatorName << ", was not found in the forces file." << endl;
-                break;
-            }
-            const ScalarActuator* act = dynamic_cast<const ScalarActuator*>(&actuatorSet[actuatorIndex]);
-            if (act){
-                act->overrideActuation(s_analysis, true);
-                act->setOverrideActuation(s_analysis, forces[storageIndex]);
-            }
+    const int numOverridden = int(_overriddenActuators.size());
+    if(_useForceStorage) {
+        _storeActuation->getDataAtTime(s.getTime(), _storedForces.getSize(),
+                                       _storedForces);
+    }
+
+    // Queue the frame to be recorded in parallel.
+    if(_numThreads != 1) {
+        _queuedTimes.push_back(s.getTime());
+        _queuedY.push_back(s.getY());
+        for(const auto& dv : _discreteVariables)
+            _queuedDiscreteValues.push_back(
+                    dv.first->getDiscreteVariableValue(s, dv.second));
+        if(_useForceStorage) {
+            for(int i=0; i<numOverridden; ++i)
+                _queuedForces.push_back(_storedForces[_actuatorColumns[i]]);
         }
+        return 0;
+    }
+
+    _workingState.updTime() = s.getTime();
+    _workingState.updY() = s.getY();
+    for(const auto& dv : _discreteVariables)
+        dv.first->setDiscreteVariableValue(_workingState, dv.second,
+                dv.first->getDiscreteVariableValue(s, dv.second));
+    if(_useForceStorage) {
+        for(int i=0; i<numOverridden; ++i)
+            _overriddenActuators[i]->setOverrideActuation(_workingState,
+                    _storedForces[_actuatorColumns[i]]);
+    }
+    computeReactionLoads(_workingState, nullptr, _allReactions, &_Loads[0]);
+
+    /* Write the reaction data to storage*/
+    _storeReactionLoads.append(s.getTime(),_Loads.getSize(),&_Loads[0]);
+
+    return 0;
+}
+
+//_____________________________________________________________________________
+/**
+ * Copy the state into the working state and, if a forces file is specified,
+ * override the actuation of the actuators in the forces file.
+ */
+void JointReaction::
+setupWorkingState(const SimTK::State& s)
+{
+    _workingState = s;
+    if(_useForceStorage) {
+        for(const ScalarActuator* act : _overriddenActuators)
+            act->overrideActuation(_workingState, true);
+    }
+
+    // The discrete variables (e.g., the override values of actuators, or
+    // those of controllers and muscles) may change between recorded states.
+    // Model::getComponentList() does not include the model itself.
+    _discreteVariables.clear();
+    std::vector<const Component*> components{_model};
+    for(const Component& comp : _model->getComponentList<Component>())
+        components.push_back(&comp);
+    for(const Component* comp : components) {
+        const Array<std::string> names =
+                comp->getDiscreteVariableNamesAddedByComponent();
+        for(int i=0; i<names.getSize(); ++i)
+            _discreteVariables.push_back(std::make_pair(comp, names[i]));
+    }
+    _hasWorkingState = true;
+}
+
+//_____________________________________________________________________________
+/**
+ * Write the time, state values and discrete variable values of a recorded
+ * frame into a copy of the working state.
+ */
+void JointReaction::
+setFrame(SimTK::State& s, double time, const SimTK::Vector& y,
+        const double* discreteValues) const
+{
+    s.updTime() = time;
+    s.updY() = y;
+    for(size_t i=0; i<_discreteVariables.size(); ++i)
+        _discreteVariables[i].first->setDiscreteVariableValue(s,
+                _discreteVariables[i].second, discreteValues[i]);
+}
+
+//_____________________________________________________________________________
+/**
+ * Compute the requested reaction loads, acting on the requested bodies and
+ * expressed in the requested frames, at a state whose time and state values
+ * have been set.
+ *
+ * The reaction loads of all mobilizers are computed with a single call to
+ * SimbodyMatterSubsystem::calcMobilizerReactionForces(); each call to
+ * Joint::calcReactionOnChildExpressedInGround() or
+ * Joint::calcReactionOnParentExpressedInGround() would compute them all for
+ * a single joint.
+ */
+void JointReaction::
+computeReactionLoads(SimTK::State& s, const double* overrideForces,
+        Vector_<SpatialVec>& allReactions, double* rLoads) const
+{
+    if(overrideForces) {
+        for(size_t i=0; i<_overriddenActuators.size(); ++i)
+            _overriddenActuators[i]->setOverrideActuation(s, overrideForces[i]);
     }
+
     // VARIABLES
     const Ground& ground = _model->getGround();
 
-    _model->realizeAcceleration(s_analysis);
+    _model->getMultibodySystem().realize(s, SimTK::Stage::Acceleration);
+    _model->getMatterSubsystem().calcMobilizerReactionForces(s, allReactions);
 
     /* retrieved desired joint reactions, convert to desired bodies, and convert
     *  to desired reference frames*/
     int numOutputJoints = _reactionList.getSize();
-    Vector_<Vec3> forcesVec(numOutputJoints), momentsVec(numOutputJoints), pointsVec(numOutputJoints);
     for(int i=0; i<numOutputJoints; i++) {
-        JointReactionKey currentKey = _reactionList[i];
+        const JointReactionKey& currentKey = _reactionList[i];
         const Joint& joint = *currentKey.joint;
         const Frame& expressedInBody = *currentKey.expressedInFrame;
-        SpatialVec jointReaction;
+        const MobilizedBody& mobod = joint.getChildFrame().getMobilizedBody();
+        // Reaction on the child at the mobilizer's M frame, in ground.
+        SpatialVec jointReaction = allReactions[mobod.getMobilizedBodyIndex()];
         Vec3 pointOfApplication;
         
         // check if the load requested is on the parent or child
         if(!currentKey.isAppliedOnChild){
-            jointReaction = joint.calcReactionOnParentExpressedInGround(s_analysis);
+            // The reaction on the parent is equal and opposite, and acts at
+            // the mobilizer's F frame (as computed by
+            // MobilizedBody::findMobilizerReactionOnParentAtFInGround()).
+            const Vec3 p_GF = mobod.getParentMobilizedBody()
+                    .getBodyTransform(s) * mobod.getInboardFrame(s).p();
+            const Vec3 p_GM =
+                    mobod.getBodyTransform(s) * mobod.getOutboardFrame(s).p();
+            jointReaction = -shiftForceFromTo(jointReaction, p_GM, p_GF);
 
             // find the point of application in immediate parent frame, then
             // transform to the base frame of the parent (expressedInBody)
-            Vec3 parentLocationInGlobal = joint.getParentFrame().getTransformInGround(s_analysis).p();
+            Vec3 parentLocationInGlobal = joint.getParentFrame().getTransformInGround(s).p();
             pointOfApplication = 
-                ground.findStationLocationInAnotherFrame(s_analysis, parentLocationInGlobal, expressedInBody);
+                ground.findStationLocationInAnotherFrame(s, parentLocationInGlobal, expressedInBody);
         }
         else{
-            jointReaction = joint.calcReactionOnChildExpressedInGround(s_analysis);
-
             // find the point of application in immediate child frame, then
             // transform to the base frame of the child (expressedInBody)
-            Vec3 childLocationInGlobal = joint.getChildFrame().getTransformInGround(s_analysis).p();
+            Vec3 childLocationInGlobal = joint.getChildFrame().getTransformInGround(s).p();
             pointOfApplication =
-                ground.findStationLocationInAnotherFrame(s_analysis, childLocationInGlobal, expressedInBody);
+                ground.findStationLocationInAnotherFrame(s, childLocationInGlobal, expressedInBody);
         }
 
         // transform SpatialVec of reaction forces and moments to the
         // requested base frame (expressedInBody)
-        Vec3 force = ground.expressVectorInAnotherFrame(s_analysis, jointReaction[1], expressedInBody);
-        Vec3 moment = ground.expressVectorInAnotherFrame(s_analysis, jointReaction[0], expressedInBody);
-
-        /* place results in the truncated loads vectors*/
-        forcesVec[i] = force;
-        momentsVec[i] = moment;
-        pointsVec[i] = pointOfApplication;
-    }
+        Vec3 force = ground.expressVectorInAnotherFrame(s, jointReaction[1], expressedInBody);
+        Vec3 moment = ground.expressVectorInAnotherFrame(s, jointReaction[0], expressedInBody);
 
-    /* fill out row construction array*/
-    for(int i=0;i<numOutputJoints;i++) {
+        /* fill out row construction array*/
         int I = 9*i;
         for(int j=0;j<3;j++) {
-            _Loads[I+j] = forcesVec[i][j];
-            _Loads[I+j+3] = momentsVec[i][j];
-            _Loads[I+j+6] = pointsVec[i][j];
+            rLoads[I+j] = force[j];
+            rLoads[I+j+3] = moment[j];
+            rLoads[I+j+6] = pointOfApplication[j];
         }
     }
-    /* Write the reaction data to storage*/
-    _storeReactionLoads.append(s.getTime(),_Loads.getSize(),&_Loads[0]);
+}
 
-    return 0;
+namespace OpenSim {
+/** Computes the reaction loads of a contiguous block of queued frames per
+    task index, each block on a private copy of the working state. */
+class JointReaction::ReactionLoadsTask : public ParallelExecutor::Task {
+public:
+    ReactionLoadsTask(const JointReaction& analysis, std::vector<double>& loads,
+            int firstFrame, int numBlocks) :
+        _analysis(analysis), _loads(loads), _firstFrame(firstFrame),
+        _numBlocks(numBlocks) {}
+
+    void execute(int block) override {
+        const long long n =
+                (long long)_analysis._queuedTimes.size() - _firstFrame;
+        const int begin = _firstFrame + (int)((n * block) / _numBlocks);
+        const int end = _firstFrame + (int)((n * (block + 1)) / _numBlocks);
+        if (begin >= end) return;
+
+        const size_t numLoads = _analysis._Loads.getSize();
+        const size_t numOverridden = _analysis._overriddenActuators.size();
+        const size_t numDiscrete = _analysis._discreteVariables.size();
+        State s(_analysis._workingState);
+        Vector_<SpatialVec> allReactions;
+        for (int i = begin; i < end; ++i) {
+            _analysis.setFrame(s, _analysis._queuedTimes[i],
+                    _analysis._queuedY[i],
+                    _analysis._queuedDiscreteValues.data() + i*numDiscrete);
+            _analysis.computeReactionLoads(s, _analysis._useForceStorage ?
+                    _analysis._queuedForces.data() + i*numOverridden : nullptr,
+                    allReactions, &_loads[i*numLoads]);
+        }
+    }
+
+private:
+    const JointReaction& _analysis;
+    std::vector<double>& _loads;
+    const int _firstFrame;
+    const int _numBlocks;
+};
 }
+
+//_____________________________________________________________________________
+/**
+ * Compute the reaction loads of the queued frames in parallel, and record
+ * them in the order in which the frames were queued.
+ */
+void JointReaction::
+recordQueuedFrames()
+{
+    const int numFrames = int(_queuedTimes.size());
+    if(numFrames == 0) return;
+
+    // Compute the first frame on this thread so that lazily constructed
+    // internals of the model exist before the workers use them concurrently.
+    const size_t numLoads = _Loads.getSize();
+    std::vector<double> loads(numFrames*numLoads);
+    setFrame(_workingState, _queuedTimes[0], _queuedY[0],
+             _queuedDiscreteValues.data());
+    computeReactionLoads(_workingState,
+            _useForceStorage ? _queuedForces.data() : nullptr,
+            _allReactions, loads.data());
+
+    if(numFrames > 1) {
+        int numThreads = _numThreads;
+        if(numThreads < 1)
+            numThreads = ParallelExecutor::getNumProcessors();
+        numThreads = std::max(1, std::min(numThreads, numFrames - 1));
+
+        ReactionLoadsTask task(*this, loads, 1, numThreads);
+        ParallelExecutor executor(numThreads);
+        executor.execute(task, numThreads);
+    }
+
+    /* Write the reaction data to storage, in order*/
+    for(int i=0; i<numFrames; ++i)
+        _storeReactionLoads.append(_queuedTimes[i], int(numLoads),
+                                   &loads[i*numLoads]);
+
+    _queuedTimes.clear();
+    _queuedY.clear();
+    _queuedDiscreteValues.clear();
+    _queuedForces.clear();
+}
+
 //_____________________________________________________________________________
 /**
  * This method is called at the beginning of an analysis so that any
@@ -632,6 +820,11 @@ begin(const SimTK::State& s)
     if(!proceed()) return(0);
     // Read forces file here rather than during initialization
     setupStorage();
+    setupWorkingState(s);
+    _queuedTimes.clear();
+    _queuedY.clear();
+    _queuedDiscreteValues.clear();
+    _queuedForces.clear();
 
     // RESET STORAGE
     _storeReactionLoads.reset(s.getTime());
@@ -679,6 +872,7 @@ end(const SimTK::State&s)
     if(!proceed()) return(0);
 
     record(s);
+    recordQueuedFrames();
 
     return(0);
 }
@@ -31,6 +31,8 @@
 #include <OpenSim/Common/PropertyStrArray.h>
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include "osimAnalysesDLL.h"
+#include <utility>
+#include <vector>
 
 
 //=============================================================================
@@ -39,6 +41,7 @@ namespace OpenSim {
 
 class Model;
 class Joint;
+class ScalarActuator;
 
 
 /**
@@ -52,6 +55,11 @@ class Joint;
  * any specified frame. The default behavior is the force on the child 
  * expressed in the ground frame.
  *
+ * The loads are computed on a working state, copied from the state passed to
+ * begin(), into which the time and state values (SimTK::State::getY()) of
+ * each recorded state are written. Other variables, such as whether a
+ * coordinate is locked, are those of the state passed to begin().
+ *
  * @author Matt DeMers, Ajay Seth
  * @version 1.0
  */
@@ -137,6 +145,38 @@ protected:
 
     bool _useForceStorage;
 
+    /** The actuators whose actuation is overridden by the forces file, and
+    *   the index of each one's column in _storeActuation. */
+    std::vector<const ScalarActuator*> _overriddenActuators;
+    std::vector<int> _actuatorColumns;
+
+    /** Internal work array for holding a row of the forces file. */
+    Array<double> _storedForces;
+
+    /** Working state, copied from the state passed to begin(), into which the
+    *   time, state values and discrete variables of each recorded state are
+    *   written. */
+    SimTK::State _workingState;
+    bool _hasWorkingState;
+
+    /** The discrete variables of the model's components, as (component, name)
+    *   pairs, which are copied from each recorded state. */
+    std::vector<std::pair<const Component*, std::string>> _discreteVariables;
+
+    /** Internal work array for holding the reaction loads of all
+    *   mobilizers. */
+    SimTK::Vector_<SimTK::SpatialVec> _allReactions;
+
+    /** Number of threads across which recorded frames are distributed. */
+    int _numThreads;
+
+    /** Times, state values, discrete variable values and overriding actuator
+    *   forces of the frames queued for recording in parallel. */
+    std::vector<double> _queuedTimes;
+    std::vector<SimTK::Vector> _queuedY;
+    std::vector<double> _queuedDiscreteValues;
+    std::vector<double> _queuedForces;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -180,6 +220,25 @@ public:
      /** Public accessors for the inFrame property */
     const Array<std::string>& getInFrame() const { return _inFrame; }
     void setInFrame( Array<std::string>& inFrame) { _inFrame = inFrame; }
+    /** The recorded reaction loads. */
+    const Storage& getReactionLoadsStorage() const
+    {   return _storeReactionLoads; }
+
+    /** Set the number of threads across which the frames passed to begin(),
+    step() and end() are distributed. With the default of 1, the reaction
+    loads are computed as each frame is passed in. Otherwise, each frame's
+    time, state values, discrete variables and (if a forces file is used)
+    actuator forces are queued, and the reaction loads of the queued frames are computed in
+    parallel by end() or recordQueuedFrames(); values less than 1 use all
+    available processors. AnalyzeTool uses this for its num_threads
+    property. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+
+    /** Compute and record the reaction loads of the queued frames, in the
+    order in which they were queued. Does nothing if no frames are queued.
+    @see setNumThreads() */
+    void recordQueuedFrames();
 
     //-------------------------------------------------------------------------
     // INTEGRATION
@@ -209,6 +268,21 @@ protected:
     void setupStorage();
     void loadForcesFromFile();
 
+private:
+    class ReactionLoadsTask;
+
+    // Set up the actuation overrides of the working state.
+    void setupWorkingState(const SimTK::State& s);
+    // Write a frame's time, state values and discrete variable values (in
+    // the order of _discreteVariables) into s.
+    void setFrame(SimTK::State& s, double time, const SimTK::Vector& y,
+            const double* discreteValues) const;
+    // Realize s to Acceleration with the given overriding actuator forces
+    // (if any) and compute the requested reaction loads into rLoads.
+    void computeReactionLoads(SimTK::State& s, const double* overrideForces,
+            SimTK::Vector_<SimTK::SpatialVec>& allReactions,
+            double* rLoads) const;
+
 //=============================================================================
 }; // END of class JointReaction
 }; //namespace
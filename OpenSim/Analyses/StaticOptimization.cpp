@@ -26,12 +26,14 @@
 // INCLUDES
 //=============================================================================
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/LogManager.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Actuators/CoordinateActuator.h>
 #include <OpenSim/Simulation/Control/ControlSet.h>
 #include "StaticOptimization.h"
 #include "StaticOptimizationTarget.h"
 #include <OpenSim/Simulation/Model/ActivationFiberLengthMuscle.h>
+#include <algorithm>
 
 
 using namespace OpenSim;
@@ -116,6 +118,10 @@ operator=(const StaticOptimization &aStaticOptimization)
     _maximumIterations=aStaticOptimization._maximumIterations;
     _forceReporter = nullptr;
     _useMusclePhysiology=aStaticOptimization._useMusclePhysiology;
+    _numThreads = aStaticOptimization._numThreads;
+    _queuedTimes.clear();
+    _queuedQ.clear();
+    _queuedU.clear();
     return(*this);
 }
 
@@ -139,6 +145,7 @@ void StaticOptimization::setNull()
     _convergenceCriterion = 1e-4;
     _maximumIterations = 100;
     _forceReporter = nullptr;
+    _numThreads = 1;
     setName("StaticOptimization");
 }
 //_____________________________________________________________________________
@@ -306,33 +313,55 @@ record(const SimTK::State& s)
 {
     if(!_modelWorkingCopy) return -1;
 
+    // IPOPT
+    _numericalDerivativeStepSize = 0.0001;
+    _optimizerAlgorithm = "ipopt";
+    _printLevel = 0;
+    //_optimizationConvergenceTolerance = 1e-004;
+    //_maxIterations = 2000;
+
+    // Queue the frame to be solved in parallel.
+    if(_numThreads != 1) {
+        _queuedTimes.push_back(s.getTime());
+        _queuedQ.push_back(s.getQ());
+        _queuedU.push_back(s.getU());
+        return 0;
+    }
+
+    solveFrame(*_modelWorkingCopy, s.getTime(), s.getQ(), s.getU(), false,
+               _parameters, *_forceReporter, *_activationStorage);
+
+    return 0;
+}
+//_____________________________________________________________________________
+/**
+ * Solve the static optimization problem of one frame and record the results.
+ */
+void StaticOptimization::
+solveFrame(Model& model, double time, const SimTK::Vector& q,
+           const SimTK::Vector& u, bool warmStart, SimTK::Vector& parameters,
+           ForceReporter& forceReporter, Storage& activationStorage) const
+{
     // Set model to whatever defaults have been updated to from the last iteration
-    SimTK::State& sWorkingCopy = _modelWorkingCopy->updWorkingState();
-    sWorkingCopy.setTime(s.getTime());
-    _modelWorkingCopy->initStateWithoutRecreatingSystem(sWorkingCopy); 
+    SimTK::State& sWorkingCopy = model.updWorkingState();
+    sWorkingCopy.setTime(time);
+    model.initStateWithoutRecreatingSystem(sWorkingCopy); 
 
     // update Q's and U's
-    sWorkingCopy.setQ(s.getQ());
-    sWorkingCopy.setU(s.getU());
+    sWorkingCopy.setQ(q);
+    sWorkingCopy.setU(u);
 
-    _modelWorkingCopy->getMultibodySystem().realize(sWorkingCopy, SimTK::Stage::Velocity);
-    //_modelWorkingCopy->equilibrateMuscles(sWorkingCopy);
+    model.getMultibodySystem().realize(sWorkingCopy, SimTK::Stage::Velocity);
+    //model.equilibrateMuscles(sWorkingCopy);
 
-    const Set<Actuator>& fs = _modelWorkingCopy->getActuators();
+    const Set<Actuator>& fs = model.getActuators();
 
     int na = fs.getSize();
     int nacc = _accelerationIndices.getSize();
 
-    // IPOPT
-    _numericalDerivativeStepSize = 0.0001;
-    _optimizerAlgorithm = "ipopt";
-    _printLevel = 0;
-    //_optimizationConvergenceTolerance = 1e-004;
-    //_maxIterations = 2000;
-
     // Optimization target
-    _modelWorkingCopy->setAllControllersEnabled(false);
-    StaticOptimizationTarget target(sWorkingCopy,_modelWorkingCopy,na,nacc,_useMusclePhysiology);
+    model.setAllControllersEnabled(false);
+    StaticOptimizationTarget target(sWorkingCopy,&model,na,nacc,_useMusclePhysiology);
     target.setStatesStore(_statesStore);
     target.setStatesSplineSet(_statesSplineSet);
     target.setActivationExponent(_activationExponent);
@@ -375,11 +404,13 @@ record(const SimTK::State& s)
     
     target.setParameterLimits(lowerBounds, upperBounds);
 
-    _parameters = 0; // Set initial guess to zeros
+    // Set initial guess to zeros, unless starting from the solution of the
+    // previous frame
+    if(!warmStart) parameters = 0;
 
     // Static optimization
-    _modelWorkingCopy->getMultibodySystem().realize(sWorkingCopy,SimTK::Stage::Velocity);
-    target.prepareToOptimize(sWorkingCopy, &_parameters[0]);
+    model.getMultibodySystem().realize(sWorkingCopy,SimTK::Stage::Velocity);
+    target.prepareToOptimize(sWorkingCopy, &parameters[0]);
 
     //LARGE_INTEGER start;
     //LARGE_INTEGER stop;
@@ -390,24 +421,25 @@ record(const SimTK::State& s)
 
     try {
         target.setCurrentState( &sWorkingCopy );
-        optimizer->optimize(_parameters);
+        optimizer->optimize(parameters);
     }
     catch (const SimTK::Exception::Base& ex) {
         cout << ex.getMessage() << endl;
         cout << "OPTIMIZATION FAILED..." << endl;
         cout << endl;
-        cout << "StaticOptimization.record:  WARN- The optimizer could not find a solution at time = " << s.getTime() << endl;
+        cout << "StaticOptimization.record:  WARN- The optimizer could not find a solution at time = " << time << endl;
         cout << endl;
 
         double tolBounds = 1e-1;
         bool weakModel = false;
         string msgWeak = "The model appears too weak for static optimization.\nTry increasing the strength and/or range of the following force(s):\n";
+        const ForceSet& forceSet = model.getForceSet();
         for(int a=0;a<na;a++) {
-            Actuator* act = dynamic_cast<Actuator*>(&_forceSet->get(a));
+            const Actuator* act = dynamic_cast<const Actuator*>(&forceSet.get(a));
             if( act ) {
-                Muscle*  mus = dynamic_cast<Muscle*>(&_forceSet->get(a));
+                const Muscle*  mus = dynamic_cast<const Muscle*>(&forceSet.get(a));
                 if(mus==NULL) {
-                    if(_parameters(a) < (lowerBounds(a)+tolBounds)) {
+                    if(parameters(a) < (lowerBounds(a)+tolBounds)) {
                         msgWeak += "   ";
                         msgWeak += act->getName();
                         msgWeak += " approaching lower bound of ";
@@ -416,7 +448,7 @@ record(const SimTK::State& s)
                         msgWeak += oLower.str();
                         msgWeak += "\n";
                         weakModel = true;
-                    } else if(_parameters(a) > (upperBounds(a)-tolBounds)) {
+                    } else if(parameters(a) > (upperBounds(a)-tolBounds)) {
                         msgWeak += "   ";
                         msgWeak += act->getName();
                         msgWeak += " approaching upper bound of ";
@@ -427,7 +459,7 @@ record(const SimTK::State& s)
                         weakModel = true;
                     } 
                 } else {
-                    if(_parameters(a) > (upperBounds(a)-tolBounds)) {
+                    if(parameters(a) > (upperBounds(a)-tolBounds)) {
                         msgWeak += "   ";
                         msgWeak += mus->getName();
                         msgWeak += " approaching upper bound of ";
@@ -447,9 +479,9 @@ record(const SimTK::State& s)
             bool incompleteModel = false;
             string msgIncomplete = "The model appears unsuitable for static optimization.\nTry appending the model with additional force(s) or locking joint(s) to reduce the following acceleration constraint violation(s):\n";
             SimTK::Vector constraints;
-            target.constraintFunc(_parameters,true,constraints);
+            target.constraintFunc(parameters,true,constraints);
 
-            auto coordinates = _modelWorkingCopy->getCoordinatesInMultibodyTreeOrder();
+            auto coordinates = model.getCoordinatesInMultibodyTreeOrder();
 
             for(int acc=0;acc<nacc;acc++) {
                 if(fabs(constraints(acc)) > tolConstraints) {
@@ -464,7 +496,7 @@ record(const SimTK::State& s)
                     incompleteModel = true;
                 }
             }
-            _forceReporter->step(sWorkingCopy, 1);
+            forceReporter.step(sWorkingCopy, 1);
             if(incompleteModel) cout << msgIncomplete << endl;
         }
     }
@@ -473,27 +505,174 @@ record(const SimTK::State& s)
     //double duration = (double)(stop.QuadPart-start.QuadPart)/(double)frequency.QuadPart;
     //cout << "optimizer time = " << (duration*1.0e3) << " milliseconds" << endl;
 
-    target.printPerformance(sWorkingCopy, &_parameters[0]);
+    target.printPerformance(sWorkingCopy, &parameters[0]);
 
     //update defaults for use in the next step
 
-    const Set<Actuator>& actuators = _modelWorkingCopy->getActuators();
+    const Set<Actuator>& actuators = model.getActuators();
     for(int k=0; k < actuators.getSize(); ++k){
         ActivationFiberLengthMuscle *mus = dynamic_cast<ActivationFiberLengthMuscle*>(&actuators[k]);
         if(mus){
-            mus->setDefaultActivation(_parameters[k]);
+            mus->setDefaultActivation(parameters[k]);
         }
     }
 
-    _activationStorage->append(sWorkingCopy.getTime(),na,&_parameters[0]);
+    activationStorage.append(sWorkingCopy.getTime(),na,&parameters[0]);
 
     SimTK::Vector forces(na);
-    target.getActuation(const_cast<SimTK::State&>(sWorkingCopy), _parameters,forces);
+    target.getActuation(const_cast<SimTK::State&>(sWorkingCopy), parameters,forces);
 
-    _forceReporter->step(sWorkingCopy, 1);
+    forceReporter.step(sWorkingCopy, 1);
+}
 
-    return 0;
+namespace OpenSim {
+/** Solves a contiguous block of queued frames per task index, each block in
+    time order with its own copy of the working model. The output of each
+    block and the message of any exception are kept with the block, to be
+    logged (or rethrown) on the calling thread. */
+class StaticOptimization::SolveFramesTask : public SimTK::ParallelExecutor::Task {
+public:
+    /** The copy of the working model with which a block is solved, and the
+        results of the block. */
+    struct Block {
+        std::unique_ptr<Model> model;
+        std::unique_ptr<ForceReporter> forceReporter;
+        std::unique_ptr<Storage> activationStorage;
+        SimTK::Vector parameters;
+        int begin;
+        int end;
+        std::string out;
+        std::string err;
+        std::string error;
+    };
+
+    SolveFramesTask(const StaticOptimization& analysis,
+            std::vector<Block>& blocks) :
+        _analysis(analysis), _blocks(blocks) {}
+
+    void execute(int index) override {
+        Block& block = _blocks[index];
+        LogCapture capture(block.out, block.err);
+        try {
+            // The first frame of a block starts from zero, as in the serial
+            // mode; each later frame starts from the previous frame.
+            for (int i = block.begin; i < block.end; ++i) {
+                _analysis.solveFrame(*block.model, _analysis._queuedTimes[i],
+                        _analysis._queuedQ[i], _analysis._queuedU[i],
+                        i != block.begin, block.parameters,
+                        *block.forceReporter, *block.activationStorage);
+            }
+        } catch (const std::exception& e) {
+            block.error = e.what();
+        }
+    }
+
+private:
+    const StaticOptimization& _analysis;
+    std::vector<Block>& _blocks;
+};
+}
+
+//_____________________________________________________________________________
+/**
+ * Solve the queued frames in parallel, and record the results in the order
+ * in which the frames were queued.
+ */
+void StaticOptimization::
+recordQueuedFrames()
+{
+    const int numFrames = int(_queuedTimes.size());
+    if(numFrames == 0) return;
+
+    // Solve the first frame on this thread, from an initial guess of zero.
+    // Its activations are the initial guess and default activations of the
+    // copies of the working model made below.
+    solveFrame(*_modelWorkingCopy, _queuedTimes[0], _queuedQ[0], _queuedU[0],
+               false, _parameters, *_forceReporter, *_activationStorage);
+
+    if(numFrames > 1) {
+        int numThreads = _numThreads;
+        if(numThreads < 1)
+            numThreads = SimTK::ParallelExecutor::getNumProcessors();
+        numThreads = std::max(1, std::min(numThreads, numFrames - 1));
+
+        // Copy the working model for each block on this thread; the model is
+        // not safe to copy and initialize concurrently.
+        std::vector<SolveFramesTask::Block> blocks(numThreads);
+        const long long n = numFrames - 1;
+        for(int b=0; b<numThreads; ++b) {
+            SolveFramesTask::Block& block = blocks[b];
+            block.begin = 1 + (int)((n * b) / numThreads);
+            block.end = 1 + (int)((n * (b + 1)) / numThreads);
+
+            block.model.reset(_modelWorkingCopy->clone());
+            SimTK::State& sBlock = block.model->initSystem();
+            const ForceSet& forceSet = block.model->getForceSet();
+            for(int i=0; i<forceSet.getSize(); i++) {
+                const ScalarActuator* act =
+                    dynamic_cast<const ScalarActuator*>(&forceSet.get(i));
+                if( act ) {
+                    act->overrideActuation(sBlock, true);
+                }
+            }
+
+            block.forceReporter.reset(new ForceReporter(block.model.get()));
+            block.forceReporter->begin(sBlock);
+            block.forceReporter->updForceStorage().reset();
+            block.activationStorage.reset(
+                    new Storage(1000, "Static Optimization"));
+            block.parameters = _parameters;
+        }
+
+        SolveFramesTask task(*this, blocks);
+        SimTK::ParallelExecutor executor(numThreads);
+        executor.execute(task, numThreads);
+
+        // Log the output of the blocks in the order of the frames, and
+        // report the first failure.
+        std::string error;
+        for(const SolveFramesTask::Block& block : blocks) {
+            LogCapture::write(block.out, block.err);
+            if(error.empty() && !block.error.empty())
+                error = "StaticOptimization: Failed to solve the frames "
+                        "from time " +
+                        std::to_string(_queuedTimes[block.begin]) + ": " +
+                        block.error;
+        }
+        if(!error.empty()) {
+            _queuedTimes.clear();
+            _queuedQ.clear();
+            _queuedU.clear();
+            OPENSIM_THROW(Exception, error);
+        }
+
+        // Record the results of the blocks, in order.
+        for(const SolveFramesTask::Block& block : blocks) {
+            const Storage& activations = *block.activationStorage;
+            for(int i=0; i<activations.getSize(); ++i)
+                _activationStorage->append(*activations.getStateVector(i));
+            const Storage& forces = block.forceReporter->getForceStorage();
+            for(int i=0; i<forces.getSize(); ++i)
+                _forceReporter->updForceStorage().append(
+                        *forces.getStateVector(i));
+        }
+
+        // Continue from the last frame, as the serial mode would.
+        _parameters = blocks.back().parameters;
+        const Set<Actuator>& actuators = _modelWorkingCopy->getActuators();
+        for(int k=0; k < actuators.getSize(); ++k){
+            ActivationFiberLengthMuscle *mus = dynamic_cast<ActivationFiberLengthMuscle*>(&actuators[k]);
+            if(mus){
+                mus->setDefaultActivation(_parameters[k]);
+            }
+        }
+    }
+
+    _queuedTimes.clear();
+    _queuedQ.clear();
+    _queuedU.clear();
 }
+
 //_____________________________________________________________________________
 /**
  * This method is called at the beginning of an analysis so that any
@@ -584,6 +763,10 @@ int StaticOptimization::begin(const SimTK::State& s )
         _parameters = 0;
     }
 
+    _queuedTimes.clear();
+    _queuedQ.clear();
+    _queuedU.clear();
+
     _statesSplineSet=GCVSplineSet(5,_statesStore);
 
     // DESCRIPTION AND LABELS
@@ -655,6 +838,7 @@ int StaticOptimization::end( const SimTK::State& s )
     if(!proceed()) return(0);
 
     record(s);
+    recordQueuedFrames();
 
     return(0);
 }
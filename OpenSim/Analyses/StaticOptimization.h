@@ -29,6 +29,7 @@
 //=============================================================================
 #include "osimAnalysesDLL.h"
 #include <memory>
+#include <vector>
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 #include "ForceReporter.h"
@@ -46,6 +47,9 @@ class ForceSet;
  * This class implements static optimization to compute Muscle Forces and 
  * activations. 
  *
+ * The frames are independent once the kinematics are known, so they can
+ * be solved in parallel; see setNumThreads().
+ *
  * @author Jeff Reinbolt
  */
 class OSIMANALYSES_API StaticOptimization : public Analysis {
@@ -93,6 +97,15 @@ protected:
 
     Model *_modelWorkingCopy;
 
+    /** Number of threads across which recorded frames are distributed. */
+    int _numThreads;
+
+    /** Times, generalized coordinates and speeds of the frames queued for
+    *   solving in parallel. */
+    std::vector<double> _queuedTimes;
+    std::vector<SimTK::Vector> _queuedQ;
+    std::vector<SimTK::Vector> _queuedU;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -135,6 +148,31 @@ public:
     double getConvergenceCriterion() { return _convergenceCriterion; }
     void setMaxIterations( const int maxIt) { _maximumIterations = maxIt; }
     int getMaxIterations() {return _maximumIterations; }
+
+    /** Set the number of threads across which the frames passed to begin(),
+    step() and end() are distributed. With the default of 1, each frame is
+    solved as it is passed in, starting from an initial guess of zero.
+    Otherwise, each frame's time and generalized coordinates and speeds are
+    queued, and the queued frames are solved by end() or
+    recordQueuedFrames(); values less than 1 use all available processors.
+    The first queued frame is solved on the calling thread. The remaining
+    frames are split into contiguous blocks, one per thread, and each block
+    is solved in time order with its own copy of the model. The first frame
+    of each block starts from an initial guess of zero; each later frame
+    starts from the activations of the previous frame (warm start), so the
+    results can differ from those of the serial mode by up to the
+    convergence criterion. The output of the blocks is logged in the order
+    of the frames once all of them have been solved, and an exception thrown
+    while solving a block is rethrown as an OpenSim::Exception on the
+    calling thread. AnalyzeTool uses this for its num_threads property. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+
+    /** Solve and record the queued frames; the activations and forces are
+    recorded in the order in which the frames were queued. Does nothing if
+    no frames are queued.
+    @see setNumThreads() */
+    void recordQueuedFrames();
     //--------------------------------------------------------------------------
     // ANALYSIS
     //--------------------------------------------------------------------------
@@ -155,6 +193,18 @@ public:
         printResults(const std::string &aBaseName,const std::string &aDir="",
         double aDT=-1.0,const std::string &aExtension=".sto") override;
 
+private:
+    class SolveFramesTask;
+
+    // Solve the static optimization problem of one frame with the given
+    // working model, which must have been set up by begin() (or be a copy of
+    // the working model), and record the activations and forces. If
+    // warmStart is false, the optimizer starts from zero; otherwise it starts
+    // from the values in parameters, which hold the solution on return.
+    void solveFrame(Model& model, double time, const SimTK::Vector& q,
+            const SimTK::Vector& u, bool warmStart, SimTK::Vector& parameters,
+            ForceReporter& forceReporter, Storage& activationStorage) const;
+
 //=============================================================================
 };  // END of class StaticOptimization
 
@@ -0,0 +1,282 @@
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  Benchmark.cpp                            *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Benchmark.h"
+#include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/LogManager.h>
+#include <OpenSim/Auxiliary/getRSS.h>
+#include <OpenSim/version.h>
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+using namespace OpenSim;
+
+namespace {
+    // Discards everything written to it.
+    class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override { return traits_type::not_eof(c); }
+        std::streamsize xsputn(const char*, std::streamsize n) override
+        {   return n; }
+    };
+
+    std::string escapeJSON(const std::string& str) {
+        std::string escaped;
+        for (char c : str) {
+            switch (c) {
+            case '"':  escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) escaped += ' ';
+                else escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+    std::string getTimestamp() {
+        std::time_t now = std::time(nullptr);
+        char buffer[32];
+        std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ",
+                      std::gmtime(&now));
+        return buffer;
+    }
+}
+
+void BenchmarkRunner::add(const std::string& name,
+        const std::string& directory,
+        std::function<std::function<void()>()> prepare,
+        double itemsPerIteration) {
+    BenchmarkCase benchmark;
+    benchmark.name = name;
+    benchmark.directory = directory;
+    benchmark.prepare = std::move(prepare);
+    benchmark.itemsPerIteration = itemsPerIteration;
+    _cases.push_back(std::move(benchmark));
+}
+
+void BenchmarkRunner::printUsage(std::ostream& out,
+                                 const std::string& program) {
+    out << "Usage: " << program << " [options]\n"
+        << "Runs the OpenSim performance benchmarks and writes the results "
+           "to a JSON file.\n\n"
+        << "Options:\n"
+        << "  --output <file>         Results file "
+           "[default: benchmark_results.json].\n"
+        << "  --filter <text>         Only run benchmarks whose name "
+           "contains <text>.\n"
+        << "  --data-dir <dir>        Directory containing the benchmark "
+           "data [default: .].\n"
+        << "  --min-time <s>          Minimum time to run each benchmark "
+           "[default: 1].\n"
+        << "  --min-iterations <n>    Minimum number of iterations "
+           "[default: 1].\n"
+        << "  --max-iterations <n>    Maximum number of iterations "
+           "[default: 1000000].\n"
+        << "  --list                  List the benchmarks and exit.\n"
+        << "  --verbose               Show the output of OpenSim while "
+           "benchmarking.\n"
+        << "  --help                  Show this message.\n"
+        << "\nCompare two results files with compareBenchmarks.py."
+        << std::endl;
+}
+
+int BenchmarkRunner::run(int argc, const char* argv[]) {
+    std::string outputFile = "benchmark_results.json";
+    std::string filter;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--help" || arg == "-h") {
+            printUsage(std::cout, argv[0]);
+            return 0;
+        } else if (arg == "--list") {
+            list = true;
+        } else if (arg == "--verbose") {
+            _verbose = true;
+        } else if (arg == "--output" && hasValue) {
+            outputFile = argv[++i];
+        } else if (arg == "--filter" && hasValue) {
+            filter = argv[++i];
+        } else if (arg == "--data-dir" && hasValue) {
+            _dataDirectory = argv[++i];
+        } else if (arg == "--min-time" && hasValue) {
+            _minTime = std::stod(argv[++i]);
+        } else if (arg == "--min-iterations" && hasValue) {
+            _minIterations = std::stoi(argv[++i]);
+        } else if (arg == "--max-iterations" && hasValue) {
+            _maxIterations = std::stoi(argv[++i]);
+        } else {
+            std::cerr << "Unrecognized argument '" << arg << "'." << std::endl;
+            printUsage(std::cerr, argv[0]);
+            return 1;
+        }
+    }
+    _minIterations = std::max(1, _minIterations);
+    _maxIterations = std::max(_minIterations, _maxIterations);
+
+    std::vector<const BenchmarkCase*> selected;
+    for (const auto& benchmark : _cases)
+        if (benchmark.name.find(filter) != std::string::npos)
+            selected.push_back(&benchmark);
+
+    if (list) {
+        for (const auto* benchmark : selected)
+            std::cout << benchmark->name << std::endl;
+        return 0;
+    }
+
+    // Report progress on the console even if the output of OpenSim is
+    // discarded.
+    std::ostream console(LogManager::cout.rdbuf());
+    const std::string startDirectory = IO::getCwd();
+    std::vector<BenchmarkResult> results;
+    int numFailed = 0;
+    for (const auto* benchmark : selected) {
+        console << std::left << std::setw(50) << benchmark->name
+                << std::flush;
+        IO::chDir(_dataDirectory);
+        if (!benchmark->directory.empty()) IO::chDir(benchmark->directory);
+        try {
+            BenchmarkResult result = runCase(*benchmark);
+            console << std::right << std::setw(12) << std::setprecision(4)
+                    << 1e3 * result.medianTime << " ms  ("
+                    << result.iterations << " iterations)" << std::endl;
+            results.push_back(result);
+        } catch (const std::exception& e) {
+            console << " FAILED: " << e.what() << std::endl;
+            ++numFailed;
+        }
+        IO::chDir(startDirectory);
+    }
+
+    std::ofstream out(outputFile);
+    if (!out) {
+        std::cerr << "Could not open '" << outputFile << "' for writing."
+                  << std::endl;
+        return 1;
+    }
+    writeJSON(out, results);
+    console << "Wrote the results of " << results.size() << " benchmarks to '"
+            << outputFile << "'." << std::endl;
+    return numFailed == 0 ? 0 : 1;
+}
+
+BenchmarkResult BenchmarkRunner::runCase(const BenchmarkCase& benchmark) const {
+    NullBuffer discard;
+    std::streambuf* console = LogManager::cout.rdbuf();
+    if (!_verbose) LogManager::cout.rdbuf(&discard);
+
+    BenchmarkResult result;
+    result.name = benchmark.name;
+    std::vector<double> times;
+    const auto startRSS = (long long)getCurrentRSS();
+    const auto startPeakRSS = (long long)getPeakRSS();
+    try {
+        std::function<void()> iteration = benchmark.prepare();
+        result.setupRSS = (long long)getCurrentRSS() - startRSS;
+
+        double total = 0;
+        while ((int(times.size()) < _minIterations || total < _minTime) &&
+               int(times.size()) < _maxIterations) {
+            const auto start = std::chrono::steady_clock::now();
+            iteration();
+            const double elapsed = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start).count();
+            times.push_back(elapsed);
+            total += elapsed;
+        }
+        result.totalTime = total;
+        // Measured before the timed function, and what it holds, is freed.
+        result.rssIncrease = (long long)getCurrentRSS() - startRSS;
+        result.peakRSSIncrease = (long long)getPeakRSS() - startPeakRSS;
+    } catch (...) {
+        LogManager::cout.rdbuf(console);
+        throw;
+    }
+    LogManager::cout.rdbuf(console);
+
+    result.iterations = int(times.size());
+    result.meanTime = result.totalTime / result.iterations;
+    std::sort(times.begin(), times.end());
+    result.minTime = times.front();
+    const size_t mid = times.size() / 2;
+    result.medianTime = times.size() % 2 ? times[mid]
+                                         : 0.5 * (times[mid - 1] + times[mid]);
+    if (result.totalTime > 0) {
+        result.iterationsPerSecond = result.iterations / result.totalTime;
+        result.itemsPerSecond =
+                benchmark.itemsPerIteration * result.iterationsPerSecond;
+    }
+    return result;
+}
+
+void BenchmarkRunner::writeJSON(std::ostream& out,
+                                const std::vector<BenchmarkResult>& results) {
+    out << std::setprecision(9);
+    out << "{\n";
+    out << "  \"context\": {\n";
+    out << "    \"opensim_version\": \"" << escapeJSON(GetVersion()) << "\",\n";
+    out << "    \"os\": \"" << escapeJSON(GetOSInfo()) << "\",\n";
+    out << "    \"compiler\": \"" << escapeJSON(GetCompilerVersion())
+        << "\",\n";
+#ifdef NDEBUG
+    out << "    \"build_type\": \"Release\",\n";
+#else
+    out << "    \"build_type\": \"Debug\",\n";
+#endif
+    out << "    \"hardware_threads\": "
+        << std::thread::hardware_concurrency() << ",\n";
+    out << "    \"date\": \"" << getTimestamp() << "\"\n";
+    out << "  },\n";
+    out << "  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\n";
+        out << "      \"name\": \"" << escapeJSON(r.name) << "\",\n";
+        out << "      \"iterations\": " << r.iterations << ",\n";
+        out << "      \"total_time_s\": " << r.totalTime << ",\n";
+        out << "      \"min_time_s\": " << r.minTime << ",\n";
+        out << "      \"mean_time_s\": " << r.meanTime << ",\n";
+        out << "      \"median_time_s\": " << r.medianTime << ",\n";
+        out << "      \"iterations_per_second\": " << r.iterationsPerSecond
+            << ",\n";
+        out << "      \"items_per_second\": " << r.itemsPerSecond << ",\n";
+        out << "      \"setup_rss_bytes\": " << r.setupRSS << ",\n";
+        out << "      \"rss_increase_bytes\": " << r.rssIncrease << ",\n";
+        out << "      \"peak_rss_increase_bytes\": " << r.peakRSSIncrease
+            << "\n";
+        out << "    }";
+    }
+    out << "\n  ]\n}\n";
+}
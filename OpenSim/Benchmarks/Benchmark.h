@@ -0,0 +1,109 @@
+#ifndef OPENSIM_BENCHMARK_H_
+#define OPENSIM_BENCHMARK_H_
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  Benchmark.h                             *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+/** A single benchmark. prepare() performs the setup that is not timed (e.g.,
+loading a model and calling initSystem()) and returns the function that is
+timed. The timed function is called repeatedly, until both the minimum number
+of iterations and the minimum time are reached. prepare() and the timed function
+are run from the benchmark's directory, relative to the data directory. */
+struct BenchmarkCase {
+    std::string name;
+    std::string directory;
+    std::function<std::function<void()>()> prepare;
+    /** The number of items (e.g., function evaluations or frames) processed
+    by one call to the timed function; used to report items per second. */
+    double itemsPerIteration = 1;
+};
+
+/** The measurements of a single benchmark. Times are in seconds and memory
+sizes in bytes. The resident memory of the process is shared by all of the
+benchmarks, so the memory sizes are changes over this benchmark: setupRSS and
+rssIncrease are the growth of the resident memory during prepare() and over
+the whole benchmark (while the timed function still exists), and may be
+negative. The peak resident memory only
+grows, so peakRSSIncrease is zero if the benchmark stayed below the peak
+reached by an earlier one; use --filter to run a benchmark on its own. */
+struct BenchmarkResult {
+    std::string name;
+    int iterations = 0;
+    double totalTime = 0;
+    double minTime = 0;
+    double meanTime = 0;
+    double medianTime = 0;
+    double iterationsPerSecond = 0;
+    double itemsPerSecond = 0;
+    long long setupRSS = 0;
+    long long rssIncrease = 0;
+    long long peakRSSIncrease = 0;
+};
+
+/** Runs a set of BenchmarkCase%s and writes their results to a JSON file.
+Output written to std::cout by OpenSim while a benchmark runs is discarded
+unless the runner is verbose, so that the benchmarks are not limited by the
+speed of the console. */
+class BenchmarkRunner {
+public:
+    /** Add a benchmark; see BenchmarkCase. */
+    void add(const std::string& name, const std::string& directory,
+             std::function<std::function<void()>()> prepare,
+             double itemsPerIteration = 1);
+
+    /** Parse the command-line arguments (see printUsage()), run the
+    benchmarks and write the results. Returns the exit code of the program. */
+    int run(int argc, const char* argv[]);
+
+    static void printUsage(std::ostream& out, const std::string& program);
+
+    /** Write results in the JSON format read by compareBenchmarks.py. */
+    static void writeJSON(std::ostream& out,
+                          const std::vector<BenchmarkResult>& results);
+
+private:
+    BenchmarkResult runCase(const BenchmarkCase& benchmark) const;
+
+    std::vector<BenchmarkCase> _cases;
+    std::string _dataDirectory = ".";
+    double _minTime = 1.0;
+    int _minIterations = 1;
+    int _maxIterations = 1000000;
+    bool _verbose = false;
+};
+
+// Each of these adds the benchmarks of one area of OpenSim.
+void addSimulationBenchmarks(BenchmarkRunner& runner);
+void addToolBenchmarks(BenchmarkRunner& runner);
+void addFileBenchmarks(BenchmarkRunner& runner);
+void addComponentBenchmarks(BenchmarkRunner& runner);
+
+} // namespace OpenSim
+
+#endif // OPENSIM_BENCHMARK_H_
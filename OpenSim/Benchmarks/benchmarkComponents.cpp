@@ -0,0 +1,149 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  benchmarkComponents.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* GeometryPath lengths and moment arms of the muscles of gait2354, and the
+evaluation of the Millard2012EquilibriumMuscle curves. */
+
+#include "Benchmark.h"
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/Muscle.h>
+#include <OpenSim/Simulation/Model/GeometryPath.h>
+#include <OpenSim/Actuators/ActiveForceLengthCurve.h>
+#include <OpenSim/Actuators/FiberForceLengthCurve.h>
+#include <OpenSim/Actuators/ForceVelocityCurve.h>
+#include <OpenSim/Actuators/TendonForceLengthCurve.h>
+#include <memory>
+#include <random>
+
+using namespace OpenSim;
+
+namespace {
+    const std::string pathModelFile = "gait2354_simbody.osim";
+
+    // A model and a set of random poses within the ranges of the
+    // coordinates. The same seed is used every time, so that every run of the
+    // benchmarks evaluates the same poses.
+    struct Poses {
+        explicit Poses(int numPoses) : model(pathModelFile) {
+            state = model.initSystem();
+            std::default_random_engine generator(0);
+            std::uniform_real_distribution<double> distribution(0.0, 1.0);
+            const CoordinateSet& coords = model.getCoordinateSet();
+            for (int p = 0; p < numPoses; ++p) {
+                for (int i = 0; i < coords.getSize(); ++i) {
+                    const Coordinate& coord = coords[i];
+                    const double fraction = distribution(generator);
+                    if (coord.getDefaultLocked()) continue;
+                    coord.setValue(state, coord.getRangeMin() + fraction *
+                            (coord.getRangeMax() - coord.getRangeMin()),
+                            false);
+                }
+                q.push_back(state.getQ());
+            }
+        }
+        Model model;
+        SimTK::State state;
+        std::vector<SimTK::Vector> q;
+    };
+
+    const int numPoses = 50;
+    const int numPoints = 10000;
+}
+
+void OpenSim::addComponentBenchmarks(BenchmarkRunner& runner) {
+    // An item is the length of every muscle in one pose.
+    runner.add("GeometryPath/length/gait2354", "models",
+        []() -> std::function<void()> {
+            auto poses = std::make_shared<Poses>(numPoses);
+            return [poses]() {
+                Model& model = poses->model;
+                SimTK::State& s = poses->state;
+                const auto& muscles = model.getMuscles();
+                double total = 0;
+                for (const auto& q : poses->q) {
+                    s.updQ() = q;
+                    model.realizePosition(s);
+                    for (int m = 0; m < muscles.getSize(); ++m)
+                        total += muscles[m].getGeometryPath().getLength(s);
+                }
+                SimTK_ASSERT_ALWAYS(!SimTK::isNaN(total), "NaN path length.");
+            };
+        }, numPoses);
+
+    // Moment arms of all muscles about the right hip flexion and knee angle.
+    // An item is the moment arms of every muscle about one coordinate in one
+    // pose.
+    const std::vector<std::string> coordNames{"hip_flexion_r",
+                                              "knee_angle_r"};
+    runner.add("GeometryPath/moment_arm/gait2354", "models",
+        [coordNames]() -> std::function<void()> {
+            auto poses = std::make_shared<Poses>(5);
+            return [poses, coordNames]() {
+                Model& model = poses->model;
+                SimTK::State& s = poses->state;
+                const auto& muscles = model.getMuscles();
+                for (const auto& q : poses->q) {
+                    s.updQ() = q;
+                    model.realizePosition(s);
+                    for (const auto& name : coordNames) {
+                        const Coordinate& coord =
+                                model.getCoordinateSet().get(name);
+                        for (int m = 0; m < muscles.getSize(); ++m)
+                            muscles[m].getGeometryPath().computeMomentArm(
+                                    s, coord);
+                    }
+                }
+            };
+        }, 5 * coordNames.size());
+
+    // Evaluate each curve across (and beyond) its domain.
+    auto addCurve = [&](const std::string& name,
+            std::function<double(double)> (*make)(), double x0, double x1) {
+        runner.add("curves/" + name, "",
+            [make, x0, x1]() -> std::function<void()> {
+                auto curve = make();
+                return [curve, x0, x1]() {
+                    double total = 0;
+                    for (int i = 0; i < numPoints; ++i)
+                        total += curve(x0 + (x1 - x0) * i / (numPoints - 1));
+                    SimTK_ASSERT_ALWAYS(!SimTK::isNaN(total),
+                                        "NaN curve value.");
+                };
+            }, numPoints);
+    };
+    addCurve("ActiveForceLengthCurve", []() -> std::function<double(double)> {
+            auto curve = std::make_shared<ActiveForceLengthCurve>();
+            return [curve](double x) { return curve->calcValue(x); };
+        }, 0.2, 1.9);
+    addCurve("FiberForceLengthCurve", []() -> std::function<double(double)> {
+            auto curve = std::make_shared<FiberForceLengthCurve>();
+            return [curve](double x) { return curve->calcValue(x); };
+        }, 0.5, 1.8);
+    addCurve("TendonForceLengthCurve", []() -> std::function<double(double)> {
+            auto curve = std::make_shared<TendonForceLengthCurve>();
+            return [curve](double x) { return curve->calcValue(x); };
+        }, 0.99, 1.06);
+    addCurve("ForceVelocityCurve", []() -> std::function<double(double)> {
+            auto curve = std::make_shared<ForceVelocityCurve>();
+            return [curve](double x) { return curve->calcValue(x); };
+        }, -1.1, 1.1);
+}
@@ -0,0 +1,79 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  benchmarkFiles.cpp                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Reading and writing STO, TRC and C3D files. C3D files can only be read, and
+only if OpenSim is built with BTK. */
+
+#include "Benchmark.h"
+#include <OpenSim/Common/Storage.h>
+#include <OpenSim/Common/STOFileAdapter.h>
+#include <OpenSim/Common/TRCFileAdapter.h>
+#ifdef WITH_BTK
+#include <OpenSim/Common/C3DFileAdapter.h>
+#endif
+#include <memory>
+
+using namespace OpenSim;
+
+namespace {
+    const std::string stoFile = "std_subject01_walk1_states.sto";
+    const std::string trcFile = "constraintTest.trc";
+}
+
+void OpenSim::addFileBenchmarks(BenchmarkRunner& runner) {
+    runner.add("files/sto/read", "data",
+        []() -> std::function<void()> {
+            return []() { STOFileAdapter::read(stoFile); };
+        });
+    runner.add("files/sto/write", "data",
+        []() -> std::function<void()> {
+            auto table = std::make_shared<TimeSeriesTable>(
+                    STOFileAdapter::read(stoFile));
+            return [table]() {
+                STOFileAdapter::write(*table, "benchmark_write.sto");
+            };
+        });
+    runner.add("files/sto/read_Storage", "data",
+        []() -> std::function<void()> {
+            return []() { Storage sto(stoFile); };
+        });
+
+    runner.add("files/trc/read", "data",
+        []() -> std::function<void()> {
+            return []() { TRCFileAdapter::read(trcFile); };
+        });
+    runner.add("files/trc/write", "data",
+        []() -> std::function<void()> {
+            auto table = std::make_shared<TimeSeriesTableVec3>(
+                    TRCFileAdapter::read(trcFile));
+            return [table]() {
+                TRCFileAdapter::write(*table, "benchmark_write.trc");
+            };
+        });
+
+#ifdef WITH_BTK
+    runner.add("files/c3d/read", "data",
+        []() -> std::function<void()> {
+            return []() { C3DFileAdapter::read("walking2.c3d"); };
+        });
+#endif
+}
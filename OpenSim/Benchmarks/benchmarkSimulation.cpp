@@ -0,0 +1,100 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  benchmarkSimulation.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Forward simulation of the bundled models with each integrator, and loading
+a model and creating its System. */
+
+#include "Benchmark.h"
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Manager/Manager.h>
+#include <memory>
+
+using namespace OpenSim;
+
+namespace {
+    struct ModelInfo {
+        const char* name;
+        const char* file;
+        double finalTime;
+    };
+
+    // The simulated durations are chosen so that each simulation takes
+    // roughly the same time with the default integrator.
+    const ModelInfo models[] = {
+        {"arm26",      "arm26.osim",            0.5},
+        {"gait2354",   "gait2354_simbody.osim", 0.05},
+        {"BothLegs22", "BothLegs22.osim",       0.05}
+    };
+
+    struct IntegratorInfo {
+        const char* name;
+        Manager::IntegratorMethod method;
+    };
+
+    const IntegratorInfo integrators[] = {
+        {"ExplicitEuler",      Manager::IntegratorMethod::ExplicitEuler},
+        {"RungeKutta2",        Manager::IntegratorMethod::RungeKutta2},
+        {"RungeKutta3",        Manager::IntegratorMethod::RungeKutta3},
+        {"RungeKuttaFeldberg", Manager::IntegratorMethod::RungeKuttaFeldberg},
+        {"RungeKuttaMerson",   Manager::IntegratorMethod::RungeKuttaMerson},
+        {"SemiExplicitEuler2", Manager::IntegratorMethod::SemiExplicitEuler2},
+        {"Verlet",             Manager::IntegratorMethod::Verlet}
+    };
+}
+
+void OpenSim::addSimulationBenchmarks(BenchmarkRunner& runner) {
+    for (const auto& info : models) {
+        for (const auto& integrator : integrators) {
+            const std::string file = info.file;
+            const double finalTime = info.finalTime;
+            const Manager::IntegratorMethod method = integrator.method;
+            runner.add(std::string("forward/") + info.name + "/" +
+                       integrator.name, "models",
+                [file, finalTime, method]() -> std::function<void()> {
+                    auto model = std::make_shared<Model>(file);
+                    SimTK::State& state = model->initSystem();
+                    model->equilibrateMuscles(state);
+                    const SimTK::State initialState = state;
+                    return [model, initialState, finalTime, method]() {
+                        SimTK::State s = initialState;
+                        Manager manager(*model);
+                        manager.setIntegratorMethod(method);
+                        manager.setIntegratorAccuracy(1e-4);
+                        manager.setWriteToStorage(false);
+                        manager.initialize(s);
+                        manager.integrate(finalTime);
+                    };
+                });
+        }
+    }
+
+    for (const auto& info : models) {
+        const std::string file = info.file;
+        runner.add(std::string("load/") + info.name, "models",
+            [file]() -> std::function<void()> {
+                return [file]() {
+                    Model model(file);
+                    model.initSystem();
+                };
+            });
+    }
+}
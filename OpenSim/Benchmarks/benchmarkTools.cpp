@@ -0,0 +1,61 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  benchmarkTools.cpp                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Inverse kinematics, inverse dynamics, static optimization and computed
+muscle control, run from the setup files of the tests of these tools. Each
+iteration runs the complete tool, including loading its model and input
+files, as a user would from the command line. */
+
+#include "Benchmark.h"
+#include <OpenSim/Common/Exception.h>
+#include <OpenSim/Tools/InverseKinematicsTool.h>
+#include <OpenSim/Tools/InverseDynamicsTool.h>
+#include <OpenSim/Tools/AnalyzeTool.h>
+#include <OpenSim/Tools/CMCTool.h>
+
+using namespace OpenSim;
+
+namespace {
+    template <typename ToolType>
+    std::function<std::function<void()>()> runTool(const std::string& setup) {
+        return [setup]() -> std::function<void()> {
+            return [setup]() {
+                ToolType tool(setup);
+                OPENSIM_THROW_IF(!tool.run(), Exception,
+                                 "Running '" + setup + "' failed.");
+            };
+        };
+    }
+}
+
+void OpenSim::addToolBenchmarks(BenchmarkRunner& runner) {
+    runner.add("tools/InverseKinematics/subject01", "ik",
+               runTool<InverseKinematicsTool>(
+                       "subject01_Setup_InverseKinematics.xml"));
+    runner.add("tools/InverseDynamics/arm26", "analyze",
+               runTool<InverseDynamicsTool>(
+                       "arm26_Setup_InverseDynamics.xml"));
+    runner.add("tools/StaticOptimization/arm26", "analyze",
+               runTool<AnalyzeTool>("arm26_Setup_StaticOptimization.xml"));
+    runner.add("tools/CMC/arm26", "cmc",
+               runTool<CMCTool>("arm26_Setup_CMC.xml"));
+}
@@ -0,0 +1,108 @@
+"""
+Compare two results files written by opensim-benchmarks and flag the
+benchmarks that became slower (or use more memory) than in the baseline run.
+
+Usage:
+    python compareBenchmarks.py baseline.json contender.json
+           [--metric median_time_s] [--threshold 0.1] [--rss-threshold 10]
+
+The exit code is 1 if any benchmark regressed, so that this script can be used
+in continuous integration. Timings are only comparable between runs on the
+same machine with the same build type; the context of each run is printed.
+The memory sizes in the results are increases over each benchmark, so they are
+compared as differences in megabytes rather than as fractions.
+"""
+from __future__ import print_function
+import argparse
+import json
+import sys
+
+# Metrics for which larger values are better.
+HIGHER_IS_BETTER = {'iterations_per_second', 'items_per_second'}
+
+
+def load(path):
+    with open(path) as f:
+        results = json.load(f)
+    return results['context'], {b['name']: b for b in results['benchmarks']}
+
+
+def relative_change(old, new, higher_is_better):
+    """Fractional change, positive if the contender is worse."""
+    if old == 0:
+        return 0.0
+    change = (new - old) / float(old)
+    return -change if higher_is_better else change
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compare two OpenSim benchmark results files.')
+    parser.add_argument('baseline', help='Results of the reference run.')
+    parser.add_argument('contender', help='Results of the run to check.')
+    parser.add_argument('--metric', default='median_time_s',
+                        help='Timing metric to compare [%(default)s].')
+    parser.add_argument('--threshold', type=float, default=0.1,
+                        help='Fractional slowdown that is flagged as a '
+                             'regression [%(default)s].')
+    parser.add_argument('--rss-threshold', type=float, default=None,
+                        help='Increase, in megabytes, of the resident memory '
+                             'that a benchmark adds that is flagged as a '
+                             'regression (not checked by default).')
+    args = parser.parse_args()
+
+    base_context, baseline = load(args.baseline)
+    new_context, contender = load(args.contender)
+    for label, context in (('baseline', base_context),
+                           ('contender', new_context)):
+        print('%-10s OpenSim %s, %s, %s build, %s threads, %s' % (
+            label, context.get('opensim_version'), context.get('compiler'),
+            context.get('build_type'), context.get('hardware_threads'),
+            context.get('date')))
+    if base_context.get('build_type') != new_context.get('build_type'):
+        print('WARNING: the runs used different build types.')
+    print()
+
+    higher_is_better = args.metric in HIGHER_IS_BETTER
+    regressions = []
+    print('%-50s %14s %14s %9s' % ('benchmark', 'baseline', 'contender',
+                                   'change'))
+    for name in sorted(set(baseline) | set(contender)):
+        if name not in contender:
+            print('%-50s %14s' % (name, 'missing'))
+            continue
+        if name not in baseline:
+            print('%-50s %14s' % (name, 'new'))
+            continue
+        old = baseline[name][args.metric]
+        new = contender[name][args.metric]
+        change = relative_change(old, new, higher_is_better)
+        flag = ''
+        if change > args.threshold:
+            flag = 'REGRESSION'
+            regressions.append(name)
+        elif change < -args.threshold:
+            flag = 'improved'
+        if args.rss_threshold is not None:
+            rss_change = (contender[name]['rss_increase_bytes'] -
+                          baseline[name]['rss_increase_bytes']) / 1e6
+            if rss_change > args.rss_threshold:
+                flag += ' RSS +%.1f MB' % rss_change
+                if name not in regressions:
+                    regressions.append(name)
+        print('%-50s %14.6g %14.6g %+8.1f%% %s' % (
+            name, old, new, 100 * change, flag))
+
+    print()
+    if regressions:
+        print('%d benchmark(s) regressed by more than the threshold:' %
+              len(regressions))
+        for name in regressions:
+            print('    ' + name)
+        return 1
+    print('No regressions.')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,54 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  opensim-benchmarks.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Runs the OpenSim performance benchmarks. Build and run the benchmarks with
+the run_benchmarks target, or run this program from the OpenSim/Benchmarks
+build directory (or pass --data-dir). Run with --help for the options. */
+
+#include "Benchmark.h"
+#include <OpenSim/OpenSim.h>
+#include <OpenSim/Common/LoadOpenSimLibrary.h>
+#include <iostream>
+
+using namespace OpenSim;
+
+int main(int argc, const char* argv[])
+{
+    try {
+        // The actuators library is not loaded automatically (unless using
+        // clang).
+        #if !defined(__clang__)
+            LoadOpenSimLibrary("osimActuators");
+        #endif
+
+        BenchmarkRunner runner;
+        addSimulationBenchmarks(runner);
+        addToolBenchmarks(runner);
+        addFileBenchmarks(runner);
+        addComponentBenchmarks(runner);
+        return runner.run(argc, argv);
+    }
+    catch (const std::exception& e) {
+        std::cout << "opensim-benchmarks FAILED: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -5,6 +5,11 @@
 #include "btkForcePlatformsExtractor.h"
 #include "btkGroundReactionWrenchFilter.h"
 
+#include "SimTKcommon/internal/ParallelExecutor.h"
+
+#include <algorithm>
+#include <functional>
+
 namespace {
 
 // Function to convert Eigen matrix to SimTK matrix. This can become a lambda
@@ -23,6 +28,44 @@ convertToSimtkMatrix(const Eigen::Matrix<_Scalar, _Rows, _Cols>&
     return simtkMat;
 }
 
+// Fills contiguous blocks of columns of a table, one block per task index.
+class FillColumnsTask : public SimTK::ParallelExecutor::Task {
+public:
+    FillColumnsTask(int numColumns, int numBlocks,
+                    const std::function<void(int)>& fillColumn) :
+        _numColumns(numColumns), _numBlocks(numBlocks),
+        _fillColumn(fillColumn) {}
+
+    void execute(int block) override {
+        const int begin = (_numColumns * block) / _numBlocks;
+        const int end = (_numColumns * (block + 1)) / _numBlocks;
+        for(int c = begin; c < end; ++c)
+            _fillColumn(c);
+    }
+
+private:
+    const int _numColumns;
+    const int _numBlocks;
+    const std::function<void(int)>& _fillColumn;
+};
+
+// Call fillColumn(c) for each of numColumns columns, concurrently on
+// numThreads threads (one thread per processor if numThreads < 1).
+void fillColumns(int numColumns, int numThreads,
+                 const std::function<void(int)>& fillColumn) {
+    if(numThreads < 1)
+        numThreads = SimTK::ParallelExecutor::getNumProcessors();
+    numThreads = std::min(numThreads, numColumns);
+    if(numThreads <= 1) {
+        for(int c = 0; c < numColumns; ++c)
+            fillColumn(c);
+        return;
+    }
+    FillColumnsTask task(numColumns, numThreads, fillColumn);
+    SimTK::ParallelExecutor executor(numThreads);
+    executor.execute(task, numThreads);
+}
+
 } // anonymous namespace
 
 namespace OpenSim {
@@ -48,8 +91,13 @@ C3DFileAdapter::read(const std::string& fileName, ForceLocation wrt)
 {
     C3DFileAdapter c3dreader{};
     c3dreader.setLocationForForceExpression(wrt);
+    return c3dreader.readTables(fileName);
+}
 
-    auto abstables = c3dreader.extendRead(fileName);
+C3DFileAdapter::Tables
+C3DFileAdapter::readTables(const std::string& fileName) const
+{
+    auto abstables = extendRead(fileName);
     auto marker_table = 
         std::static_pointer_cast<TimeSeriesTableVec3>(abstables.at(_markers));
     auto force_table = 
@@ -87,57 +135,69 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
 
     OutputTables tables{};
 
-    auto marker_pts = btk::PointCollection::New();
-
+    std::vector<btk::Point::Pointer> marker_pts{};
     for(auto it = acquisition->BeginPoint();
         it != acquisition->EndPoint();
         ++it) {
         auto pt = *it;
         if(pt->GetType() == btk::Point::Marker)
-               marker_pts->InsertItem(pt);
+               marker_pts.push_back(pt);
+    }
+
+    if(!_markersToRead.empty()) {
+        std::vector<btk::Point::Pointer> selected_pts{};
+        for(const auto& label : _markersToRead) {
+            auto it = std::find_if(marker_pts.begin(), marker_pts.end(),
+                [&label](const btk::Point::Pointer& pt) {
+                    return pt->GetLabel() == label;
+                });
+            OPENSIM_THROW_IF(it == marker_pts.end(), Exception,
+                "Marker '" + label + "' not found in '" + fileName + "'.");
+            selected_pts.push_back(*it);
+        }
+        marker_pts = selected_pts;
     }
 
-    if(marker_pts->GetItemNumber() != 0) {
+    if(!marker_pts.empty()) {
 
-        int marker_nrow = marker_pts->GetFrontItem()->GetFrameNumber();
-        int marker_ncol = marker_pts->GetItemNumber();
+        int marker_nrow = marker_pts.front()->GetFrameNumber();
+        int marker_ncol = static_cast<int>(marker_pts.size());
 
         std::vector<double> marker_times(marker_nrow);
-        SimTK::Matrix_<SimTK::Vec3> marker_matrix(marker_nrow, marker_ncol);
-
         std::vector<std::string> marker_labels{};
-        for (auto it = marker_pts->Begin(); it != marker_pts->End(); ++it) {
-            marker_labels.push_back(SimTK::Value<std::string>((*it)->GetLabel()));
+        for (const auto& pt : marker_pts) {
+            marker_labels.push_back(SimTK::Value<std::string>(pt->GetLabel()));
         }
 
         double time_step{1.0 / acquisition->GetPointFrequency()};
-        for(int f = 0; f < marker_nrow; ++f) {
-            SimTK::RowVector_<SimTK::Vec3> row{ marker_pts->GetItemNumber(), 
-                                                SimTK::Vec3(SimTK::NaN) };
-            int m{0};
-            for(auto it = marker_pts->Begin();  it != marker_pts->End(); ++it) {
-                auto pt = *it;
-                // BTK reads empty values as zero, but sets a "residual" value
-                // to -1 and it is how it knows to export these values as 
-                // blank, instead of 0,  when exporting to .trc
-                // See: BTKCore/Code/IO/btkTRCFileIO.cpp#L359-L360
-                // Read in value if it is not zero or residual is not -1
-                if (!pt->GetValues().row(f).isZero() ||    //not precisely zero
-                    (pt->GetResiduals().coeff(f) != -1) ) {//residual is not -1
-                    row[m] = SimTK::Vec3{ pt->GetValues().coeff(f, 0),
-                                          pt->GetValues().coeff(f, 1),
-                                          pt->GetValues().coeff(f, 2) };
-                }
-                ++m;
-            }
-
-            marker_matrix.updRow(f) = row;
+        for(int f = 0; f < marker_nrow; ++f)
             marker_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
-        }
 
-        // Create the data
-        auto& marker_table = *new 
-            TimeSeriesTableVec3(marker_times, marker_matrix, marker_labels);
+        // Create the table with all of its rows, and fill it column by column.
+        auto& marker_table = *new TimeSeriesTableVec3(marker_times,
+            SimTK::Matrix_<SimTK::Vec3>(marker_nrow, marker_ncol,
+                                        SimTK::Vec3(SimTK::NaN)),
+            marker_labels);
+        marker_table.fillMatrix(
+                [&](SimTK::Matrix_<SimTK::Vec3>& marker_matrix) {
+            fillColumns(marker_ncol, _numThreads, [&](int m) {
+                const auto& values = marker_pts[m]->GetValues();
+                const auto& residuals = marker_pts[m]->GetResiduals();
+                for(int f = 0; f < marker_nrow; ++f) {
+                    // BTK reads empty values as zero, but sets a "residual" value
+                    // to -1 and it is how it knows to export these values as 
+                    // blank, instead of 0,  when exporting to .trc
+                    // See: BTKCore/Code/IO/btkTRCFileIO.cpp#L359-L360
+                    // Read in value if it is not zero or residual is not -1
+                    if (!values.row(f).isZero() ||    //not precisely zero
+                        (residuals.coeff(f) != -1) ) {//residual is not -1
+                        marker_matrix(f, m) = SimTK::Vec3{ values.coeff(f, 0),
+                                                           values.coeff(f, 1),
+                                                           values.coeff(f, 2) };
+                    }
+                }
+            });
+        });
 
         marker_table.
             updTableMetaData().
@@ -162,16 +222,33 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
     auto force_platform_collection = force_platforms_extractor->GetOutput();
     force_platforms_extractor->Update();
 
+    const int num_platforms =
+        static_cast<int>(force_platform_collection->GetItemNumber());
+    std::vector<bool> read_platform(num_platforms, _forcePlatesToRead.empty());
+    for(int fp : _forcePlatesToRead) {
+        OPENSIM_THROW_IF(fp < 1 || fp > num_platforms, Exception,
+            "Force plate " + std::to_string(fp) + " not found in '" +
+            fileName + "', which has " + std::to_string(num_platforms) +
+            " force plates.");
+        read_platform[fp - 1] = true;
+    }
+
     std::vector<SimTK::Matrix_<double>> fpCalMatrices{};
     std::vector<SimTK::Matrix_<double>> fpCorners{};
     std::vector<SimTK::Matrix_<double>> fpOrigins{};
     std::vector<unsigned>               fpTypes{};
-    auto    fp_force_pts = btk::PointCollection::New();
-    auto   fp_moment_pts = btk::PointCollection::New();
-    auto fp_position_pts = btk::PointCollection::New();
+    std::vector<btk::Point::Pointer>    fp_force_pts{};
+    std::vector<btk::Point::Pointer>    fp_moment_pts{};
+    std::vector<btk::Point::Pointer>    fp_position_pts{};
+    std::vector<int>                    fp_numbers{};
+    int fp_number{0};
     for(auto platform = force_platform_collection->Begin(); 
         platform != force_platform_collection->End(); 
         ++platform) {
+        ++fp_number;
+        if(!read_platform[fp_number - 1])
+            continue;
+
         const auto& calMatrix = (*platform)->GetCalMatrix();
         const auto& corners   = (*platform)->GetCorners();
         const auto& origins   = (*platform)->GetOrigin();
@@ -193,19 +270,20 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
             wrench != wrench_collection->End(); 
             ++wrench) {
             // Forces time series.
-            fp_force_pts->InsertItem((*wrench)->GetForce());
+            fp_force_pts.push_back((*wrench)->GetForce());
             // Moment time series.
-            fp_moment_pts->InsertItem((*wrench)->GetMoment());
+            fp_moment_pts.push_back((*wrench)->GetMoment());
             // Position time series.
-            fp_position_pts->InsertItem((*wrench)->GetPosition());
+            fp_position_pts.push_back((*wrench)->GetPosition());
+            fp_numbers.push_back(fp_number);
         }
     }
 
-    if(fp_force_pts->GetItemNumber() != 0) {
+    if(!fp_force_pts.empty()) {
 
         std::vector<std::string> labels{};
         ValueArray<std::string> units{};
-        for(int fp = 1; fp <= fp_force_pts->GetItemNumber(); ++fp) {
+        for(int fp : fp_numbers) {
             auto fp_str = std::to_string(fp);
 
             labels.push_back(SimTK::Value<std::string>("f" + fp_str));
@@ -224,43 +302,37 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
             units.upd().push_back(SimTK::Value<std::string>(moment_unit));
         }
 
-        const int nf = fp_force_pts->GetFrontItem()->GetFrameNumber();
+        const int nf = fp_force_pts.front()->GetFrameNumber();
         
         std::vector<double> force_times(nf);
-        SimTK::Matrix_<SimTK::Vec3> force_matrix(nf, (int)labels.size());
-
         double time_step{1.0 / acquisition->GetAnalogFrequency()};
-
-        for(int f = 0; f < nf;  ++f) {
-            SimTK::RowVector_<SimTK::Vec3> 
-                row{fp_force_pts->GetItemNumber() * 3};
-            int col{0};
-            for(auto fit = fp_force_pts->Begin(),
-                mit =     fp_moment_pts->Begin(),
-                pit =   fp_position_pts->Begin();
-                fit != fp_force_pts->End();
-                ++fit, 
-                ++mit,
-                ++pit) {
-                row[col] = SimTK::Vec3{(*fit)->GetValues().coeff(f, 0),
-                                       (*fit)->GetValues().coeff(f, 1),
-                                       (*fit)->GetValues().coeff(f, 2)};
-                ++col;
-                row[col] = SimTK::Vec3{(*pit)->GetValues().coeff(f, 0),
-                                       (*pit)->GetValues().coeff(f, 1),
-                                       (*pit)->GetValues().coeff(f, 2)};
-                ++col;
-                row[col] = SimTK::Vec3{(*mit)->GetValues().coeff(f, 0),
-                                       (*mit)->GetValues().coeff(f, 1),
-                                       (*mit)->GetValues().coeff(f, 2)};
-                ++col;
-            }
-            force_matrix.updRow(f) = row;
+        for(int f = 0; f < nf;  ++f)
             force_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
-        }
 
-        auto&  force_table = 
-            *(new TimeSeriesTableVec3(force_times, force_matrix, labels));
+        // Create the table with all of its rows, and fill the force, point
+        // and moment columns of each force plate.
+        auto&  force_table = *(new TimeSeriesTableVec3(force_times,
+            SimTK::Matrix_<SimTK::Vec3>(nf, (int)labels.size()), labels));
+        force_table.fillMatrix(
+                [&](SimTK::Matrix_<SimTK::Vec3>& force_matrix) {
+            fillColumns(static_cast<int>(fp_force_pts.size()), _numThreads,
+                    [&](int w) {
+                const auto& forces = fp_force_pts[w]->GetValues();
+                const auto& positions = fp_position_pts[w]->GetValues();
+                const auto& moments = fp_moment_pts[w]->GetValues();
+                for(int f = 0; f < nf;  ++f) {
+                    force_matrix(f, 3*w) = SimTK::Vec3{forces.coeff(f, 0),
+                                                       forces.coeff(f, 1),
+                                                       forces.coeff(f, 2)};
+                    force_matrix(f, 3*w + 1) = SimTK::Vec3{positions.coeff(f, 0),
+                                                           positions.coeff(f, 1),
+                                                           positions.coeff(f, 2)};
+                    force_matrix(f, 3*w + 2) = SimTK::Vec3{moments.coeff(f, 0),
+                                                           moments.coeff(f, 1),
+                                                           moments.coeff(f, 2)};
+                }
+            });
+        });
 
         TimeSeriesTableVec3::DependentsMetaData force_dep_metadata
             = force_table.getDependentsMetaData();
@@ -99,6 +99,59 @@ public:
     const ForceLocation getLocationForForceExpression() const {
         return _location;
     }
+
+    /** Read only the markers with the given labels, in the given order. An
+        empty list (the default) reads all of the markers in the file, in the
+        order of the file. Reading a file that does not contain one of the
+        markers throws an Exception. */
+    void setMarkersToRead(const std::vector<std::string>& markerLabels) {
+        _markersToRead = markerLabels;
+    }
+
+    const std::vector<std::string>& getMarkersToRead() const {
+        return _markersToRead;
+    }
+
+    /** Read only the force plates with the given numbers. Force plates are
+        numbered from 1 in the order of the file, which is the number that
+        appears in the *f#*, *p#* and *m#* column labels; the labels keep this
+        number when some plates are skipped. The ground reaction wrenches of
+        the skipped force plates are not computed. An empty list (the default)
+        reads all of the force plates in the file. */
+    void setForcePlatesToRead(const std::vector<int>& forcePlates) {
+        _forcePlatesToRead = forcePlates;
+    }
+
+    const std::vector<int>& getForcePlatesToRead() const {
+        return _forcePlatesToRead;
+    }
+
+    /** Set the number of threads used to fill the markers and forces tables.
+        The columns of each marker and of each force plate are filled
+        independently, so they are distributed across the threads. A value
+        less than 1 uses one thread per processor. The default is 1. */
+    void setNumThreads(int numThreads) {
+        _numThreads = numThreads;
+    }
+
+    int getNumThreads() const {
+        return _numThreads;
+    }
+
+    /** Same as read() but with the settings of this adapter: the location
+        in which forces are expressed, the markers and force plates to read,
+        and the number of threads.
+
+        <b>C++ example</b>
+        \code{.cpp}
+        C3DFileAdapter c3d{};
+        c3d.setMarkersToRead({"R.ASIS", "L.ASIS", "R.Heel", "L.Heel"});
+        c3d.setForcePlatesToRead({1, 2});
+        c3d.setNumThreads(0);
+        auto tables = c3d.readTables("myData.c3d");
+        \endcode
+        */
+    Tables readTables(const std::string& fileName) const;
     
     /** Read in a C3D file into separate markers and forces tables of type
         TimeSeriesTableVec3. The markers table has each column labeled by its
@@ -129,6 +182,9 @@ private:
     static const std::unordered_map<std::string, std::size_t> _unit_index;
 
     ForceLocation _location{ ForceLocation::OriginOfForcePlate };
+    std::vector<std::string> _markersToRead{};
+    std::vector<int> _forcePlatesToRead{};
+    int _numThreads{1};
 
 };
 
@@ -27,6 +27,7 @@
 #include "OpenSim/Common/IO.h"
 #include "XMLDocument.h"
 #include <unordered_map>
+#include <mutex>
 #include <set>
 #include <regex>
 
@@ -79,29 +80,65 @@ public:
     {   return this->getValueZero(); }
 
     void realizeMeasureTopologyVirtual(SimTK::State& s) const override final
-    {   _Component.extendRealizeTopology(s); }
+    {
+        ComponentProfiler::Scope scope(_Component.getProfiler(), _Component,
+                                       ComponentProfiler::RealizeTopology);
+        _Component.extendRealizeTopology(s);
+    }
     void realizeMeasureModelVirtual(SimTK::State& s) const override final
-    {   _Component.extendRealizeModel(s); }
+    {
+        ComponentProfiler::Scope scope(_Component.getProfiler(), _Component,
+                                       ComponentProfiler::RealizeModel);
+        _Component.extendRealizeModel(s);
+    }
     void realizeMeasureInstanceVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeInstance(s); }
+    {
+        ComponentProfiler::Scope scope(_Component.getProfiler(), _Component,
+                                       ComponentProfiler::RealizeInstance);
+        _Component.extendRealizeInstance(s);
+    }
     void realizeMeasureTimeVirtual(const SimTK::State& s) const override final
-    {   _Component.extendRealizeTime(s); }
+    {
+        ComponentProfiler::Scope scope(_Component.getProfiler(), _Component,
+                                       ComponentProfiler::RealizeTime);
+        _Component.extendRealizeTime(s);
+    }
     void realizeMeasurePositionVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizePosition(s); }
+    {
+        ComponentProfiler::Scope scope(_Component.getProfiler(), _Component,
+                                       ComponentProfiler::RealizePosition);
+        _Component.extendRealizePosition(s);
+    }
     void realizeMeasureVelocityVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeVelocity(s); }
+    {
+        ComponentProfiler::Scope scope(_Component.getProfiler(), _Component,
+                                       ComponentProfiler::RealizeVelocity);
+        _Component.extendRealizeVelocity(s);
+    }
     void realizeMeasureDynamicsVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeDynamics(s); }
+    {
+        ComponentProfiler::Scope scope(_Component.getProfiler(), _Component,
+                                       ComponentProfiler::RealizeDynamics);
+        _Component.extendRealizeDynamics(s);
+    }
     void realizeMeasureAccelerationVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeAcceleration(s); }
+    {
+        ComponentProfiler::Scope scope(_Component.getProfiler(), _Component,
+                                       ComponentProfiler::RealizeAcceleration);
+        _Component.extendRealizeAcceleration(s);
+    }
     void realizeMeasureReportVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeReport(s); }
+    {
+        ComponentProfiler::Scope scope(_Component.getProfiler(), _Component,
+                                       ComponentProfiler::RealizeReport);
+        _Component.extendRealizeReport(s);
+    }
 
 private:
     const Component& _Component;
@@ -411,6 +448,11 @@ void Component::baseAddToSystem(SimTK::MultibodySystem& system) const
     // making realize() calls, and add it to the system's default subsystem. 
     ComponentMeasure<double> mcMeasure(system.updDefaultSubsystem(), *this);
     mutableThis->_simTKcomponentIndex = mcMeasure.getSubsystemMeasureIndex();
+
+    // Remember the property values the System is built from, so that later
+    // edits can be detected by updateSystemFromProperties(), if any of them
+    // can be applied in place.
+    mutableThis->snapshotProperties();
 }
 
 void Component::componentsAddToSystem(SimTK::MultibodySystem& system) const
@@ -471,6 +513,100 @@ void Component::componentsSetPropertiesFromState(const SimTK::State& state)
         _adoptedSubcomponents[i]->setPropertiesFromState(state);
 }
 
+bool Component::updateSystemFromProperties()
+{
+    if (!hasSystem())
+        return false;
+
+    // Find the changes to all the components before applying any of them, so
+    // that nothing is modified if the System must be rebuilt.
+    std::vector<const Component*> components(1, this);
+    const auto subcomponents = getFlattenedSubcomponents<Component>();
+    components.insert(components.end(),
+            subcomponents->begin(), subcomponents->end());
+
+    std::vector<std::pair<Component*, std::vector<std::string>>> changes;
+    for (const Component* comp : components) {
+        // A component added after the System was built requires a rebuild.
+        if (!comp->hasSystem() || &comp->getSystem() != &getSystem())
+            return false;
+        if (comp->isObjectUpToDateWithProperties())
+            continue;
+
+        std::vector<std::string> changed;
+        if (!comp->findChangedProperties(changed))
+            return false;
+        for (const auto& name : changed) {
+            if (!comp->canUpdateSystemForProperty(name))
+                return false;
+        }
+        changes.emplace_back(const_cast<Component*>(comp), changed);
+    }
+
+    for (auto& change : changes) {
+        Component& comp = *change.first;
+        if (!change.second.empty()) {
+            comp.extendUpdateSystemFromProperties(change.second);
+            comp.snapshotProperties();
+        }
+        comp.setObjectIsUpToDateWithProperties();
+    }
+    return true;
+}
+
+void Component::snapshotProperties()
+{
+    _propertySnapshots.clear();
+    // Only components with a property that can be updated in place need a
+    // snapshot. Without one, any edit to this component's properties causes
+    // the System to be rebuilt (see findChangedProperties()), so the
+    // properties of most components are never copied.
+    bool canUpdateAny = false;
+    for (int i = 0; i < getNumProperties() && !canUpdateAny; ++i)
+        canUpdateAny = canUpdateSystemForProperty(
+                getPropertyByIndex(i).getName());
+    if (!canUpdateAny)
+        return;
+
+    for (int i = 0; i < getNumProperties(); ++i) {
+        const AbstractProperty& prop = getPropertyByIndex(i);
+        PropertySnapshot snapshot;
+        if (prop.isObjectProperty() && !prop.empty() &&
+                dynamic_cast<const Component*>(&prop.getValueAsObject(0))) {
+            for (int j = 0; j < prop.size(); ++j)
+                snapshot.components.push_back(&prop.getValueAsObject(j));
+        }
+        else {
+            snapshot.value.reset(prop.clone());
+        }
+        _propertySnapshots.push_back(snapshot);
+    }
+}
+
+bool Component::findChangedProperties(std::vector<std::string>& changed) const
+{
+    if (int(_propertySnapshots.size()) != getNumProperties())
+        return false;
+
+    for (int i = 0; i < getNumProperties(); ++i) {
+        const AbstractProperty& prop = getPropertyByIndex(i);
+        const PropertySnapshot& snapshot = _propertySnapshots[i];
+        bool same;
+        if (snapshot.value) {
+            same = prop == *snapshot.value;
+        }
+        else {
+            same = prop.isObjectProperty() &&
+                    prop.size() == int(snapshot.components.size());
+            for (int j = 0; same && j < prop.size(); ++j)
+                same = &prop.getValueAsObject(j) == snapshot.components[j];
+        }
+        if (!same)
+            changed.push_back(prop.getName());
+    }
+    return true;
+}
+
 // Base class implementation of virtual method. Note that we're not handling
 // subcomponents here; this method gets called from extendRealizeAcceleration()
 // which will be invoked for each (sub) component by its own ComponentMeasure.
@@ -738,6 +874,15 @@ const Component::StateVariable* Component::
     // Must have already called initSystem.
     OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
 
+    // A path with slashes that was resolved before.
+    {
+        std::lock_guard<CachesMutex> lock(_subcomponentCachesMutex);
+        auto it = _resolvedStateVariablePaths.find(pathName);
+        if (it != _resolvedStateVariablePaths.end() &&
+                isStillResolved(it->second))
+            return it->second.stateVariable;
+    }
+
     ComponentPath svPath(pathName);
 
     const StateVariable* found = nullptr;
@@ -754,6 +899,12 @@ const Component::StateVariable* Component::
             // This is the leaf of the path:
             const auto& varName = svPath.getComponentName();
             found = comp->traverseToStateVariable(varName);
+            ResolvedPath resolved;
+            if (found && makeResolvedPath(compPath, *comp, resolved)) {
+                resolved.stateVariable = found;
+                std::lock_guard<CachesMutex> lock(_subcomponentCachesMutex);
+                _resolvedStateVariablePaths[pathName] = std::move(resolved);
+            }
         }
     }
     return found;
@@ -859,7 +1010,11 @@ double Component::
     // Must have already called initSystem.
     OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
 
-    computeStateVariableDerivatives(state);
+    {
+        ComponentProfiler::Scope scope(getProfiler(), *this,
+                ComponentProfiler::ComputeStateVariableDerivatives);
+        computeStateVariableDerivatives(state);
+    }
     
     std::map<std::string, StateVariableInfo>::const_iterator it;
     it = _namedStateVariableInfo.find(name);
@@ -991,6 +1146,33 @@ void Component::
     }
 }
 
+// Get the indices in the state's Y vector of the values of all the state
+// variables allocated by this Component, including its subcomponents.
+std::vector<SimTK::SystemYIndex> Component::
+    getStateVariableSystemIndices(const SimTK::State& state) const
+{
+    // Must have already called initSystem.
+    OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
+
+    int nsv = getNumStateVariables();
+    // if the StateVariables are invalid (see above) rebuild the list
+    if (!isAllStatesVariablesListValid()) {
+        _statesAssociatedSystem.reset(&getSystem());
+        _allStateVariables.clear();
+        _allStateVariables.resize(nsv);
+        Array<std::string> names = getStateVariableNames();
+        for (int i = 0; i < nsv; ++i)
+            _allStateVariables[i].reset(traverseToStateVariable(names[i]));
+    }
+
+    std::vector<SimTK::SystemYIndex> indices(nsv);
+    for (int i = 0; i < nsv; ++i) {
+        indices[i] = _allStateVariables[i]->calcSystemYIndex(state);
+    }
+
+    return indices;
+}
+
 // Set the derivative of a state variable computed by this Component by name.
 void Component::
     setStateVariableDerivativeValue(const State& state, 
@@ -1062,6 +1244,15 @@ setDiscreteVariableValue(SimTK::State& s, const std::string& name, double value)
     }
 }
 
+Array<std::string> Component::
+getDiscreteVariableNamesAddedByComponent() const
+{
+    Array<std::string> names;
+    for (const auto& it : _namedDiscreteVariableInfo)
+        names.append(it.first);
+    return names;
+}
+
 bool Component::constructOutputForStateVariable(const std::string& name)
 {
     auto func = [name](const Component* comp,
@@ -1083,6 +1274,18 @@ void Component::setNextSubcomponentInSystem(const Component& sub) const
     }
 }
 
+void Component::setProfiler(ComponentProfiler* profiler)
+{
+    _profiler.reset(profiler);
+    for (auto& it : _outputsTable)
+        it.second.upd()->_profiler.reset(profiler);
+    // The list of subcomponents is only valid once finalized. The profiler is
+    // not a property, so setting it does not require finalizing again.
+    if (!isObjectUpToDateWithProperties()) return;
+    for (auto& sub : getImmediateSubcomponents())
+        const_cast<Component&>(sub.getRef()).setProfiler(profiler);
+}
+
 void Component::updateFromXMLNode(SimTK::Xml::Element& node, int versionNumber)
 {
     if (versionNumber < XMLDocument::getLatestVersion()) {
@@ -1173,6 +1376,7 @@ void Component::markPropertiesAsSubcomponents()
     // or the properties have been modified. In the latter case
     // we must make sure that pointers to old properties are cleared
     _propertySubcomponents.clear();
+    clearSubcomponentCaches();
 
     // Now mark properties that are Components as subcomponents
     //loop over all its properties
@@ -1262,6 +1466,7 @@ void Component::adoptSubcomponent(Component* subcomponent)
 
     subcomponent->setOwner(*this);
     _adoptedSubcomponents.push_back(SimTK::ClonePtr<Component>(subcomponent));
+    clearSubcomponentCaches();
 }
 
 std::vector<SimTK::ReferencePtr<const Component>> 
@@ -1469,7 +1674,11 @@ void Component::extendRealizeAcceleration(const SimTK::State& s) const
         const SimTK::Subsystem& subSys = getDefaultSubsystem();
 
         // evaluate and set component state derivative values (in cache) 
-        computeStateVariableDerivatives(s);
+        {
+            ComponentProfiler::Scope scope(getProfiler(), *this,
+                    ComponentProfiler::ComputeStateVariableDerivatives);
+            computeStateVariableDerivatives(s);
+        }
     
         std::map<std::string, StateVariableInfo>::const_iterator it;
 
@@ -1560,6 +1769,19 @@ void Component::AddedStateVariable::
     return getOwner().setCacheVariableValue<double>(state, getName()+"_deriv", deriv);
 }
 
+SimTK::SystemYIndex Component::AddedStateVariable::
+    calcSystemYIndex(const SimTK::State& state) const
+{
+    ZIndex zix(getVarIndex());
+    if (!getSubsysIndex().isValid() || !zix.isValid())
+        return SimTK::SystemYIndex();
+
+    // Z follows Q and U in Y; the subsystem's z's are a contiguous block.
+    return SimTK::SystemYIndex(int(state.getZStart())
+                               + int(state.getZStart(getSubsysIndex()))
+                               + int(zix));
+}
+
 
 void Component::printSocketInfo() const {
     std::cout << "Sockets for component " << getName() << " of type ["
@@ -1674,84 +1896,119 @@ void Component::printOutputInfo(const bool includeDescendants) const {
     }
 }
 
-void Component::initComponentTreeTraversal(const Component &root) const {
-    // Going down the tree, this node is followed by all its children.
-    // The last child's successor (next) is the parent's successor.
+std::shared_ptr<const std::vector<const Component*>>
+Component::getFlattenedSubcomponents(const std::type_info& type,
+        bool (*isType)(const Component&)) const
+{
+    std::lock_guard<CachesMutex> lock(_subcomponentCachesMutex);
+    auto& components = _flattenedSubcomponents[std::type_index(type)];
+    if (!components) {
+        auto newComponents = std::make_shared<std::vector<const Component*>>();
+        appendSubcomponents(*newComponents, isType);
+        components = newComponents;
+    }
+    return components;
+}
 
-    const size_t nmsc = _memberSubcomponents.size();
-    const size_t npsc = _propertySubcomponents.size();
-    const size_t nasc = _adoptedSubcomponents.size();
+void Component::appendSubcomponents(std::vector<const Component*>& components,
+        bool (*isType)(const Component&)) const
+{
+    // Going down the tree, this node is followed by all its children.
+    auto append = [&](const Component& sub) {
+        // If the subcomponent has no owner, we likely failed to call
+        // finalizeFromProperties() on the root.
+        OPENSIM_THROW_IF(!sub.hasOwner(), ComponentIsAnOrphan,
+                sub.getName(), sub.getConcreteClassName());
+        if (isType(sub))
+            components.push_back(&sub);
+        sub.appendSubcomponents(components, isType);
+    };
+    for (auto& comp : _memberSubcomponents)
+        append(*comp);
+    for (auto& comp : _propertySubcomponents)
+        append(*comp);
+    for (auto& comp : _adoptedSubcomponents)
+        append(*comp);
+}
 
-    if (!hasOwner()) {
-        // If this isn't the root component and it has no owner, then
-        // this is an orphan component and we likely failed to call 
-        // finalizeFromProperties() on the root OR this is a clone that
-        // has not been added to the root (in which case would have an owner).
-        if (this != &root) {
-            OPENSIM_THROW(ComponentIsAnOrphan, getName(),
-                getConcreteClassName());
-        }
-        // if the root (have no owner) and have no components
-        else if (!(nmsc + npsc + nasc)) {
-            OPENSIM_THROW(ComponentIsRootWithNoSubcomponents,
-                getName(), getConcreteClassName());
-        }
+void Component::clearSubcomponentCaches()
+{
+    // The caches of all owners contain the subcomponents of this Component.
+    for (const Component* comp = this; comp != nullptr;
+            comp = comp->_owner.get()) {
+        std::lock_guard<CachesMutex> lock(comp->_subcomponentCachesMutex);
+        comp->_flattenedSubcomponents.clear();
+        comp->_resolvedPaths.clear();
+        comp->_resolvedStateVariablePaths.clear();
     }
+}
 
-    const Component* last = nullptr;
-    for (unsigned int i = 0; i < nmsc; i++) {
-        if (i == nmsc - 1) {
-            _memberSubcomponents[i]->_nextComponent = _nextComponent.get();
-            last = _memberSubcomponents[i].get();
-        }
-        else {
-            _memberSubcomponents[i]->_nextComponent =
-                _memberSubcomponents[i + 1].get();
-            last = _memberSubcomponents[i + 1].get();
-        }
+const Component* Component::resolvePath(const std::string& pathName) const
+{
+    {
+        std::lock_guard<CachesMutex> lock(_subcomponentCachesMutex);
+        auto it = _resolvedPaths.find(pathName);
+        if (it != _resolvedPaths.end() && isStillResolved(it->second))
+            return it->second.component;
     }
-    if (npsc) {
-        if (last)
-            last->_nextComponent = _propertySubcomponents[0].get();
 
-        for (unsigned int i = 0; i < npsc; i++) {
-            if (i == npsc - 1) {
-                _propertySubcomponents[i]->_nextComponent =
-                    _nextComponent.get();
-                last = _propertySubcomponents[i].get();
-            }
-            else {
-                _propertySubcomponents[i]->_nextComponent =
-                    _propertySubcomponents[i + 1].get();
-                last = _propertySubcomponents[i + 1].get();
-            }
-        }
+    ComponentPath path(pathName);
+    const Component* comp = traversePathToComponent<Component>(path);
+    ResolvedPath resolved;
+    if (comp && makeResolvedPath(path, *comp, resolved)) {
+        std::lock_guard<CachesMutex> lock(_subcomponentCachesMutex);
+        _resolvedPaths[pathName] = std::move(resolved);
     }
-    if (nasc) {
-        if (last)
-            last->_nextComponent = _adoptedSubcomponents[0].get();
+    return comp;
+}
 
-        for (unsigned int i = 0; i <nasc; i++) {
-            if (i == nasc - 1) {
-                _adoptedSubcomponents[i]->_nextComponent = _nextComponent.get();
-            }
-            else {
-                _adoptedSubcomponents[i]->_nextComponent
-                    = _adoptedSubcomponents[i + 1].get();
-            }
+bool Component::makeResolvedPath(ComponentPath path, const Component& comp,
+        ResolvedPath& resolved) const
+{
+    // Find the component from which traversePathToComponent() descended.
+    path.trimDotAndDotDotElements();
+    const Component* start = this;
+    if (path.isAbsolute()) {
+        resolved.numUp = -1;
+        while (start->hasOwner()) start = &start->getOwner();
+        resolved.rootName = start->getName();
+    } else {
+        resolved.numUp = 0;
+        while (size_t(resolved.numUp) < path.getNumPathLevels() &&
+                path.getSubcomponentNameAtLevel(resolved.numUp) == "..") {
+            if (!start->hasOwner()) return false;
+            start = &start->getOwner();
+            ++resolved.numUp;
         }
     }
 
-    // recurse to handle children of subcomponents
-    for (unsigned int i = 0; i < nmsc; ++i) {
-        _memberSubcomponents[i]->initComponentTreeTraversal(root);
+    resolved.component = &comp;
+    resolved.names.clear();
+    for (const Component* node = &comp; node != start;
+            node = &node->getOwner()) {
+        if (!node->hasOwner()) return false;
+        resolved.names.push_back(node->getName());
     }
-    for (unsigned int i = 0; i < npsc; ++i) {
-        _propertySubcomponents[i]->initComponentTreeTraversal(root);
+    return true;
+}
+
+bool Component::isStillResolved(const ResolvedPath& resolved) const
+{
+    // Walk up from the component, checking the names along the path.
+    const Component* node = resolved.component;
+    for (const auto& name : resolved.names) {
+        if (node->getName() != name || !node->hasOwner()) return false;
+        node = &node->getOwner();
     }
-    for (unsigned int i = 0; i < nasc; ++i) {
-        _adoptedSubcomponents[i]->initComponentTreeTraversal(root);
+    if (resolved.numUp < 0)
+        return !node->hasOwner() && node->getName() == resolved.rootName;
+
+    const Component* start = this;
+    for (int i = 0; i < resolved.numUp; ++i) {
+        if (!start->hasOwner()) return false;
+        start = &start->getOwner();
     }
+    return node == start;
 }
 
 
@@ -1761,6 +2018,8 @@ void Component::clearStateAllocations()
     _namedStateVariableInfo.clear();
     _namedDiscreteVariableInfo.clear();
     _namedCacheVariableInfo.clear();
+    // Resolved state variable paths may refer to the cleared variables.
+    clearSubcomponentCaches();
 }
 
 void Component::reset()
@@ -50,6 +50,9 @@
 #include "ComponentList.h"
 #include "ComponentPath.h"
 #include <functional>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
 
 #include "simbody/internal/MultibodySystem.h"
 
@@ -472,6 +475,17 @@ public:
     /** %Set Component's properties given a state. */
     void setPropertiesFromState(const SimTK::State& state);
 
+    /** Apply the changes made to the properties of this Component and of its
+        subcomponents since they were added to the System (see addToSystem())
+        to that System, without rebuilding it. This is possible only if every
+        changed property can be updated in place (see
+        canUpdateSystemForProperty()). Otherwise, nothing is applied and false
+        is returned; the System must then be rebuilt (e.g., by
+        Model::initSystem()). Since the System's topology is unchanged, States
+        need only be reinitialized from the Model stage (see
+        Model::updateSystem()). */
+    bool updateSystemFromProperties();
+
     // End of Component Structural Interface (public non-virtual).
     ///@} 
 
@@ -557,6 +571,12 @@ public:
     * Component has not added itself to the System.  */
     bool hasSystem() const { return !_system.empty(); }
 
+    /**
+    * The profiler that records the computations of this Component, or
+    * nullptr if this Component is not being profiled.
+    * @see Model::setProfilingEnabled()  */
+    ComponentProfiler* getProfiler() const { return _profiler.get(); }
+
     /**
     * Add a Component (as a subcomponent) of this component.
     * This component takes ownership of the subcomponent and it will be
@@ -605,13 +625,20 @@ public:
      * The returned ComponentList does not permit modifying any components; if
      * you want to modify the components, see updComponentList().
      *
+     * The components of each type T are gathered into an array the first time
+     * they are iterated over, and the array is reused until a subcomponent is
+     * added anywhere in the tree (e.g., by finalizeFromProperties()), so
+     * iterating in per-frame code does not traverse the tree.
+     *
      * @tparam T A subclass of Component (e.g., Body, Muscle).
      */
     template <typename T = Component>
     ComponentList<const T> getComponentList() const {
         static_assert(std::is_base_of<Component, T>::value,
                 "Template argument must be Component or a derived class.");
-        initComponentTreeTraversal(*this);
+        OPENSIM_THROW_IF(!hasOwner() && getNumImmediateSubcomponents() == 0,
+                ComponentIsRootWithNoSubcomponents,
+                getName(), getConcreteClassName());
         return ComponentList<const T>(*this);
     }
     
@@ -634,7 +661,9 @@ public:
     ComponentList<T> updComponentList() {
         static_assert(std::is_base_of<Component, T>::value,
                 "Template argument must be Component or a derived class.");
-        initComponentTreeTraversal(*this);
+        OPENSIM_THROW_IF(!hasOwner() && getNumImmediateSubcomponents() == 0,
+                ComponentIsRootWithNoSubcomponents,
+                getName(), getConcreteClassName());
         clearObjectIsUpToDateWithProperties();
         return ComponentList<T>(*this);
     }
@@ -647,14 +676,12 @@ public:
      */
     template <typename T = Component>
     unsigned countNumComponents() const {
-        unsigned count = 0u;
-        const auto compList = getComponentList<T>();
-        auto it = compList.begin();
-        while (it != compList.end()) {
-            ++count;
-            ++it;
-        }
-        return count;
+        static_assert(std::is_base_of<Component, T>::value,
+                "Template argument must be Component or a derived class.");
+        OPENSIM_THROW_IF(!hasOwner() && getNumImmediateSubcomponents() == 0,
+                ComponentIsRootWithNoSubcomponents,
+                getName(), getConcreteClassName());
+        return unsigned(getFlattenedSubcomponents<T>()->size());
     }
 
     /** Class that permits iterating over components/subcomponents (but does
@@ -732,28 +759,32 @@ public:
      * This template function cannot be used in Python/Java/MATLAB; see the
      * non-templatized getComponent().
      *
+     * The component found at each path is remembered, so that getting it
+     * again (e.g., every frame in a reporter or a script) does not search
+     * the tree, until a subcomponent is added anywhere in the tree.
+     *
      * @param  pathname        a pathname of a Component of interest
      * @return const reference to component of type C at 
      * @throws ComponentNotFoundOnSpecifiedPath if no component exists
      */
     template <class C = Component>
     const C& getComponent(const std::string& pathname) const {
-        return getComponent<C>(ComponentPath(pathname));
-    }
-    template <class C = Component>
-    const C& getComponent(const ComponentPath& pathname) const {
         static_assert(std::is_base_of<Component, C>::value, 
             "Template parameter 'CompType' must be derived from Component.");
 
-        const C* comp = this->template traversePathToComponent<C>(pathname);
+        const C* comp = dynamic_cast<const C*>(resolvePath(pathname));
         if (comp) {
             return *comp;
         }
 
         // Only error cases remain
-        OPENSIM_THROW(ComponentNotFoundOnSpecifiedPath, pathname.toString(),
-                                                       C::getClassName(),
-                                                       getName());
+        OPENSIM_THROW(ComponentNotFoundOnSpecifiedPath,
+                      ComponentPath(pathname).toString(), C::getClassName(),
+                      getName());
+    }
+    template <class C = Component>
+    const C& getComponent(const ComponentPath& pathname) const {
+        return getComponent<C>(pathname.toString());
     }
 
     /** Similar to the templatized getComponent(), except this returns the
@@ -789,12 +820,12 @@ public:
     */
     template <class C = Component>
     C& updComponent(const std::string& name) {
-        return updComponent<C>(ComponentPath(name));
+        clearObjectIsUpToDateWithProperties();
+        return *const_cast<C*>(&(this->template getComponent<C>(name)));
     }
     template <class C = Component>
     C& updComponent(const ComponentPath& name) {
-        clearObjectIsUpToDateWithProperties();
-        return *const_cast<C*>(&(this->template getComponent<C>(name)));
+        return updComponent<C>(name.toString());
     }
 
     /** Similar to the templatized updComponent(), except this returns the
@@ -1323,6 +1354,25 @@ public:
     void setStateVariableValues(SimTK::State& state,
                                 const SimTK::Vector& values) const;
 
+    /**
+     * Get the indices in the Y vector of the State (see SimTK::State::getY())
+     * at which the values of the state variables allocated by this Component
+     * and its subcomponents are stored. Code that sets many States from
+     * stored values (e.g., to replay a trajectory) can use these indices to
+     * write all the values into State::updY() at once, rather than calling
+     * setStateVariableValues(). Unlike setStateVariableValues(), this does not
+     * skip the values of locked Coordinates. An index is invalid if the
+     * state variable's value is not stored directly in Y.
+     *
+     * @param state   a State realized to at least SimTK::Stage::Model
+     * @return indices of length getNumStateVariables() in the order returned
+     *         by getStateVariableNames()
+     * @throws ComponentHasNoSystem if this Component has not been added to a
+     *         System (i.e., if initSystem has not been called)
+     */
+    std::vector<SimTK::SystemYIndex>
+        getStateVariableSystemIndices(const SimTK::State& state) const;
+
     /**
      * Get the value of a state variable derivative computed by this Component.
      *
@@ -1358,6 +1408,14 @@ public:
     void setDiscreteVariableValue(SimTK::State& state, const std::string& name,
                                   double value) const;
 
+    /**
+     * Get the names of the discrete variables allocated by this Component
+     * with addDiscreteVariable(). The discrete variables of subcomponents are
+     * not included. These are the names accepted by getDiscreteVariableValue()
+     * and setDiscreteVariableValue().
+     */
+    Array<std::string> getDiscreteVariableNamesAddedByComponent() const;
+
     /**
      * Get the value of a cache variable allocated by this Component by name.
      *
@@ -1658,6 +1716,7 @@ protected:
         component->setName(name);
         component->setOwner(*this);
         _memberSubcomponents.push_back(SimTK::ClonePtr<Component>(component));
+        clearSubcomponentCaches();
         return MemberSubcomponentIndex(_memberSubcomponents.size()-1);
     }
     template<class C = Component>
@@ -1800,17 +1859,30 @@ protected:
     @endcode   */
     virtual void extendConnect(Component& root) {};
 
-    /** Build the tree of Components from this component through its descendants.
-    This method is invoked whenever a ComponentList<C> is requested. Note that
-    all components must have been added to the model (or its subcomponents),
-    otherwise it will not be included in the tree and will not be found for
-    iteration or for connection. The implementation populates the _nextComponent
-    ReferencePtr with a pointer to the next Component in tree pre-order traversal.
-    
-    @throws ComponentIsRootWithNoSubcomponents if the Component is the root and 
-            yet has no subcomponents.
-    */
-    void initComponentTreeTraversal(const Component &root) const;
+    /** Get the descendants of this Component that are of type T, in tree
+    pre-order traversal. This is the array through which a ComponentList<T>
+    iterates. It is built the first time it is requested and reused until
+    clearSubcomponentCaches() is invoked on this Component or one of its
+    descendants. Note that all components must have been added to the model
+    (or its subcomponents), otherwise they will not be included in the tree
+    and will not be found for iteration or for connection.
+
+    @throws ComponentIsAnOrphan if a subcomponent has no owner. */
+    template <typename T>
+    std::shared_ptr<const std::vector<const Component*>>
+    getFlattenedSubcomponents() const {
+        return getFlattenedSubcomponents(typeid(T),
+                [](const Component& comp) {
+                    return dynamic_cast<const T*>(&comp) != nullptr;
+                });
+    }
+
+    /** Discard the arrays of descendants (see getFlattenedSubcomponents())
+    and the resolved paths (see getComponent()) of this Component and of its
+    owners, because a subcomponent was added to or removed from this
+    Component. This is invoked whenever the subcomponents of a Component
+    change (e.g., by finalizeFromProperties()). */
+    void clearSubcomponentCaches();
 
     ///@cond
     /** Opportunity to remove connection-related information. 
@@ -1935,6 +2007,47 @@ protected:
     @see extendInitStateFromProperties() **/
     virtual void extendSetPropertiesFromState(const SimTK::State& state) {};
 
+    /** Return true if a change to the value of the property with the given
+    name can be applied to the System this component has already been added
+    to, without rebuilding the System (see updateSystemFromProperties()).
+    This is the case for properties that are only used once the State has been
+    initialized, e.g., to compute forces or positions. A change to any other
+    property, which is the default, causes the System to be rebuilt. Only
+    this component is notified of the change (see
+    extendUpdateSystemFromProperties()), so do not list properties that other
+    components read when they are connected, e.g., a Muscle's
+    max_isometric_force, which metabolic probes cache.
+
+    If you override this method, be sure to defer to the base class for the
+    properties your component does not handle, using code like this:
+    @code
+    bool MyComponent::canUpdateSystemForProperty(
+            const std::string& name) const {
+        return name == "my_gain" || Super::canUpdateSystemForProperty(name);
+    }
+    @endcode **/
+    virtual bool canUpdateSystemForProperty(const std::string& name) const
+    {   return false; }
+
+    /** Update any data members of this component that were computed from the
+    properties with the given names, whose values changed after the component
+    was added to the System. Only properties for which
+    canUpdateSystemForProperty() returns true are passed.
+
+    If you override this method, be sure to invoke the base class method first,
+    using code like this:
+    @code
+    void MyComponent::extendUpdateSystemFromProperties(
+            const std::vector<std::string>& changedProperties) {
+        Super::extendUpdateSystemFromProperties(changedProperties);
+        // ... your code goes here
+    }
+    @endcode
+
+    @see updateSystemFromProperties() **/
+    virtual void extendUpdateSystemFromProperties(
+            const std::vector<std::string>& changedProperties) {};
+
     /** If a model component has allocated any continuous state variables
     using the addStateVariable() method, then %computeStateVariableDerivatives()
     must be implemented to provide time derivatives for those states.
@@ -2652,6 +2765,52 @@ private:
     // and cache variable allocated by this Component
     void clearStateAllocations();
 
+    // A path resolved by resolvePath() or traverseToStateVariable(), with
+    // what is needed to check that the path still leads to the same
+    // component.
+    struct ResolvedPath {
+        const Component* component = nullptr;
+        // The state variable at the path, for traverseToStateVariable().
+        const StateVariable* stateVariable = nullptr;
+        // Number of ".." at the start of a relative path, or -1 if the path
+        // is absolute.
+        int numUp = 0;
+        // Name of the root, for an absolute path.
+        std::string rootName;
+        // Names of the component and of its owners, up to (excluding) the
+        // component from which the path starts.
+        std::vector<std::string> names;
+    };
+
+    // Same as traversePathToComponent<Component>(ComponentPath(pathName)),
+    // but the result is remembered until clearSubcomponentCaches() is
+    // invoked.
+    const Component* resolvePath(const std::string& pathName) const;
+    // Describe how path (which was traversed from this Component) leads to
+    // comp. Returns false if comp is not below the start of the path.
+    bool makeResolvedPath(ComponentPath path, const Component& comp,
+            ResolvedPath& resolved) const;
+    // Whether the path still leads from this Component to the same component
+    // (i.e., no component along the path was renamed).
+    bool isStillResolved(const ResolvedPath& resolved) const;
+
+    // Type-erased implementation of getFlattenedSubcomponents<T>().
+    std::shared_ptr<const std::vector<const Component*>>
+    getFlattenedSubcomponents(const std::type_info& type,
+            bool (*isType)(const Component&)) const;
+    // Append the descendants of this Component for which isType() is true to
+    // the given array, in tree pre-order traversal.
+    void appendSubcomponents(std::vector<const Component*>& components,
+            bool (*isType)(const Component&)) const;
+
+    // Record the values of the properties of this Component, against which
+    // updateSystemFromProperties() finds the properties that changed. Nothing
+    // is recorded if none of the properties can be updated in place.
+    void snapshotProperties();
+    // Append the names of the properties whose values differ from the
+    // snapshot. Returns false if there is no snapshot to compare against.
+    bool findChangedProperties(std::vector<std::string>& changed) const;
+
     // Reset by clearing underlying system indices.
     void reset();
 
@@ -2706,6 +2865,14 @@ protected:
         // change the state
         virtual void setDerivative(const SimTK::State& state, double deriv) const = 0;
 
+        // Index of the state variable's value in the Y vector of the state
+        // (see SimTK::State::getY()), which is known once the state has been
+        // realized to Stage::Model. State variables whose values are not
+        // stored directly in Y return an invalid index.
+        virtual SimTK::SystemYIndex
+            calcSystemYIndex(const SimTK::State& state) const
+        {   return SimTK::SystemYIndex(); }
+
     private:
         std::string name;
         SimTK::ReferencePtr<const Component> owner;
@@ -2754,6 +2921,15 @@ protected:
         _orderedSubcomponents.clear();
     }
 
+    /// Record the computations (realize(), computeForce(), Outputs, ...) of
+    /// this Component and all of its subcomponents with the given profiler,
+    /// or stop recording them if the profiler is nullptr. Subcomponents are
+    /// only affected if this Component is up to date with its properties
+    /// (i.e., finalized). The profiler must outlive the recording;
+    /// Model::setProfilingEnabled() manages this for the components of a
+    /// Model.
+    void setProfiler(ComponentProfiler* profiler);
+
     /// Handle a change in XML syntax for Sockets.
     void updateFromXMLNode(SimTK::Xml::Element& node, int versionNumber)
             override;
@@ -2764,12 +2940,54 @@ private:
     // one.
     SimTK::ReferencePtr<const Component> _owner;
 
-    // Reference pointer to the successor of the current Component in Pre-order traversal
-    mutable SimTK::ReferencePtr<const Component> _nextComponent;
+    // Arrays of the descendants of each type that has been iterated over
+    // (see getFlattenedSubcomponents()), indexed by the type. They are not
+    // copied, since they refer to the components of this tree.
+    mutable SimTK::ResetOnCopy<std::map<std::type_index,
+            std::shared_ptr<const std::vector<const Component*>>>>
+        _flattenedSubcomponents;
+    // The paths resolved by resolvePath() and traverseToStateVariable(),
+    // indexed by the path strings.
+    mutable SimTK::ResetOnCopy<std::unordered_map<std::string, ResolvedPath>>
+        _resolvedPaths;
+    mutable SimTK::ResetOnCopy<std::unordered_map<std::string, ResolvedPath>>
+        _resolvedStateVariablePaths;
+
+    // A mutex that is not copied, since each copy of a Component has its own
+    // caches.
+    class CachesMutex {
+    public:
+        CachesMutex() = default;
+        CachesMutex(const CachesMutex&) {}
+        CachesMutex& operator=(const CachesMutex&) { return *this; }
+        void lock() { _mutex.lock(); }
+        void unlock() { _mutex.unlock(); }
+    private:
+        std::mutex _mutex;
+    };
+    // Guards the three caches above, which are built lazily, possibly on
+    // multiple threads. Each Component has its own, so that threads that use
+    // different Models (or different parts of a Model) do not wait for each
+    // other.
+    mutable CachesMutex _subcomponentCachesMutex;
+
+    // The value of a property when this Component was added to the System
+    // (see snapshotProperties()). The values of properties that hold
+    // (sub)components are compared by identity only, since the subcomponents
+    // track changes to their own properties.
+    struct PropertySnapshot {
+        std::shared_ptr<const AbstractProperty> value;
+        std::vector<const Object*> components;
+    };
+    SimTK::ResetOnCopy<std::vector<PropertySnapshot>> _propertySnapshots;
 
     // Reference pointer to the system that this component belongs to.
     SimTK::ReferencePtr<SimTK::MultibodySystem> _system;
 
+    // Records the computations of this component when profiling is enabled.
+    // Not copied, so that a copy of a component is not profiled.
+    SimTK::ReferencePtr<ComponentProfiler> _profiler;
+
     // propertiesTable maintained by Object
 
     // Table of Component's structural Sockets indexed by name.
@@ -2847,6 +3065,9 @@ private:
         double getDerivative(const SimTK::State& state) const override;
         void setDerivative(const SimTK::State& state, double deriv) const override;
 
+        SimTK::SystemYIndex
+            calcSystemYIndex(const SimTK::State& state) const override;
+
         private: // DATA
         // Changes in state variables trigger recalculation of appropriate cache 
         // variables by automatically invalidating the realization stage specified
@@ -2944,6 +3165,14 @@ private:
 //==============================================================================
 //==============================================================================
     
+// Implement methods for ComponentList
+template <typename T>
+std::shared_ptr<const std::vector<const Component*>>
+ComponentList<T>::getComponents() const {
+    return _root.template getFlattenedSubcomponents<
+            typename std::remove_const<T>::type>();
+}
+
 // Implement methods for ComponentListIterator
 /// ComponentListIterator<T> pre-increment operator, advances the iterator to
 /// the next valid entry.
@@ -2951,53 +3180,27 @@ template <typename T>
 ComponentListIterator<T>& ComponentListIterator<T>::operator++() {
     if (_node==nullptr)
         return *this;
-    // If _node has children then successor is first child
-    // move _node to point to it
-    if (_node->_memberSubcomponents.size() > 0) {
-        _node = _node->_memberSubcomponents[0].get();
-    }
-    else if (_node->_propertySubcomponents.size() > 0) {
-        _node = _node->_propertySubcomponents[0].get();
-    }
-    else if (_node->_adoptedSubcomponents.size() > 0) {
-        _node = _node->_adoptedSubcomponents[0].get();
-    }
-    // If processing a subtree under _root we stop when our successor is the same
-    // as the successor of _root as this indicates we're leaving the _root's subtree.
-    else if (_node->_nextComponent.get() == _root->_nextComponent.get())
+    // The array is in tree pre-order and contains only components of type T.
+    if (++_index < _components->size())
+        _node = (*_components)[_index];
+    else
         _node = nullptr;
-    else // move on to the next component we computed earlier for the full tree
-        _node = _node->_nextComponent.get();
-    advanceToNextValidComponent(); // make sure we have a _node of type T after advancing
+    advanceToNextValidComponent(); // make sure _node matches the filter
     return *this;
 }
 
 /// Internal method to advance iterator to next valid component.
 template <typename T>
 void ComponentListIterator<T>::advanceToNextValidComponent() {
-    // Advance _node to next valid (of type T) if needed
-    // Similar logic to operator++ but applies _filter->isMatch()
-    while (_node != nullptr && (dynamic_cast<const T*>(_node) == nullptr || 
-                                !_filter.isMatch(*_node) || 
-                                (_node == _root))){
-        if (_node->_memberSubcomponents.size() > 0) {
-            _node = _node->_memberSubcomponents[0].get();
-        }
-        else if (_node->_propertySubcomponents.size() > 0) {
-            _node = _node->_propertySubcomponents[0].get();
-        }
-        else if (_node->_adoptedSubcomponents.size() > 0) {
-            _node = _node->_adoptedSubcomponents[0].get();
-        }
-        else {
-            if (_node->_nextComponent.get() == _root->_nextComponent.get()){ // end of subtree under _root
-                _node = nullptr;
-                continue;
-            }
-            _node = _node->_nextComponent.get();
-        }
+    // Advance _node to the next component that matches the filter, if any.
+    if (_filter == nullptr)
+        return;
+    while (_node != nullptr && !_filter->isMatch(*_node)) {
+        if (++_index < _components->size())
+            _node = (*_components)[_index];
+        else
+            _node = nullptr;
     }
-    return;
 }
 
 
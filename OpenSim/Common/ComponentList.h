@@ -26,8 +26,10 @@
 
 // INCLUDES
 #include <OpenSim/Common/osimCommonDLL.h>
+#include <memory>
 #include <string>
 #include <type_traits>
+#include <vector>
 #include "SimTKcommon/basics.h"
 
 namespace OpenSim {
@@ -96,17 +98,18 @@ private:
 
 
 /**
-Collection (linked list) of components to iterate through. Typical use is to
+Collection of components to iterate through. Typical use is to
 call getComponentList() on a component (e.g. model) to obtain an instance of 
 this class, then call begin() to get an
 iterator pointing to the first entry in the list then increment the iterator
 until end(). 
-The linked list is formed by tree pre-order traversal where each component is 
-visited followed by all its immediate subcomponents (recursively).
-@internal The traversal order is wired via
-    Component::initComponentTreeTraversal(), which is called just before
-    getting a ComponentList from a Component, either via
-    Component::getComponentList() or Component::updComponentList().
+The order of the list is that of tree pre-order traversal where each component
+is visited followed by all its immediate subcomponents (recursively).
+@internal The root Component keeps a flattened array of its descendants of
+    type T, which is built the first time begin() is called for that type and
+    is discarded when a subcomponent is added to the tree (see
+    Component::getFlattenedSubcomponents()). Iterating is then a walk through
+    the array, and the filter, if any, is the only per-component check.
 */
 template <typename T>
 class ComponentList {
@@ -137,7 +140,7 @@ public:
     construction and can only be changed using setFilter().
     */
     ComponentList(const Component& root, const ComponentFilter& f) : 
-        _root(root), _filter(f) {
+        _root(root), _filter(f), _matchAll(false) {
     }
     /** Constructor that takes only a Component to iterate over (itself and its
     descendants). ComponentFilterMatchAll is used internally. You can
@@ -153,23 +156,23 @@ public:
     to the ComponentList constructor. If T is non-const, then this iterator
     allows you to modify the elements of this list. */
     iterator begin() {
-        return iterator(&_root, _filter.getRef());
+        return iterator(getComponents(), getFilter());
     }
     /** Same as cbegin(). */
     const_iterator begin() const {
-        return const_iterator(&_root, _filter.getRef());
+        return const_iterator(getComponents(), getFilter());
     }
     /** Similar to begin(), except it does not permit
     modifying the elements of the list, even if T is non-const (e.g., 
     ComponentList<Body>). */
     const_iterator cbegin() const {
-        return const_iterator(&_root, _filter.getRef());
+        return const_iterator(getComponents(), getFilter());
     }
     /** Use this method to check if you have reached the end of the list.
     This points past the end of the list, *not* to the last item in the
     list. */
     iterator end() {
-        return iterator(nullptr, _filter.getRef());
+        return iterator(nullptr, getFilter());
     }
     /** Same as cend(). */
     const_iterator end() const { return cend(); }
@@ -177,19 +180,34 @@ public:
     This points past the end of the list, *not* to the last item in the
     list. Use this if you used cbegin(). */
     const_iterator cend() const {
-        return const_iterator(nullptr, _filter.getRef());
+        return const_iterator(nullptr, getFilter());
     }
     /** Allow users to specify a custom ComponentFilter. This object makes a
     clone of the passed in filter. */
     void setFilter(const ComponentFilter& filter) {
           _filter = filter;
+          _matchAll = false;
     }
 private:
     const Component& _root; // root of subtree to be iterated over
     SimTK::ClonePtr<ComponentFilter> _filter; // filter to choose components 
+    // True if the filter is the default ComponentFilterMatchAll, which the
+    // iterators then need not call.
+    bool _matchAll;
     // Internal method to setFilter to ComponentFilterMatchAll if no user specified
     // filter is provided.
-    void setDefaultFilter() { setFilter(ComponentFilterMatchAll()); }
+    void setDefaultFilter() {
+        setFilter(ComponentFilterMatchAll());
+        _matchAll = true;
+    }
+    // The filter for the iterators; nullptr if every component matches.
+    const ComponentFilter* getFilter() const {
+        return _matchAll ? nullptr : &_filter.getRef();
+    }
+    // The flattened array of the components of type T under _root. Defined
+    // in Component.h.
+    std::shared_ptr<const std::vector<const Component*>>
+        getComponents() const;
 };
 
 //==============================================================================
@@ -288,8 +306,10 @@ public:
     // The const cast is required for the case when T is not const. In the
     // case where T is const, it is okay that we do the const cast,
     // since the return type is still const.
+    // The components in the list are known to be of type T, so a static_cast
+    // suffices.
     T* operator->() const
-    { return const_cast<NonConstT*>(dynamic_cast<const T*>(_node)); }
+    { return const_cast<NonConstT*>(static_cast<ConstT*>(_node)); }
     
     /** Prefix increment operator to get the next item in the ComponentList.
      Prefer to use ++iter and not iter++. */
@@ -327,7 +347,8 @@ public:
     ComponentListIterator(const ComponentListIterator<FromT>& source,
         typename std::enable_if<std::is_convertible<FromT*, T*>::value>::type* = 0) :
         _node(source._node),
-        _root(source._root),
+        _components(source._components),
+        _index(source._index),
         _filter(source._filter)
     {/*No need to advanceToNextValid; was done when source was constructed.*/}
     
@@ -348,21 +369,27 @@ private:
     // advanceToNextValidComponent(), etc. So instead, we cast away the const
     // just before giving the node to the user (operator*() and operator->()).
     const Component* _node;
-    // Root of subtree of Components that we're iterating over.
-    const Component* _root = nullptr;
-    /** Optional filter to further select Components under _root, defaults to
-    Filter by type. */
-    const ComponentFilter& _filter;
+    // Flattened array of the Components of type T under the root of the
+    // list. The iterator shares ownership so that the array outlives it even
+    // if the root discards its copy.
+    std::shared_ptr<const std::vector<const Component*>> _components;
+    // Index of _node in _components.
+    size_t _index = 0;
+    /** Optional filter to further select Components under the root; nullptr
+    selects all of them. */
+    const ComponentFilter* _filter;
     
-    /** Constructor that takes a Component and ComponentFilter.
-     The iterator contains a const ref to filter and doesn't take ownership
-     of it. A pointer is used since iterator at end() doesn't have a valid
-     Component underneath it. */
-    ComponentListIterator(const Component* node,
-                          const ComponentFilter& filter) :
-        _node(node),
-        _root(node),
+    /** Constructor that takes the flattened array of Components and a
+     ComponentFilter. The iterator contains a const pointer to the filter and
+     doesn't take ownership of it. The iterator at end() has no array. */
+    ComponentListIterator(
+            std::shared_ptr<const std::vector<const Component*>> components,
+            const ComponentFilter* filter) :
+        _node(nullptr),
+        _components(std::move(components)),
         _filter(filter) {
+        if (_components && !_components->empty())
+            _node = (*_components)[0];
         advanceToNextValidComponent(); // in case node is not a match.
     }
 }; // end of ComponentListIterator
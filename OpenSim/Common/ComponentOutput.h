@@ -33,6 +33,7 @@
 // INCLUDES
 #include "Exception.h"
 #include "Object.h"
+#include "ComponentProfiler.h"
 
 #include <functional>
 #include <map>
@@ -152,6 +153,10 @@ protected:
 
     SimTK::ReferencePtr<const Component> _owner;
 
+    // Records the evaluations of this Output, if the owner is being profiled.
+    // Set by Component::setProfiler().
+    SimTK::ReferencePtr<ComponentProfiler> _profiler;
+
 private:
     std::string name;
     SimTK::Stage dependsOnStage;
@@ -284,6 +289,8 @@ public:
                     state.getSystemStage(), getDependsOnStage(),
                     "Output::getValue(state)");
         }
+        ComponentProfiler::Scope scope(_profiler.get(), _owner.getRef(),
+                ComponentProfiler::EvaluateOutput, &getName());
         _outputFcn(_owner.get(), state, "", _result);
         return _result;
     }
@@ -333,6 +340,9 @@ public:
     Channel(const Output<T>* output, const std::string& channelName)
      : _output(output), _channelName(channelName) {}
     const T& getValue(const SimTK::State& state) const {
+        ComponentProfiler::Scope scope(_output->_profiler.get(),
+                _output->_owner.getRef(), ComponentProfiler::EvaluateOutput,
+                &_output->getName());
         // Must cache, since we're returning a reference.
         _output->_outputFcn(_output->_owner.get(), state, _channelName, _result);
         return _result;
@@ -0,0 +1,227 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim: ComponentProfiler.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ComponentProfiler.h"
+#include "Component.h"
+#include "Exception.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+
+using namespace OpenSim;
+
+namespace {
+    bool compareTotalTime(const ComponentProfiler::Record& a,
+                          const ComponentProfiler::Record& b) {
+        return a.totalTime > b.totalTime;
+    }
+
+    std::string escapeJSON(const std::string& str) {
+        std::string escaped;
+        for (char c : str) {
+            if (c == '"' || c == '\\') escaped += '\\';
+            if (static_cast<unsigned char>(c) < 0x20) escaped += ' ';
+            else escaped += c;
+        }
+        return escaped;
+    }
+}
+
+ComponentProfiler::ComponentProfiler() : _epoch(Clock::now()) {}
+
+const char* ComponentProfiler::getEventName(Event event) {
+    switch (event) {
+    case RealizeTopology:       return "realizeTopology";
+    case RealizeModel:          return "realizeModel";
+    case RealizeInstance:       return "realizeInstance";
+    case RealizeTime:           return "realizeTime";
+    case RealizePosition:       return "realizePosition";
+    case RealizeVelocity:       return "realizeVelocity";
+    case RealizeDynamics:       return "realizeDynamics";
+    case RealizeAcceleration:   return "realizeAcceleration";
+    case RealizeReport:         return "realizeReport";
+    case ComputeForce:          return "computeForce";
+    case ComputeStateVariableDerivatives:
+                                return "computeStateVariableDerivatives";
+    case EvaluateOutput:        return "output";
+    case ComputePath:           return "computePath";
+    case WrapPathSegment:       return "wrapPathSegment";
+    }
+    return "unknown";
+}
+
+void ComponentProfiler::setTraceEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _traceEnabled = enabled;
+}
+
+bool ComponentProfiler::getTraceEnabled() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _traceEnabled;
+}
+
+void ComponentProfiler::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _records.clear();
+    _recordIndices.clear();
+    _traceEvents.clear();
+    _threadIndices.clear();
+    _epoch = Clock::now();
+}
+
+void ComponentProfiler::record(const Component& component, Event event,
+        const std::string* detail, Clock::time_point start) {
+    const Clock::time_point end = Clock::now();
+    const double duration = std::chrono::duration<double>(end - start).count();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    Key key(&component, event, detail ? *detail : std::string());
+    auto it = _recordIndices.find(key);
+    if (it == _recordIndices.end()) {
+        // Look up the path and class only once per record; this is the
+        // expensive part of recording.
+        Record newRecord;
+        newRecord.componentPath = component.getAbsolutePathString();
+        newRecord.componentClass = component.getConcreteClassName();
+        newRecord.event = event;
+        newRecord.detail = std::get<2>(key);
+        _records.push_back(newRecord);
+        it = _recordIndices.insert(
+                std::make_pair(std::move(key), _records.size() - 1)).first;
+    }
+    Record& rec = _records[it->second];
+    ++rec.count;
+    rec.totalTime += duration;
+    rec.maxTime = std::max(rec.maxTime, duration);
+
+    if (_traceEnabled) {
+        TraceEvent traceEvent;
+        traceEvent.record = it->second;
+        traceEvent.thread = getThreadIndex(std::this_thread::get_id());
+        traceEvent.start = std::chrono::duration<double, std::micro>(
+                start - _epoch).count();
+        traceEvent.duration = 1e6 * duration;
+        _traceEvents.push_back(traceEvent);
+    }
+}
+
+int ComponentProfiler::getThreadIndex(std::thread::id id) {
+    auto it = _threadIndices.find(id);
+    if (it != _threadIndices.end()) return it->second;
+    const int index = int(_threadIndices.size());
+    _threadIndices[id] = index;
+    return index;
+}
+
+std::vector<ComponentProfiler::Record> ComponentProfiler::getRecords() const {
+    std::vector<Record> records;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        records = _records;
+    }
+    std::stable_sort(records.begin(), records.end(), compareTotalTime);
+    return records;
+}
+
+std::vector<std::pair<std::string, double>>
+ComponentProfiler::getTotalTimeByComponent() const {
+    std::map<std::string, double> totals;
+    for (const auto& rec : getRecords())
+        totals[rec.componentPath] += rec.totalTime;
+    std::vector<std::pair<std::string, double>> sorted(totals.begin(),
+                                                       totals.end());
+    std::stable_sort(sorted.begin(), sorted.end(),
+        [](const std::pair<std::string, double>& a,
+           const std::pair<std::string, double>& b) {
+            return a.second > b.second;
+        });
+    return sorted;
+}
+
+void ComponentProfiler::printReport(std::ostream& out, int maxRows) const {
+    const std::vector<Record> records = getRecords();
+    double total = 0;
+    for (const auto& rec : records) total += rec.totalTime;
+
+    const std::ios::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+    out << std::left << std::setw(12) << "total (ms)"
+        << std::setw(10) << "count"
+        << std::setw(12) << "mean (us)"
+        << std::setw(12) << "max (us)"
+        << std::setw(34) << "event"
+        << "component" << "\n";
+    out << std::fixed << std::setprecision(3);
+    int row = 0;
+    for (const auto& rec : records) {
+        if (maxRows > 0 && row++ == maxRows) {
+            out << "... " << records.size() - maxRows << " more rows.\n";
+            break;
+        }
+        std::string event = getEventName(rec.event);
+        if (!rec.detail.empty()) event += " " + rec.detail;
+        out << std::left << std::setw(12) << 1e3 * rec.totalTime
+            << std::setw(10) << rec.count
+            << std::setw(12) << 1e6 * rec.totalTime / rec.count
+            << std::setw(12) << 1e6 * rec.maxTime
+            << std::setw(34) << event
+            << rec.componentPath << " (" << rec.componentClass << ")\n";
+    }
+    out << "Total (inclusive) time recorded: " << 1e3 * total << " ms in "
+        << records.size() << " records." << std::endl;
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void ComponentProfiler::writeChromeTrace(const std::string& fileName) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    OPENSIM_THROW_IF(!_traceEnabled && _traceEvents.empty(), Exception,
+            "Tracing is not enabled; call setTraceEnabled(true) before "
+            "running the computations to trace.");
+
+    std::ofstream out(fileName);
+    OPENSIM_THROW_IF(!out, Exception,
+            "Could not open '" + fileName + "' for writing.");
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (size_t i = 0; i < _traceEvents.size(); ++i) {
+        const TraceEvent& traceEvent = _traceEvents[i];
+        const Record& rec = _records[traceEvent.record];
+        std::string name = rec.componentPath + " " + getEventName(rec.event);
+        if (!rec.detail.empty()) name += " " + rec.detail;
+        out << (i == 0 ? "\n" : ",\n");
+        out << "{\"name\":\"" << escapeJSON(name) << "\","
+            << "\"cat\":\"" << getEventName(rec.event) << "\","
+            << "\"ph\":\"X\","
+            << "\"ts\":" << traceEvent.start << ","
+            << "\"dur\":" << traceEvent.duration << ","
+            << "\"pid\":1,"
+            << "\"tid\":" << traceEvent.thread << ","
+            << "\"args\":{\"class\":\"" << escapeJSON(rec.componentClass)
+            << "\"}}";
+    }
+    out << "\n]}\n";
+    OPENSIM_THROW_IF(!out, Exception,
+            "Could not write to '" + fileName + "'.");
+}
@@ -0,0 +1,204 @@
+#ifndef OPENSIM_COMPONENT_PROFILER_H_
+#define OPENSIM_COMPONENT_PROFILER_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim: ComponentProfiler.h                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+#include <chrono>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace OpenSim {
+
+class Component;
+
+//==============================================================================
+//                          OPENSIM COMPONENT PROFILER
+//==============================================================================
+/**
+ * Records the number of times, and the wall-clock time spent, each Component
+ * performs a computation during a simulation: its extendRealize<Stage>()
+ * methods, computeForce(), computeStateVariableDerivatives(), the evaluation
+ * of its Outputs, and the computation and wrapping of GeometryPaths. Calls
+ * that Simbody makes into OpenSim (e.g., realizing the measure of a Component
+ * or calculating the forces of a Force) are attributed to the Component that
+ * implements them.
+ *
+ * You do not normally create a profiler yourself; enable profiling on a Model
+ * instead, run your simulation, and then report the profile:
+ * @code
+ * model.setProfilingEnabled(true);
+ * SimTK::State& state = model.initSystem();
+ * Manager manager(model);
+ * manager.setInitialTime(0);
+ * manager.setFinalTime(1.0);
+ * manager.integrate(state);
+ * model.getProfiler()->printReport(std::cout);
+ * @endcode
+ *
+ * Times are inclusive: the time for computeForce() of a Muscle includes the
+ * time to compute the length of its GeometryPath, which is also listed
+ * separately. When profiling is disabled, each instrumented computation costs
+ * only a check of a null pointer.
+ *
+ * The profiler can also keep every individual event, so that the profile can
+ * be written to a file in the Chrome trace-event format and inspected on a
+ * timeline with chrome://tracing or https://ui.perfetto.dev. This uses memory
+ * proportional to the number of events, so it is off by default; see
+ * setTraceEnabled().
+ *
+ * A profiler may be used from multiple threads at once.
+ */
+class OSIMCOMMON_API ComponentProfiler {
+public:
+    /** The computations that are timed. */
+    enum Event {
+        RealizeTopology,
+        RealizeModel,
+        RealizeInstance,
+        RealizeTime,
+        RealizePosition,
+        RealizeVelocity,
+        RealizeDynamics,
+        RealizeAcceleration,
+        RealizeReport,
+        ComputeForce,
+        ComputeStateVariableDerivatives,
+        EvaluateOutput,
+        ComputePath,
+        WrapPathSegment
+    };
+
+    /** The accumulated cost of one type of computation by one Component. */
+    struct Record {
+        /** Absolute path of the Component. */
+        std::string componentPath;
+        /** Concrete class name of the Component. */
+        std::string componentClass;
+        Event event;
+        /** The name of the Output, for EvaluateOutput events; otherwise
+        empty. */
+        std::string detail;
+        /** Number of times the computation was performed. */
+        long long count = 0;
+        /** Total time (seconds) spent in the computation. */
+        double totalTime = 0;
+        /** Longest time (seconds) spent in a single computation. */
+        double maxTime = 0;
+    };
+
+    /** Times the computation performed during the lifetime of this object,
+    and records it with the given profiler. If the profiler is null, this does
+    nothing. The Component (and the detail string, if provided) must outlive
+    this object. */
+    class Scope {
+    public:
+        Scope(ComponentProfiler* profiler, const Component& component,
+              Event event, const std::string* detail = nullptr) :
+                _profiler(profiler), _component(component), _event(event),
+                _detail(detail) {
+            if (_profiler) _start = Clock::now();
+        }
+        ~Scope() {
+            if (_profiler) _profiler->record(_component, _event, _detail,
+                                             _start);
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        ComponentProfiler* _profiler;
+        const Component& _component;
+        Event _event;
+        const std::string* _detail;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    ComponentProfiler();
+    ComponentProfiler(const ComponentProfiler&) = delete;
+    ComponentProfiler& operator=(const ComponentProfiler&) = delete;
+
+    /** The name of an event as it appears in reports (e.g.,
+    "realizePosition"). */
+    static const char* getEventName(Event event);
+
+    /** Keep each individual event (in addition to the accumulated Records),
+    as needed by writeChromeTrace(). Default: false. */
+    void setTraceEnabled(bool enabled);
+    bool getTraceEnabled() const;
+
+    /** Discard everything recorded so far. */
+    void clear();
+
+    /** The accumulated Records, sorted from largest to smallest total time. */
+    std::vector<Record> getRecords() const;
+
+    /** Total time (seconds) spent in each Component's computations, sorted
+    from largest to smallest. Because times are inclusive, time spent in
+    nested computations (e.g., an Output evaluated within computeForce()) is
+    counted more than once. */
+    std::vector<std::pair<std::string, double>> getTotalTimeByComponent()
+        const;
+
+    /** Print a table of the Records, sorted from largest to smallest total
+    time. If maxRows is positive, only that many Records are printed. */
+    void printReport(std::ostream& out, int maxRows = 0) const;
+
+    /** Write the individual events in the Chrome trace-event (JSON) format.
+    Throws an exception if tracing was not enabled or the file cannot be
+    written. */
+    void writeChromeTrace(const std::string& fileName) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+    using Key = std::tuple<const Component*, int, std::string>;
+
+    struct TraceEvent {
+        size_t record;
+        int thread;
+        double start;    // microseconds since _epoch.
+        double duration; // microseconds.
+    };
+
+    void record(const Component& component, Event event,
+                const std::string* detail, Clock::time_point start);
+    int getThreadIndex(std::thread::id id);
+
+    mutable std::mutex _mutex;
+    bool _traceEnabled = false;
+    Clock::time_point _epoch;
+    std::vector<Record> _records;
+    std::map<Key, size_t> _recordIndices;
+    std::vector<TraceEvent> _traceEvents;
+    std::map<std::thread::id, int> _threadIndices;
+
+//==============================================================================
+};  // END of class ComponentProfiler
+//==============================================================================
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_COMPONENT_PROFILER_H_
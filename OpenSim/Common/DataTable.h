@@ -34,6 +34,7 @@ in-memory container for data access and manipulation.                         */
 #include <OpenSim/Common/IO.h>
 
 #include <iomanip>
+#include <memory>
 #include <numeric>
 
 namespace OpenSim {
@@ -46,6 +47,14 @@ columns, which together form a matrix, can be configured using ETY (template
 param). Independent and dependent columns can contain metadata. DataTable_ as a 
 whole can contain metadata.
 
+Copies of a DataTable_ share the matrix of dependent data until one of them is
+modified (copy-on-write), so copying a table, returning it by value or storing
+it in another object does not copy the data. A writable view of the data (e.g.
+from updMatrix() or updRowAtIndex()) gives the table its own copy of the
+data for good; use fillMatrix() to populate a table in place while keeping
+it shareable. Read-only views obtained from a table that shares its data with a copy
+continue to refer to the shared data if the table is modified afterwards.
+
 \tparam ETX Type of each element of the column holding independent data.
 \tparam ETY Type of each element of the underlying matrix holding dependent 
             data.                                                             */
@@ -73,12 +82,48 @@ public:
     typedef SimTK::MatrixView_<ETY>    MatrixView;
 
     DataTable_()                             = default;
-    DataTable_(const DataTable_&)            = default;
-    DataTable_(DataTable_&&)                 = default;
-    DataTable_& operator=(const DataTable_&) = default;
-    DataTable_& operator=(DataTable_&&)      = default;
     ~DataTable_()                            = default;
 
+    /** The copy shares the dependent data with this table until either is
+    modified.                                                                 */
+    DataTable_(const DataTable_& that) :
+        AbstractDataTable{that},
+        _indData{that._indData},
+        _depData{that.shareDepData()} {}
+
+    DataTable_(DataTable_&& that) :
+        AbstractDataTable{std::move(that)},
+        _indData{std::move(that._indData)},
+        _depData{std::move(that._depData)},
+        _depDataIsShareable{that._depDataIsShareable} {
+        that._depData = std::make_shared<Matrix>();
+        that._depDataIsShareable = true;
+    }
+
+    DataTable_& operator=(const DataTable_& that) {
+        if(&that == this)
+            return *this;
+        AbstractDataTable::operator=(that);
+        _indData = that._indData;
+        assignDepData(that);
+        return *this;
+    }
+
+    DataTable_& operator=(DataTable_&& that) {
+        if(&that == this)
+            return *this;
+        AbstractDataTable::operator=(std::move(that));
+        _indData = std::move(that._indData);
+        if(_depDataIsShareable) {
+            _depData = std::move(that._depData);
+            _depDataIsShareable = that._depDataIsShareable;
+        } else
+            *_depData = *that._depData;
+        that._depData = std::make_shared<Matrix>();
+        that._depDataIsShareable = true;
+        return *this;
+    }
+
     std::shared_ptr<AbstractDataTable> clone() const override {
         return std::shared_ptr<AbstractDataTable>{new DataTable_{*this}};
     }
@@ -224,14 +269,15 @@ public:
         setColumnLabels(thisLabels);
 
         // Construct matrix for this table from that table.
-        _depData.resize((int)that.getNumRows(), 
+        auto& depData = updDepData();
+        depData.resize((int)that.getNumRows(), 
             (int)that.getNumColumns() * that.numComponentsPerElement());
         for(unsigned r = 0; r < that.getNumRows(); ++r) {
             const auto& thatRow = that.getRowAtIndex(r);
             for (unsigned c = 0; c < that.getNumColumns(); ++c) {
-                splitAndAssignElement(_depData.updRow(r).begin() +
+                splitAndAssignElement(depData.updRow(r).begin() +
                                         c*that.numComponentsPerElement(), 
-                                      _depData.updRow(r).end(),
+                                      depData.updRow(r).end(),
                                       thatRow[c]);
             }
         }
@@ -381,12 +427,13 @@ public:
         setColumnLabels(thisLabels);
 
         // Construct matrix for this table from that table.
-        _depData.resize((int)that.getNumRows(), 
+        auto& depData = updDepData();
+        depData.resize((int)that.getNumRows(), 
             (int)that.getNumColumns() / numComponentsPerElement());
         for(unsigned r = 0; r < that.getNumRows(); ++r) {
             auto thatRow = that.getRowAtIndex(r).getAsRowVector();
             for(unsigned c = 0; c < this->getNumColumns(); ++c) {
-                _depData.updElt(r,c) = makeElement(
+                depData.updElt(r,c) = makeElement(
                     thatRow.begin() + c*numComponentsPerElement(), 
                     thatRow.end());
             }
@@ -663,13 +710,77 @@ public:
 
         _indData.push_back(indRow);
 
-        if(_depData.nrow() == 0) {
-            _depData.resize(1, depRow.size());
+        auto& depData = updDepData();
+        if(depData.nrow() == 0) {
+            depData.resize(1, depRow.size());
         }
         else 
-            _depData.resizeKeep(_depData.nrow() + 1, _depData.ncol());
+            depData.resizeKeep(depData.nrow() + 1, depData.ncol());
             
-        _depData.updRow(_depData.nrow() - 1) = depRow;
+        depData.updRow(depData.nrow() - 1) = depRow;
+    }
+
+    /** Append multiple rows to the DataTable_ at once: row `i` of depRows is
+    appended with the independent column value `indRows[i]`. This is
+    equivalent to calling appendRow() for each row, but the dependent columns
+    are resized only once, so the time taken is linear rather than quadratic
+    in the number of rows. If any of the rows is invalid, none of them is
+    appended.
+
+    \throws InvalidArgument If the length of indRows does not match the
+    number of rows of depRows.
+    \throws IncorrectNumColumns If the rows added are invalid. Validity of
+    the rows added is decided by the derived class.                          */
+    void appendRows(const std::vector<ETX>& indRows,
+                    const SimTK::Matrix_<ETY>& depRows) {
+        OPENSIM_THROW_IF(indRows.size() !=
+                         static_cast<size_t>(depRows.nrow()),
+                         InvalidArgument,
+                         "Length of independent column does not match number "
+                         "of rows of dependent data.");
+        if(indRows.empty())
+            return;
+
+        if (_dependentsMetaData.hasKey("labels")) {
+            auto& labels =
+                    _dependentsMetaData.getValueArrayForKey("labels");
+            OPENSIM_THROW_IF(static_cast<unsigned>(depRows.ncol()) !=
+                             labels.size(),
+                             IncorrectNumColumns,
+                             labels.size(),
+                             static_cast<size_t>(depRows.ncol()));
+        }
+        if(getDepData().nrow() != 0) {
+            OPENSIM_THROW_IF(depRows.ncol() != getDepData().ncol(),
+                             IncorrectNumColumns,
+                             static_cast<size_t>(getDepData().ncol()),
+                             static_cast<size_t>(depRows.ncol()));
+        }
+
+        // Each row is validated against the rows preceding it, so the
+        // independent values are appended one at a time.
+        const size_t numRowsBefore = _indData.size();
+        try {
+            for(size_t i = 0; i < indRows.size(); ++i) {
+                validateRow(_indData.size(), indRows[i],
+                            depRows.row(static_cast<int>(i)));
+                _indData.push_back(indRows[i]);
+            }
+        } catch(...) {
+            _indData.resize(numRowsBefore);
+            throw;
+        }
+
+        auto& depData = updDepData();
+        const int firstRow = depData.nrow();
+        if(firstRow == 0) {
+            depData.resize(depRows.nrow(), depRows.ncol());
+        }
+        else
+            depData.resizeKeep(firstRow + depRows.nrow(), depData.ncol());
+
+        depData.updBlock(firstRow, 0, depRows.nrow(), depRows.ncol()) =
+            depRows;
     }
 
     /** Get row at index.                                                     
@@ -680,7 +791,7 @@ public:
                          RowIndexOutOfRange, 
                          index, 0, static_cast<unsigned>(_indData.size() - 1));
 
-        return _depData.row(static_cast<int>(index));
+        return getDepData().row(static_cast<int>(index));
     }
 
     /** Get row corresponding to the given entry in the independent column. This
@@ -696,7 +807,7 @@ public:
         OPENSIM_THROW_IF(iter == _indData.cend(),
                          KeyNotFound, std::to_string(ind));
 
-        return _depData.row((int)std::distance(_indData.cbegin(), iter));
+        return getDepData().row((int)std::distance(_indData.cbegin(), iter));
     }
 
     /** Update row at index.                                                  
@@ -707,7 +818,7 @@ public:
                          RowIndexOutOfRange, 
                          index, 0, static_cast<unsigned>(_indData.size() - 1));
 
-        return _depData.updRow((int)index);
+        return exposeDepData().updRow((int)index);
     }
 
     /** Update row corresponding to the given entry in the independent column.
@@ -723,7 +834,7 @@ public:
         OPENSIM_THROW_IF(iter == _indData.cend(),
                          KeyNotFound, std::to_string(ind));
 
-        return _depData.updRow((int)std::distance(_indData.cbegin(), iter));
+        return exposeDepData().updRow((int)std::distance(_indData.cbegin(), iter));
     }
 
     /** Set row at index. Equivalent to
@@ -784,11 +895,12 @@ public:
                          RowIndexOutOfRange, 
                          index, 0, static_cast<unsigned>(_indData.size() - 1));
 
+        auto& depData = updDepData();
         if(index < getNumRows() - 1)
             for(size_t r = index; r < getNumRows() - 1; ++r)
-                _depData.updRow((int)r) = _depData.row((int)(r + 1));
+                depData.updRow((int)r) = depData.row((int)(r + 1));
         
-        _depData.resizeKeep(_depData.nrow() - 1, _depData.ncol());
+        depData.resizeKeep(depData.nrow() - 1, depData.ncol());
         _indData.erase(_indData.begin() + index);
     }
 
@@ -942,8 +1054,9 @@ public:
                          static_cast<size_t>(getNumRows()),
                          static_cast<size_t>(depCol.nrow()));
         
-        _depData.resizeKeep(_depData.nrow(), _depData.ncol() + 1);
-        _depData.updCol(_depData.ncol() - 1) = depCol;
+        auto& depData = updDepData();
+        depData.resizeKeep(depData.nrow(), depData.ncol() + 1);
+        depData.updCol(depData.ncol() - 1) = depCol;
         appendColumnLabel(columnLabel);
     }
 
@@ -956,9 +1069,9 @@ public:
         OPENSIM_THROW_IF(isEmpty(), EmptyTable);
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(index),
                          ColumnIndexOutOfRange, index, 0,
-                         static_cast<size_t>(_depData.ncol() - 1));
+                         static_cast<size_t>(getDepData().ncol() - 1));
 
-        return _depData.col(static_cast<int>(index));
+        return getDepData().col(static_cast<int>(index));
     }
 
     /** Get dependent Column which has the given column label.                
@@ -966,7 +1079,7 @@ public:
     \throws KeyNotFound If columnLabel is not found to be label of any existing
                         column.                                               */
     VectorView getDependentColumn(const std::string& columnLabel) const {
-        return _depData.col(static_cast<int>(getColumnIndex(columnLabel)));
+        return getDepData().col(static_cast<int>(getColumnIndex(columnLabel)));
     }
 
     /** Update dependent column at index.
@@ -978,9 +1091,9 @@ public:
         OPENSIM_THROW_IF(isEmpty(), EmptyTable);
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(index),
                          ColumnIndexOutOfRange, index, 0,
-                         static_cast<size_t>(_depData.ncol() - 1));
+                         static_cast<size_t>(getDepData().ncol() - 1));
 
-        return _depData.updCol(static_cast<int>(index));
+        return exposeDepData().updCol(static_cast<int>(index));
     }
 
     /** Update dependent Column which has the given column label.
@@ -988,7 +1101,7 @@ public:
     \throws KeyNotFound If columnLabel is not found to be label of any existing
                         column.                                               */
     VectorView updDependentColumn(const std::string& columnLabel) {
-        return _depData.updCol(static_cast<int>(getColumnIndex(columnLabel)));
+        return exposeDepData().updCol(static_cast<int>(getColumnIndex(columnLabel)));
     }
 
     /** %Set value of the independent column at index.
@@ -1004,7 +1117,7 @@ public:
                          rowIndex, 0, 
                          static_cast<unsigned>(_indData.size() - 1));
 
-        validateRow(rowIndex, value, _depData.row((int)rowIndex));
+        validateRow(rowIndex, value, getDepData().row((int)rowIndex));
         _indData[rowIndex] = value;
     }
 
@@ -1017,7 +1130,7 @@ public:
 
     /** Get a read-only view to the underlying matrix.                        */
     const MatrixView& getMatrix() const {
-        return _depData.getAsMatrixView();
+        return getDepData().getAsMatrixView();
     }
 
     /** Get a read-only view of a block of the underlying matrix.             
@@ -1039,21 +1152,21 @@ public:
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart),
                          RowIndexOutOfRange,
                          rowStart, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(getDepData().nrow() - 1));
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart + numRows - 1),
                          RowIndexOutOfRange,
                          rowStart + numRows - 1, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(getDepData().nrow() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart),
                          ColumnIndexOutOfRange,
                          columnStart, 0, 
-                         static_cast<unsigned>(_depData.ncol() - 1));
+                         static_cast<unsigned>(getDepData().ncol() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart + numColumns - 1),
                          ColumnIndexOutOfRange,
                          columnStart + numColumns - 1, 0, 
-                         static_cast<unsigned>(_depData.ncol() - 1));
+                         static_cast<unsigned>(getDepData().ncol() - 1));
 
-        return _depData.block(static_cast<int>(rowStart),
+        return getDepData().block(static_cast<int>(rowStart),
                               static_cast<int>(columnStart),
                               static_cast<int>(numRows),
                               static_cast<int>(numColumns));
@@ -1061,9 +1174,24 @@ public:
 
     /** Get a writable view to the underlying matrix.                         */
     MatrixView& updMatrix() {
-        return _depData.updAsMatrixView();
+        return exposeDepData().updAsMatrixView();
     }
 
+#ifndef SWIG
+    /** Write the underlying matrix in place by calling `fill` with a writable
+    reference to it, e.g. to populate a table created with room for its data.
+    Unlike updMatrix(), this does not stop the table from sharing its data
+    with copies made afterwards, so `fill` must not keep references or views
+    to the matrix after it returns.
+    ```
+    table.fillMatrix([&](SimTK::Matrix& matrix) { matrix(0, 0) = 1; });
+    ```                                                                      */
+    template<typename FillFunction>
+    void fillMatrix(FillFunction fill) {
+        fill(updDepData());
+    }
+#endif
+
     /** Get a writable view of a block of the underlying matrix.
 
     \throws InvalidArgument If numRows or numColumns is zero.
@@ -1083,21 +1211,21 @@ public:
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart),
                          RowIndexOutOfRange,
                          rowStart, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(getDepData().nrow() - 1));
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart + numRows - 1),
                          RowIndexOutOfRange,
                          rowStart + numRows - 1, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(getDepData().nrow() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart),
                          ColumnIndexOutOfRange,
                          columnStart, 0, 
-                         static_cast<unsigned>(_depData.ncol() - 1));
+                         static_cast<unsigned>(getDepData().ncol() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart + numColumns - 1),
                          ColumnIndexOutOfRange,
                          columnStart + numColumns - 1, 0, 
-                         static_cast<unsigned>(_depData.ncol() - 1));
+                         static_cast<unsigned>(getDepData().ncol() - 1));
 
-        return _depData.updBlock(static_cast<int>(rowStart),
+        return exposeDepData().updBlock(static_cast<int>(rowStart),
                                  static_cast<int>(columnStart),
                                  static_cast<int>(numRows),
                                  static_cast<int>(numColumns));
@@ -1192,7 +1320,7 @@ protected:
 
         setColumnLabels(labels);
         _indData = indVec;
-        _depData = depData;
+        _depData = std::make_shared<Matrix>(depData);
     }
 
     /** Construct a table with only the independent column and 0
@@ -1201,7 +1329,18 @@ protected:
     DataTable_(const std::vector<ETX>& indVec) {
         setColumnLabels({});
         _indData = indVec;
-        _depData.resize((int)indVec.size(), 0);
+        updDepData().resize((int)indVec.size(), 0);
+    }
+
+    /** Construct a table with the given independent column and column labels,
+    whose dependent data is allocated but not initialized. This constructor
+    is useful when populating the table through fillMatrix(), which avoids
+    copying a matrix filled beforehand.                                       */
+    DataTable_(const std::vector<ETX>& indVec,
+               const std::vector<std::string>& labels) {
+        setColumnLabels(labels);
+        _indData = indVec;
+        updDepData().resize((int)indVec.size(), (int)labels.size());
     }
 
     // Implement toString.
@@ -1474,17 +1613,17 @@ protected:
 
     /** Check if column index is out of range.                                */
     bool isColumnIndexOutOfRange(size_t index) const {
-        return index >= static_cast<size_t>(_depData.ncol());
+        return index >= static_cast<size_t>(getDepData().ncol());
     }
 
     /** Get number of rows.                                                   */
     size_t implementGetNumRows() const override {
-        return _depData.nrow();
+        return getDepData().nrow();
     }
 
     /** Get number of columns.                                                */
     size_t implementGetNumColumns() const override {
-        return _depData.ncol();
+        return getDepData().ncol();
     }
 
     /** Validate metadata for independent column.                             
@@ -1539,10 +1678,10 @@ protected:
                 "Leading/trailing spaces are not permitted in column labels.");
         }
 
-        OPENSIM_THROW_IF(_depData.ncol() != 0 && 
-                         numCols != static_cast<unsigned>(_depData.ncol()),
+        OPENSIM_THROW_IF(getDepData().ncol() != 0 && 
+                         numCols != static_cast<unsigned>(getDepData().ncol()),
                          IncorrectMetaDataLength, "labels", 
-                         static_cast<size_t>(_depData.ncol()), numCols);
+                         static_cast<size_t>(getDepData().ncol()), numCols);
 
         for(const std::string& key : _dependentsMetaData.getKeys()) {
             OPENSIM_THROW_IF(numCols != 
@@ -1578,8 +1717,56 @@ protected:
         return M * N;
     }
 
+    /** Read-only access to the dependent data.                             */
+    const Matrix& getDepData() const {
+        return *_depData;
+    }
+
+    /** Writable access to the dependent data, for modifying it within this
+    class. If the data is shared with copies of this table, this table first
+    gets its own copy. Do not hand out references or views to the result;
+    use exposeDepData() for that.                                            */
+    Matrix& updDepData() {
+        if(_depData.use_count() > 1)
+            _depData = std::make_shared<Matrix>(*_depData);
+        return *_depData;
+    }
+
+    /** Like updDepData(), for handing out writable views of the dependent
+    data. Since writes through such a view must not affect copies of this
+    table made later, the data of this table is not shared with copies
+    anymore.                                                                  */
+    Matrix& exposeDepData() {
+        _depDataIsShareable = false;
+        return updDepData();
+    }
+
+private:
+    // The dependent data to use for a copy of this table.
+    std::shared_ptr<Matrix> shareDepData() const {
+        if(_depDataIsShareable)
+            return _depData;
+        return std::make_shared<Matrix>(*_depData);
+    }
+
+    // Assign the dependent data of another table to this table. If views of
+    // the data of this table have been handed out, the data is copied into
+    // the existing matrix, as those views would expect.
+    void assignDepData(const DataTable_& that) {
+        if(_depDataIsShareable)
+            _depData = that.shareDepData();
+        else
+            *_depData = *that._depData;
+    }
+
+protected:
     std::vector<ETX>    _indData;
-    SimTK::Matrix_<ETY> _depData;
+
+private:
+    // Shared by copies of this table until one of them is modified.
+    std::shared_ptr<Matrix> _depData{std::make_shared<Matrix>()};
+    // False once a writable view of _depData has been handed out.
+    bool _depDataIsShareable{true};
 };  // DataTable_
 
 
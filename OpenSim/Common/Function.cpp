@@ -173,6 +173,18 @@ double Function::calcDerivative(const std::vector<int>& derivComponents, const V
     return _function->calcDerivative(derivComponents, x);
 }
 
+void Function::calcValueAndDerivatives(double aX, double& rValue,
+        double& rFirstDeriv, double& rSecondDeriv, int* rInterval) const
+{
+    static const std::vector<int> firstDeriv(1, 0);
+    static const std::vector<int> secondDeriv(2, 0);
+    const Vector x(1, aX);
+    const int maxOrder = getMaxDerivativeOrder();
+    rValue = calcValue(x);
+    rFirstDeriv = maxOrder >= 1 ? calcDerivative(firstDeriv, x) : SimTK::NaN;
+    rSecondDeriv = maxOrder >= 2 ? calcDerivative(secondDeriv, x) : SimTK::NaN;
+}
+
 int Function::getArgumentSize() const
 {
     if (_function == NULL)
@@ -114,6 +114,29 @@ public:
      * @param x                the Vector of input arguments.  Its size must equal the value returned by getArgumentSize().
      */
     virtual double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const;
+    /**
+     * Calculate the value and the first and second derivatives of a function
+     * of one variable at a particular point. Spline functions override this
+     * method to locate the interval containing aX once for all three
+     * quantities, rather than once per call to calcValue() and
+     * calcDerivative(). The default implementation calls calcValue() and
+     * calcDerivative(); a derivative beyond getMaxDerivativeOrder() is NaN.
+     *
+     * @param aX           Value of the independent variable.
+     * @param rValue       Value of the function at aX.
+     * @param rFirstDeriv  First derivative of the function at aX.
+     * @param rSecondDeriv Second derivative of the function at aX.
+     * @param rInterval    Optional interval hint. On entry, the interval
+     *                     returned by a previous call on this function (e.g.,
+     *                     at a nearby aX); on exit, the interval containing
+     *                     aX. Passing the same hint through a monotone sweep
+     *                     over aX reduces the interval search to a
+     *                     constant-time check. Functions without intervals
+     *                     leave it unchanged.
+     */
+    virtual void calcValueAndDerivatives(double aX, double& rValue,
+            double& rFirstDeriv, double& rSecondDeriv,
+            int* rInterval = nullptr) const;
     /**
      * Get the number of components expected in the input vector.
      */
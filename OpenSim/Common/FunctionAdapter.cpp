@@ -45,13 +45,26 @@ FunctionAdapter::FunctionAdapter(const OpenSim::Function& aFunction) : _function
 // SimTK::Function METHODS
 //=============================================================================
 double FunctionAdapter::calcValue(const Vector& x) const {
+    double result;
+    if (x.size() == 1 && calcFromCache(x[0], 0, result))
+        return result;
     return _function.calcValue(x);
 }
 double FunctionAdapter::calcDerivative(const std::vector<int>& derivComponents, const Vector& x) const {
+    const int order = (int)derivComponents.size();
+    double result;
+    if (x.size() == 1 && (order == 1 || order == 2) &&
+            calcFromCache(x[0], order, result))
+        return result;
     return _function.calcDerivative(derivComponents, x);
 }
 
 double FunctionAdapter::calcDerivative(const SimTK::Array_<int>& derivComponents, const SimTK::Vector& x) const{
+    const int order = (int)derivComponents.size();
+    double result;
+    if (x.size() == 1 && (order == 1 || order == 2) &&
+            calcFromCache(x[0], order, result))
+        return result;
     std::vector<int> dcs(derivComponents.begin(), derivComponents.end());
     return _function.calcDerivative(dcs, x);
 }
@@ -63,3 +76,26 @@ int FunctionAdapter::getMaxDerivativeOrder() const {
     return _function.getMaxDerivativeOrder();
 }
 
+bool FunctionAdapter::calcFromCache(double x, int derivOrder,
+                                    double& result) const {
+    if (_cacheBusy.exchange(true, std::memory_order_acquire))
+        return false;
+    if (x != _cache.x) {
+        try {
+            _function.calcValueAndDerivatives(x, _cache.value,
+                    _cache.firstDeriv, _cache.secondDeriv, &_cache.interval);
+        }
+        catch (...) {
+            // Let the caller evaluate the function directly, which reports
+            // the error only if the requested quantity is unavailable.
+            _cache.x = SimTK::NaN;
+            _cacheBusy.store(false, std::memory_order_release);
+            return false;
+        }
+        _cache.x = x;
+    }
+    result = derivOrder == 0 ? _cache.value
+           : derivOrder == 1 ? _cache.firstDeriv : _cache.secondDeriv;
+    _cacheBusy.store(false, std::memory_order_release);
+    return !SimTK::isNaN(result);
+}
@@ -26,6 +26,7 @@
 
 // INCLUDES
 #include "Function.h"
+#include <atomic>
 
 
 //=============================================================================
@@ -37,6 +38,15 @@ namespace OpenSim {
 /**
  * This is a SimTK::Function that acts as a wrapper around an OpenMM::Function.
  *
+ * For a function of one variable, the value and the first and second
+ * derivatives are computed together with
+ * OpenSim::Function::calcValueAndDerivatives() and kept until the argument
+ * changes, since callers such as a FunctionBased mobilizer request all three
+ * at the same argument one after another. The interval found by each
+ * evaluation is the hint for the next one. The wrapped function must not be
+ * modified while the adapter is in use (i.e., rebuild the System after
+ * editing it).
+ *
  * @author Peter Eastman
  */
 class OSIMCOMMON_API FunctionAdapter : public SimTK::Function
@@ -63,6 +73,26 @@ private:
     FunctionAdapter();
     FunctionAdapter& operator=(FunctionAdapter& function);
 
+    // Set result to the value (derivOrder 0) or a derivative of a function
+    // of one variable at x, evaluating the function only if x differs from
+    // the argument of the previous evaluation. Returns false if another
+    // thread is using the cache or if the result is not available (NaN, or
+    // the evaluation threw), in which case the caller evaluates the function
+    // directly.
+    bool calcFromCache(double x, int derivOrder, double& result) const;
+
+    // The most recent evaluation. _cacheBusy serializes access to it;
+    // threads that find it set evaluate the function directly.
+    struct Evaluation {
+        double x = SimTK::NaN;
+        double value = SimTK::NaN;
+        double firstDeriv = SimTK::NaN;
+        double secondDeriv = SimTK::NaN;
+        int interval = -1;
+    };
+    mutable Evaluation _cache;
+    mutable std::atomic<bool> _cacheBusy{false};
+
 //=============================================================================
 };  // END class FunctionAdapter
 
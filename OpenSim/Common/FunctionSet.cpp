@@ -154,3 +154,35 @@ evaluate(Array<double> &rValues,int aDerivOrder,double aX) const
         }
     }
 }
+
+//_____________________________________________________________________________
+/**
+ * Evaluate all the functions in the function set and their first and second
+ * derivatives.
+ *
+ * @param aX Value of the x independent variable.
+ * @param rValues Values of the functions.
+ * @param rFirstDerivatives First derivatives of the functions.
+ * @param rSecondDerivatives Second derivatives of the functions.
+ */
+void FunctionSet::
+evaluateWithDerivatives(double aX, SimTK::Vector& rValues,
+        SimTK::Vector& rFirstDerivatives,
+        SimTK::Vector& rSecondDerivatives) const
+{
+    int size = getSize();
+    rValues.resize(size);
+    rFirstDerivatives.resize(size);
+    rSecondDerivatives.resize(size);
+
+    const SimTK::Vector arg(1, aX);
+    static const std::vector<int> firstDeriv(1, 0);
+    static const std::vector<int> secondDeriv(2, 0);
+
+    for(int i=0;i<size;i++) {
+        const Function& func = get(i);
+        rValues[i] = func.calcValue(arg);
+        rFirstDerivatives[i] = func.calcDerivative(firstDeriv, arg);
+        rSecondDerivatives[i] = func.calcDerivative(secondDeriv, arg);
+    }
+}
@@ -75,6 +75,16 @@ public:
     virtual void
         evaluate(Array<double> &rValues,int aDerivOrder,
         double aX=0.0) const;
+    /**
+     * Evaluate all the functions in the set, along with their first and
+     * second derivatives, at aX in one pass. The output vectors are resized
+     * to getSize() if necessary, so repeated calls with the same vectors do
+     * not allocate.
+     */
+    virtual void
+        evaluateWithDerivatives(double aX, SimTK::Vector& rValues,
+        SimTK::Vector& rFirstDerivatives,
+        SimTK::Vector& rSecondDerivatives) const;
 
 //=============================================================================
 };  // END class FunctionSet
@@ -580,6 +580,30 @@ addPoint(double aX, double aY)
     return i;
 }
 
+void GCVSpline::
+calcValueAndDerivatives(double aX, double& rValue,
+        double& rFirstDeriv, double& rSecondDeriv, int* rInterval) const
+{
+    // The coefficients are computed when the SimTK::Spline is fit.
+    if (_function == NULL)
+        _function = createSimTKFunction();
+
+    // splder() needs a work array of length 2*m; m is at most 4 (heptic).
+    double work[8];
+    int interval = (rInterval != nullptr) ? *rInterval : 1;
+    const int n = _x.getSize();
+    double* x = &_x[0];
+    double* c = &_coefficients[0];
+
+    // The first call locates the interval; the following ones find it
+    // already correct and return immediately from the search.
+    rValue = splder(0, _halfOrder, n, aX, x, c, &interval, work);
+    rFirstDeriv = splder(1, _halfOrder, n, aX, x, c, &interval, work);
+    rSecondDeriv = splder(2, _halfOrder, n, aX, x, c, &interval, work);
+
+    if (rInterval != nullptr) *rInterval = interval;
+}
+
 SimTK::Function* GCVSpline::createSimTKFunction() const {
     int degree = _halfOrder*2-1;
     Vector x(_x.getSize());
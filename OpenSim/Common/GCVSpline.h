@@ -233,6 +233,27 @@ public:
     //--------------------------------------------------------------------------
     // EVALUATION
     //--------------------------------------------------------------------------
+    /**
+     * Evaluate the value and the first and second derivatives of the spline
+     * at aX with a single search for the knot interval containing aX.
+     *
+     * Apart from the first call (which fits the spline if it has not been
+     * fit yet), this method does not modify the spline and may be called
+     * concurrently from multiple threads.
+     *
+     * @param aX Value of the independent variable.
+     * @param rValue Value of the spline at aX.
+     * @param rFirstDeriv First derivative of the spline at aX.
+     * @param rSecondDeriv Second derivative of the spline at aX.
+     * @param rInterval Optional knot interval hint. On entry, the interval
+     * found by a previous call (e.g., at a nearby aX, or for another spline
+     * with the same knots); on exit, the interval containing aX. Passing the
+     * same hint through a sweep over aX or across splines that share a knot
+     * sequence reduces the interval search to a constant-time check.
+     */
+    void calcValueAndDerivatives(double aX, double& rValue,
+            double& rFirstDeriv, double& rSecondDeriv,
+            int* rInterval = nullptr) const override;
 
 //=============================================================================
 };  // END class GCVSpline
@@ -137,6 +137,33 @@ GCVSpline* GCVSplineSet::getGCVSpline(int aIndex) const {
     return(&func);
 }
 
+void GCVSplineSet::evaluateWithDerivatives(double aX,
+        SimTK::Vector& rValues, SimTK::Vector& rFirstDerivatives,
+        SimTK::Vector& rSecondDerivatives) const {
+    int size = getSize();
+    rValues.resize(size);
+    rFirstDerivatives.resize(size);
+    rSecondDerivatives.resize(size);
+
+    const SimTK::Vector arg(1, aX);
+    static const std::vector<int> firstDeriv(1, 0);
+    static const std::vector<int> secondDeriv(2, 0);
+
+    int interval = 1;
+    for(int i=0;i<size;i++) {
+        const Function& func = get(i);
+        const GCVSpline* spline = dynamic_cast<const GCVSpline*>(&func);
+        if(spline) {
+            spline->calcValueAndDerivatives(aX, rValues[i],
+                    rFirstDerivatives[i], rSecondDerivatives[i], &interval);
+        } else {
+            rValues[i] = func.calcValue(arg);
+            rFirstDerivatives[i] = func.calcDerivative(firstDeriv, arg);
+            rSecondDerivatives[i] = func.calcDerivative(secondDeriv, arg);
+        }
+    }
+}
+
 Storage* GCVSplineSet::constructStorage(int aDerivOrder,double aDX) {
     if(aDerivOrder<0) return(NULL);
     if(getSize()<=0) return(NULL);
@@ -134,6 +134,19 @@ public:
      *         returned.
      */
     GCVSpline* getGCVSpline(int aIndex) const;
+
+    /**
+     * Evaluate all the splines in the set, along with their first and second
+     * derivatives, at aX. Each GCVSpline is evaluated with a single knot
+     * interval search, and the interval found for one spline is used as the
+     * starting guess for the next, so splines fit to the same Storage (and
+     * thus sharing a knot sequence) locate the interval only once. Members
+     * of the set that are not GCVSplines (e.g., Constants) are evaluated
+     * through the generic Function interface.
+     */
+    void evaluateWithDerivatives(double aX, SimTK::Vector& rValues,
+            SimTK::Vector& rFirstDerivatives,
+            SimTK::Vector& rSecondDerivatives) const override;
     double getMinX() const;
     double getMaxX() const;
 
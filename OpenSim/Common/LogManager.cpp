@@ -20,11 +20,15 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 #include "LogManager.h"
+#include <condition_variable>
 #include <fstream>
+#include <map>
+#include <thread>
 
 using namespace OpenSim;
 
 // Initialize static members
+std::atomic<int> LogManager::_level(static_cast<int>(LogLevel::Info));
 LogBuffer LogManager::out;
 LogBuffer LogManager::err;
 std::ostream LogManager::cout(std::cout.rdbuf()); // This cout writes to the actual standard out
@@ -54,15 +58,237 @@ void StreamLogCallback::log(const std::string &str)
     *_out << str << std::flush;
 }
 
+//=============================================================================
+// LogRateLimiter
+//=============================================================================
+LogRateLimiter::LogRateLimiter(int maxBurst, double intervalInSeconds) :
+    _maxBurst(maxBurst),
+    _interval(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(intervalInSeconds))),
+    _allowance(maxBurst),
+    _numSuppressed(0),
+    _lastTime(std::chrono::steady_clock::now())
+{}
+
+// Copies the limits, but not the history of the other limiter.
+LogRateLimiter::LogRateLimiter(const LogRateLimiter& other) :
+    _maxBurst(other._maxBurst),
+    _interval(other._interval),
+    _allowance(other._maxBurst),
+    _numSuppressed(0),
+    _lastTime(std::chrono::steady_clock::now())
+{}
+
+LogRateLimiter& LogRateLimiter::operator=(const LogRateLimiter& other)
+{
+    if(this != &other) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _maxBurst = other._maxBurst;
+        _interval = other._interval;
+        _allowance = _maxBurst;
+        _numSuppressed = 0;
+        _lastTime = std::chrono::steady_clock::now();
+    }
+    return *this;
+}
+
+bool LogRateLimiter::allow(int& numSuppressed)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto now = std::chrono::steady_clock::now();
+    if(_interval.count() > 0) {
+        _allowance += double((now - _lastTime).count()) / _interval.count();
+        if(_allowance > _maxBurst) _allowance = _maxBurst;
+    } else {
+        _allowance = _maxBurst;
+    }
+    _lastTime = now;
+
+    if(_allowance < 1.0) {
+        ++_numSuppressed;
+        numSuppressed = 0;
+        return false;
+    }
+    _allowance -= 1.0;
+    numSuppressed = _numSuppressed;
+    _numSuppressed = 0;
+    return true;
+}
+
+void LogRateLimiter::reset()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _allowance = _maxBurst;
+    _numSuppressed = 0;
+    _lastTime = std::chrono::steady_clock::now();
+}
+
+//=============================================================================
+// LogBuffer::AsyncQueue
+//=============================================================================
+// A multiple-producer, single-consumer queue of strings (an intrusive linked
+// list with a stub node; see D. Vyukov, "Intrusive MPSC node-based queue").
+// Producers exchange an atomic pointer, and take the mutex only to wake the
+// background thread when it is waiting for strings, so flushing a stream
+// never waits for the callbacks. The background thread pops the strings and
+// passes them to the callbacks of the LogBuffer.
+class LogBuffer::AsyncQueue
+{
+public:
+    explicit AsyncQueue(LogBuffer& buffer) :
+        _buffer(buffer), _head(&_stub), _tail(&_stub)
+    {
+        _thread = std::thread(&AsyncQueue::run, this);
+    }
+
+    // Log everything that was pushed, then stop the thread.
+    ~AsyncQueue()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wake.notify_one();
+        _thread.join();
+    }
+
+    void push(std::string str)
+    {
+        Node* node = new Node(std::move(str));
+        _numPushed.fetch_add(1, std::memory_order_relaxed);
+        Node* prev = _head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+        // Only wake the thread if it is waiting for strings.
+        if(_waiting.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _wake.notify_one();
+        }
+    }
+
+    void waitUntilLogged()
+    {
+        const long long target = _numPushed.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(_mutex);
+        _wake.notify_one();
+        _logged.wait(lock, [&] {
+            return _numLogged.load(std::memory_order_acquire) >= target;
+        });
+    }
+
+private:
+    struct Node {
+        Node() = default;
+        explicit Node(std::string aStr) : str(std::move(aStr)) {}
+        std::string str;
+        std::atomic<Node*> next{nullptr};
+    };
+
+    // Called only by the background thread. Returns nullptr if the queue is
+    // empty or if the string at the front is still being pushed.
+    Node* pop()
+    {
+        Node* tail = _tail;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if(tail == &_stub) {
+            if(next == nullptr) return nullptr;
+            _tail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if(next != nullptr) {
+            _tail = next;
+            return tail;
+        }
+        if(tail != _head.load(std::memory_order_acquire)) return nullptr;
+        // Put the stub back behind the last node so that the last node can
+        // be popped.
+        _stub.next.store(nullptr, std::memory_order_relaxed);
+        Node* prev = _head.exchange(&_stub, std::memory_order_acq_rel);
+        prev->next.store(&_stub, std::memory_order_release);
+        next = tail->next.load(std::memory_order_acquire);
+        if(next != nullptr) {
+            _tail = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+    void run()
+    {
+        while(true) {
+            while(Node* node = pop()) {
+                _buffer.logToCallbacks(node->str);
+                delete node;
+                _numLogged.fetch_add(1, std::memory_order_release);
+            }
+            std::unique_lock<std::mutex> lock(_mutex);
+            _logged.notify_all();
+            const bool empty = _numLogged.load(std::memory_order_acquire) ==
+                               _numPushed.load(std::memory_order_acquire);
+            if(_stop && empty) return;
+            if(empty) {
+                _waiting.store(true, std::memory_order_release);
+                // Strings pushed while this thread decides to wait are
+                // picked up after the timeout.
+                _wake.wait_for(lock, std::chrono::milliseconds(50));
+                _waiting.store(false, std::memory_order_release);
+            }
+        }
+    }
+
+    LogBuffer& _buffer;
+    Node _stub;
+    std::atomic<Node*> _head;
+    Node* _tail;
+    std::atomic<long long> _numPushed{0};
+    std::atomic<long long> _numLogged{0};
+    std::atomic<bool> _waiting{false};
+    bool _stop{false};
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _logged;
+    std::thread _thread;
+};
+
 //=============================================================================
 // LogBuffer
 //=============================================================================
+struct LogBuffer::ThreadState
+{
+    std::string str;
+    std::string* capture = nullptr;
+};
+
+namespace {
+    // Set when the calling thread's states have been destroyed; the thread
+    // may still write to std::cout (e.g., while the program exits).
+    thread_local bool threadStatesDestroyed = false;
+}
+
+// The states of the calling thread for each LogBuffer. When the thread
+// exits, its output that has not been flushed is logged.
+struct LogBuffer::ThreadStates
+{
+    std::map<LogBuffer*, ThreadState> states;
+
+    ~ThreadStates()
+    {
+        threadStatesDestroyed = true;
+        for(auto& entry : states)
+            entry.first->logThreadString(entry.second);
+    }
+};
+
 LogBuffer::LogBuffer()
 {
+    // Without a put area, every character goes through overflow() or
+    // xsputn(), which write to the calling thread's string.
+    setp(nullptr, nullptr);
 }
 
 LogBuffer::~LogBuffer()
 {
+    setAsynchronous(false);
     for(int i = 0; i < _logCallbacks.size(); i++) {
         delete _logCallbacks[i];
     }
@@ -72,6 +298,7 @@ LogBuffer::~LogBuffer()
 bool LogBuffer::
 addLogCallback(LogCallback *aLogCallback)
 {
+    std::lock_guard<std::mutex> lock(_logCallbacksMutex);
     if(_logCallbacks.findIndex(aLogCallback) >= 0) return false;
     _logCallbacks.append(aLogCallback); 
     return true;
@@ -80,20 +307,118 @@ addLogCallback(LogCallback *aLogCallback)
 bool LogBuffer::
 removeLogCallback(LogCallback *aLogCallback)
 {
+    std::lock_guard<std::mutex> lock(_logCallbacksMutex);
     int index = _logCallbacks.findIndex(aLogCallback);
     if(index < 0) return false;
     _logCallbacks.remove(index); 
     return true;
 }
 
+void LogBuffer::
+setAsynchronous(bool aAsynchronous)
+{
+    // Threads that log wait for the lock, so no string is pushed to a queue
+    // that is being destroyed, and the strings queued so far are logged
+    // before any string that is logged afterwards.
+    std::lock_guard<std::mutex> lock(_asyncQueueMutex);
+    if(aAsynchronous == (_asyncQueue != nullptr)) return;
+    if(_asyncQueue) {
+        _asyncQueue->waitUntilLogged();
+        _asyncQueue.reset();
+    }
+    if(aAsynchronous)
+        _asyncQueue.reset(new AsyncQueue(*this));
+}
+
+bool LogBuffer::
+isAsynchronous() const
+{
+    std::lock_guard<std::mutex> lock(_asyncQueueMutex);
+    return _asyncQueue != nullptr;
+}
+
+void LogBuffer::
+waitUntilLogged()
+{
+    std::lock_guard<std::mutex> lock(_asyncQueueMutex);
+    if(_asyncQueue) _asyncQueue->waitUntilLogged();
+}
+
+std::string* LogBuffer::
+setThreadCapture(std::string* aCapture)
+{
+    ThreadState& state = getThreadState();
+    std::string* previous = state.capture;
+    state.capture = aCapture;
+    return previous;
+}
+
+LogBuffer::ThreadState& LogBuffer::
+getThreadState()
+{
+    static thread_local ThreadStates threadStates;
+    if(threadStatesDestroyed) {
+        // Nothing is captured once the thread's states are gone.
+        static thread_local ThreadState exitState;
+        exitState.capture = nullptr;
+        return exitState;
+    }
+    return threadStates.states[this];
+}
+
+LogBuffer::int_type LogBuffer::
+overflow(int_type c)
+{
+    if(!traits_type::eq_int_type(c, traits_type::eof()))
+        getThreadState().str += traits_type::to_char_type(c);
+    return traits_type::not_eof(c);
+}
+
+std::streamsize LogBuffer::
+xsputn(const char* s, std::streamsize n)
+{
+    getThreadState().str.append(s, size_t(n));
+    return n;
+}
+
+void LogBuffer::
+logToCallbacks(const std::string &aStr)
+{
+    std::lock_guard<std::mutex> lock(_logCallbacksMutex);
+    for(int i=0; i<_logCallbacks.getSize(); i++) {
+        try {
+            _logCallbacks[i]->log(aStr);
+        } catch(...) {
+            // A failing callback must not prevent the others from logging,
+            // nor terminate the background thread.
+        }
+    }
+}
+
 int LogBuffer::
 sync()
 {
-    // Pass current string to all log callbacks
-    for(int i=0; i<_logCallbacks.getSize(); i++) _logCallbacks[i]->log(str());
-    // Reset current buffer contents
-    str("");
-    return std::stringbuf::sync();
+    logThreadString(getThreadState());
+    return 0;
+}
+
+void LogBuffer::
+logThreadString(ThreadState& state)
+{
+    if(state.str.empty()) return;
+    std::string str;
+    str.swap(state.str);
+    // Pass the calling thread's string to its capture or to all log
+    // callbacks, directly or through the background thread.
+    if(state.capture) {
+        state.capture->append(str);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_asyncQueueMutex);
+    if(_asyncQueue)
+        _asyncQueue->push(std::move(str));
+    else
+        logToCallbacks(str);
 }
 
 //=============================================================================
@@ -119,6 +444,7 @@ LogManager::~LogManager()
 {
     std::cout << std::flush;
     std::cerr << std::flush;
+    setAsynchronous(false);
 }
 
 LogManager *LogManager::getInstance()
@@ -135,3 +461,65 @@ LogBuffer *LogManager::getErrBuffer()
 {
     return &err;
 }
+
+void LogManager::setLevel(LogLevel level)
+{
+    _level.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+LogLevel LogManager::getLevel()
+{
+    return static_cast<LogLevel>(_level.load(std::memory_order_relaxed));
+}
+
+std::ostream& LogManager::getStream(LogLevel level)
+{
+    return level == LogLevel::Error ? std::cerr : std::cout;
+}
+
+void LogManager::setAsynchronous(bool asynchronous)
+{
+    std::cout << std::flush;
+    std::cerr << std::flush;
+    out.setAsynchronous(asynchronous);
+    err.setAsynchronous(asynchronous);
+}
+
+bool LogManager::isAsynchronous()
+{
+    return out.isAsynchronous();
+}
+
+void LogManager::flush()
+{
+    std::cout << std::flush;
+    std::cerr << std::flush;
+    out.waitUntilLogged();
+    err.waitUntilLogged();
+}
+
+//=============================================================================
+// LogCapture
+//=============================================================================
+LogCapture::LogCapture(std::string& out, std::string& err)
+{
+    // Output written before the capture is not captured.
+    std::cout << std::flush;
+    std::cerr << std::flush;
+    _previousOut = LogManager::out.setThreadCapture(&out);
+    _previousErr = LogManager::err.setThreadCapture(&err);
+}
+
+LogCapture::~LogCapture()
+{
+    std::cout << std::flush;
+    std::cerr << std::flush;
+    LogManager::out.setThreadCapture(_previousOut);
+    LogManager::err.setThreadCapture(_previousErr);
+}
+
+void LogCapture::write(const std::string& out, const std::string& err)
+{
+    if(!out.empty()) std::cout << out << std::flush;
+    if(!err.empty()) std::cerr << err << std::flush;
+}
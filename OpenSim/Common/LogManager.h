@@ -25,11 +25,94 @@
 #include "osimCommonDLL.h"
 #include "Array.h"
 #include "LogCallback.h"
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <sstream>
 
+/** Messages logged with OPENSIM_LOG() at a level above this one (see
+OpenSim::LogLevel) are removed at compile time. Define it (e.g., as 2 to keep
+only errors and warnings) before including this header or on the compiler's
+command line. */
+#ifndef OPENSIM_LOG_COMPILED_LEVEL
+#define OPENSIM_LOG_COMPILED_LEVEL 4
+#endif
+
+/** Write a message to the stream for the given OpenSim::LogLevel if the level
+is enabled (see LogManager::setLevel()). The message is a sequence of
+insertions, and it is not evaluated if the level is disabled:
+@code
+OPENSIM_LOG(OpenSim::LogLevel::Info, "Frame " << i << ": RMS = " << rms);
+@endcode */
+#define OPENSIM_LOG(level, message)                                           \
+    do {                                                                      \
+        if (static_cast<int>(level) <= OPENSIM_LOG_COMPILED_LEVEL &&          \
+                OpenSim::LogManager::isEnabled(level)) {                      \
+            OpenSim::LogManager::getStream(level) << message << std::endl;    \
+        }                                                                     \
+    } while (false)
+
+/** Same as OPENSIM_LOG() but the message is written only if the given
+OpenSim::LogRateLimiter allows it. Use this for messages that may repeat
+every frame or every time step. The first message written after some were
+suppressed says how many were suppressed. */
+#define OPENSIM_LOG_RATE_LIMITED(level, limiter, message)                     \
+    do {                                                                      \
+        if (static_cast<int>(level) <= OPENSIM_LOG_COMPILED_LEVEL &&          \
+                OpenSim::LogManager::isEnabled(level)) {                      \
+            int opensimLogNumSuppressed = 0;                                  \
+            if ((limiter).allow(opensimLogNumSuppressed)) {                   \
+                std::ostream& opensimLogStream =                              \
+                        OpenSim::LogManager::getStream(level);                \
+                if (opensimLogNumSuppressed > 0)                              \
+                    opensimLogStream << "(" << opensimLogNumSuppressed        \
+                            << " similar messages suppressed) ";              \
+                opensimLogStream << message << std::endl;                     \
+            }                                                                 \
+        }                                                                     \
+    } while (false)
+
 namespace OpenSim {
 
+/** The severity of a message logged with OPENSIM_LOG(). A message is written
+if its level is at or below the level set with LogManager::setLevel(). */
+enum class LogLevel {
+    Off   = 0, ///< Used only with LogManager::setLevel() to disable logging.
+    Error = 1,
+    Warn  = 2,
+    Info  = 3,
+    Debug = 4
+};
+
+/** Limits how often a repeated message is logged: up to maxBurst messages
+are allowed at once, and the allowance is replenished at one message per
+interval. See OPENSIM_LOG_RATE_LIMITED(). A limiter may be used from
+multiple threads. */
+class OSIMCOMMON_API LogRateLimiter {
+public:
+    explicit LogRateLimiter(int maxBurst = 10, double intervalInSeconds = 1.0);
+    LogRateLimiter(const LogRateLimiter& other);
+    LogRateLimiter& operator=(const LogRateLimiter& other);
+
+    /** Return true if a message may be logged now. numSuppressed is set to
+    the number of messages that were not allowed since the last message that
+    was allowed. */
+    bool allow(int& numSuppressed);
+
+    /** Restore the full allowance of messages. */
+    void reset();
+
+private:
+    int _maxBurst;
+    std::chrono::steady_clock::duration _interval;
+    double _allowance;
+    int _numSuppressed;
+    std::chrono::steady_clock::time_point _lastTime;
+    std::mutex _mutex;
+};
+
 // Excluding this from Doxygen until it has better documentation! -Sam Hamner
 /// @cond
 
@@ -55,10 +138,44 @@ public:
     bool addLogCallback(LogCallback *aLogCallback);
     bool removeLogCallback(LogCallback *aLogCallback);
 
+    // In asynchronous mode, each flushed string is added to a queue and the
+    // callbacks are invoked by a background thread, so flushing a string
+    // never waits for the callbacks. The mode can be changed while other
+    // threads log; the strings queued so far are logged before the mode
+    // changes.
+    void setAsynchronous(bool aAsynchronous);
+    bool isAsynchronous() const;
+    // Block until all strings flushed so far have been passed to the
+    // callbacks.
+    void waitUntilLogged();
+
+    // Append the strings that the calling thread flushes to aCapture instead
+    // of passing them to the callbacks; nullptr stops capturing. Returns the
+    // previous capture of the calling thread. See LogCapture.
+    std::string* setThreadCapture(std::string* aCapture);
+
 private:
+    class AsyncQueue;
+    // The output of a thread that has not been flushed yet. Each thread
+    // writes to its own string, so that threads writing to the same stream
+    // neither race nor interleave within a line.
+    struct ThreadState;
+    struct ThreadStates;
+
     Array<LogCallback*> _logCallbacks;
+    std::mutex _logCallbacksMutex;
+    // Guards _asyncQueue: held by the logging threads while they pass a
+    // string on, and by setAsynchronous() while it drains and replaces the
+    // queue. It is taken before _logCallbacksMutex.
+    mutable std::mutex _asyncQueueMutex;
+    std::unique_ptr<AsyncQueue> _asyncQueue;
 
+    ThreadState& getThreadState();
+    void logThreadString(ThreadState& state);
+    int_type overflow(int_type c) override;
+    std::streamsize xsputn(const char* s, std::streamsize n) override;
     int sync() override;
+    void logToCallbacks(const std::string &aStr);
 };
 /// @endcond
 
@@ -82,8 +199,64 @@ public:
 
     LogBuffer *getOutBuffer();
     LogBuffer *getErrBuffer();
+
+    // Messages at levels above this one are not written (default: Info).
+    static void setLevel(LogLevel level);
+    static LogLevel getLevel();
+    static bool isEnabled(LogLevel level) {
+        return static_cast<int>(level) <= _level.load(std::memory_order_relaxed);
+    }
+    // The stream to which messages at the given level are written: std::cerr
+    // for errors and std::cout otherwise.
+    static std::ostream& getStream(LogLevel level);
+
+    // Pass the output to the log callbacks (e.g., the terminal and the out.log
+    // and err.log files) on background threads, so that writing a line does
+    // not wait for the callbacks. The order of the lines in each of out and
+    // err is preserved, but not the order between them. Callbacks are invoked
+    // on the background threads. Switching back to synchronous mode waits for
+    // all pending output.
+    static void setAsynchronous(bool asynchronous);
+    static bool isAsynchronous();
+    // Flush std::cout and std::cerr and wait until their output has been
+    // passed to the log callbacks.
+    static void flush();
+
+private:
+    static std::atomic<int> _level;
 };
 /// @endcond
+
+/** While an object of this class exists, the output that the thread that
+created it writes to std::cout and std::cerr is appended to the given strings
+instead of being logged. Tasks that run in parallel use this so that their
+output can be logged in order once they have all finished:
+@code
+// In each task (e.g., on a SimTK::ParallelExecutor thread):
+{
+    LogCapture capture(outputs[i].out, outputs[i].err);
+    // ... std::cout << ... ;
+}
+// Then, on the calling thread:
+for (const auto& output : outputs)
+    LogCapture::write(output.out, output.err);
+@endcode
+The output of other threads is not affected, and captures may be nested. */
+class OSIMCOMMON_API LogCapture {
+public:
+    LogCapture(std::string& out, std::string& err);
+    ~LogCapture();
+
+    LogCapture(const LogCapture&) = delete;
+    LogCapture& operator=(const LogCapture&) = delete;
+
+    /** Log output that was captured, to std::cout and std::cerr. */
+    static void write(const std::string& out, const std::string& err);
+
+private:
+    std::string* _previousOut;
+    std::string* _previousErr;
+};
 }
 
 #endif
@@ -182,6 +182,20 @@ double MultiplierFunction::calcValue(const SimTK::Vector& x) const
     }
 }
 
+void MultiplierFunction::calcValueAndDerivatives(double aX, double& rValue,
+        double& rFirstDeriv, double& rSecondDeriv, int* rInterval) const
+{
+    if (_osFunction) {
+        _osFunction->calcValueAndDerivatives(aX, rValue, rFirstDeriv,
+                                             rSecondDeriv, rInterval);
+        rValue *= _scale;
+        rFirstDeriv *= _scale;
+        rSecondDeriv *= _scale;
+    }
+    else
+        throw Exception("MultiplierFunction::calcValueAndDerivatives(): _osFunction is NULL.");
+}
+
 int MultiplierFunction::getArgumentSize() const
 {
     if (_osFunction)
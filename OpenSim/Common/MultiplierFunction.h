@@ -102,6 +102,9 @@ public:
     //--------------------------------------------------------------------------
     double calcValue(const SimTK::Vector& x) const override;
     double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const override;
+    void calcValueAndDerivatives(double aX, double& rValue,
+            double& rFirstDeriv, double& rSecondDeriv,
+            int* rInterval = nullptr) const override;
     int getArgumentSize() const override;
     int getMaxDerivativeOrder() const override;
     SimTK::Function* createSimTKFunction() const override;
@@ -443,19 +443,7 @@ double PiecewiseLinearFunction::calcValue(const Vector& x) const
     else if (EQUAL_WITHIN_ERROR(aX,_x[n-1]))
         return _y[n-1];
 
-    // Do a binary search to find which two points the abscissa is between.
-    int k, i = 0;
-    int j = n;
-    while (1)
-    {
-        k = (i+j)/2;
-        if (aX < _x[k])
-            j = k;
-        else if (aX > _x[k+1])
-            i = k;
-        else
-            break;
-    }
+    int k = findInterval(aX);
 
     return _y[k] + (aX - _x[k]) * _b[k];
 }
@@ -486,6 +474,62 @@ double PiecewiseLinearFunction::calcDerivative(const std::vector<int>& derivComp
         return _b[n-1];
     }
 
+    int k = findInterval(aX);
+
+    return _b[k];
+}
+
+void PiecewiseLinearFunction::calcValueAndDerivatives(double aX,
+        double& rValue, double& rFirstDeriv, double& rSecondDeriv,
+        int* rInterval) const
+{
+    int n = _x.getSize();
+    rSecondDeriv = 0.0;
+
+    if (aX < _x[0]) {
+        rValue = _y[0] + (aX - _x[0]) * _b[0];
+        rFirstDeriv = _b[0];
+        return;
+    } else if (aX > _x[n-1]) {
+        rValue = _y[n-1] + (aX - _x[n-1]) * _b[n-1];
+        rFirstDeriv = _b[n-1];
+        return;
+    }
+
+    if (EQUAL_WITHIN_ERROR(aX, _x[0])) {
+        rValue = _y[0];
+        rFirstDeriv = _b[0];
+        return;
+    } else if (EQUAL_WITHIN_ERROR(aX,_x[n-1])) {
+        rValue = _y[n-1];
+        rFirstDeriv = _b[n-1];
+        return;
+    }
+
+    int k = findInterval(aX, (rInterval != nullptr) ? *rInterval : -1);
+    if (rInterval != nullptr) *rInterval = k;
+
+    rValue = _y[k] + (aX - _x[k]) * _b[k];
+    rFirstDeriv = _b[k];
+}
+
+int PiecewiseLinearFunction::findInterval(double aX, int aHint) const
+{
+    int n = _x.getSize();
+
+    // When sweeping over aX, the abscissa is usually in the same interval as
+    // on the previous call, or in one of its neighbors.
+    if (aHint >= 0 && aHint < n-1) {
+        if (aX >= _x[aHint]) {
+            if (aX <= _x[aHint+1])
+                return aHint;
+            if (aHint < n-2 && aX <= _x[aHint+2])
+                return aHint+1;
+        }
+        else if (aHint > 0 && aX >= _x[aHint-1])
+            return aHint-1;
+    }
+
     // Do a binary search to find which two points the abscissa is between.
     int k, i = 0;
     int j = n;
@@ -499,8 +543,7 @@ double PiecewiseLinearFunction::calcDerivative(const std::vector<int>& derivComp
         else
             break;
     }
-
-    return _b[k];
+    return k;
 }
 
 int PiecewiseLinearFunction::getArgumentSize() const
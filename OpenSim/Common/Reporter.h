@@ -202,6 +202,13 @@ public:
         }
     }
 
+    /** Replace the report with the given table, for example, to restore the
+    report of a simulation that continues from a checkpoint (see
+    Manager::initializeFromCheckpoint()).                                    */
+    void setTable(const TimeSeriesTable_<ValueT>& table) {
+        _outputTable = table;
+    }
+
 protected:
     void implementReport(const SimTK::State& state) const override {
         const auto& input = this->template getInput<InputT>("inputs");
@@ -516,7 +516,7 @@ double SimmSpline::calcValue(const Vector& x) const
     if(!_c.getSize()) return(SimTK::NaN);
     if(!_d.getSize()) return(SimTK::NaN);
 
-    int i, j, k;
+    int k;
     double dx;
 
     int n = _x.getSize();
@@ -546,30 +546,7 @@ double SimmSpline::calcValue(const Vector& x) const
    else if (EQUAL_WITHIN_ERROR(aX,_x[n-1]))
        return _y[n-1];
 
-    if (n < 3)
-    {
-        /* If there are only 2 function points, then set k to zero
-         * (you've already checked to see if the abscissa is out of
-         * range or equal to one of the endpoints).
-         */
-        k = 0;
-    }
-    else
-    {
-        /* Do a binary search to find which two points the abscissa is between. */
-        i = 0;
-        j = n;
-        while (1)
-        {
-            k = (i+j)/2;
-            if (aX < _x[k])
-                j = k;
-            else if (aX > _x[k+1])
-                i = k;
-            else
-                break;
-        }
-    }
+    k = findInterval(aX);
 
    dx = aX - _x[k];
    return _y[k] + dx*(_b[k] + dx*(_c[k] + dx*_d[k]));
@@ -583,7 +560,7 @@ double SimmSpline::calcDerivative(const std::vector<int>& derivComponents, const
     if(!_c.getSize()) return(SimTK::NaN);
     if(!_d.getSize()) return(SimTK::NaN);
 
-    int i, j, k;
+    int k;
     double dx;
 
     int n = _x.getSize();
@@ -636,30 +613,7 @@ double SimmSpline::calcDerivative(const std::vector<int>& derivComponents, const
          return 2.0*_c[n-1];
    }
 
-    if (n < 3)
-    {
-        /* If there are only 2 function points, then set k to zero
-         * (you've already checked to see if the abscissa is out of
-         * range or equal to one of the endpoints).
-         */
-        k = 0;
-    }
-    else
-    {
-        /* Do a binary search to find which two points the abscissa is between. */
-        i = 0;
-        j = n;
-        while (1)
-        {
-            k = (i+j)/2;
-            if (aX < _x[k])
-                j = k;
-            else if (aX > _x[k+1])
-                i = k;
-            else
-                break;
-        }
-    }
+    k = findInterval(aX);
 
    dx = aX - _x[k];
 
@@ -670,6 +624,93 @@ double SimmSpline::calcDerivative(const std::vector<int>& derivComponents, const
       return (2.0*_c[k] + 6.0*dx*_d[k]);
 }
 
+void SimmSpline::calcValueAndDerivatives(double aX, double& rValue,
+        double& rFirstDeriv, double& rSecondDeriv, int* rInterval) const
+{
+    // NOT A NUMBER
+    if(!_y.getSize() || !_b.getSize() || !_c.getSize() || !_d.getSize()) {
+        rValue = rFirstDeriv = rSecondDeriv = SimTK::NaN;
+        return;
+    }
+
+    int n = _x.getSize();
+
+    // Extrapolate linearly outside the range of the function, and handle the
+    // end points, as in calcValue() and calcDerivative().
+    if (aX < _x[0]) {
+        rValue = _y[0] + (aX - _x[0])*_b[0];
+        rFirstDeriv = _b[0];
+        rSecondDeriv = 0;
+        return;
+    }
+    else if (aX > _x[n-1]) {
+        rValue = _y[n-1] + (aX - _x[n-1])*_b[n-1];
+        rFirstDeriv = _b[n-1];
+        rSecondDeriv = 0;
+        return;
+    }
+    if (EQUAL_WITHIN_ERROR(aX,_x[0])) {
+        rValue = _y[0];
+        rFirstDeriv = _b[0];
+        rSecondDeriv = 2.0*_c[0];
+        return;
+    }
+    else if (EQUAL_WITHIN_ERROR(aX,_x[n-1])) {
+        rValue = _y[n-1];
+        rFirstDeriv = _b[n-1];
+        rSecondDeriv = 2.0*_c[n-1];
+        return;
+    }
+
+    int k = findInterval(aX, (rInterval != nullptr) ? *rInterval : -1);
+    if (rInterval != nullptr) *rInterval = k;
+
+    double dx = aX - _x[k];
+    rValue = _y[k] + dx*(_b[k] + dx*(_c[k] + dx*_d[k]));
+    rFirstDeriv = _b[k] + dx*(2.0*_c[k] + 3.0*dx*_d[k]);
+    rSecondDeriv = 2.0*_c[k] + 6.0*dx*_d[k];
+}
+
+int SimmSpline::findInterval(double aX, int aHint) const
+{
+    int n = _x.getSize();
+
+    /* If there are only 2 function points, then the abscissa is in the
+     * first interval (the caller has already checked to see if the abscissa
+     * is out of range or equal to one of the endpoints).
+     */
+    if (n < 3)
+        return 0;
+
+    // When sweeping over aX, the abscissa is usually in the same interval as
+    // on the previous call, or in one of its neighbors.
+    if (aHint >= 0 && aHint < n-1) {
+        if (aX >= _x[aHint]) {
+            if (aX <= _x[aHint+1])
+                return aHint;
+            if (aHint < n-2 && aX <= _x[aHint+2])
+                return aHint+1;
+        }
+        else if (aHint > 0 && aX >= _x[aHint-1])
+            return aHint-1;
+    }
+
+    /* Do a binary search to find which two points the abscissa is between. */
+    int k, i = 0;
+    int j = n;
+    while (1)
+    {
+        k = (i+j)/2;
+        if (aX < _x[k])
+            j = k;
+        else if (aX > _x[k+1])
+            i = k;
+        else
+            break;
+    }
+    return k;
+}
+
 int SimmSpline::getArgumentSize() const
 {
     return 1;
@@ -120,6 +120,12 @@ public:
     //--------------------------------------------------------------------------
     double calcValue(const SimTK::Vector& x) const override;
     double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const override;
+    /** Calculate the value and the first and second derivatives at aX with
+    a single search for the interval containing aX. See
+    Function::calcValueAndDerivatives(). */
+    void calcValueAndDerivatives(double aX, double& rValue,
+            double& rFirstDeriv, double& rSecondDeriv,
+            int* rInterval = nullptr) const override;
     int getArgumentSize() const override;
     int getMaxDerivativeOrder() const override;
     SimTK::Function* createSimTKFunction() const override;
@@ -128,6 +134,10 @@ public:
 
 private:
     void calcCoefficients();
+    // Return the index k of the interval [x[k], x[k+1]] containing aX, which
+    // must lie strictly within the range of x. The interval aHint and its
+    // neighbors are checked before falling back to a binary search.
+    int findInterval(double aX, int aHint = -1) const;
 //=============================================================================
 };  // END class SimmSpline
 
@@ -24,6 +24,7 @@
 // INCLUDES
 //=============================================================================
 #include "SmoothSegmentedFunction.h"
+#include "Exception.h"
 #include <fstream>
 #include "simmath/internal/SplineFitter.h"
 
@@ -230,6 +231,148 @@ double SmoothSegmentedFunction::calcValue(const SimTK::Vector& ax) const
     return calcValue(ax(0)); 
 }
 
+namespace {
+    // Quintic Bezier curve, and its derivative with respect to u, for point i
+    // of a block of control points stored as 6 rows of length n. The
+    // arithmetic is that of SegmentedQuinticBezierToolkit's
+    // calcQuinticBezierCurveVal and calcQuinticBezierCurveDerivU (order 1), so
+    // that calcValues takes the same iterates as calcValue.
+    inline double calcBezierVal(double u, const double* p, int n, int i)
+    {
+        const double u4 = u;
+        const double u3 = u4*u;
+        const double u2 = u3*u;
+        const double u1 = u2*u;
+        const double u0 = u1*u;
+        const double t2 = u1 * 0.5e1;
+        const double t3 = u2 * 0.10e2;
+        const double t4 = u3 * 0.10e2;
+        const double t5 = u4 * 0.5e1;
+        const double t9 = u0 * 0.5e1;
+        const double t10 = u1 * 0.20e2;
+        const double t11 = u2 * 0.30e2;
+        const double t15 = u0 * 0.10e2;
+        return p[i] * (u0 * (-0.1e1) + t2 - t3 + t4 - t5 + 0.1e1)
+             + p[n+i] * (t9 - t10 + t11 + u3 * (-0.20e2) + t5)
+             + p[2*n+i] * (-t15 + u1 * 0.30e2 - t11 + t4)
+             + p[3*n+i] * (t15 - t10 + t3)
+             + p[4*n+i] * (-t9 + t2) + p[5*n+i] * u0 * 0.1e1;
+    }
+
+    inline double calcBezierDerivU(double u, const double* p, int n, int i)
+    {
+        const double t1 = u*u;
+        const double t2 = t1*t1;
+        const double t4 = t1 * u;
+        const double t5 = t4 * 0.20e2;
+        const double t6 = t1 * 0.30e2;
+        const double t7 = u * 0.20e2;
+        const double t10 = t2 * 0.25e2;
+        const double t11 = t4 * 0.80e2;
+        const double t12 = t1 * 0.90e2;
+        const double t16 = t2 * 0.50e2;
+        return p[i] * (t2 * (-0.5e1) + t5 - t6 + t7 - 0.5e1)
+             + p[n+i] * (t10 - t11 + t12 + u * (-0.40e2) + 0.5e1)
+             + p[2*n+i] * (-t16 + t4 * 0.120e3 - t12 + t7)
+             + p[3*n+i] * (t16 - t11 + t6)
+             + p[4*n+i] * (-t10 + t5)
+             + p[5*n+i] * t2 * 0.5e1;
+    }
+}
+
+void SmoothSegmentedFunction::calcValues(int n,
+    const SmoothSegmentedFunction* const* functions,
+    const double* x, double* y, std::vector<double>& work)
+{
+    if(n <= 0)
+        return;
+
+    // Scratch layout: 6 rows of x control points, 6 rows of y control points,
+    // then u, f, the in-domain flag and the pathologic flag, each of length n.
+    work.resize(16*n);
+    double* px         = &work[0];
+    double* py         = px + 6*n;
+    double* u          = py + 6*n;
+    double* f          = u + n;
+    double* bezier     = f + n;
+    double* pathologic = bezier + n;
+
+    // Gather the Bezier section that contains each point, and the spline
+    // estimate of u. Points in the linear extrapolation regions are evaluated
+    // here and given a constant section x(u) = x so that the iteration below
+    // leaves them alone.
+    for(int i=0; i<n; ++i){
+        const SmoothSegmentedFunction& fcn = *functions[i];
+        const double xi = x[i];
+        if(xi >= fcn._x0 && xi <= fcn._x1){
+            int idx = SegmentedQuinticBezierToolkit::calcIndex(xi,fcn._mXVec);
+            const SimTK::Vector& bezierPtsX = fcn._mXVec[idx];
+            const SimTK::Vector& bezierPtsY = fcn._mYVec[idx];
+            for(int k=0; k<6; ++k){
+                px[k*n+i] = bezierPtsX(k);
+                py[k*n+i] = bezierPtsY(k);
+            }
+            u[i] = min(1.0, max(0.0, fcn._arraySplineUX[idx].calcValue(xi)));
+            bezier[i] = 1.0;
+        }else{
+            for(int k=0; k<6; ++k){
+                px[k*n+i] = xi;
+                py[k*n+i] = 0.0;
+            }
+            u[i] = 0.0;
+            bezier[i] = 0.0;
+            if(xi < fcn._x0){
+                y[i] = fcn._y0 + fcn._dydx0*(xi-fcn._x0);
+            }else{
+                y[i] = fcn._y1 + fcn._dydx1*(xi-fcn._x1);
+            }
+        }
+    }
+
+    // Newton iterate all points with the stopping and convergence tests of
+    // calcU. Points that have stopped keep their value of u, so each point
+    // takes the same steps, and fails in the same cases, as calcU.
+    for(int i=0; i<n; ++i){
+        f[i] = calcBezierVal(u[i],px,n,i) - x[i];
+        pathologic[i] = 0.0;
+    }
+
+    for(int iter=0; iter < MAXITER; ++iter){
+        int numActive = 0;
+        for(int i=0; i<n; ++i)
+            numActive += (abs(f[i]) > UTOL && pathologic[i] < 0.5) ? 1 : 0;
+        if(numActive == 0)
+            break;
+
+        for(int i=0; i<n; ++i){
+            const bool active = abs(f[i]) > UTOL && pathologic[i] < 0.5;
+            const double df = calcBezierDerivU(u[i],px,n,i);
+            const bool step = active && abs(df) > 0;
+            pathologic[i] = (active && !step) ? 1.0 : pathologic[i];
+            const double ui = step ? u[i] + -f[i]/df : u[i];
+            u[i] = min(1.0, max(0.0, ui));
+        }
+        for(int i=0; i<n; ++i)
+            f[i] = calcBezierVal(u[i],px,n,i) - x[i];
+    }
+
+    for(int i=0; i<n; ++i){
+        OPENSIM_THROW_IF(f[i] > UTOL, OpenSim::Exception,
+            functions[i]->_name + ": desired tolerance on U not met by the "
+            "Newton iteration. A tolerance of " + to_string(f[i]) +
+            " was reached.");
+        OPENSIM_THROW_IF(pathologic[i] > 0.5, OpenSim::Exception,
+            functions[i]->_name + ": Newton iteration went pathologic: "
+            "df = 0 to machine precision.");
+    }
+
+    // Evaluate y(u) for the points that lie on a Bezier section.
+    for(int i=0; i<n; ++i){
+        const double yBezier = calcBezierVal(u[i],py,n,i);
+        y[i] = (bezier[i] > 0.5) ? yBezier : y[i];
+    }
+}
+
 /*Detailed Computational Costs
 ________________________________________________________________________
 If x is in the Bezier Curve, and dy/dx is being evaluated
@@ -24,6 +24,7 @@
  * -------------------------------------------------------------------------- */
 #include "osimCommonDLL.h"
 #include "SegmentedQuinticBezierToolkit.h"
+#include <vector>
 
 namespace OpenSim { 
 
@@ -130,6 +131,37 @@ namespace OpenSim {
        // SmoothSegmentedFunction is used (e.g., calcValue() delegates to the
        // internal `m_value`).
        using Function_<double>::calcDerivative;
+
+       /**Evaluates many curves, one point each, in structure-of-arrays form:
+       y[i] is set to functions[i]->calcValue(x[i]). The Bezier section that
+       contains each point is gathered into contiguous control point arrays,
+       and the Newton iteration that inverts x(u) is run in lockstep across
+       all of the points, so that the polynomial arithmetic of the iteration
+       is done in plain loops over contiguous memory that the compiler can
+       vectorize. Each point takes the same iterates, with the same stopping
+       and convergence tests, as calcValue(double), so the results are the
+       same.
+
+       @param n         The number of points
+       @param functions The n curves to evaluate; entries may repeat
+       @param x         The n domain points
+       @param y         The n curve values (output)
+       @param work      Scratch storage. It is resized as needed and can be
+                        reused across calls to avoid reallocation.
+       @throws OpenSim::Exception
+        -If the Newton iteration does not converge for any of the points, in
+         the cases in which calcValue(double) throws
+
+       <B>Computational Costs</B>
+       \verbatim
+            per point in curve domain  : ~282 flops, as calcValue(double)
+            per point in linear section:   ~5 flops
+       \endverbatim
+       */
+       static void calcValues(int n,
+                              const SmoothSegmentedFunction* const* functions,
+                              const double* x, double* y,
+                              std::vector<double>& work);
 #endif
 
 
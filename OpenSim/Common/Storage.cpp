@@ -42,61 +42,6 @@
 using namespace OpenSim;
 using namespace std;
 
-void convertTableToStorage(const AbstractDataTable* table, Storage& sto)
-{
-    sto.purge();
-    TimeSeriesTable out;
-
-    if (auto td = dynamic_cast<const TimeSeriesTable*>(table))
-        // Table is already flattened, so clone for further processing
-        out = TimeSeriesTable{ *td };
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec2>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec3>*>(table))
-        out = tst->flatten({ "_x", "_y", "_z" });
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec4>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec5>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec6>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec7>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec8>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec9>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec<10>>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec<11>>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec<12>>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::UnitVec3>*>(table))
-        out = tst->flatten({ "_x", "_y", "_z" });
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Quaternion>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::SpatialVec>*>(table))
-        out = tst->flatten({ "_rx", "_ry", "_rz", "_tx", "_ty", "_tz" });
-    else {
-        OPENSIM_THROW( STODataTypeNotSupported, typeid(table).name());
-    }
-
-    OpenSim::Array<std::string> labels("", (int)out.getNumColumns() + 1);
-    labels[0] = "time";
-    for (int i = 0; i < (int)out.getNumColumns(); ++i) {
-        labels[i + 1] = out.getColumnLabel(i);
-    }
-    sto.setColumnLabels(labels);
-
-    const auto& times = out.getIndependentColumn();
-    for (unsigned i_time = 0; i_time < out.getNumRows(); ++i_time) {
-        const SimTK::Vector rowVector =
-            out.getRowAtIndex(i_time).transpose().getAsVector();
-        sto.append(times[i_time], rowVector);
-    }
-}
-
 
 //============================================================================
 // DEFINES
@@ -210,7 +155,7 @@ Storage::Storage(const string &fileName, bool readHeadersOnly) :
                     << "Only the first table '" << tables.begin()->first << "' will "
                     << "be loaded as Storage." << endl;
             }
-            convertTableToStorage(tables.begin()->second.get(), *this);
+            copyDataFromTable(tables.begin()->second.get());
             return;
         }
         catch (const std::exception& x) {
@@ -329,6 +274,32 @@ Storage::Storage(const Storage &aStorage,bool aCopyData) :
     if(aCopyData) copyData(aStorage);
 }
 //_____________________________________________________________________________
+/**
+ * Construct a Storage from a TimeSeriesTable.
+ */
+Storage::Storage(const TimeSeriesTable& table) :
+    StorageInterface("UNKNOWN"),
+    _storage(StateVector())
+{
+    // SET NULL STATES
+    setNull();
+    _storage.setCapacityIncrement(-1);
+    _fileVersion = Storage::LatestVersion;
+
+    // The metadata written by exportToTable().
+    setName(table.hasTableMetaDataKey("header") ?
+            table.getTableMetaDataAsString("header") : "UNKNOWN");
+    if (table.hasTableMetaDataKey("description"))
+        setDescription(table.getTableMetaDataAsString("description"));
+    if (table.hasTableMetaDataKey("inDegrees")) {
+        const std::string inDegrees = IO::Lowercase(
+                table.getTableMetaDataAsString("inDegrees"));
+        setInDegrees(inDegrees == "yes" || inDegrees == "y");
+    }
+
+    copyDataFromTable(&table);
+}
+//_____________________________________________________________________________
 /**
  * Construct a copy of a specified storage taking only a subset of the states.
  *
@@ -443,6 +414,76 @@ copyData(const Storage &aStorage)
         _storage.append(aStorage._storage[i]);
     }
 }
+//_____________________________________________________________________________
+/**
+ * Replace the column labels and the stored data with those of a table.
+ * Tables with elements other than double (e.g., SimTK::Vec3) are flattened
+ * into multiple columns per element.
+ */
+void Storage::
+copyDataFromTable(const AbstractDataTable* table)
+{
+    purge();
+    TimeSeriesTable out;
+
+    if (auto td = dynamic_cast<const TimeSeriesTable*>(table))
+        // Table is already flattened. The copy shares the data of the table.
+        out = *td;
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec2>*>(table))
+        out = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec3>*>(table))
+        out = tst->flatten({ "_x", "_y", "_z" });
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec4>*>(table))
+        out = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec5>*>(table))
+        out = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec6>*>(table))
+        out = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec7>*>(table))
+        out = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec8>*>(table))
+        out = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec9>*>(table))
+        out = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec<10>>*>(table))
+        out = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec<11>>*>(table))
+        out = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec<12>>*>(table))
+        out = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::UnitVec3>*>(table))
+        out = tst->flatten({ "_x", "_y", "_z" });
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Quaternion>*>(table))
+        out = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::SpatialVec>*>(table))
+        out = tst->flatten({ "_rx", "_ry", "_rz", "_tx", "_ty", "_tz" });
+    else {
+        OPENSIM_THROW( STODataTypeNotSupported, typeid(table).name());
+    }
+
+    OpenSim::Array<std::string> labels("", (int)out.getNumColumns() + 1);
+    labels[0] = "time";
+    for (int i = 0; i < (int)out.getNumColumns(); ++i) {
+        labels[i + 1] = out.getColumnLabel(i);
+    }
+    setColumnLabels(labels);
+
+    // Fill the StateVectors in place rather than appending copies of them.
+    const auto& times = out.getIndependentColumn();
+    const auto& matrix = out.getMatrix();
+    const int nRows = matrix.nrow();
+    const int nCols = matrix.ncol();
+    _storage.ensureCapacity(nRows);
+    _storage.setSize(nRows);
+    for (int r = 0; r < nRows; ++r) {
+        StateVector& vec = _storage[r];
+        vec.setTime(times[r]);
+        Array<double>& data = vec.getData();
+        data.setSize(nCols);
+        for (int c = 0; c < nCols; ++c)
+            data[c] = matrix(r, c);
+    }
+}
 
 
 
@@ -1371,7 +1412,32 @@ Storage::getColumnIndicesForIdentifier(const std::string& identifier) const
 }
 
 TimeSeriesTable Storage::exportToTable() const {
-    TimeSeriesTable table{};
+    // Exclude the first column label. It is 'time'. Time is a separate column
+    // in TimeSeriesTable and column label is optional.
+    const int nRows = _storage.getSize();
+    const int nCols = std::max(0, _columnLabels.getSize() - 1);
+    std::vector<std::string> labels;
+    if (nCols > 0)
+        labels.assign(_columnLabels.get() + 1,
+                      _columnLabels.get() + _columnLabels.getSize());
+
+    // Fill the matrix of the table directly; appending the rows one at a
+    // time would reallocate the matrix for every row, and constructing the
+    // table from a filled matrix would copy it.
+    std::vector<double> times(nRows);
+    for(int i = 0; i < nRows; ++i)
+        times[i] = _storage[i].getTime();
+    TimeSeriesTable table{times, labels};
+    table.fillMatrix([&](SimTK::Matrix& matrix) {
+        for(int i = 0; i < nRows; ++i) {
+            const Array<double>& row = _storage[i].getData();
+            OPENSIM_THROW_IF(row.getSize() != nCols, IncorrectNumColumns,
+                             static_cast<size_t>(nCols),
+                             static_cast<size_t>(row.getSize()));
+            for(int j = 0; j < nCols; ++j)
+                matrix(i, j) = row[j];
+        }
+    });
 
     table.addTableMetaData("header", getName());
     table.addTableMetaData("inDegrees", std::string{_inDegrees ? "yes" : "no"});
@@ -1380,19 +1446,6 @@ TimeSeriesTable Storage::exportToTable() const {
     if(!getDescription().empty())
         table.addTableMetaData("description", getDescription());
 
-    // Exclude the first column label. It is 'time'. Time is a separate column
-    // in TimeSeriesTable and column label is optional.
-    table.setColumnLabels(_columnLabels.get() + 1, 
-                          _columnLabels.get() + _columnLabels.getSize());
-
-    for(int i = 0; i < _storage.getSize(); ++i) {
-        const auto& row = getStateVector(i)->getData();
-        const auto time = getStateVector(i)->getTime();
-        // Exclude the first column. It is 'time'. Time is a separate column in
-        // TimeSeriesTable.
-        table.appendRow(time, row.get(), row.get() + row.getSize());
-    }
-
     return table;
 }
 
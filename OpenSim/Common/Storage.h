@@ -131,6 +131,13 @@ public:
     Storage(const Storage &aStorage,bool aCopyData=true);
     Storage(const Storage &aStorage,int aStateIndex,int aN,
         const char *aDelimiter="\t");
+    /** Construct a Storage from a TimeSeriesTable. The column labels are
+    "time" followed by the column labels of the table. The name, description
+    and whether angles are in degrees are taken from the "header",
+    "description" and "inDegrees" metadata of the table, if present (see
+    exportToTable()). Storage keeps its data as rows (StateVectors), so the
+    data of the table is copied once, directly into the rows. */
+    explicit Storage(const TimeSeriesTable& table);
     virtual ~Storage();
 
 #ifndef SWIG
@@ -154,6 +161,7 @@ private:
     void allocateCapacity();
     void setNull();
     void copyData(const Storage &aStorage);
+    void copyDataFromTable(const AbstractDataTable* table);
     void parseColumnLabels(const char *aLabels);
     bool parseHeaders(std::ifstream& aStream, int& rNumRows, int& rNumColumns);
     bool isSimmReservedToken(const std::string& aToken);
@@ -207,7 +215,9 @@ public:
     void getDataColumn(const std::string& columnName, Array<double>& data, double startTime=0.0) override;
 
     /** Convert to a TimeSeriesTable. This may be useful if you need to use
-    parts of the API that require a TimeSeriesTable instead of a Storage. */
+    parts of the API that require a TimeSeriesTable instead of a Storage. The
+    data is copied once, directly into the matrix of the table; copies of the
+    returned table share that matrix until one of them is modified. */
     TimeSeriesTable exportToTable() const;
 
 #ifndef SWIG
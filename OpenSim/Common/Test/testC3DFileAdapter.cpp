@@ -193,6 +193,88 @@ void test(const std::string filename) {
         << 1.e3*(std::clock() - startTime) / CLOCKS_PER_SEC  << "ms" << endl;
 }
 
+template<typename ETY>
+void compare_columns(const OpenSim::TimeSeriesTable_<ETY>& table1,
+                     const std::string& label1,
+                     const OpenSim::TimeSeriesTable_<ETY>& table2,
+                     const std::string& label2) {
+    const auto col1 = table1.getDependentColumn(label1);
+    const auto col2 = table2.getDependentColumn(label2);
+    ASSERT(col1.size() == col2.size(), __FILE__, __LINE__,
+        "Columns '" + label1 + "' and '" + label2 + "' differ in length.");
+    for(int r = 0; r < col1.size(); ++r)
+        ASSERT_EQUAL(col1[r], col2[r], 0.0, __FILE__, __LINE__,
+            "Columns '" + label1 + "' and '" + label2 + "' differ at row " +
+            std::to_string(r) + ".");
+}
+
+// Reading with multiple threads, or only some of the markers and force
+// plates, must give the same values as reading the whole file on one thread.
+// Also reports the time taken by each.
+void testSelectionsAndThreads(const std::string filename) {
+    using namespace OpenSim;
+    using namespace std;
+
+    auto timeRead = [&filename](const C3DFileAdapter& c3d,
+                                C3DFileAdapter::Tables& tables) {
+        const int numReads = 5;
+        auto start = chrono::steady_clock::now();
+        for(int i = 0; i < numReads; ++i)
+            tables = c3d.readTables(filename);
+        return 1.e3*chrono::duration<double>(
+            chrono::steady_clock::now() - start).count() / numReads;
+    };
+
+    C3DFileAdapter serial{};
+    C3DFileAdapter::Tables serialTables;
+    double serialTime = timeRead(serial, serialTables);
+    const auto& markers = *serialTables.at("markers");
+    const auto& forces = *serialTables.at("forces");
+
+    C3DFileAdapter parallel{};
+    parallel.setNumThreads(0);
+    C3DFileAdapter::Tables parallelTables;
+    double parallelTime = timeRead(parallel, parallelTables);
+    compare_tables<SimTK::Vec3>(*parallelTables.at("markers"), markers, 0);
+    compare_tables<SimTK::Vec3>(*parallelTables.at("forces"), forces, 0);
+
+    // Select two markers, in the reverse of their order in the file, and
+    // the second force plate.
+    const auto& labels = markers.getColumnLabels();
+    ASSERT(labels.size() > 2 && forces.getNumColumns() >= 6,
+        __FILE__, __LINE__, "Expected at least 3 markers and 2 force plates.");
+    C3DFileAdapter selection{};
+    selection.setNumThreads(0);
+    selection.setMarkersToRead({labels[2], labels[0]});
+    selection.setForcePlatesToRead({2});
+    C3DFileAdapter::Tables selectedTables;
+    double selectionTime = timeRead(selection, selectedTables);
+    const auto& selectedMarkers = *selectedTables.at("markers");
+    const auto& selectedForces = *selectedTables.at("forces");
+    ASSERT(selectedMarkers.getColumnLabels() ==
+           std::vector<std::string>({labels[2], labels[0]}),
+           __FILE__, __LINE__, "Unexpected selected marker labels.");
+    ASSERT(selectedForces.getColumnLabels() ==
+           std::vector<std::string>({"f2", "p2", "m2"}),
+           __FILE__, __LINE__, "Unexpected selected force plate labels.");
+    for(const auto& label : selectedMarkers.getColumnLabels())
+        compare_columns(selectedMarkers, label, markers, label);
+    for(const auto& label : selectedForces.getColumnLabels())
+        compare_columns(selectedForces, label, forces, label);
+
+    C3DFileAdapter missing{};
+    missing.setMarkersToRead({"not_a_marker"});
+    ASSERT_THROW(OpenSim::Exception, missing.readTables(filename));
+    missing.setMarkersToRead({});
+    missing.setForcePlatesToRead({0});
+    ASSERT_THROW(OpenSim::Exception, missing.readTables(filename));
+
+    cout << "\tRead '" << filename << "' in " << serialTime
+         << "ms on 1 thread, " << parallelTime << "ms on all processors, and "
+         << selectionTime << "ms selecting 2 markers and 1 force plate."
+         << endl;
+}
+
 int main() {
     std::vector<std::string> filenames{};
     filenames.push_back("walking2.c3d");
@@ -202,6 +284,7 @@ int main() {
         std::cout << "\nTest reading '" + filename + "'." << std::endl;
         try {
             test(filename);
+            testSelectionsAndThreads(filename);
         }
         catch (const std::exception& ex) {
             std::cout << "testC3DFileAdapter FAILED: " << ex.what() << std::endl;
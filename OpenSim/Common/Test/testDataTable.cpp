@@ -762,6 +762,104 @@ int main() {
         SimTK_TEST_MUST_THROW_EXC(table.appendRow(-0.3, {0.6}),
                 TimestampLessThanEqualToPrevious);
     }
+    {
+        std::cout << "Test appending multiple rows at once." << std::endl;
+        TimeSeriesTable table{};
+        table.setColumnLabels({"0", "1", "2"});
+        table.appendRow(0.0, {0, 1, 2});
+
+        SimTK::Matrix depRows(3, 3);
+        for(int r = 0; r < depRows.nrow(); ++r)
+            for(int c = 0; c < depRows.ncol(); ++c)
+                depRows(r, c) = 10 * (r + 1) + c;
+        table.appendRows({0.1, 0.2, 0.3}, depRows);
+        ASSERT(table.getNumRows() == 4);
+        ASSERT(table.getIndependentColumn()[3] == 0.3);
+        for(int r = 0; r < depRows.nrow(); ++r)
+            for(int c = 0; c < depRows.ncol(); ++c)
+                ASSERT(table.getMatrix()(r + 1, c) == depRows(r, c));
+
+        // Mismatched lengths, an incorrect number of columns, and invalid
+        // time stamps leave the table unchanged.
+        SimTK_TEST_MUST_THROW_EXC(table.appendRows({0.4, 0.5}, depRows),
+                                  InvalidArgument);
+        SimTK_TEST_MUST_THROW_EXC(
+                table.appendRows({0.4}, SimTK::Matrix(1, 2, 0.0)),
+                IncorrectNumColumns);
+        SimTK_TEST_MUST_THROW_EXC(table.appendRows({0.4, 0.6, 0.5}, depRows),
+                                  TimestampLessThanEqualToPrevious);
+        ASSERT(table.getNumRows() == 4);
+        ASSERT(table.getIndependentColumn().size() == 4);
+    }
+    {
+        std::cout << "Test filling a table constructed with labels."
+                  << std::endl;
+        TimeSeriesTable table{std::vector<double>{0.1, 0.2, 0.3},
+                              std::vector<std::string>{"0", "1"}};
+        ASSERT(table.getNumRows() == 3);
+        ASSERT(table.getNumColumns() == 2);
+        ASSERT(table.getColumnLabel(1) == "1");
+        table.fillMatrix([](SimTK::Matrix& matrix) {
+            for(int r = 0; r < 3; ++r)
+                for(int c = 0; c < 2; ++c)
+                    matrix(r, c) = 10 * r + c;
+        });
+        ASSERT(table.getRow(0.3)[1] == 21);
+
+        // Unlike updMatrix(), filling the table keeps its data shareable.
+        TimeSeriesTable copy{table};
+        ASSERT(&copy.getMatrix()(0, 0) == &table.getMatrix()(0, 0));
+        ASSERT(copy.getRow(0.3)[1] == 21);
+
+        SimTK_TEST_MUST_THROW_EXC(
+                TimeSeriesTable(std::vector<double>{0.1, 0.1},
+                                std::vector<std::string>{"0"}),
+                TimestampGreaterThanEqualToNext);
+    }
+    {
+        std::cout << "Test that copies share data until modified."
+                  << std::endl;
+        TimeSeriesTable table{};
+        table.setColumnLabels({"0", "1"});
+        table.appendRow(0.0, {0, 1});
+        table.appendRow(0.1, {2, 3});
+
+        // A copy initially refers to the same data.
+        TimeSeriesTable copy{table};
+        ASSERT(&copy.getMatrix()(0, 0) == &table.getMatrix()(0, 0));
+
+        // Modifying the copy does not affect the original.
+        copy.updMatrix()(0, 0) = 100;
+        ASSERT(copy.getMatrix()(0, 0) == 100);
+        ASSERT(table.getMatrix()(0, 0) == 0);
+        copy.appendRow(0.2, {4, 5});
+        ASSERT(copy.getNumRows() == 3);
+        ASSERT(table.getNumRows() == 2);
+
+        // A writable view handed out before copying still refers to the
+        // data of the table it came from, and only to that table.
+        auto row = table.updRowAtIndex(1);
+        TimeSeriesTable copy2{table};
+        ASSERT(&copy2.getMatrix()(0, 0) != &table.getMatrix()(0, 0));
+        row[0] = 200;
+        ASSERT(table.getMatrix()(1, 0) == 200);
+        ASSERT(copy2.getMatrix()(1, 0) == 2);
+
+        // Assigning into a table with outstanding views keeps those views
+        // valid.
+        copy2.updRowAtIndex(0)[1] = 300;
+        table = copy2;
+        row[1] = 400;
+        ASSERT(table.getMatrix()(0, 1) == 300);
+        ASSERT(table.getMatrix()(1, 1) == 400);
+        ASSERT(copy2.getMatrix()(1, 1) == 3);
+
+        // Moving leaves the source empty.
+        TimeSeriesTable moved{std::move(copy)};
+        ASSERT(moved.getNumRows() == 3);
+        ASSERT(moved.getMatrix()(0, 0) == 100);
+        ASSERT(copy.getMatrix().nrow() == 0);
+    }
 
     return 0;
 }
@@ -24,6 +24,11 @@
 #include <OpenSim/Common/Sine.h>
 #include <OpenSim/Common/SignalGenerator.h>
 #include <OpenSim/Common/Reporter.h>
+#include <OpenSim/Common/SimmSpline.h>
+#include <OpenSim/Common/PiecewiseLinearFunction.h>
+#include <OpenSim/Common/GCVSpline.h>
+#include <OpenSim/Common/MultiplierFunction.h>
+#include <OpenSim/Common/FunctionAdapter.h>
 
 #include "ComponentsForTesting.h"
 
@@ -74,9 +79,72 @@ void testSignalGenerator() {
     }
 }
 
+// The fused value-and-derivatives evaluation must agree with calcValue() and
+// calcDerivative(), with and without an interval hint, in increasing and
+// decreasing sweeps, outside of the range of the function, and through a
+// FunctionAdapter.
+void testCalcValueAndDerivatives() {
+    const int n = 12;
+    double x[n], y[n];
+    for (int i = 0; i < n; ++i) {
+        x[i] = 0.1*i*i;
+        y[i] = std::sin(x[i]) + 0.2*x[i];
+    }
+    SimmSpline simmSpline(n, x, y);
+    PiecewiseLinearFunction linear(n, x, y);
+    GCVSpline gcvSpline(5, n, x, y);
+    MultiplierFunction multiplier(simmSpline.clone(), 2.5);
+    Sine sine(1.5, 3.1, 0.3, 0.12345);
+
+    const std::vector<int> first(1, 0);
+    const std::vector<int> second(2, 0);
+    const double tol = 1e-12;
+
+    // Sample points away from the knots (where the derivatives of the
+    // piecewise linear function are discontinuous), including points outside
+    // of [x[0], x[n-1]].
+    std::vector<double> sweep;
+    for (int i = -10; i <= 130; ++i)
+        sweep.push_back(0.1*i + 0.0123);
+    std::vector<double> reverse(sweep.rbegin(), sweep.rend());
+
+    for (const OpenSim::Function* f : std::vector<const OpenSim::Function*>{
+                &simmSpline, &linear, &gcvSpline, &multiplier, &sine}) {
+        FunctionAdapter adapter(*f);
+        for (const auto& points : {sweep, reverse}) {
+            int interval = -1;
+            for (double t : points) {
+                const Vector arg(1, t);
+                const double value = f->calcValue(arg);
+                const double d1 = f->calcDerivative(first, arg);
+                const double d2 = f->calcDerivative(second, arg);
+
+                double fusedValue, fusedD1, fusedD2;
+                f->calcValueAndDerivatives(t, fusedValue, fusedD1, fusedD2,
+                                           &interval);
+                SimTK_TEST_EQ_TOL(fusedValue, value, tol);
+                SimTK_TEST_EQ_TOL(fusedD1, d1, tol);
+                SimTK_TEST_EQ_TOL(fusedD2, d2, tol);
+
+                f->calcValueAndDerivatives(t, fusedValue, fusedD1, fusedD2);
+                SimTK_TEST_EQ_TOL(fusedValue, value, tol);
+                SimTK_TEST_EQ_TOL(fusedD1, d1, tol);
+                SimTK_TEST_EQ_TOL(fusedD2, d2, tol);
+
+                // Ask the adapter for the quantities in different orders.
+                SimTK_TEST_EQ_TOL(adapter.calcDerivative(second, arg), d2, tol);
+                SimTK_TEST_EQ_TOL(adapter.calcValue(arg), value, tol);
+                SimTK_TEST_EQ_TOL(adapter.calcDerivative(first, arg), d1, tol);
+                SimTK_TEST_EQ_TOL(adapter.calcValue(arg), value, tol);
+            }
+        }
+    }
+}
+
 int main() {
 
     SimTK_START_TEST("testSignalGenerator");
         SimTK_SUBTEST(testSignalGenerator);
+        SimTK_SUBTEST(testCalcValueAndDerivatives);
     SimTK_END_TEST();
 }
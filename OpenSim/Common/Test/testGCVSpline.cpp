@@ -82,6 +82,32 @@ int main() {
                 SimTK::Eps, __FILE__, __LINE__,
                 "Duplicate GCVSpline failed to reproduce identical first derivative.");
         }
+
+        // The fused evaluation must match the separate value and derivative
+        // evaluations, with or without an interval hint.
+        std::vector<int> secondDerivComponents(2, 0);
+        int interval = 1;
+        for (int i = 0; i < (2*size-1); ++i) {
+            t[0] = dt / 2 * i;
+            double value, dS, ddS;
+            spline.calcValueAndDerivatives(t[0], value, dS, ddS, &interval);
+            ASSERT_EQUAL(spline.calcValue(t), value, SimTK::SignificantReal,
+                __FILE__, __LINE__,
+                "GCVSpline fused evaluation failed to reproduce value.");
+            ASSERT_EQUAL(spline.calcDerivative(derivComponents, t), dS,
+                SimTK::SignificantReal, __FILE__, __LINE__,
+                "GCVSpline fused evaluation failed to reproduce first derivative.");
+            ASSERT_EQUAL(spline.calcDerivative(secondDerivComponents, t), ddS,
+                SimTK::SignificantReal, __FILE__, __LINE__,
+                "GCVSpline fused evaluation failed to reproduce second derivative.");
+            double valueNoHint, dSNoHint, ddSNoHint;
+            spline2.calcValueAndDerivatives(t[0], valueNoHint, dSNoHint,
+                                            ddSNoHint);
+            ASSERT_EQUAL(value, valueNoHint, SimTK::Eps, __FILE__, __LINE__,
+                "GCVSpline fused evaluation depends on the interval hint.");
+        }
+        cout << "GCVSpline successfully produced fused value and derivatives."
+             << endl;
     }
     catch(const Exception& e) {
         e.print(cerr);
@@ -0,0 +1,318 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  testLogManager.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Tests the asynchronous mode, the log levels, the rate limiting and the
+output of multiple threads (LogCapture) of LogManager, and compares the time spent writing to std::cout in synchronous
+and asynchronous modes. */
+
+#include <OpenSim/Common/LogManager.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <chrono>
+#include <string>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace OpenSim;
+using namespace std;
+
+// Collects the strings passed to it.
+class CollectingLogCallback : public LogCallback {
+public:
+    void log(const std::string& str) override { strings.push_back(str); }
+    std::vector<std::string> strings;
+};
+
+// Slow callback, like writing to a file on a network drive.
+class SlowLogCallback : public LogCallback {
+public:
+    void log(const std::string&) override {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+};
+
+void testAsynchronous();
+void testLevels();
+void testRateLimiter();
+void testThreads();
+void testTiming();
+
+int main()
+{
+    try {
+        testAsynchronous();
+        testLevels();
+        testRateLimiter();
+        testThreads();
+        testTiming();
+    }
+    catch (const std::exception& e) {
+        LogManager::setAsynchronous(false);
+        LogManager::setLevel(LogLevel::Info);
+        cout << "testLogManager FAILED: " << e.what() << endl;
+        return 1;
+    }
+    cout << "testLogManager PASSED" << endl;
+    return 0;
+}
+
+void testAsynchronous()
+{
+    CollectingLogCallback callback;
+    LogManager::out.addLogCallback(&callback);
+
+    LogManager::setAsynchronous(true);
+    ASSERT(LogManager::isAsynchronous(), __FILE__, __LINE__,
+            "Expected asynchronous mode.");
+    const int n = 1000;
+    for (int i = 0; i < n; ++i)
+        cout << "line " << i << endl;
+    // All lines have been passed to the callback after flush().
+    LogManager::flush();
+    LogManager::out.removeLogCallback(&callback);
+    LogManager::setAsynchronous(false);
+    ASSERT(!LogManager::isAsynchronous(), __FILE__, __LINE__,
+            "Expected synchronous mode.");
+
+    ASSERT(int(callback.strings.size()) == n, __FILE__, __LINE__,
+            "Expected " + to_string(n) + " lines but got " +
+            to_string(callback.strings.size()) + ".");
+    for (int i = 0; i < n; ++i)
+        ASSERT(callback.strings[i] == "line " + to_string(i) + "\n",
+                __FILE__, __LINE__, "Lines are out of order.");
+    cout << "Logged " << n << " lines asynchronously." << endl;
+
+    // The mode can be changed while other threads log; no line is lost and
+    // the lines of each thread stay in order.
+    {
+        CollectingLogCallback callback;
+        LogManager::out.addLogCallback(&callback);
+        const int numThreads = 3;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; ++t)
+            threads.emplace_back([t]() {
+                for (int i = 0; i < n; ++i)
+                    cout << "thread " << t << " line " << i << endl;
+            });
+        for (int i = 0; i < 50; ++i)
+            LogManager::setAsynchronous(i % 2 == 0);
+        for (auto& thread : threads) thread.join();
+        LogManager::setAsynchronous(false);
+        LogManager::out.removeLogCallback(&callback);
+
+        ASSERT(int(callback.strings.size()) == numThreads*n, __FILE__,
+                __LINE__, "Expected " + to_string(numThreads*n) +
+                " lines but got " + to_string(callback.strings.size()) + ".");
+        std::vector<int> next(numThreads, 0);
+        for (const auto& str : callback.strings) {
+            const int t = str.size() > 7 ? str[7] - '0' : -1;
+            ASSERT(t >= 0 && t < numThreads && str == "thread " +
+                    to_string(t) + " line " + to_string(next[t]++) + "\n",
+                    __FILE__, __LINE__, "Unexpected line: " + str);
+        }
+    }
+}
+
+void testLevels()
+{
+    CollectingLogCallback callback;
+    LogManager::out.addLogCallback(&callback);
+
+    int numEvaluations = 0;
+    auto expensive = [&]() { ++numEvaluations; return 42; };
+
+    LogManager::setLevel(LogLevel::Warn);
+    ASSERT(LogManager::getLevel() == LogLevel::Warn, __FILE__, __LINE__,
+            "Expected level Warn.");
+    ASSERT(!LogManager::isEnabled(LogLevel::Info), __FILE__, __LINE__,
+            "Expected Info to be disabled.");
+    OPENSIM_LOG(LogLevel::Info, "info " << expensive());
+    OPENSIM_LOG(LogLevel::Debug, "debug " << expensive());
+    OPENSIM_LOG(LogLevel::Warn, "warn " << expensive());
+    ASSERT(numEvaluations == 1, __FILE__, __LINE__,
+            "Disabled messages must not be evaluated.");
+
+    LogManager::setLevel(LogLevel::Off);
+    OPENSIM_LOG(LogLevel::Warn, "warn " << expensive());
+    ASSERT(numEvaluations == 1, __FILE__, __LINE__,
+            "No message must be evaluated when logging is off.");
+
+    LogManager::setLevel(LogLevel::Info);
+    OPENSIM_LOG(LogLevel::Info, "info " << expensive());
+    LogManager::out.removeLogCallback(&callback);
+
+    ASSERT(numEvaluations == 2, __FILE__, __LINE__,
+            "Expected enabled messages to be evaluated.");
+    ASSERT(callback.strings.size() == 2 &&
+            callback.strings[0] == "warn 42\n" &&
+            callback.strings[1] == "info 42\n", __FILE__, __LINE__,
+            "Expected only the enabled messages.");
+}
+
+void testRateLimiter()
+{
+    // The allowance is replenished at one message every 100 s, so it is
+    // not replenished during this test.
+    LogRateLimiter limiter(3, 100.0);
+    int numSuppressed = -1;
+    for (int i = 0; i < 3; ++i) {
+        ASSERT(limiter.allow(numSuppressed), __FILE__, __LINE__,
+                "Expected the burst of messages to be allowed.");
+        ASSERT(numSuppressed == 0, __FILE__, __LINE__,
+                "Expected no suppressed messages.");
+    }
+    for (int i = 0; i < 5; ++i)
+        ASSERT(!limiter.allow(numSuppressed), __FILE__, __LINE__,
+                "Expected messages beyond the burst to be suppressed.");
+    limiter.reset();
+    ASSERT(limiter.allow(numSuppressed) && numSuppressed == 0, __FILE__,
+            __LINE__, "Expected reset() to restore the allowance.");
+
+    // A fast limiter replenishes the allowance and reports how many messages
+    // it suppressed.
+    LogRateLimiter fast(1, 0.01);
+    ASSERT(fast.allow(numSuppressed), __FILE__, __LINE__,
+            "Expected the first message to be allowed.");
+    ASSERT(!fast.allow(numSuppressed) && !fast.allow(numSuppressed),
+            __FILE__, __LINE__, "Expected the next messages to be suppressed.");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT(fast.allow(numSuppressed) && numSuppressed == 2, __FILE__,
+            __LINE__, "Expected 2 suppressed messages.");
+
+    // The macro writes the first messages and a count of the suppressed ones.
+    CollectingLogCallback callback;
+    LogManager::out.addLogCallback(&callback);
+    LogRateLimiter macroLimiter(2, 100.0);
+    for (int i = 0; i < 10; ++i)
+        OPENSIM_LOG_RATE_LIMITED(LogLevel::Warn, macroLimiter,
+                "WARNING- frame " << i);
+    LogManager::out.removeLogCallback(&callback);
+    ASSERT(callback.strings.size() == 2, __FILE__, __LINE__,
+            "Expected 2 messages to be written.");
+}
+
+void testThreads()
+{
+    const int numThreads = 4;
+    const int n = 200;
+    auto line = [](int thread, int i) {
+        return "thread " + to_string(thread) + " line " + to_string(i) + "\n";
+    };
+
+    // Lines written by threads at the same time are not interleaved.
+    {
+        CollectingLogCallback callback;
+        LogManager::out.addLogCallback(&callback);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; ++t)
+            threads.emplace_back([&, t]() {
+                for (int i = 0; i < n; ++i)
+                    cout << "thread " << t << " line " << i << endl;
+            });
+        for (auto& thread : threads) thread.join();
+        LogManager::out.removeLogCallback(&callback);
+
+        ASSERT(int(callback.strings.size()) == numThreads*n, __FILE__,
+                __LINE__, "Expected " + to_string(numThreads*n) +
+                " lines but got " + to_string(callback.strings.size()) + ".");
+        std::vector<int> next(numThreads, 0);
+        for (const auto& str : callback.strings) {
+            const int t = str.size() > 7 ? str[7] - '0' : -1;
+            ASSERT(t >= 0 && t < numThreads && str == line(t, next[t]++),
+                    __FILE__, __LINE__, "Unexpected line: " + str);
+        }
+    }
+
+    // Captured output is logged in the order of the tasks.
+    {
+        std::vector<std::string> outs(numThreads), errs(numThreads);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; ++t)
+            threads.emplace_back([&, t]() {
+                LogCapture capture(outs[t], errs[t]);
+                for (int i = 0; i < n; ++i)
+                    cout << "thread " << t << " line " << i << endl;
+                cerr << "thread " << t << " done" << endl;
+            });
+        for (auto& thread : threads) thread.join();
+
+        for (int t = 0; t < numThreads; ++t) {
+            std::string expected;
+            for (int i = 0; i < n; ++i) expected += line(t, i);
+            ASSERT(outs[t] == expected, __FILE__, __LINE__,
+                    "Unexpected output captured from thread " +
+                    to_string(t) + ".");
+            ASSERT(errs[t] == "thread " + to_string(t) + " done\n",
+                    __FILE__, __LINE__, "Unexpected error output captured "
+                    "from thread " + to_string(t) + ".");
+        }
+
+        CollectingLogCallback callback;
+        LogManager::out.addLogCallback(&callback);
+        for (int t = 0; t < numThreads; ++t)
+            LogCapture::write(outs[t], "");
+        LogManager::out.removeLogCallback(&callback);
+        ASSERT(int(callback.strings.size()) == numThreads &&
+                callback.strings[1] == outs[1], __FILE__, __LINE__,
+                "Expected the captured output of each thread, in order.");
+    }
+    cout << "Logged the output of " << numThreads << " threads." << endl;
+}
+
+void testTiming()
+{
+    // Add a slow callback, so that the time spent in the callbacks
+    // dominates.
+    SlowLogCallback slow;
+    LogManager::out.addLogCallback(&slow);
+
+    const int n = 2000;
+    auto writeLines = [&]() {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i)
+            LogManager::getStream(LogLevel::Info)
+                << "Frame " << i << " (t=" << 0.01*i << ")" << std::endl;
+        return std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+    };
+
+    // Don't flood the terminal.
+    std::ostringstream discard;
+    std::streambuf* original = LogManager::cout.rdbuf(discard.rdbuf());
+
+    double syncTime = writeLines();
+    LogManager::setAsynchronous(true);
+    double asyncTime = writeLines();
+    auto start = std::chrono::steady_clock::now();
+    LogManager::flush();
+    double drainTime = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    LogManager::setAsynchronous(false);
+
+    LogManager::cout.rdbuf(original);
+    LogManager::out.removeLogCallback(&slow);
+
+    cout << "Wrote " << n << " lines to a slow log callback:" << endl;
+    cout << "  synchronous:  " << syncTime << " s" << endl;
+    cout << "  asynchronous: " << asyncTime << " s (plus " << drainTime
+         << " s in the background)" << endl;
+}
@@ -98,6 +98,49 @@ void testStorageLegacy() {
     }
 }
 
+void testStorageFromTable() {
+    Storage st("test.sto");
+    st.setInDegrees(true);
+    st.setDescription("A description.");
+    const TimeSeriesTable table = st.exportToTable();
+    ASSERT(table.getNumRows() == 2);
+    ASSERT(table.getNumColumns() == 2);
+    ASSERT(table.getColumnLabel(1) == "v2");
+    ASSERT(table.getIndependentColumn()[1] == 2.0);
+    ASSERT(table.getMatrix()(1, 1) == 40.0);
+
+    // The exported table was filled in place, and copies of it share its
+    // data rather than copying it.
+    const TimeSeriesTable copy{table};
+    ASSERT(&copy.getMatrix()(0, 0) == &table.getMatrix()(0, 0));
+    TimeSeriesTable assigned;
+    assigned = st.exportToTable();
+    const TimeSeriesTable copyOfAssigned{assigned};
+    ASSERT(&copyOfAssigned.getMatrix()(0, 0) == &assigned.getMatrix()(0, 0));
+
+    // Convert back: the data, labels and metadata are preserved.
+    Storage fromTable(table);
+    ASSERT(fromTable.getSize() == st.getSize());
+    ASSERT(fromTable.getColumnLabels() == st.getColumnLabels());
+    ASSERT(fromTable.getName() == st.getName());
+    ASSERT(fromTable.getDescription() == st.getDescription());
+    ASSERT(fromTable.isInDegrees());
+    for (int i = 0; i < st.getSize(); ++i) {
+        const StateVector& expected = *st.getStateVector(i);
+        const StateVector& actual = *fromTable.getStateVector(i);
+        ASSERT(actual.getTime() == expected.getTime());
+        ASSERT(actual.getSize() == expected.getSize());
+        for (int j = 0; j < expected.getSize(); ++j)
+            ASSERT(actual.getData()[j] == expected.getData()[j]);
+    }
+
+    // Rows with a different number of columns than there are column labels
+    // cannot be exported.
+    Storage ragged(st);
+    ragged.getStateVector(1)->getData().append(60.0);
+    SimTK_TEST_MUST_THROW_EXC(ragged.exportToTable(), IncorrectNumColumns);
+}
+
 int main() {
     SimTK_START_TEST("testStorage");
 
@@ -120,6 +163,7 @@ int main() {
         #endif
 
         SimTK_SUBTEST(testStorageLegacy);
+        SimTK_SUBTEST(testStorageFromTable);
     SimTK_END_TEST();
 }
 
@@ -162,7 +162,7 @@ public:
         catch (std::exception&) {
             // wipe out the data loaded if any
             this->_indData.clear();
-            this->_depData.clear();
+            this->updDepData().clear();
             this->removeDependentsMetaDataForKey("labels");
             throw;
         }
@@ -180,19 +180,44 @@ public:
             // because base classes cannot properly invoke virtual functions.
             this->validateDependentsMetaData();
             for (size_t i = 0; i < indVec.size(); ++i) {
-                this->validateRow(i, indVec[i], this->_depData.row(int(i)));
+                this->validateRow(i, indVec[i], this->getDepData().row(int(i)));
             }
         }
         catch (std::exception&) {
             // wipe out the data loaded if any
             this->_indData.clear();
-            this->_depData.clear(); // should be empty
+            this->updDepData().clear(); // should be empty
             this->removeDependentsMetaDataForKey("labels"); // should be empty
             throw;
         }
 
     }
 
+    /** Construct a table with the given independent (time) column and column
+    labels, whose dependent data is allocated but not initialized. Populate
+    the table through fillMatrix(); this is useful for converting large data
+    to a table without building and copying a separate matrix.               */
+    TimeSeriesTable_(const std::vector<double>& indVec,
+                     const std::vector<std::string>& labels) :
+            DataTable_<double, ETY>(indVec, labels) {
+        try {
+            // Perform the validation of the data of this TimeSeriesTable.
+            // Only the time column is checked, since the dependent data has
+            // not been filled in yet.
+            this->validateDependentsMetaData();
+            for (size_t i = 0; i < indVec.size(); ++i) {
+                this->validateRow(i, indVec[i], RowVector{});
+            }
+        }
+        catch (std::exception&) {
+            // wipe out the data loaded if any
+            this->_indData.clear();
+            this->updDepData().clear();
+            this->removeDependentsMetaDataForKey("labels");
+            throw;
+        }
+    }
+
 #ifndef SWIG
     using DataTable_<double, ETY>::DataTable_;
     using DataTable_<double, ETY>::operator=;
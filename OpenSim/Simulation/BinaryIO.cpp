@@ -0,0 +1,121 @@
+/* -------------------------------------------------------------------------- *
+ *                           OpenSim:  BinaryIO.cpp                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "BinaryIO.h"
+#include <OpenSim/Simulation/Model/Model.h>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+using namespace OpenSim;
+
+void BinaryIO::writeSize(std::ostream& out, size_t size) {
+    const std::uint64_t value = size;
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void BinaryIO::writeDouble(std::ostream& out, double value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void BinaryIO::writeDoubles(std::ostream& out,
+                            const std::vector<double>& values) {
+    out.write(reinterpret_cast<const char*>(values.data()),
+              values.size()*sizeof(double));
+}
+
+void BinaryIO::writeString(std::ostream& out, const std::string& str) {
+    writeSize(out, str.size());
+    out.write(str.data(), str.size());
+}
+
+BinaryIO::Reader::Reader(std::istream& in) : _in(in), _end(-1) {
+    const std::streampos start = in.tellg();
+    if (start < 0) return;
+    in.seekg(0, std::ios::end);
+    const std::streampos end = in.tellg();
+    in.clear();
+    in.seekg(start);
+    if (end >= start) _end = static_cast<long long>(end);
+}
+
+void BinaryIO::Reader::checkSize(size_t size, size_t elementSize) const {
+    if (_end < 0 || elementSize == 0 || !_in) return;
+    const long long position = static_cast<long long>(_in.tellg());
+    if (position < 0) return;
+    const unsigned long long remaining =
+            position < _end ? _end - position : 0;
+    OPENSIM_THROW_IF(size > remaining/elementSize, IOError,
+            "Read a size of " + std::to_string(size) + ", but only " +
+            std::to_string(remaining) + " bytes are left; the file is "
+            "corrupt or truncated.");
+}
+
+size_t BinaryIO::Reader::readSize(size_t elementSize) {
+    std::uint64_t value = 0;
+    _in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    if (!_in) return 0;
+    OPENSIM_THROW_IF(value > std::uint64_t(size_t(-1)), IOError,
+            "Read a size of " + std::to_string(value) + ", which is too "
+            "large; the file is corrupt.");
+    checkSize(static_cast<size_t>(value), elementSize);
+    return static_cast<size_t>(value);
+}
+
+double BinaryIO::Reader::readDouble() {
+    double value = SimTK::NaN;
+    _in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return value;
+}
+
+void BinaryIO::Reader::readDoubles(std::vector<double>& values, size_t size) {
+    checkSize(size, sizeof(double));
+    values.resize(size);
+    _in.read(reinterpret_cast<char*>(values.data()), size*sizeof(double));
+}
+
+std::string BinaryIO::Reader::readString() {
+    std::string str(readSize(), '\0');
+    if (_in && !str.empty()) _in.read(&str[0], str.size());
+    return str;
+}
+
+void BinaryIO::Reader::read(char* data, size_t size) {
+    _in.read(data, size);
+}
+
+std::vector<std::pair<const Component*, std::string>>
+BinaryIO::getDiscreteVariables(const Model& model) {
+    // Model::getComponentList() does not include the model itself.
+    std::vector<const Component*> components{&model};
+    for (const auto& comp : model.getComponentList<Component>())
+        components.push_back(&comp);
+
+    std::vector<std::pair<const Component*, std::string>> variables;
+    for (const Component* comp : components) {
+        const Array<std::string> names =
+                comp->getDiscreteVariableNamesAddedByComponent();
+        for (int i = 0; i < names.getSize(); ++i)
+            variables.push_back(std::make_pair(comp, names[i]));
+    }
+    return variables;
+}
@@ -0,0 +1,93 @@
+/* -------------------------------------------------------------------------- *
+ *                            OpenSim:  BinaryIO.h                            *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#ifndef OPENSIM_BINARY_IO_H_
+#define OPENSIM_BINARY_IO_H_
+
+// This header is internal to osimSimulation: it is used to write and read the
+// binary files of CompactStatesTrajectory and of Manager's checkpoints, and
+// is not part of the API.
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace OpenSim {
+
+class Component;
+class Model;
+
+namespace BinaryIO {
+
+/** Write a size (or another nonnegative integer) as 8 bytes. */
+void writeSize(std::ostream& out, size_t size);
+void writeDouble(std::ostream& out, double value);
+void writeDoubles(std::ostream& out, const std::vector<double>& values);
+/** Write the length of the string, followed by its characters. */
+void writeString(std::ostream& out, const std::string& str);
+
+/** Reads the values written by the functions above. Sizes read from the
+stream are checked against the number of bytes left in it, so that a corrupt
+or truncated file causes an IOError rather than a huge allocation. As with
+std::istream, check the stream for failures after reading. */
+class Reader {
+public:
+    explicit Reader(std::istream& in);
+
+    /** Read a number of elements that each take at least elementSize bytes
+    in the rest of the stream.
+    @throws IOError if the elements cannot fit in the rest of the stream.
+    Pass 0 for integers that are not numbers of elements. */
+    size_t readSize(size_t elementSize = 1);
+    double readDouble();
+    /** Read the given number of doubles into values, which is resized.
+    @throws IOError if they cannot fit in the rest of the stream. */
+    void readDoubles(std::vector<double>& values, size_t size);
+    std::string readString();
+    /** Read size bytes into data. */
+    void read(char* data, size_t size);
+
+    std::istream& getStream() { return _in; }
+
+private:
+    // Throw if size elements of elementSize bytes do not fit in the rest of
+    // the stream.
+    void checkSize(size_t size, size_t elementSize) const;
+
+    std::istream& _in;
+    // The position of the end of the stream; negative if the stream cannot
+    // seek, in which case sizes are not checked.
+    long long _end;
+};
+
+/** The discrete variables allocated by the model's components, including the
+model itself, as (component, name) pairs in a fixed order. */
+std::vector<std::pair<const Component*, std::string>>
+getDiscreteVariables(const Model& model);
+
+} // namespace BinaryIO
+
+} // namespace OpenSim
+
+#endif // OPENSIM_BINARY_IO_H_
@@ -0,0 +1,270 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  CompactStatesTrajectory.cpp                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "CompactStatesTrajectory.h"
+#include "BinaryIO.h"
+#include <OpenSim/Simulation/Model/Model.h>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+using namespace OpenSim;
+
+// Identifies the binary file format; the last character is the version.
+static const char BinaryFileMagic[8] = {'O','S','I','M','S','T','B','1'};
+
+CompactStatesTrajectory::CompactStatesTrajectory(const Model& model) {
+    for (const auto& dv : BinaryIO::getDiscreteVariables(model)) {
+        m_discreteVariables.push_back({dv.first, dv.second});
+        m_discreteVariableNames.push_back(
+                dv.first->getAbsolutePathString() + "/" + dv.second);
+    }
+}
+
+CompactStatesTrajectory CompactStatesTrajectory::createFromStatesTrajectory(
+        const StatesTrajectory& states, const Model* model) {
+    CompactStatesTrajectory compact = model ? CompactStatesTrajectory(*model)
+                                            : CompactStatesTrajectory();
+    compact.reserve(states.getSize());
+    for (const auto& state : states)
+        compact.append(state);
+    return compact;
+}
+
+const SimTK::State& CompactStatesTrajectory::get(size_t index) const {
+    OPENSIM_THROW_IF(index >= getSize(), IndexOutOfRange, index, 0,
+                     static_cast<unsigned>(getSize() - 1));
+    return materialize(index);
+}
+
+void CompactStatesTrajectory::clear() {
+    m_times.clear();
+    m_y.clear();
+    m_discreteValues.clear();
+    m_numY = 0;
+    m_template = SimTK::State();
+    m_scratch = SimTK::State();
+    m_hasTemplate = false;
+    m_scratchIndex = size_t(-1);
+}
+
+void CompactStatesTrajectory::reserve(size_t numStates) {
+    m_times.reserve(numStates);
+    m_y.reserve(numStates*m_numY);
+    m_discreteValues.reserve(numStates*m_discreteVariables.size());
+}
+
+void CompactStatesTrajectory::setTemplateState(const SimTK::State& state) {
+    m_template = state;
+    m_scratch = state;
+    m_hasTemplate = true;
+    m_scratchIndex = size_t(-1);
+    m_numY = state.getNY();
+}
+
+void CompactStatesTrajectory::append(const SimTK::State& state) {
+    if (!m_hasTemplate) {
+        setTemplateState(state);
+        // reserve() may have been called before the number of Y's was known.
+        m_y.reserve(m_times.capacity()*m_numY);
+    } else {
+        SimTK_APIARGCHECK2_ALWAYS(
+                m_times.empty() || m_times.back() <= state.getTime(),
+                "CompactStatesTrajectory", "append",
+                "New state's time (%f) must be equal to or greater than the "
+                "time for the last state in the trajectory (%f).",
+                state.getTime(), m_times.back());
+        OPENSIM_THROW_IF(!m_template.isConsistent(state),
+                         StatesTrajectory::InconsistentState, state.getTime());
+    }
+
+    m_times.push_back(state.getTime());
+    const SimTK::Vector& y = state.getY();
+    for (int i = 0; i < m_numY; ++i)
+        m_y.push_back(y[i]);
+    for (const auto& dv : m_discreteVariables)
+        m_discreteValues.push_back(
+                dv.component->getDiscreteVariableValue(state, dv.name));
+}
+
+const SimTK::State& CompactStatesTrajectory::materialize(size_t index) const {
+    if (index == m_scratchIndex) return m_scratch;
+
+    m_scratch.setTime(m_times[index]);
+    SimTK::Vector& y = m_scratch.updY();
+    const double* values = getY(index);
+    for (int i = 0; i < m_numY; ++i)
+        y[i] = values[i];
+
+    const double* discreteValues = getDiscreteVariableValues(index);
+    for (size_t i = 0; i < m_discreteVariables.size(); ++i) {
+        const auto& dv = m_discreteVariables[i];
+        dv.component->setDiscreteVariableValue(m_scratch, dv.name,
+                                               discreteValues[i]);
+    }
+    m_scratchIndex = index;
+    return m_scratch;
+}
+
+StatesTrajectory CompactStatesTrajectory::toStatesTrajectory() const {
+    StatesTrajectory states;
+    for (const auto& state : *this)
+        states.append(state);
+    return states;
+}
+
+bool CompactStatesTrajectory::isCompatibleWith(const Model& model) const {
+    // An empty trajectory is necessarily compatible.
+    if (getSize() == 0) return true;
+
+    return model.getNumStateVariables() == m_numY &&
+           model.getNumCoordinates() == m_template.getNQ() &&
+           model.getNumSpeeds() == m_template.getNU();
+}
+
+TimeSeriesTable CompactStatesTrajectory::exportToTable(const Model& model,
+        const std::vector<std::string>& requestedStateVars) const {
+
+    OPENSIM_THROW_IF(!isCompatibleWith(model),
+                     StatesTrajectory::IncompatibleModel, model);
+
+    const Array<std::string> allStateVars = model.getStateVariableNames();
+    std::vector<std::string> stateVars;
+    if (requestedStateVars.empty()) {
+        for (int i = 0; i < allStateVars.getSize(); ++i)
+            stateVars.push_back(allStateVars[i]);
+    } else {
+        stateVars = requestedStateVars;
+    }
+    const int numRows = static_cast<int>(getSize());
+    const int numColumns = static_cast<int>(stateVars.size());
+
+    // Find where each requested state variable is stored in Y. Columns that
+    // are not stored directly in Y (or are not state variables) are filled
+    // from the materialized states below.
+    std::vector<int> yIndices(numColumns, -1);
+    if (numRows > 0) {
+        const auto systemIndices =
+                model.getStateVariableSystemIndices(m_template);
+        std::map<std::string, int> indexOfName;
+        for (int i = 0; i < allStateVars.getSize(); ++i)
+            if (systemIndices[i].isValid())
+                indexOfName[allStateVars[i]] = int(systemIndices[i]);
+        for (int icol = 0; icol < numColumns; ++icol) {
+            auto it = indexOfName.find(stateVars[icol]);
+            if (it != indexOfName.end()) yIndices[icol] = it->second;
+        }
+    }
+
+    SimTK::Matrix data(numRows, numColumns);
+    bool needStates = false;
+    for (int icol = 0; icol < numColumns; ++icol) {
+        if (yIndices[icol] < 0) { needStates = true; continue; }
+        for (int irow = 0; irow < numRows; ++irow)
+            data(irow, icol) = getY(irow)[yIndices[icol]];
+    }
+    if (needStates) {
+        for (int irow = 0; irow < numRows; ++irow) {
+            const SimTK::State& state = materialize(irow);
+            for (int icol = 0; icol < numColumns; ++icol)
+                if (yIndices[icol] < 0)
+                    data(irow, icol) =
+                        model.getStateVariableValue(state, stateVars[icol]);
+        }
+    }
+
+    if (numRows == 0) {
+        TimeSeriesTable table;
+        table.setColumnLabels(stateVars);
+        return table;
+    }
+    return TimeSeriesTable(m_times, data, stateVars);
+}
+
+void CompactStatesTrajectory::write(const std::string& filePath) const {
+    using namespace BinaryIO;
+    std::ofstream out(filePath, std::ios::binary);
+    OPENSIM_THROW_IF(!out, IOError,
+                     "Could not open file '" + filePath + "' for writing.");
+
+    out.write(BinaryFileMagic, sizeof(BinaryFileMagic));
+    writeSize(out, getSize());
+    writeSize(out, m_numY);
+    writeSize(out, m_discreteVariableNames.size());
+    for (const auto& name : m_discreteVariableNames)
+        writeString(out, name);
+    writeDoubles(out, m_times);
+    writeDoubles(out, m_y);
+    writeDoubles(out, m_discreteValues);
+
+    OPENSIM_THROW_IF(!out, IOError,
+                     "Could not write to file '" + filePath + "'.");
+}
+
+CompactStatesTrajectory CompactStatesTrajectory::createFromBinaryFile(
+        const Model& model, const std::string& filePath) {
+    std::ifstream in(filePath, std::ios::binary);
+    OPENSIM_THROW_IF(!in, IOError,
+                     "Could not open file '" + filePath + "' for reading.");
+
+    char magic[sizeof(BinaryFileMagic)];
+    in.read(magic, sizeof(magic));
+    OPENSIM_THROW_IF(!in || std::memcmp(magic, BinaryFileMagic,
+                                        sizeof(magic)) != 0,
+                     IOError, "File '" + filePath + "' is not a binary "
+                     "states trajectory file.");
+
+    CompactStatesTrajectory states(model);
+    BinaryIO::Reader reader(in);
+    // Each state has at least a time, and each name at least its length.
+    const size_t numStates = reader.readSize(sizeof(double));
+    const size_t numY = reader.readSize(0);
+    const size_t numDiscrete = reader.readSize(sizeof(double));
+    OPENSIM_THROW_IF(!in, IOError,
+                     "Could not read the header of file '" + filePath + "'.");
+
+    std::vector<std::string> names(numDiscrete);
+    for (auto& name : names)
+        name = reader.readString();
+    OPENSIM_THROW_IF(names != states.m_discreteVariableNames, Exception,
+            "The discrete variables in file '" + filePath + "' do not match "
+            "those of Model '" + model.getName() + "'.");
+
+    const SimTK::State& workingState = model.getWorkingState();
+    OPENSIM_THROW_IF(numStates > 0 &&
+                     numY != static_cast<size_t>(workingState.getNY()),
+                     StatesTrajectory::IncompatibleModel, model);
+
+    reader.readDoubles(states.m_times, numStates);
+    reader.readDoubles(states.m_y, numStates*numY);
+    reader.readDoubles(states.m_discreteValues, numStates*numDiscrete);
+    OPENSIM_THROW_IF(!in, IOError,
+                     "File '" + filePath + "' is truncated.");
+
+    if (numStates > 0) states.setTemplateState(workingState);
+    return states;
+}
+
+size_t CompactStatesTrajectory::getMemoryUsage() const {
+    return sizeof(double)*(m_times.capacity() + m_y.capacity() +
+                           m_discreteValues.capacity());
+}
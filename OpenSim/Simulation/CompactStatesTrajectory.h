@@ -0,0 +1,262 @@
+#ifndef OPENSIM_COMPACT_STATES_TRAJECTORY_H_
+#define OPENSIM_COMPACT_STATES_TRAJECTORY_H_
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  CompactStatesTrajectory.h                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <SimTKcommon/internal/State.h>
+
+#include "StatesTrajectory.h"
+
+namespace OpenSim {
+
+class Component;
+
+/** This class holds a sequence of SimTK::State%s in a compact form: only the
+ * time, the continuous state variables (the Y vector), and the discrete
+ * variables of each state are stored, in contiguous arrays. A StatesTrajectory
+ * stores a complete copy of each SimTK::State, including its cache, which
+ * occupies many times more memory than the state variables themselves for a
+ * typical model.
+ *
+ * Complete SimTK::State%s are materialized lazily: get(), operator[] and the
+ * iterators write the stored values of the requested state into a single
+ * scratch State, which is a copy of the first appended state. Therefore, the
+ * reference returned by get() is only valid until the next call to get(),
+ * operator[], or until the next iterator of this trajectory is dereferenced;
+ * make a copy of the State if you need to keep it. Since the scratch State is
+ * shared, a CompactStatesTrajectory must not be accessed concurrently from
+ * multiple threads.
+ *
+ * The discrete variables stored for each state are those allocated by the
+ * Component%s of the Model passed to the constructor (see
+ * Component::addDiscreteVariable()). All other values (e.g., modeling options,
+ * and discrete variables allocated directly by Simbody subsystems) are taken
+ * from the first appended state. If no Model is provided, only the time and
+ * the continuous state variables are stored.
+ *
+ * The guarantees of StatesTrajectory also apply to this class: the states
+ * are nondecreasing in time and consistent with each other.
+ *
+ * ### Usage
+ * @code{.cpp}
+ * Model model("subject01.osim");
+ * SimTK::State& state = model.initSystem();
+ * CompactStatesTrajectory states(model);
+ * // ... append states during a simulation ...
+ * for (const auto& s : states) {
+ *     std::cout << s.getTime() << " "
+ *               << model.getStateVariableValue(s, "knee/flexion/value")
+ *               << std::endl;
+ * }
+ * TimeSeriesTable table = states.exportToTable(model);
+ * states.write("subject01.states.bin");
+ * auto reread = CompactStatesTrajectory::createFromBinaryFile(model,
+ *                                                 "subject01.states.bin");
+ * @endcode
+ */
+class OSIMSIMULATION_API CompactStatesTrajectory {
+public:
+    /** Create an empty trajectory that stores only the time and the continuous
+     * state variables of each state. */
+    CompactStatesTrajectory() = default;
+
+    /** Create an empty trajectory that also stores the discrete variables
+     * allocated by the components of the given model. The model's system must
+     * have been created (see Model::initSystem()), and the model must outlive
+     * the trajectory. */
+    explicit CompactStatesTrajectory(const Model& model);
+
+    /** Create a compact copy of the states in a StatesTrajectory. The
+     * discrete variables are stored if a model is provided. */
+    static CompactStatesTrajectory createFromStatesTrajectory(
+            const StatesTrajectory& states, const Model* model = nullptr);
+
+    /** The number of SimTK::State%s in the trajectory. */
+    size_t getSize() const { return m_times.size(); }
+    /** The number of continuous state variables (Y's) in each state. */
+    int getNumY() const { return m_numY; }
+    /** The number of discrete variables stored for each state. */
+    int getNumDiscreteVariables() const
+    {   return static_cast<int>(m_discreteVariableNames.size()); }
+    /** The absolute paths of the stored discrete variables (e.g.,
+     * `/forceset/soleus_r/override_actuation`). */
+    const std::vector<std::string>& getDiscreteVariableNames() const
+    {   return m_discreteVariableNames; }
+
+    /// @name Accessing the stored values
+    /// These do not materialize a SimTK::State.
+    /// @{
+    /** The time of the state at the given index. */
+    double getTime(size_t index) const { return m_times[index]; }
+    /** Pointer to the getNumY() continuous state variable values of the state
+     * at the given index, in the order of SimTK::State::getY(). */
+    const double* getY(size_t index) const
+    {   return m_y.data() + index*m_numY; }
+    /** Pointer to the getNumDiscreteVariables() discrete variable values of the
+     * state at the given index, in the order of getDiscreteVariableNames(). */
+    const double* getDiscreteVariableValues(size_t index) const
+    {   return m_discreteValues.data() + index*getNumDiscreteVariables(); }
+    /// @}
+
+    /// @name Accessing individual SimTK::State%s
+    /// The returned reference is valid until a different state of this
+    /// trajectory is accessed.
+    /// @{
+    /** Get the state at a given index in the trajectory. This function does
+     * not check if the index is larger than the size of the trajectory; see
+     * get() if you want this check. */
+    const SimTK::State& operator[](size_t index) const {
+        return materialize(index);
+    }
+    /** Get the state at a given index in the trajectory.
+     * @throws IndexOutOfRange If the index is greater than the size of the
+     *                         trajectory. */
+    const SimTK::State& get(size_t index) const;
+    /** Get the first state in the trajectory. */
+    const SimTK::State& front() const { return get(0); }
+    /** Get the last state in the trajectory. */
+    const SimTK::State& back() const { return get(getSize() - 1); }
+    /// @}
+
+    /** Iterator that materializes each state into the trajectory's scratch
+     * State as it is dereferenced. */
+    class const_iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef SimTK::State value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const SimTK::State* pointer;
+        typedef const SimTK::State& reference;
+
+        const_iterator() = default;
+        const_iterator(const CompactStatesTrajectory* trajectory,
+                       size_t index) :
+                m_trajectory(trajectory), m_index(index) {}
+        reference operator*() const { return (*m_trajectory)[m_index]; }
+        pointer operator->() const { return &(*m_trajectory)[m_index]; }
+        const_iterator& operator++() { ++m_index; return *this; }
+        const_iterator operator++(int)
+        {   const_iterator copy(*this); ++m_index; return copy; }
+        bool operator==(const const_iterator& other) const
+        {   return m_trajectory == other.m_trajectory &&
+                   m_index == other.m_index; }
+        bool operator!=(const const_iterator& other) const
+        {   return !(*this == other); }
+    private:
+        const CompactStatesTrajectory* m_trajectory = nullptr;
+        size_t m_index = 0;
+    };
+
+    /** A helper type to allow using range for loops over a subset of the
+     * trajectory. */
+    typedef SimTK::IteratorRange<const_iterator> IteratorRange;
+
+    /// @name Iterating through the trajectory
+    /// @{
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, getSize()); }
+    /// @}
+
+    /// @name Modify the contents of the trajectory
+    /// @{
+    /** Clear all the states in the trajectory. The stored discrete variables
+     * are retained. */
+    void clear();
+    /** Append the values of a SimTK::State to this trajectory. The time of
+     * the new state must be greater than or equal to the time of the last
+     * state in the trajectory.
+     * @throws StatesTrajectory::InconsistentState If the state is not
+     *      consistent with the states already in the trajectory. */
+    void append(const SimTK::State& state);
+    /** Reserve memory for the given number of states. */
+    void reserve(size_t numStates);
+    /// @}
+
+    /** Create a StatesTrajectory containing a complete copy of each state. */
+    StatesTrajectory toStatesTrajectory() const;
+
+    /** Weak check for if the trajectory can be used with the given model; see
+     * StatesTrajectory::isCompatibleWith(). */
+    bool isCompatibleWith(const Model& model) const;
+
+    /** Export the continuous state variables to a data table; see
+     * StatesTrajectory::exportToTable(). Values that are stored directly in
+     * the Y vector are copied into the table without materializing any
+     * states.
+     * @throws StatesTrajectory::IncompatibleModel Thrown if the Model fails
+     *      the check isCompatibleWith(). */
+    TimeSeriesTable exportToTable(const Model& model,
+            const std::vector<std::string>& stateVars = {}) const;
+
+    /// @name Binary files
+    /// The binary file holds the times, the continuous state variables and the
+    /// discrete variables to full precision, in the byte order of the
+    /// machine that wrote it.
+    /// @{
+    /** Write the trajectory to a binary file. */
+    void write(const std::string& filePath) const;
+    /** Read a trajectory written by write(). The states are materialized from
+     * a copy of the model's working state, and the model must store the same
+     * discrete variables as the model of the trajectory that was written.
+     * The model's system must have been created (see Model::initSystem()). */
+    static CompactStatesTrajectory createFromBinaryFile(const Model& model,
+            const std::string& filePath);
+    /// @}
+
+    /** The number of bytes allocated for the stored values. The template
+     * and scratch states are not included. */
+    size_t getMemoryUsage() const;
+
+private:
+    struct DiscreteVariable {
+        const Component* component;
+        std::string name;
+    };
+
+    void setTemplateState(const SimTK::State& state);
+    const SimTK::State& materialize(size_t index) const;
+
+    // Values of each state, stored contiguously (row-major).
+    std::vector<double> m_times;
+    std::vector<double> m_y;
+    std::vector<double> m_discreteValues;
+    int m_numY = 0;
+
+    std::vector<DiscreteVariable> m_discreteVariables;
+    std::vector<std::string> m_discreteVariableNames;
+
+    // All values that are not stored are taken from this state.
+    SimTK::State m_template;
+    bool m_hasTemplate = false;
+
+    // The most recently materialized state.
+    mutable SimTK::State m_scratch;
+    mutable size_t m_scratchIndex = size_t(-1);
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_COMPACT_STATES_TRAJECTORY_H_
@@ -417,7 +417,7 @@ setControlValue(ArrayPtrs<ControlLinearNode> &aNodes,double aT,double aValue)
 }
 
 double ControlLinear::
-getControlValue(ArrayPtrs<ControlLinearNode> &aNodes,double aT)
+getControlValue(const ArrayPtrs<ControlLinearNode> &aNodes,double aT) const
 {
     // CHECK SIZE
     int size = aNodes.getSize();
@@ -425,8 +425,49 @@ getControlValue(ArrayPtrs<ControlLinearNode> &aNodes,double aT)
     if(size<=0) return(SimTK::NaN);
 
     // GET NODE
-    _searchNode.setTime(aT);
-    int i = aNodes.searchBinary(_searchNode);
+    int i = searchNodes(aNodes, aT);
+
+    return getControlValue(aNodes, i, aT);
+}
+
+//_____________________________________________________________________________
+/**
+ * Find the index that aNodes.searchBinary() would return for a node at time
+ * aT (i.e., the index of the last node at or before aT, or -1). Unlike
+ * searchBinary(), this does not need _searchNode, so that the control values
+ * may be computed concurrently (e.g., by the analyses of AnalyzeTool).
+ */
+int ControlLinear::
+searchNodes(const ArrayPtrs<ControlLinearNode> &aNodes,double aT)
+{
+    int lo = 0;
+    int hi = aNodes.getSize() - 1;
+    int mid = -1;
+    if(lo>hi) return(-1);
+
+    while(lo <= hi) {
+        mid = (lo + hi) / 2;
+        const double tMid = aNodes.get(mid)->getTime();
+        if(aT < tMid) {
+            hi = mid - 1;
+        } else if(tMid < aT) {
+            lo = mid + 1;
+        } else {
+            break;
+        }
+    }
+
+    // MAKE SURE LESS THAN
+    if(aT < aNodes.get(mid)->getTime()) mid--;
+    return(mid);
+}
+
+double ControlLinear::
+getControlValue(const ArrayPtrs<ControlLinearNode> &aNodes,int i,
+                double aT) const
+{
+    int size = aNodes.getSize();
+    if(size<=0) return(SimTK::NaN);
 
     // BEFORE FIRST
     double value;
@@ -494,7 +535,7 @@ extrapolateBefore(const ArrayPtrs<ControlLinearNode> &aNodes,double aT) const
 }
 
 double ControlLinear::
-extrapolateAfter(ArrayPtrs<ControlLinearNode> &aNodes,double aT) const
+extrapolateAfter(const ArrayPtrs<ControlLinearNode> &aNodes,double aT) const
 {
     int size = aNodes.getSize();
     if(size<=0) return(SimTK::NaN);
@@ -529,6 +570,12 @@ getControlValue(double aT)
 }
 //_____________________________________________________________________________
 double ControlLinear::
+getControlValueInInterval(int aIndex, double aT) const
+{
+    return getControlValue(_xNodes,aIndex,aT);
+}
+//_____________________________________________________________________________
+double ControlLinear::
 extrapolateBefore(double aT) const
 {
     return extrapolateBefore(_xNodes,aT);
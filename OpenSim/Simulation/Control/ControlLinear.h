@@ -84,8 +84,8 @@ protected:
     double &_kv;
 
 
-    /** Utility node for speeding up searches for control values in
-    getControlValue() and elsewhere.  Without this node, a control node would
+    /** Utility node for speeding up searches for control nodes in
+    getParameterList() and elsewhere.  Without this node, a control node would
     need to be constructed, but this is too expensive.  It is better to construct
     a node up front, and then just alter the time. */
     ControlLinearNode _searchNode;
@@ -284,7 +284,18 @@ public:
      * in which case the parameters of that control node are changed.
      */
     void setControlValue(double aT,double aX) override;
+    /**
+     * Get the control value at time aT. This does not modify the control, so
+     * the control values at different times may be computed concurrently.
+     */
     double getControlValue(double aT) override;
+    /**
+     * Get the control value at time aT, given the index of the last control
+     * node whose time is at or before aT (-1 if aT precedes the first node).
+     * This allows controls whose nodes have the same times to share one
+     * search for the interval that contains aT.
+     */
+    double getControlValueInInterval(int aIndex, double aT) const;
     double getControlValueMin(double aT=0.0) override;
     /**
      * This method adds a set of control parameters at the specified time unless
@@ -383,9 +394,14 @@ public:
 
 private:
     void setControlValue(ArrayPtrs<ControlLinearNode> &aNodes,double aT,double aX);
-    double getControlValue(ArrayPtrs<ControlLinearNode> &aNodes,double aT);
+    double getControlValue(const ArrayPtrs<ControlLinearNode> &aNodes,
+                           double aT) const;
+    static int searchNodes(const ArrayPtrs<ControlLinearNode> &aNodes,
+                           double aT);
+    double getControlValue(const ArrayPtrs<ControlLinearNode> &aNodes,
+                           int aIndex,double aT) const;
     double extrapolateBefore(const ArrayPtrs<ControlLinearNode> &aNodes,double aT) const;
-    double extrapolateAfter(ArrayPtrs<ControlLinearNode> &aNodes,double aT) const;
+    double extrapolateAfter(const ArrayPtrs<ControlLinearNode> &aNodes,double aT) const;
 
 //=============================================================================
 };  // END of class ControlLinear
@@ -35,6 +35,7 @@
 #include "ControlSet.h"
 #include <OpenSim/Simulation/Model/Actuator.h>
 #include <OpenSim/Common/Storage.h>
+#include <algorithm>
 
 
 //=============================================================================
@@ -91,7 +92,7 @@ void ControlSetController::setNull()
 
     _model = NULL;
     _controlSet = NULL;
-
+    _routedControlSet = nullptr;
 
 }
 //_____________________________________________________________________________
@@ -123,6 +124,11 @@ setupProperties()
 void ControlSetController::copyData(const ControlSetController &aController)
 {   
     _controlsFileName = aController._controlsFileName;
+    _controlRoutes.clear();
+    _nodeTimes.clear();
+    _routedControlSet = nullptr;
+    _routedControls.clear();
+    _routedActuators.clear();
 }
 
 
@@ -152,6 +158,11 @@ operator=(const ControlSetController &aController)
 //=============================================================================
 // GET AND SET
 //=============================================================================
+void ControlSetController::setControlSet(ControlSet *aControlSet)
+{
+    _controlSet = aControlSet;
+    updateControlRoutes();
+}
 
 //=============================================================================
 // CONTROL
@@ -162,23 +173,54 @@ void ControlSetController::computeControls(const SimTK::State& s, SimTK::Vector&
 {
     SimTK_ASSERT( _controlSet , "ControlSetController::computeControls controlSet is NULL");
 
-    std::string actName = "";
-    int index = -1;
-
+    const double t = s.getTime();
     int na = getActuatorSet().getSize();
 
-    for(int i=0; i< na; ++i){
-        actName = getActuatorSet()[i].getName();
-        index = _controlSet->getIndex(actName);
-        if(index < 0){
-            actName = actName + ".excitation";
+    // The ControlSet or the actuators changed since the routes were built.
+    if (!areControlRoutesCurrent()) {
+        std::string actName = "";
+        int index = -1;
+
+        for(int i=0; i< na; ++i){
+            actName = getActuatorSet()[i].getName();
             index = _controlSet->getIndex(actName);
+            if(index < 0){
+                actName = actName + ".excitation";
+                index = _controlSet->getIndex(actName);
+            }
+
+            if(index >= 0){
+                SimTK::Vector actControls(1, _controlSet->get(index).getControlValue(t));
+                getActuatorSet()[i].addInControls(actControls, controls);
+            }
         }
+        return;
+    }
 
-        if(index >= 0){
-            SimTK::Vector actControls(1, _controlSet->get(index).getControlValue(s.getTime()));
-            getActuatorSet()[i].addInControls(actControls, controls);
+    // Index of the last shared node at or before t, as
+    // ArrayPtrs::searchBinary() would find it for each control.
+    const int numNodes = int(_nodeTimes.size());
+    const int interval = int(std::upper_bound(_nodeTimes.begin(),
+                                    _nodeTimes.end(), t) - _nodeTimes.begin()) - 1;
+
+    SimTK::Vector actControls(1);
+    for (const auto& route : _controlRoutes) {
+        double value;
+        const ControlLinear* linear = route.sharedNodes;
+        // Nodes may have been added to or moved in the control since the
+        // routes were built.
+        if (linear && linear->getNumParameters() == numNodes &&
+                (interval < 0 ||
+                 linear->getParameterTime(interval) == _nodeTimes[interval]) &&
+                (interval + 1 >= numNodes ||
+                 linear->getParameterTime(interval + 1) ==
+                        _nodeTimes[interval + 1])) {
+            value = linear->getControlValueInInterval(interval, t);
+        } else {
+            value = route.control->getControlValue(t);
         }
+        actControls[0] = value;
+        route.actuator->addInControls(actControls, controls);
     }
 }
 
@@ -260,6 +302,9 @@ void ControlSetController::extendFinalizeFromProperties()
     if (loadedControlSet) {
         // Now set the current control set from what was loaded
         _controlSet = loadedControlSet;
+        // The routes are rebuilt when the controller is connected to the
+        // model; until then, the controls are looked up by name.
+        _routedControlSet = nullptr;
         setEnabled(true);
     }
 
@@ -274,3 +319,90 @@ void ControlSetController::extendFinalizeFromProperties()
             updProperty_actuator_list().appendValue(actName);
     }
 }
+
+void ControlSetController::extendConnectToModel(Model& model)
+{
+    Super::extendConnectToModel(model);
+    updateControlRoutes();
+}
+
+void ControlSetController::updateControlRoutes()
+{
+    _controlRoutes.clear();
+    _nodeTimes.clear();
+    _routedControlSet = nullptr;
+    _routedControls.clear();
+    _routedActuators.clear();
+    if (_controlSet == nullptr)
+        return;
+
+    // Node times are compared exactly, as ArrayPtrs::searchBinary() does.
+    auto hasNodeTimes = [this](const ControlLinear& linear) {
+        if (linear.getNumParameters() != int(_nodeTimes.size()))
+            return false;
+        for (int j = 0; j < linear.getNumParameters(); ++j)
+            if (linear.getParameterTime(j) != _nodeTimes[j]) return false;
+        return true;
+    };
+
+    const int na = getActuatorSet().getSize();
+    for (int i = 0; i < na; ++i) {
+        const Actuator& actuator = getActuatorSet()[i];
+        int index = _controlSet->getIndex(actuator.getName());
+        if (index < 0)
+            index = _controlSet->getIndex(actuator.getName() + ".excitation");
+        if (index < 0)
+            continue;
+
+        Control& control = _controlSet->get(index);
+        const ControlLinear* linear = dynamic_cast<ControlLinear*>(&control);
+        if (linear && _nodeTimes.empty()) {
+            // The first ControlLinear with strictly increasing node times
+            // provides the shared times.
+            bool increasing = linear->getNumParameters() > 0;
+            for (int j = 1; increasing && j < linear->getNumParameters(); ++j)
+                increasing = linear->getParameterTime(j - 1) <
+                             linear->getParameterTime(j);
+            if (increasing)
+                for (int j = 0; j < linear->getNumParameters(); ++j)
+                    _nodeTimes.push_back(linear->getParameterTime(j));
+        }
+        if (linear && (_nodeTimes.empty() || !hasNodeTimes(*linear)))
+            linear = nullptr;
+
+        _controlRoutes.push_back({&actuator, &control, linear});
+    }
+
+    _routedControlSet = _controlSet;
+    for (int i = 0; i < _controlSet->getSize(); ++i) {
+        const Control& control = _controlSet->get(i);
+        _routedControls.push_back({&control, control.getName()});
+    }
+    for (int i = 0; i < na; ++i) {
+        const Actuator& actuator = getActuatorSet()[i];
+        _routedActuators.push_back({&actuator, actuator.getName()});
+    }
+}
+
+bool ControlSetController::areControlRoutesCurrent() const
+{
+    // Comparing the addresses catches controls or actuators that have been
+    // replaced, and comparing the names catches those that have been renamed.
+    if (_controlSet != _routedControlSet ||
+            _controlSet->getSize() != int(_routedControls.size()) ||
+            getActuatorSet().getSize() != int(_routedActuators.size()))
+        return false;
+    for (int i = 0; i < _controlSet->getSize(); ++i) {
+        const Control& control = _controlSet->get(i);
+        if (&control != _routedControls[i].first ||
+                control.getName() != _routedControls[i].second)
+            return false;
+    }
+    for (int i = 0; i < getActuatorSet().getSize(); ++i) {
+        const Actuator& actuator = getActuatorSet()[i];
+        if (&actuator != _routedActuators[i].first ||
+                actuator.getName() != _routedActuators[i].second)
+            return false;
+    }
+    return true;
+}
@@ -32,11 +32,16 @@
 // that will be used by the Controller class.
 #include "Controller.h"
 #include <OpenSim/Common/PropertyStr.h>
+#include <string>
+#include <utility>
+#include <vector>
 
 //=============================================================================
 //=============================================================================
 namespace OpenSim { 
 
+class Control;
+class ControlLinear;
 class ControlSet;
 
 /**
@@ -83,7 +88,7 @@ public:
     const ControlSet *getControlSet() {return _controlSet;} 
     ControlSet *updControlSet() {return _controlSet;}
 
-    void setControlSet(ControlSet *aControlSet) {_controlSet = aControlSet;}
+    void setControlSet(ControlSet *aControlSet);
 
 
     
@@ -93,6 +98,29 @@ private:
 
     void setNull();
 
+    /** Match each actuator to its control once, so computeControls() need not
+    look the controls up by name. ControlLinears whose nodes have the same
+    times share a single search for the interval that contains the time. */
+    void updateControlRoutes();
+    /** Whether the ControlSet, its controls and the actuators are the ones
+    (with the names) for which the routes were built. */
+    bool areControlRoutesCurrent() const;
+
+    struct ControlRoute {
+        const Actuator* actuator;
+        Control* control;
+        // Non-null if the control's nodes have the times in _nodeTimes.
+        const ControlLinear* sharedNodes;
+    };
+    std::vector<ControlRoute> _controlRoutes;
+    std::vector<double> _nodeTimes;
+    // The ControlSet, its controls and the actuators, with their names, when
+    // the routes were built; if any of them has been replaced or renamed
+    // since, the controls are looked up by name.
+    const ControlSet* _routedControlSet;
+    std::vector<std::pair<const Control*, std::string>> _routedControls;
+    std::vector<std::pair<const Actuator*, std::string>> _routedActuators;
+
 protected:
 
     /**
@@ -110,6 +138,8 @@ protected:
 
     /// read in ControlSet and update Controller's actuator list
     void extendFinalizeFromProperties() override;
+    /// match the actuators to their controls
+    void extendConnectToModel(Model& model) override;
 
     //--------------------------------------------------------------------------
     // OPERATORS
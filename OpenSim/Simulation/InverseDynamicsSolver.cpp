@@ -25,6 +25,8 @@
 #include "Model/Model.h"
 #include <OpenSim/Common/FunctionSet.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace SimTK;
 
@@ -113,11 +115,7 @@ Vector InverseDynamicsSolver::solve(SimTK::State &s, const FunctionSet &Qs, doub
     Vector &u = s.updU();
     Vector &udot = s.updUDot();
 
-    for(int i=0; i<nq; i++){
-        q[i] = Qs.evaluate(i, 0, time);
-        u[i] = Qs.evaluate(i, 1, time);
-        udot[i] = Qs.evaluate(i, 2, time);
-    }
+    Qs.evaluateWithDerivatives(time, q, u, udot);
 
     // Perform general inverse dynamics
     return solve(s, udot);
@@ -141,4 +139,83 @@ void InverseDynamicsSolver::solve(SimTK::State &s, const FunctionSet &Qs, const
     }
 }
 
+namespace {
+/** Solves a contiguous block of frames per task index, each on a private copy
+    of the state. */
+class InverseDynamicsTask : public ParallelExecutor::Task {
+public:
+    InverseDynamicsTask(InverseDynamicsSolver& solver, const State& s,
+            const FunctionSet& Qs, const Array_<double>& times,
+            Array_<Vector>& genForceTrajectory, int firstFrame,
+            int numBlocks) :
+        _solver(solver), _s(s), _Qs(Qs), _times(times),
+        _genForceTrajectory(genForceTrajectory), _firstFrame(firstFrame),
+        _numBlocks(numBlocks) {}
+
+    void execute(int block) override {
+        const long long n = (long long)_times.size() - _firstFrame;
+        const int begin = _firstFrame + (int)((n * block) / _numBlocks);
+        const int end = _firstFrame + (int)((n * (block + 1)) / _numBlocks);
+        if (begin >= end) return;
+
+        State s(_s);
+        Vector udot(s.getNU());
+        for (int i = begin; i < end; ++i) {
+            s.updTime() = _times[i];
+            _Qs.evaluateWithDerivatives(_times[i], s.updQ(), s.updU(), udot);
+            _genForceTrajectory[i] = _solver.solve(s, udot);
+        }
+    }
+
+private:
+    InverseDynamicsSolver& _solver;
+    const State& _s;
+    const FunctionSet& _Qs;
+    const Array_<double>& _times;
+    Array_<Vector>& _genForceTrajectory;
+    const int _firstFrame;
+    const int _numBlocks;
+};
+} // anonymous namespace
+
+/** Same as above but frames are solved concurrently */
+void InverseDynamicsSolver::solveInParallel(const SimTK::State &s,
+        const FunctionSet &Qs, const Array_<double> &times,
+        Array_<Vector> &genForceTrajectory, int numThreads)
+{
+    int nq = getModel().getNumCoordinates();
+    int nt = times.size();
+
+    if(Qs.getSize() != nq){
+        throw Exception("InverseDynamicsSolver::solveInParallel invalid number of q functions.");
+    }
+
+    if( nq != getModel().getNumSpeeds()){
+        throw Exception("InverseDynamicsSolver::solveInParallel using FunctionSet, nq != nu not supported.");
+    }
+
+    //Preallocate if not done already
+    genForceTrajectory.resize(nt, Vector(nq));
+    if(nt == 0) return;
+
+    // Solve the first frame on this thread so that lazily constructed
+    // internals (e.g., the fits of the coordinate splines and of the splines
+    // in model forces) exist before the workers evaluate them concurrently.
+    State s0(s);
+    Vector udot(nq);
+    s0.updTime() = times[0];
+    Qs.evaluateWithDerivatives(times[0], s0.updQ(), s0.updU(), udot);
+    genForceTrajectory[0] = solve(s0, udot);
+    if(nt == 1) return;
+
+    if(numThreads < 1)
+        numThreads = ParallelExecutor::getNumProcessors();
+    numThreads = std::max(1, std::min(numThreads, nt-1));
+
+    InverseDynamicsTask task(*this, s, Qs, times, genForceTrajectory,
+            1, numThreads);
+    ParallelExecutor executor(numThreads);
+    executor.execute(task, numThreads);
+}
+
 } // end of namespace OpenSim
\ No newline at end of file
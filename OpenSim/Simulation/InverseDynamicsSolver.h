@@ -98,6 +98,28 @@ public:
     virtual void solve(SimTK::State& s, const FunctionSet& Qs, 
                  const SimTK::Array_<double>&  times,
                  SimTK::Array_<SimTK::Vector>& genForceTrajectory);
+
+    /** Same as above, but the time frames are distributed across worker
+        threads. Each thread solves a contiguous block of frames on its own
+        copy of the state s, sharing the (read-only) model and system. The
+        coordinate values, speeds and accelerations for a frame are obtained
+        from Qs in a single FunctionSet::evaluateWithDerivatives() call.
+        Because frames are not solved in order, the model's analyses are
+        not stepped; use the serial solve() if analyses must be updated.
+        The functions in Qs are evaluated concurrently and must therefore
+        be safe to evaluate from multiple threads (GCVSplines and Constants
+        are).
+        @param[in] s        the state whose discrete variables and enabled
+                            forces are copied to each thread
+        @param[in] Qs       coordinate functions, in multibody tree order
+        @param[in] times    the times at which to solve
+        @param[out] genForceTrajectory  generalized forces for each time
+        @param[in] numThreads  number of threads to use; values less than 1
+                            use as many threads as there are processors */
+    void solveInParallel(const SimTK::State& s, const FunctionSet& Qs,
+                 const SimTK::Array_<double>&  times,
+                 SimTK::Array_<SimTK::Vector>& genForceTrajectory,
+                 int numThreads = 0);
 #endif
 //=============================================================================
 };  // END of class InverseDynamicsSolver
@@ -26,13 +26,18 @@
  */
 #include <cstdio>
 #include "Manager.h"
+#include <OpenSim/Simulation/BinaryIO.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/AnalysisSet.h>
 #include <OpenSim/Simulation/Model/ControllerSet.h>
 #include <OpenSim/Common/Array.h>
+#include <OpenSim/Common/Reporter.h>
+#include <cstring>
+#include <fstream>
 
 
 using namespace OpenSim;
+using namespace OpenSim::BinaryIO;
 using namespace std;
 
 #define ASSERT(cond) {if (!(cond)) throw(exception());}
@@ -40,9 +45,169 @@ using namespace std;
 // STATICS
 //=============================================================================
 std::string Manager::_displayName = "Simulator";
+
+// Identifies the checkpoint file format; the last character is the version.
+static const char CheckpointFileMagic[8] = {'O','S','I','M','C','K','P','1'};
+
+// Hide these from other translation units.
+namespace {
+    /** The records of a Storage or of the table of a TableReporter, as saved
+    in a checkpoint. */
+    struct CheckpointTable {
+        std::string key;
+        std::vector<std::string> labels;
+        std::vector<double> times;
+        // The number of values in each row, and the values of all the rows.
+        std::vector<size_t> rowSizes;
+        std::vector<double> values;
+    };
+
+    void writeTable(std::ostream& out, const std::string& key,
+                    const Storage& storage) {
+        writeString(out, key);
+        const Array<std::string>& labels = storage.getColumnLabels();
+        writeSize(out, labels.getSize());
+        for (int i = 0; i < labels.getSize(); ++i)
+            writeString(out, labels[i]);
+        writeSize(out, storage.getSize());
+        for (int i = 0; i < storage.getSize(); ++i) {
+            const StateVector& row = *storage.getStateVector(i);
+            writeDouble(out, row.getTime());
+            writeSize(out, row.getSize());
+            if (row.getSize() > 0)
+                out.write(reinterpret_cast<const char*>(&row.getData()[0]),
+                          row.getSize()*sizeof(double));
+        }
+    }
+
+    // Write the tables of the model's TableReporter_<InputT, ValueT>s, whose
+    // elements are ValueT = double or SimTK::Vec3.
+    template <typename InputT, typename ValueT>
+    void writeReporterTables(std::ostream& out, const Model& model) {
+        for (const auto& reporter :
+                model.getComponentList<TableReporter_<InputT, ValueT>>()) {
+            const TimeSeriesTable_<ValueT>& table = reporter.getTable();
+            writeString(out, reporter.getAbsolutePathString());
+            const std::vector<std::string> labels = table.hasColumnLabels() ?
+                    table.getColumnLabels() : std::vector<std::string>();
+            writeSize(out, labels.size());
+            for (const auto& label : labels)
+                writeString(out, label);
+            const auto& times = table.getIndependentColumn();
+            const size_t numColumns = table.getNumColumns();
+            writeSize(out, times.size());
+            for (size_t i = 0; i < times.size(); ++i) {
+                writeDouble(out, times[i]);
+                writeSize(out, numColumns*sizeof(ValueT)/sizeof(double));
+                const auto row = table.getRowAtIndex(i);
+                for (int j = 0; j < int(numColumns); ++j)
+                    out.write(reinterpret_cast<const char*>(&row[j]),
+                              sizeof(ValueT));
+            }
+        }
+    }
+
+    // Read the next table; returns false at the end of the tables.
+    bool readTable(Reader& reader, CheckpointTable& table) {
+        std::istream& in = reader.getStream();
+        table.key = reader.readString();
+        if (!in || table.key.empty()) return false;
+        // Each label has at least its length, and each row its time and size.
+        table.labels.resize(reader.readSize(sizeof(double)));
+        for (auto& label : table.labels)
+            label = reader.readString();
+        const size_t numRows = reader.readSize(2*sizeof(double));
+        table.times.resize(numRows);
+        table.rowSizes.resize(numRows);
+        table.values.clear();
+        for (size_t i = 0; i < numRows && in; ++i) {
+            table.times[i] = reader.readDouble();
+            table.rowSizes[i] = reader.readSize(sizeof(double));
+            const size_t offset = table.values.size();
+            table.values.resize(offset + table.rowSizes[i]);
+            reader.read(
+                    reinterpret_cast<char*>(table.values.data() + offset),
+                    table.rowSizes[i]*sizeof(double));
+        }
+        return bool(in);
+    }
+
+    const CheckpointTable& findTable(const std::vector<CheckpointTable>& tables,
+            const std::string& key, const std::string& filePath) {
+        for (const auto& table : tables)
+            if (table.key == key) return table;
+        OPENSIM_THROW(Exception, "The checkpoint in file '" + filePath +
+                "' has no records for '" + key + "'; was it written by a "
+                "Manager with the same analyses, reporters and settings?");
+    }
+
+    void restoreStorage(Storage& storage, const CheckpointTable& table) {
+        Array<std::string> labels;
+        for (const auto& label : table.labels)
+            labels.append(label);
+        storage.purge();
+        storage.setColumnLabels(labels);
+        const double* values = table.values.data();
+        for (size_t i = 0; i < table.times.size(); ++i) {
+            const int size = int(table.rowSizes[i]);
+            storage.append(table.times[i], size, values, false);
+            values += size;
+        }
+    }
+
+    template <typename InputT, typename ValueT>
+    void checkReporterTables(const Model& model,
+            const std::vector<CheckpointTable>& tables,
+            const std::string& filePath) {
+        for (const auto& reporter :
+                model.getComponentList<TableReporter_<InputT, ValueT>>())
+            findTable(tables, reporter.getAbsolutePathString(), filePath);
+    }
+
+    // Restore the tables of the model's TableReporter_<InputT, ValueT>s from
+    // a checkpoint written at the given time, keeping the rows reported since
+    // then.
+    template <typename InputT, typename ValueT>
+    void restoreReporterTables(Model& model,
+            const std::vector<CheckpointTable>& tables,
+            const std::string& filePath, double time) {
+        const size_t width = sizeof(ValueT)/sizeof(double);
+        for (auto& reporter :
+                model.updComponentList<TableReporter_<InputT, ValueT>>()) {
+            const CheckpointTable& saved = findTable(tables,
+                    reporter.getAbsolutePathString(), filePath);
+            TimeSeriesTable_<ValueT> table;
+            if (!saved.labels.empty()) table.setColumnLabels(saved.labels);
+            const double* values = saved.values.data();
+            for (size_t i = 0; i < saved.times.size(); ++i) {
+                SimTK::RowVector_<ValueT> row(int(saved.rowSizes[i]/width));
+                for (int j = 0; j < row.size(); ++j)
+                    std::memcpy(&row[j], values + j*width, sizeof(ValueT));
+                values += saved.rowSizes[i];
+                table.appendRow(saved.times[i], row);
+            }
+            const TimeSeriesTable_<ValueT>& current = reporter.getTable();
+            const auto& times = current.getIndependentColumn();
+            for (size_t i = 0; i < times.size(); ++i)
+                if (times[i] > time)
+                    table.appendRow(times[i], current.getRowAtIndex(i));
+            reporter.setTable(table);
+        }
+    }
+}
+
+struct Manager::Checkpoint {
+    std::string filePath;
+    double time;
+    // The number of the next integration step.
+    int step;
+    std::vector<CheckpointTable> tables;
+};
+
 //=============================================================================
 // DESTRUCTOR
 //=============================================================================
+Manager::~Manager() = default;
 
 
 //=============================================================================
@@ -99,6 +264,8 @@ setNull()
     _writeToStorage=true;
     _tArray.setSize(0);
     _dtArray.setSize(0);
+    _checkpointInterval = 0;
+    _lastCheckpointTime = SimTK::NaN;
 }
 
 //_____________________________________________________________________________
@@ -645,12 +812,17 @@ hasStateStorage() const
 
 const SimTK::State& Manager::integrate(double finalTime)
 {
-    int step = 1; // for AnalysisSet::step()
-
     if (_timeStepper == nullptr) {
         throw Exception("Manager::integrate(): Manager has not been "
             "initialized. Call Manager::initialize() first.");
     }
+    OPENSIM_THROW_IF(_checkpointInterval > 0 && _checkpointFile.empty(),
+        Exception, "Manager::integrate(): A checkpoint interval is set, but "
+        "no checkpoint file. Call Manager::setCheckpointFile() first.");
+
+    // Continue the numbering of the steps of the integration that wrote the
+    // checkpoint, if any.
+    int step = _checkpoint ? _checkpoint->step : 1; // for AnalysisSet::step()
 
     // Get the internal state
     const SimTK::State& s = _integ->getState();
@@ -699,7 +871,13 @@ const SimTK::State& Manager::integrate(double finalTime)
     _model->realizeVelocity(s);
     initializeStorageAndAnalyses(s);
 
-    if (fixedStep) {
+    if (_checkpoint) {
+        // Now that the analyses have begun, replace their records (and those
+        // of the states and controls) with the records in the checkpoint.
+        for (const auto& storage : getCheckpointStorages())
+            restoreStorage(*storage.second, findTable(_checkpoint->tables,
+                    storage.first, _checkpoint->filePath));
+    } else if (fixedStep) {
         _model->realizeAcceleration(s);
         record(s, step);
     }
@@ -709,6 +887,7 @@ const SimTK::State& Manager::integrate(double finalTime)
 
     if (time >= stepToTime) {
         // No integration can be performed.
+        if (_checkpoint) restoreCheckpointReports();
         return getState();
     }
 
@@ -726,12 +905,20 @@ const SimTK::State& Manager::integrate(double finalTime)
         }
 
         status = _timeStepper->stepTo(stepToTime);
+        // The reports at the time of the checkpoint, if any, have now been
+        // made again.
+        if (_checkpoint) restoreCheckpointReports();
 
         if ( (status == SimTK::Integrator::TimeHasAdvanced) ||
              (status == SimTK::Integrator::ReachedScheduledEvent) ) {
             const SimTK::State& s = _integ->getState();
             record(s, step);
             step++;
+            if (_checkpointInterval > 0 &&
+                    s.getTime() >= _lastCheckpointTime + _checkpointInterval) {
+                writeCheckpoint(_checkpointFile, step);
+                _lastCheckpointTime = s.getTime();
+            }
         }
         // Check if simulation has terminated for some reason
         else if (_integ->isSimulationOver() &&
@@ -821,9 +1008,184 @@ void Manager::initialize(const SimTK::State& s)
             new SimTK::TimeStepper(_model->getMultibodySystem(), *_integ));
         _timeStepper->initialize(s);
         _timeStepper->setReportAllSignificantStates(true);
+        _lastCheckpointTime = s.getTime();
     }
 }
 
+//=============================================================================
+// CHECKPOINT AND RESTART
+//=============================================================================
+void Manager::setCheckpointInterval(double interval)
+{
+    OPENSIM_THROW_IF(interval < 0, Exception,
+        "Manager::setCheckpointInterval(): Expected a nonnegative interval, "
+        "but got " + std::to_string(interval) + ".");
+    _checkpointInterval = interval;
+}
+
+std::vector<std::pair<std::string, Storage*>>
+Manager::getCheckpointStorages() const
+{
+    // These are the Storages that record() writes to.
+    std::vector<std::pair<std::string, Storage*>> storages;
+    if (_writeToStorage) {
+        if (hasStateStorage())
+            storages.push_back(std::make_pair("states", _stateStore.get()));
+        if (_model->isControlled() && _controllerSet->updControlStorage())
+            storages.push_back(std::make_pair("controls",
+                                        _controllerSet->updControlStorage()));
+    }
+    if (_performAnalyses) {
+        AnalysisSet& analysisSet = _model->updAnalysisSet();
+        for (int i = 0; i < analysisSet.getSize(); ++i) {
+            ArrayPtrs<Storage>& list = analysisSet.get(i).getStorageList();
+            for (int j = 0; j < list.getSize(); ++j)
+                storages.push_back(std::make_pair("analyses/" +
+                        analysisSet.get(i).getName() + "/" +
+                        std::to_string(j), list[j]));
+        }
+    }
+    return storages;
+}
+
+void Manager::writeCheckpoint(const std::string& filePath) const
+{
+    OPENSIM_THROW_IF(_timeStepper == nullptr, Exception,
+        "Manager::writeCheckpoint(): Manager has not been initialized.");
+    OPENSIM_THROW_IF(_checkpoint != nullptr, Exception,
+        "Manager::writeCheckpoint(): The records of the checkpoint with which "
+        "the Manager was initialized are restored by integrate(); call "
+        "Manager::integrate() first.");
+    // The next call to integrate() numbers its steps from 1.
+    writeCheckpoint(filePath, 1);
+}
+
+void Manager::writeCheckpoint(const std::string& filePath, int step) const
+{
+    const SimTK::State& s = getState();
+
+    // Write to a temporary file first, so that a failure while writing does
+    // not destroy the previous checkpoint.
+    const std::string tempPath = filePath + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary);
+        OPENSIM_THROW_IF(!out, IOError,
+                "Could not open file '" + tempPath + "' for writing.");
+
+        out.write(CheckpointFileMagic, sizeof(CheckpointFileMagic));
+        writeDouble(out, s.getTime());
+        writeSize(out, step);
+        writeDouble(out, _integ->getPredictedNextStepSize());
+
+        const SimTK::Vector& y = s.getY();
+        writeSize(out, y.size());
+        for (int i = 0; i < y.size(); ++i)
+            writeDouble(out, y[i]);
+
+        const auto discreteVariables = getDiscreteVariables(*_model);
+        writeSize(out, discreteVariables.size());
+        for (const auto& dv : discreteVariables) {
+            writeString(out,
+                        dv.first->getAbsolutePathString() + "/" + dv.second);
+            writeDouble(out, dv.first->getDiscreteVariableValue(s, dv.second));
+        }
+
+        for (const auto& storage : getCheckpointStorages())
+            writeTable(out, storage.first, *storage.second);
+        writeReporterTables<SimTK::Real, SimTK::Real>(out, *_model);
+        writeReporterTables<SimTK::Vec3, SimTK::Vec3>(out, *_model);
+        writeReporterTables<SimTK::Vector, SimTK::Real>(out, *_model);
+        // An empty key ends the tables.
+        writeString(out, "");
+
+        OPENSIM_THROW_IF(!out, IOError,
+                "Could not write to file '" + tempPath + "'.");
+    }
+    std::remove(filePath.c_str());
+    OPENSIM_THROW_IF(std::rename(tempPath.c_str(), filePath.c_str()) != 0,
+            IOError, "Could not rename file '" + tempPath + "' to '" +
+            filePath + "'.");
+}
+
+void Manager::initializeFromCheckpoint(const SimTK::State& s,
+                                       const std::string& filePath)
+{
+    std::ifstream in(filePath, std::ios::binary);
+    OPENSIM_THROW_IF(!in, IOError,
+            "Could not open file '" + filePath + "' for reading.");
+
+    char magic[sizeof(CheckpointFileMagic)];
+    in.read(magic, sizeof(magic));
+    OPENSIM_THROW_IF(!in || std::memcmp(magic, CheckpointFileMagic,
+                                        sizeof(magic)) != 0,
+            IOError, "File '" + filePath + "' is not a checkpoint file.");
+
+    std::unique_ptr<Checkpoint> checkpoint(new Checkpoint());
+    checkpoint->filePath = filePath;
+    SimTK::State state = s;
+    Reader reader(in);
+    checkpoint->time = reader.readDouble();
+    state.setTime(checkpoint->time);
+    checkpoint->step = int(reader.readSize(0));
+    const double stepSize = reader.readDouble();
+
+    const size_t numY = reader.readSize(sizeof(double));
+    OPENSIM_THROW_IF(!in, IOError,
+            "Could not read the header of file '" + filePath + "'.");
+    OPENSIM_THROW_IF(numY != size_t(state.getNY()), Exception,
+            "The checkpoint in file '" + filePath + "' has " +
+            std::to_string(numY) + " continuous state variables, but the "
+            "state of Model '" + _model->getName() + "' has " +
+            std::to_string(state.getNY()) + ".");
+    SimTK::Vector& y = state.updY();
+    for (int i = 0; i < y.size(); ++i)
+        y[i] = reader.readDouble();
+
+    const auto discreteVariables = getDiscreteVariables(*_model);
+    const size_t numDiscrete = reader.readSize(sizeof(double));
+    OPENSIM_THROW_IF(numDiscrete != discreteVariables.size(), Exception,
+            "The discrete variables in file '" + filePath + "' do not match "
+            "those of Model '" + _model->getName() + "'.");
+    for (const auto& dv : discreteVariables) {
+        const std::string name = reader.readString();
+        OPENSIM_THROW_IF(name !=
+                dv.first->getAbsolutePathString() + "/" + dv.second,
+                Exception, "The discrete variables in file '" + filePath +
+                "' do not match those of Model '" + _model->getName() + "'.");
+        dv.first->setDiscreteVariableValue(state, dv.second,
+                                           reader.readDouble());
+    }
+
+    CheckpointTable table;
+    while (readTable(reader, table))
+        checkpoint->tables.push_back(table);
+    OPENSIM_THROW_IF(!in, IOError, "File '" + filePath + "' is truncated.");
+    for (const auto& storage : getCheckpointStorages())
+        findTable(checkpoint->tables, storage.first, filePath);
+    checkReporterTables<SimTK::Real, SimTK::Real>(*_model,
+            checkpoint->tables, filePath);
+    checkReporterTables<SimTK::Vec3, SimTK::Vec3>(*_model,
+            checkpoint->tables, filePath);
+    checkReporterTables<SimTK::Vector, SimTK::Real>(*_model,
+            checkpoint->tables, filePath);
+
+    // Take the step that the integration would have taken next.
+    if (stepSize > 0) _integ->setInitialStepSize(stepSize);
+    initialize(state);
+    _checkpoint = std::move(checkpoint);
+}
+
+void Manager::restoreCheckpointReports()
+{
+    restoreReporterTables<SimTK::Real, SimTK::Real>(*_model,
+            _checkpoint->tables, _checkpoint->filePath, _checkpoint->time);
+    restoreReporterTables<SimTK::Vec3, SimTK::Vec3>(*_model,
+            _checkpoint->tables, _checkpoint->filePath, _checkpoint->time);
+    restoreReporterTables<SimTK::Vector, SimTK::Real>(*_model,
+            _checkpoint->tables, _checkpoint->filePath, _checkpoint->time);
+    _checkpoint.reset();
+}
+
 void Manager::record(const SimTK::State& s, const int& step)
 {
     // ANALYSES 
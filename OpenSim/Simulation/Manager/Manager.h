@@ -118,6 +118,20 @@ private:
     /** controllerSet used for the integration */
     ControllerSet* _controllerSet;
 
+    /** Simulated time between the checkpoints written by integrate(); 0 if
+    no checkpoints are written. */
+    double _checkpointInterval;
+    /** File to which integrate() writes checkpoints. */
+    std::string _checkpointFile;
+    /** Time of the last checkpoint written by integrate(), or of the state
+    with which the Manager was initialized. */
+    double _lastCheckpointTime;
+
+    /** A checkpoint read by initializeFromCheckpoint() whose records are
+    restored by the next integrate(). */
+    struct Checkpoint;
+    std::unique_ptr<Checkpoint> _checkpoint;
+
 
 //=============================================================================
 // METHODS
@@ -141,6 +155,8 @@ public:
     DEPRECATED_14("There will be no replacement for this constructor.")
     Manager();
 
+    ~Manager();
+
     // This class would not behave properly if copied (we would need to write a
     // complex custom copy constructor, etc.), so don't allow copies.
     Manager(const Manager&) = delete;
@@ -330,6 +346,84 @@ public:
     */
     const SimTK::State& integrate(double finalTime);
 
+    /** @name Checkpoint and restart
+      * A checkpoint holds what is needed to continue an integration from
+      * where it was written: the time, the continuous state variables (Y),
+      * the discrete variables allocated by the model's components (see
+      * Component::addDiscreteVariable()), the size of the next integration
+      * step and the number of steps taken, and the records kept so far in
+      * the state Storage, the control Storage of the ControllerSet, the
+      * Storages of the model's Analyses, and the tables of its
+      * TableReporter%s. A checkpoint is a binary file, in the byte order of
+      * the machine that wrote it.
+      *
+      * Everything else in the SimTK::State (e.g., modeling options and
+      * locked coordinates) cannot change during an integration, and is taken
+      * from the state passed to initializeFromCheckpoint(). Event triggers
+      * are evaluated anew at the time of the checkpoint, as when a Manager
+      * is initialized.
+      *
+      * To continue a simulation from a checkpoint, create the model, its
+      * initial state and the Manager as for the original simulation:
+      * @code
+      * SimTK::State& state = model.initSystem();
+      * Manager manager(model);
+      * manager.setIntegratorAccuracy(1e-5);
+      * manager.setCheckpointFile("gait.checkpoint");
+      * manager.setCheckpointInterval(0.1);
+      * manager.initialize(state);
+      * manager.integrate(10.0);
+      * // ... later, possibly in another process ...
+      * SimTK::State& initialState = model.initSystem();
+      * Manager resumed(model);
+      * resumed.setIntegratorAccuracy(1e-5);
+      * resumed.initializeFromCheckpoint(initialState, "gait.checkpoint");
+      * resumed.integrate(10.0);
+      * @endcode
+      * The records of Analyses that defer their computations to
+      * Analysis::end() (e.g., StaticOptimization with more than one thread)
+      * are only complete once the integration ends.
+      * @{ */
+
+    /** Write a checkpoint during integrate() after the first integration
+      * step that is at least the given simulated time after the previous
+      * checkpoint (or after the state with which the Manager was
+      * initialized). Each checkpoint replaces the previous one in the file
+      * set with setCheckpointFile(). An interval of 0 (the default) disables
+      * checkpoints. */
+    void setCheckpointInterval(double interval);
+    double getCheckpointInterval() const { return _checkpointInterval; }
+
+    /** Set the file to which integrate() writes checkpoints. */
+    void setCheckpointFile(const std::string& filePath)
+    {   _checkpointFile = filePath; }
+    const std::string& getCheckpointFile() const { return _checkpointFile; }
+
+    /** Write a checkpoint of the current state of the integration (e.g.,
+      * after integrate() returns because of a halt()). The Manager must have
+      * been initialized. */
+    void writeCheckpoint(const std::string& filePath) const;
+
+    /** Initialize the Manager (see initialize()) to continue the integration
+      * saved in a checkpoint. The next call to integrate() replaces the
+      * records of the Storages and TableReporter%s with those in the
+      * checkpoint (followed by any reports made since), and continues
+      * the integration with the same step size and step numbering (see
+      * Analysis::step()) as the integration that wrote the checkpoint.
+      * Configure the Manager (e.g., its integrator and whether it performs
+      * analyses or writes to storage) as for that integration.
+      * @param s        A state of the model with the modeling options, locked
+      *                 coordinates, etc. of the state from which the
+      *                 original integration started (e.g., that state
+      *                 itself).
+      * @param filePath A file written by writeCheckpoint() or by
+      *                 integrate().
+      * @throws Exception if the checkpoint does not match the model or the
+      *         Storages and TableReporter%s of the model. */
+    void initializeFromCheckpoint(const SimTK::State& s,
+                                  const std::string& filePath);
+    /** @} */
+
     /** Get the current State from the Integrator associated with this 
       * Manager. */
     const SimTK::State& getState() const;
@@ -363,6 +457,15 @@ private:
     // step = 0 is the beginning, step = -1 used to denote the end/final step
     void record(const SimTK::State& s, const int& step);
 
+    // The Storages saved in checkpoints, with their keys in the file.
+    std::vector<std::pair<std::string, Storage*>>
+        getCheckpointStorages() const;
+    // Write a checkpoint; the next step of the integration is numbered step.
+    void writeCheckpoint(const std::string& filePath, int step) const;
+    // Restore the tables of the TableReporters from _checkpoint, which is
+    // then discarded.
+    void restoreCheckpointReports();
+
 //=============================================================================
 };  // END of class Manager
 
@@ -129,6 +129,7 @@ void Bhargava2004MuscleMetabolicsProbe::constructProperties()
 void Bhargava2004MuscleMetabolicsProbe::extendConnectToModel(Model& aModel)
 {
     Super::extendConnectToModel(aModel);
+    _metabolicMuscles.clear();
     if (!isEnabled()) return;   // Nothing to connect
 
     const int nM = 
@@ -138,6 +139,37 @@ void Bhargava2004MuscleMetabolicsProbe::extendConnectToModel(Model& aModel)
         connectIndividualMetabolicMuscle(aModel, 
             upd_Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet()[i]);
     }
+    cacheMetabolicMuscles();
+}
+
+
+//_____________________________________________________________________________
+/**
+ * Store the connected muscles and their parameter objects for
+ * computeProbeInputs(), which reads the parameters themselves when it is
+ * called. This must be called again whenever the MetabolicMuscleParameterSet
+ * changes.
+ */
+void Bhargava2004MuscleMetabolicsProbe::cacheMetabolicMuscles()
+{
+    _metabolicMuscles.clear();
+    if (!isEnabled()) return;
+
+    const int nM = 
+        get_Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet()
+        .getSize();
+    _metabolicMuscles.reserve(nM);
+    for (int i=0; i<nM; ++i) {
+        const Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameter& mm =
+            get_Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet()[i];
+        if (mm.getMuscle()) {
+            MetabolicMuscle muscle;
+            muscle.muscle = mm.getMuscle();
+            muscle.parameters = &mm;
+            muscle.index = i;
+            _metabolicMuscles.push_back(muscle);
+        }
+    }
 }
 
 
@@ -249,8 +281,7 @@ SimTK::Vector Bhargava2004MuscleMetabolicsProbe::
 computeProbeInputs(const State& s) const
 {
     // Initialize metabolic energy rate values
-    double Adot, Mdot, Sdot, Bdot, Wdot;
-    Adot = Mdot = Sdot = Bdot = Wdot = 0;
+    double Bdot = 0;
     Vector EdotOutput(getNumProbeInputs());
     EdotOutput = 0;
 
@@ -271,35 +302,48 @@ computeProbeInputs(const State& s) const
         EdotOutput(1) = Bdot;    // BASAL metabolic power storage
 
 
-    // Loop through each muscle in the MetabolicMuscleParameterSet
-    const int nM = 
-        get_Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet()
-        .getSize();
-    for (int i=0; i<nM; i++)
+    // Read the settings of the probe once for all muscles.
+    const double effortScalingFactor = get_muscle_effort_scaling_factor();
+    const bool useForceDependentShortening =
+        get_use_force_dependent_shortening_prop_constant();
+    const bool includeNegativeWork = get_include_negative_mechanical_work();
+    const bool forbidNegativePower = get_forbid_negative_total_power();
+    const bool activationOn = get_activation_rate_on();
+    const bool maintenanceOn = get_maintenance_rate_on();
+    const bool shorteningOn = get_shortening_rate_on();
+    const bool mechanicalWorkOn = get_mechanical_work_rate_on();
+    const bool enforceMinimumHeatRate =
+        get_enforce_minimum_heat_rate_per_muscle();
+    const bool reportTotalOnly = get_report_total_metabolics_only();
+    const OpenSim::Function& fiberLengthDependenceCurve =
+        get_normalized_fiber_length_dependence_on_maintenance_rate();
+    Vector fiberLengthArg(1);
+
+
+    // Loop through the muscles resolved in extendConnectToModel().
+    for (const MetabolicMuscle& mm : _metabolicMuscles)
     {
-        // Get the current muscle parameters from the MetabolicMuscleParameterSet
-        // and the corresponding OpenSim::Muscle pointer from the muscleMap.
-        Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameter& mm = 
-            get_Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet()[i];   
-        const Muscle* m = mm.getMuscle();
+        const Muscle* m = mm.muscle;
+        const Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameter&
+            params = *mm.parameters;
+        const double muscleMass = params.getMuscleMass();
+        double Adot = 0, Mdot = 0, Sdot = 0, Wdot = 0;
 
         // Get important muscle values at the current time state
         const double max_isometric_force = m->getMaxIsometricForce();
         //const double max_shortening_velocity = m->getMaxContractionVelocity();
-        const double activation = get_muscle_effort_scaling_factor()
-                                  * m->getActivation(s);
-        const double excitation = get_muscle_effort_scaling_factor()
-                                  * m->getControl(s);
+        const double activation = effortScalingFactor * m->getActivation(s);
+        const double excitation = effortScalingFactor * m->getControl(s);
         const double fiber_force_passive = m->getPassiveFiberForce(s);
-        const double fiber_force_active = get_muscle_effort_scaling_factor()
+        const double fiber_force_active = effortScalingFactor
                                           * m->getActiveFiberForce(s);
         const double fiber_force_total = fiber_force_active     // Scaled.
                                          + fiber_force_passive;
         const double fiber_length_normalized = m->getNormalizedFiberLength(s);
         const double fiber_velocity = m->getFiberVelocity(s);
         //const double fiber_velocity_normalized = m->getNormalizedFiberVelocity(s);
-        const double slow_twitch_excitation = mm.get_ratio_slow_twitch_fibers() * sin(Pi/2 * excitation);
-        const double fast_twitch_excitation = (1 - mm.get_ratio_slow_twitch_fibers()) * (1 - cos(Pi/2 * excitation));
+        const double slow_twitch_excitation = params.get_ratio_slow_twitch_fibers() * sin(Pi/2 * excitation);
+        const double fast_twitch_excitation = (1 - params.get_ratio_slow_twitch_fibers()) * (1 - cos(Pi/2 * excitation));
         double alpha, fiber_length_dependence;
 
         // Get the unnormalized total active force, F_iso that 'would' be developed at the current activation
@@ -316,26 +360,26 @@ computeProbeInputs(const State& s) const
 
         // ACTIVATION HEAT RATE for muscle i (W)
         // ------------------------------------------
-        if (get_forbid_negative_total_power() || get_activation_rate_on())
+        if (forbidNegativePower || activationOn)
         {
             const double decay_function_value = 1.0;    // This value is set to 1.0, as used by Anderson & Pandy (1999), however, in
                                                         // Bhargava et al., (2004) they assume a function here. We will ignore this
                                                         // function and use 1.0 for now.
-            Adot = mm.getMuscleMass() * decay_function_value * 
-                ( (mm.get_activation_constant_slow_twitch() * slow_twitch_excitation) + (mm.get_activation_constant_fast_twitch() * fast_twitch_excitation) );
+            Adot = muscleMass * decay_function_value * 
+                ( (params.get_activation_constant_slow_twitch() * slow_twitch_excitation) + (params.get_activation_constant_fast_twitch() * fast_twitch_excitation) );
         }
 
 
 
         // MAINTENANCE HEAT RATE for muscle i (W)
         // ------------------------------------------
-        if (get_forbid_negative_total_power() || get_maintenance_rate_on())
+        if (forbidNegativePower || maintenanceOn)
         {
-            Vector tmp(1, fiber_length_normalized);
-            fiber_length_dependence = get_normalized_fiber_length_dependence_on_maintenance_rate().calcValue(tmp);
+            fiberLengthArg[0] = fiber_length_normalized;
+            fiber_length_dependence = fiberLengthDependenceCurve.calcValue(fiberLengthArg);
             
-            Mdot = mm.getMuscleMass() * fiber_length_dependence * 
-                ( (mm.get_maintenance_constant_slow_twitch() * slow_twitch_excitation) + (mm.get_maintenance_constant_fast_twitch() * fast_twitch_excitation) );
+            Mdot = muscleMass * fiber_length_dependence * 
+                ( (params.get_maintenance_constant_slow_twitch() * slow_twitch_excitation) + (params.get_maintenance_constant_fast_twitch() * fast_twitch_excitation) );
         }
 
 
@@ -343,9 +387,9 @@ computeProbeInputs(const State& s) const
         // SHORTENING HEAT RATE for muscle i (W)
         // --> note that we define Vm<0 as shortening and Vm>0 as lengthening
         // -----------------------------------------------------------------------
-        if (get_forbid_negative_total_power() || get_shortening_rate_on())
+        if (forbidNegativePower || shorteningOn)
         {
-            if (get_use_force_dependent_shortening_prop_constant())
+            if (useForceDependentShortening)
             {
                 if (fiber_velocity <= 0)    // concentric contraction, Vm<0
                     alpha = (0.16 * F_iso) + (0.18 * fiber_force_total);
@@ -367,9 +411,9 @@ computeProbeInputs(const State& s) const
         // MECHANICAL WORK RATE for the contractile element of muscle i (W).
         // --> note that we define Vm<0 as shortening and Vm>0 as lengthening.
         // -------------------------------------------------------------------
-        if (get_forbid_negative_total_power() || get_mechanical_work_rate_on())
+        if (forbidNegativePower || mechanicalWorkOn)
         {
-            if (get_include_negative_mechanical_work() || fiber_velocity <= 0)
+            if (includeNegativeWork || fiber_velocity <= 0)
                 Wdot = -fiber_force_active*fiber_velocity;
             else
                 Wdot = 0;
@@ -390,7 +434,7 @@ computeProbeInputs(const State& s) const
 
         // If necessary, increase the shortening heat rate so that the total
         // power is non-negative.
-        if (get_forbid_negative_total_power()) {
+        if (forbidNegativePower) {
             const double Edot_W_beforeClamp = Adot + Mdot + Sdot + Wdot;
             if (Edot_W_beforeClamp < 0)
                 Sdot -= Edot_W_beforeClamp;
@@ -402,15 +446,15 @@ computeProbeInputs(const State& s) const
         // -----------------------------------------------------------------------
         double totalHeatRate = Adot + Mdot + Sdot;      // (W)
 
-        if(get_enforce_minimum_heat_rate_per_muscle() && totalHeatRate < 1.0 * mm.getMuscleMass()
-            && get_activation_rate_on() 
-            && get_maintenance_rate_on() 
-            && get_shortening_rate_on()) {
+        if(enforceMinimumHeatRate && totalHeatRate < 1.0 * muscleMass
+            && activationOn 
+            && maintenanceOn 
+            && shorteningOn) {
                 //cout << "WARNING: " << getName() 
                 //    << "  (t = " << s.getTime() 
-                //    << "), the muscle '" << mm.getName() 
+                //    << "), the muscle '" << m->getName() 
                 //    << "' has a net metabolic energy rate of less than 1.0 W/kg." << endl; 
-                totalHeatRate = 1.0 * mm.getMuscleMass();           // not allowed to fall below 1.0 W.kg-1
+                totalHeatRate = 1.0 * muscleMass;           // not allowed to fall below 1.0 W.kg-1
         }
 
 
@@ -418,36 +462,35 @@ computeProbeInputs(const State& s) const
         // ------------------------------------------
         double Edot = 0;
 
-        if (get_activation_rate_on() && get_maintenance_rate_on()
-            && get_shortening_rate_on())
+        if (activationOn && maintenanceOn && shorteningOn)
         {
             Edot += totalHeatRate;      // May have been clamped to 1.0 W/kg.
         } else {
-            if (get_activation_rate_on())
+            if (activationOn)
                 Edot += Adot;
-            if (get_maintenance_rate_on())
+            if (maintenanceOn)
                 Edot += Mdot;
-            if (get_shortening_rate_on())
+            if (shorteningOn)
                 Edot += Sdot;
         }
-        if (get_mechanical_work_rate_on())
+        if (mechanicalWorkOn)
             Edot += Wdot;
 
         EdotOutput(0) += Edot;       // Add to TOTAL metabolic power storage
-        if (!get_report_total_metabolics_only()) {
+        if (!reportTotalOnly) {
             // Metabolic power storage for muscle i
-            EdotOutput(i+2) = Edot;  
+            EdotOutput(mm.index+2) = Edot;  
         }  
 
 
 
 #ifdef DEBUG_METABOLICS
-        cout << "muscle_mass = " << mm.getMuscleMass() << endl;
-        cout << "ratio_slow_twitch_fibers = " << mm.get_ratio_slow_twitch_fibers() << endl;
-        cout << "activation_constant_slow_twitch = " << mm.get_activation_constant_slow_twitch() << endl;
-        cout << "activation_constant_fast_twitch = " << mm.get_activation_constant_fast_twitch() << endl;
-        cout << "maintenance_constant_slow_twitch = " << mm.get_maintenance_constant_slow_twitch() << endl;
-        cout << "maintenance_constant_fast_twitch = " << mm.get_maintenance_constant_fast_twitch() << endl;
+        cout << "muscle_mass = " << muscleMass << endl;
+        cout << "ratio_slow_twitch_fibers = " << params.get_ratio_slow_twitch_fibers() << endl;
+        cout << "activation_constant_slow_twitch = " << params.get_activation_constant_slow_twitch() << endl;
+        cout << "activation_constant_fast_twitch = " << params.get_activation_constant_fast_twitch() << endl;
+        cout << "maintenance_constant_slow_twitch = " << params.get_maintenance_constant_slow_twitch() << endl;
+        cout << "maintenance_constant_fast_twitch = " << params.get_maintenance_constant_fast_twitch() << endl;
         cout << "bodymass = " << _model->getMatterSubsystem().calcSystemMass(s) << endl;
         cout << "max_isometric_force = " << max_isometric_force << endl;
         cout << "activation = " << activation << endl;
@@ -617,6 +660,7 @@ void Bhargava2004MuscleMetabolicsProbe::
     }
     upd_Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet()
         .remove(k);
+    cacheMetabolicMuscles();
 }
 
 
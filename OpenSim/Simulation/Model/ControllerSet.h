@@ -75,6 +75,9 @@ public:
     void storeControls( const SimTK::State& s, int step );
     void printControlStorage( const std::string& fileName) const;
     TimeSeriesTable getControlTable() const;
+    /** The Storage into which storeControls() writes, or nullptr if it has
+    not been constructed (see constructStorage()). */
+    Storage* updControlStorage() { return _controlStore.get(); }
     void setActuators(Set<Actuator>& actuators);
 
     void setDesiredStates( Storage* yStore); 
@@ -805,6 +805,9 @@ void GeometryPath::computePath(const SimTK::State& s) const
         return;
     }
 
+    ComponentProfiler::Scope scope(getProfiler(), *this,
+                                   ComponentProfiler::ComputePath);
+
     // Clear the current path.
     Array<AbstractPathPoint*>& currentPath = 
         updCacheVariableValue<Array<AbstractPathPoint*> >(s, "current_path");
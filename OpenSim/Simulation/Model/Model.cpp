@@ -403,6 +403,23 @@ SimTK::State& Model::initializeState() {
     getMultibodySystem().invalidateSystemTopologyCache();
     getMultibodySystem().realizeTopology();
 
+    return initializeWorkingState();
+}
+
+SimTK::State& Model::updateSystem()
+{
+    // Rebuild the System if it does not exist yet or if any of the edits
+    // cannot be applied to it in place.
+    if (!isValidSystem() || !updateSystemFromProperties())
+        return initSystem();
+
+    // The topology of the System is unchanged; only the State needs to be
+    // initialized again, from the Model stage.
+    return initializeWorkingState();
+}
+
+SimTK::State& Model::initializeWorkingState()
+{
     // Set the model's operating state (internal member variable) to the 
     // default state that is stored inside the System.
     _workingState = getMultibodySystem().getDefaultState();
@@ -783,6 +800,10 @@ void Model::extendConnectToModel(Model &model)
         return;
     }
 
+    // Record the computations of all components (including those added since
+    // profiling was enabled) with the profiler of this model, if any.
+    setProfiler(getProfiler());
+
     // Create the Multibody tree according to the components that
     // form this model.
     createMultibodyTree();
@@ -1142,7 +1163,7 @@ void Model::generateDecorations
     }
 }
 
-void Model::equilibrateMuscles(SimTK::State& state)
+void Model::equilibrateMuscles(SimTK::State& state, bool warmStart)
 {
     getMultibodySystem().realize(state, Stage::Velocity);
 
@@ -1154,7 +1175,10 @@ void Model::equilibrateMuscles(SimTK::State& state)
     for (auto& muscle : muscles) {
         if (muscle.appliesForce(state)){
             try{
-                muscle.computeEquilibrium(state);
+                if(warmStart)
+                    muscle.computeWarmStartedEquilibrium(state);
+                else
+                    muscle.computeEquilibrium(state);
             }
             catch (const std::exception& e) {
                 if(!failed){ // haven't failed to equilibrate other muscles yet
@@ -1464,6 +1488,9 @@ bool Model::scale(SimTK::State& s, const ScaleSet& scaleSet,
 
     // Call preScale() on each ModelComponent owned by the model to store
     // GeometryPath lengths (and perform any other necessary computations).
+    // The pose is realized once here, so each GeometryPath only computes its
+    // own path from the positions that are already available.
+    getMultibodySystem().realize(s, SimTK::Stage::Position);
     for (ModelComponent& comp : updComponentList<ModelComponent>())
         comp.preScale(s, scaleSet);
 
@@ -1479,45 +1506,51 @@ bool Model::scale(SimTK::State& s, const ScaleSet& scaleSet,
     for (Body& body : updComponentList<Body>())
         body.scaleInertialProperties(scaleSet, !preserveMassDist);
 
-    // When bodies are scaled, the properties of the model are changed. The
-    // general rule is that you MUST recreate and initialize the system when
-    // properties of the model change. We must do that here or we will be
-    // querying a stale system (e.g., wrong body properties!).
-    s = initSystem();
-
     // Now that the masses of the individual bodies have been scaled (if
     // preserveMassDist == false), get the total mass and compare it to
     // finalMass in order to determine how much to scale the body masses again,
-    // so that the total model mass comes out to finalMass.
+    // so that the total model mass comes out to finalMass. The total mass is
+    // the sum of the masses of the bodies, so it is computed from their
+    // properties rather than from a System built only for that purpose.
+    double mass = 0.0;
     if (finalMass > 0.0)
     {
-        const double mass = getTotalMass(s);
+        for (const Body& body : getComponentList<Body>())
+            mass += body.getMass();
         if (mass > 0.0)
         {
             const double factor = finalMass / mass;
             for (Body& body : updComponentList<Body>())
                 body.scaleMass(factor);
+        }
+    }
 
-            // Recreate the system and update the state after updating masses.
-            s = initSystem();
+    // When bodies are scaled, the properties of the model are changed. The
+    // general rule is that you MUST recreate and initialize the system when
+    // properties of the model change. We must do that here or we will be
+    // querying a stale system (e.g., wrong body properties!).
+    s = initSystem();
 
-            // Ensure the final model mass is correct.
-            const double newMass = getTotalMass(s);
-            const double normDiffMass = abs(finalMass - newMass) / finalMass;
-            if (normDiffMass > SimTK::SignificantReal) {
-                throw Exception("Model::scale() scaled model mass does not match specified subject mass.");
-            }
+    // Ensure the final model mass is correct.
+    if (finalMass > 0.0 && mass > 0.0)
+    {
+        const double newMass = getTotalMass(s);
+        const double normDiffMass = abs(finalMass - newMass) / finalMass;
+        if (normDiffMass > SimTK::SignificantReal) {
+            throw Exception("Model::scale() scaled model mass does not match specified subject mass.");
         }
     }
 
     // Call postScale() on all ModelComponents owned by the model so that
     // components like muscles, ligaments, and path springs can update their
-    // properties based on their new path length.
+    // properties based on their new path length, all in the same pose.
+    getMultibodySystem().realize(s, SimTK::Stage::Position);
     for (ModelComponent& comp : updComponentList<ModelComponent>())
         comp.postScale(s, scaleSet);
 
-    // Changed the model after scaling path actuators. Have to recreate system!
-    s = initSystem();
+    // Changed the model after scaling path actuators. Have to update the
+    // system! Properties that do not affect its topology are applied in place.
+    s = updateSystem();
 
     // Put the model back in its original pose.
     s.updY() = savedConfiguration;
@@ -1917,6 +1950,14 @@ void Model::setAllControllersEnabled( bool enabled ) {
     _allControllersEnabled = enabled;
 }
 
+void Model::setProfilingEnabled(bool enabled) {
+    if (enabled && !_modelProfiler)
+        _modelProfiler.reset(new ComponentProfiler());
+    // If the subcomponents are not finalized yet, they start recording when
+    // the model is connected (see extendConnectToModel()).
+    setProfiler(enabled ? _modelProfiler.get() : nullptr);
+}
+
 void Model::formStateStorage(const Storage& originalStorage,
                              Storage& statesStorage,
                              bool warnUnspecifiedStates) const
@@ -353,6 +353,26 @@ public:
     }
     /**@}**/
 
+    /** @name                 Profiling
+    To find out which components make a simulation slow, enable profiling
+    before running it. The time spent in each component's realize(),
+    computeForce(), computeStateVariableDerivatives(), Output and
+    GeometryPath computations is then recorded by a ComponentProfiler,
+    available from getProfiler(). **/
+    /**@{**/
+
+    /** Start or stop recording the computations of the components of this
+    %Model. Disabling profiling stops the recording but keeps the profile, and
+    enabling it again continues the same profile; call
+    getProfiler()->clear() to start over. Components added to the %Model
+    afterwards are recorded once the %Model is connected again (e.g., by
+    initSystem()). A copy of this %Model is not profiled. The default is no
+    profiling, in which case the cost of the instrumentation is negligible. **/
+    void setProfilingEnabled(bool enabled);
+    /** Return whether the computations of this %Model are being recorded. **/
+    bool getProfilingEnabled() const { return getProfiler() != nullptr; }
+    /**@}**/
+
     /** After the %Model and its components have been constructed, call this to
     interconnect the components and then create the Simbody
     MultibodySystem needed to represent the %Model computationally. The
@@ -387,6 +407,17 @@ public:
         return initializeState();
     }
 
+    /** Apply edits to the properties of the %Model's components, made since
+    the System was built, to the existing System and return the reinitialized
+    working State, without rebuilding the System. This is much faster than
+    initSystem() when, for example, calibrating parameters such as
+    Station::location or WrapCylinder::radius in a loop. Edits that the
+    components cannot apply in place (see
+    Component::updateSystemFromProperties()), including the addition or
+    removal of components, cause this method to fall back on initSystem().
+    As with initSystem(), States obtained previously are no longer valid. **/
+    SimTK::State& updateSystem() SWIG_DECLARE_EXCEPTION;
+
 
     /** Convenience method that returns a reference to the model's 'working'
     state. This is just returning the reference that was returned by 
@@ -445,8 +476,15 @@ public:
 
     /**
      * Update the state of all Muscles so they are in equilibrium.
+     *
+     * If warmStart is true, each muscle starts its equilibrium solve from the
+     * solution of the previous call stored in the state (see
+     * Muscle::computeWarmStartedEquilibrium()). This is much cheaper when the
+     * state changes little between calls, as when replaying consecutive frames
+     * of a motion. The number of iterations each muscle needed is available
+     * from Muscle::getNumEquilibriumIterations().
      */
-    void equilibrateMuscles(SimTK::State& state);
+    void equilibrateMuscles(SimTK::State& state, bool warmStart = false);
 
     //--------------------------------------------------------------------------
     /**@name       Access to the Simbody System and components
@@ -1093,6 +1131,10 @@ private:
 
     void createAssemblySolver(const SimTK::State& s);
 
+    // Initialize the working state from the default state of the System,
+    // whose topology must have been realized, and assemble it.
+    SimTK::State& initializeWorkingState();
+
     // To provide access to private _modelComponents member.
     friend class Component; 
 
@@ -1196,6 +1238,11 @@ private:
     // copied.
     SimTK::ResetOnCopy<std::unique_ptr<ModelVisualizer>> _modelViz;
 
+    //                          PROFILING
+    // Created the first time profiling is enabled, and kept when it is
+    // disabled so that subcomponents never refer to a deleted profiler.
+    SimTK::ResetOnCopy<std::unique_ptr<ComponentProfiler>> _modelProfiler;
+
 //==============================================================================
 };  // END of class Model
 //==============================================================================
@@ -246,41 +246,48 @@ SimTK::Vec3 MovingPathPoint::getLocation(const SimTK::State& s) const
 
 SimTK::Vec3 MovingPathPoint::getVelocity(const SimTK::State& s) const
 {
-    std::vector<int> derivComponents;
-    derivComponents.push_back(0);
+    SimTK::Vec3 pInF, dPdq;
+    calcLocationAndPartials(s, pInF, dPdq);
 
+    //Multiply the partial (derivative of point coordinate w.r.t. gencoord) by genspeed
     SimTK::Vec3 vInF(0);
-
-    if (!_xCoordinate.empty()){
-        //Multiply the partial (derivative of point coordinate w.r.t. gencoord) by genspeed
-        vInF[0] = get_x_location().calcDerivative(
-            derivComponents, SimTK::Vector(1, _xCoordinate->getValue(s)))*
-                _xCoordinate->getSpeedValue(s);
-    }
-    else
-        vInF[0] = 0.0;
-
-    if (!_yCoordinate.empty()){
-        //Multiply the partial (derivative of point coordinate w.r.t. gencoord) by genspeed
-        vInF[1] = get_y_location().calcDerivative(
-            derivComponents, SimTK::Vector(1, _yCoordinate->getValue(s)))*
-                _yCoordinate->getSpeedValue(s);
-    }
-    else
-        vInF[1] = 0.0;
-
-    if (!_zCoordinate.empty()){
-        //Multiply the partial (derivative of point coordinate w.r.t. gencoord) by genspeed
-        vInF[2] = get_z_location().calcDerivative(
-            derivComponents, SimTK::Vector(1, _zCoordinate->getValue(s)))*
-                _zCoordinate->getSpeedValue(s);
-    }
-    else
-        vInF[2] = 0.0;
+    if (!_xCoordinate.empty())
+        vInF[0] = dPdq[0]*_xCoordinate->getSpeedValue(s);
+    if (!_yCoordinate.empty())
+        vInF[1] = dPdq[1]*_yCoordinate->getSpeedValue(s);
+    if (!_zCoordinate.empty())
+        vInF[2] = dPdq[2]*_zCoordinate->getSpeedValue(s);
 
     return vInF;
 }
 
+void MovingPathPoint::calcLocationAndPartials(const SimTK::State& s,
+        SimTK::Vec3& pInF, SimTK::Vec3& dPdq) const
+{
+    // The location is evaluated with the coordinate clamped to its range,
+    // but the partial is evaluated at the coordinate's value.
+    auto calcComponent = [&s](const Function& f,
+            const SimTK::ReferencePtr<const Coordinate>& coord,
+            double& p, double& dpdq) {
+        if (coord.empty()) { // assume a Constant
+            p = f.calcValue(SimTK::Vector(1, 0.0));
+            dpdq = 0.0;
+            return;
+        }
+        const double q = coord->getValue(s);
+        const double qClamped = SimTK::clamp(coord->getRangeMin(), q,
+                                             coord->getRangeMax());
+        double d2pdq2;
+        f.calcValueAndDerivatives(q, p, dpdq, d2pdq2);
+        if (qClamped != q)
+            p = f.calcValue(SimTK::Vector(1, qClamped));
+    };
+
+    calcComponent(get_x_location(), _xCoordinate, pInF[0], dPdq[0]);
+    calcComponent(get_y_location(), _yCoordinate, pInF[1], dPdq[1]);
+    calcComponent(get_z_location(), _zCoordinate, pInF[2], dPdq[2]);
+}
+
 //_____________________________________________________________________________
 /*
  * Get the velocity of the point in the body's local reference frame.
@@ -373,10 +380,19 @@ SimTK::Vec3 MovingPathPoint::calcVelocityInGround(const SimTK::State& s) const
     // compute the local position vector, r, of the moving point in its
     // parent reference frame, F, expressed in Ground, G.
     const auto& R_GF = getParentFrame().getTransformInGround(s).R();
-    const Vec3 r = R_GF*getLocation(s);
-    
+    Vec3 pInF, dPdq;
+    calcLocationAndPartials(s, pInF, dPdq);
+    const Vec3 r = R_GF*pInF;
+
     // express the local velocity of the moving point in Ground
-    const Vec3 v = R_GF*getVelocity(s);
+    Vec3 vInF(0);
+    if (!_xCoordinate.empty())
+        vInF[0] = dPdq[0]*_xCoordinate->getSpeedValue(s);
+    if (!_yCoordinate.empty())
+        vInF[1] = dPdq[1]*_yCoordinate->getSpeedValue(s);
+    if (!_zCoordinate.empty())
+        vInF[2] = dPdq[2]*_zCoordinate->getSpeedValue(s);
+    const Vec3 v = R_GF*vInF;
 
     // get the velocity of the parent frame, F,  in Ground, G.
     const SimTK::SpatialVec& V_GF = getParentFrame().getVelocityInGround(s);
@@ -119,6 +119,14 @@ private:
     SimTK::Vec3 calcVelocityInGround(const SimTK::State& state) const override;
     SimTK::Vec3 calcAccelerationInGround(const SimTK::State& state) const override;
 
+    // Compute the location of the point in its Frame, as in getLocation(),
+    // and the derivative of each of its components with respect to the
+    // corresponding coordinate, as in getdPointdQ(). Each location function
+    // is evaluated once (with Function::calcValueAndDerivatives()) unless its
+    // coordinate is outside of its range.
+    void calcLocationAndPartials(const SimTK::State& s,
+            SimTK::Vec3& pInF, SimTK::Vec3& dPdq) const;
+
 private:
     SimTK::ReferencePtr<const Coordinate> _xCoordinate;
     SimTK::ReferencePtr<const Coordinate> _yCoordinate;
@@ -233,8 +233,49 @@ void Muscle::extendConnectToModel(Model& aModel)
        ("dynamicsInfo", MuscleDynamicsInfo(), SimTK::Stage::Dynamics);
     addCacheVariable<Muscle::MusclePotentialEnergyInfo>
        ("potentialEnergyInfo", MusclePotentialEnergyInfo(), SimTK::Stage::Velocity);
+
+    // Bookkeeping for warm-starting the equilibrium solve. Nothing is computed
+    // from these values, so changing them only invalidates the Report stage.
+    addDiscreteVariable("equilibrium_fiber_length", SimTK::Stage::Report);
+    addDiscreteVariable("equilibrium_fiber_velocity", SimTK::Stage::Report);
+    addDiscreteVariable("equilibrium_iterations", SimTK::Stage::Report);
  }
 
+//_____________________________________________________________________________
+/*
+ * Bookkeeping for warm-started equilibrium solves.
+ */
+int Muscle::getNumEquilibriumIterations(const SimTK::State& s) const
+{
+    const double iterations =
+        getDiscreteVariableValue(s, "equilibrium_iterations");
+    return SimTK::isNaN(iterations) ? -1 : int(iterations);
+}
+
+void Muscle::clearPreviousEquilibriumSolution(SimTK::State& s) const
+{
+    setDiscreteVariableValue(s, "equilibrium_fiber_length", SimTK::NaN);
+    setDiscreteVariableValue(s, "equilibrium_fiber_velocity", SimTK::NaN);
+    setDiscreteVariableValue(s, "equilibrium_iterations", SimTK::NaN);
+}
+
+void Muscle::setEquilibriumSolution(SimTK::State& s, double fiberLength,
+        double fiberVelocity, int iterations) const
+{
+    setDiscreteVariableValue(s, "equilibrium_fiber_length", fiberLength);
+    setDiscreteVariableValue(s, "equilibrium_fiber_velocity", fiberVelocity);
+    setDiscreteVariableValue(s, "equilibrium_iterations", double(iterations));
+}
+
+bool Muscle::getPreviousEquilibriumSolution(const SimTK::State& s,
+        double& fiberLength, double& fiberVelocity) const
+{
+    fiberLength = getDiscreteVariableValue(s, "equilibrium_fiber_length");
+    fiberVelocity = getDiscreteVariableValue(s, "equilibrium_fiber_velocity");
+    return SimTK::isFinite(fiberLength) && SimTK::isFinite(fiberVelocity)
+        && fiberLength > 0;
+}
+
 void Muscle::extendSetPropertiesFromState(const SimTK::State& state)
 {
     Super::extendSetPropertiesFromState(state);
@@ -250,6 +291,8 @@ void  Muscle::extendInitStateFromProperties(SimTK::State& state) const {
         get_ignore_tendon_compliance());
     setIgnoreActivationDynamics(state, 
         get_ignore_activation_dynamics());
+
+    clearPreviousEquilibriumSolution(state);
 }
 
 // Get/set runtime flag to ignore tendon compliance when computing muscle 
@@ -339,6 +339,26 @@ public:
     void computeEquilibrium(SimTK::State& s) const override final {
         return computeInitialFiberEquilibrium(s);
     }
+
+    /** Find and set the equilibrium state of the muscle, starting the solver
+        from the fiber length and velocity of the last equilibrium solution
+        stored in the state (e.g., that of the previous frame when replaying
+        a motion). If the state holds no previous solution, or the
+        warm-started solve fails, the muscle falls back to the same solve as
+        computeEquilibrium(). Muscles without an iterative equilibrium solve
+        simply call computeEquilibrium(). */
+    void computeWarmStartedEquilibrium(SimTK::State& s) const {
+        return computeWarmStartedFiberEquilibrium(s);
+    }
+
+    /** Number of solver iterations taken by the most recent equilibrium solve
+        applied to the state s (including any fallback solve), or -1 if no
+        iterative equilibrium solve has been performed. */
+    int getNumEquilibriumIterations(const SimTK::State& s) const;
+
+    /** Forget the previous equilibrium solution stored in the state so that
+        the next call to computeWarmStartedEquilibrium() starts cold. */
+    void clearPreviousEquilibriumSolution(SimTK::State& s) const;
     // End of Muscle's State Dependent Accessors.
     //@} 
 
@@ -411,6 +431,24 @@ protected:
     computeFiberEquilibriumAtZeroVelocity(). */
     virtual void computeInitialFiberEquilibrium(SimTK::State& s) const = 0;
 
+    /** Same as computeInitialFiberEquilibrium(), but the solver may start from
+        the previous solution returned by getPreviousEquilibriumSolution().
+        The default implementation ignores the previous solution and calls
+        computeInitialFiberEquilibrium(). */
+    virtual void computeWarmStartedFiberEquilibrium(SimTK::State& s) const {
+        computeInitialFiberEquilibrium(s);
+    }
+
+    /** Record the solution of an equilibrium solve in the state so that a
+        subsequent warm-started solve can start from it. */
+    void setEquilibriumSolution(SimTK::State& s, double fiberLength,
+                                double fiberVelocity, int iterations) const;
+
+    /** Retrieve the fiber length and velocity of the last equilibrium solution
+        stored in the state. Returns false if there is none. */
+    bool getPreviousEquilibriumSolution(const SimTK::State& s,
+            double& fiberLength, double& fiberVelocity) const;
+
     // End of Muscle's State Related Calculations.
     //@} 
 
@@ -110,6 +110,11 @@ SimTK::Vec3 Station::findLocationInFrame(const SimTK::State& s,
                                                 get_location(), aFrame);
 }
 
+bool Station::canUpdateSystemForProperty(const std::string& name) const
+{
+    return name == "location" || Super::canUpdateSystemForProperty(name);
+}
+
 void Station::extendScale(const SimTK::State& s, const ScaleSet& scaleSet)
 {
     Super::extendScale(s, scaleSet);
@@ -78,6 +78,11 @@ public:
 
     void extendScale(const SimTK::State& s, const ScaleSet& scaleSet) override;
 
+protected:
+    /** The location is only used to compute the Station's kinematics, so it
+    can be changed without rebuilding the System. */
+    bool canUpdateSystemForProperty(const std::string& name) const override;
+
 private:
     /* Calculate the Station's location with respect to and expressed in Ground
     */
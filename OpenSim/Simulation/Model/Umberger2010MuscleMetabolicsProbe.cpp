@@ -122,6 +122,7 @@ void Umberger2010MuscleMetabolicsProbe::constructProperties()
 void Umberger2010MuscleMetabolicsProbe::extendConnectToModel(Model& aModel)
 {
     Super::extendConnectToModel(aModel);
+    _metabolicMuscles.clear();
     if (!isEnabled()) return;   // Nothing to connect
 
     const int nM = 
@@ -130,6 +131,36 @@ void Umberger2010MuscleMetabolicsProbe::extendConnectToModel(Model& aModel)
         connectIndividualMetabolicMuscle(aModel, 
             upd_Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet()[i]);
     }
+    cacheMetabolicMuscles();
+}
+
+
+//_____________________________________________________________________________
+/**
+ * Store the connected muscles and their parameter objects for
+ * computeProbeInputs(), which reads the parameters themselves when it is
+ * called. This must be called again whenever the MetabolicMuscleParameterSet
+ * changes.
+ */
+void Umberger2010MuscleMetabolicsProbe::cacheMetabolicMuscles()
+{
+    _metabolicMuscles.clear();
+    if (!isEnabled()) return;
+
+    const int nM = 
+        get_Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet().getSize();
+    _metabolicMuscles.reserve(nM);
+    for (int i=0; i<nM; ++i) {
+        const Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameter& mm =
+            get_Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet()[i];
+        if (mm.getMuscle()) {
+            MetabolicMuscle muscle;
+            muscle.muscle = mm.getMuscle();
+            muscle.parameters = &mm;
+            muscle.index = i;
+            _metabolicMuscles.push_back(muscle);
+        }
+    }
 }
 
 //_____________________________________________________________________________
@@ -234,8 +265,7 @@ void Umberger2010MuscleMetabolicsProbe::connectIndividualMetabolicMuscle(
 SimTK::Vector Umberger2010MuscleMetabolicsProbe::computeProbeInputs(const State& s) const
 {
     // Initialize metabolic energy rate values.
-    double AMdot, Sdot, Bdot, Wdot;
-    AMdot = Sdot = Bdot = Wdot = 0;
+    double Bdot = 0;
     Vector EdotOutput(getNumProbeInputs());
     EdotOutput = 0;
 
@@ -254,28 +284,35 @@ SimTK::Vector Umberger2010MuscleMetabolicsProbe::computeProbeInputs(const State&
     
     if (!get_report_total_metabolics_only())
         EdotOutput(1) = Bdot;    // BASAL metabolic power storage
-    
 
-    // Loop through each muscle in the MetabolicMuscleParameterSet
-    const int nM = 
-        get_Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet()
-        .getSize();
-    for (int i=0; i<nM; ++i)
+
+    // Read the settings of the probe once for all muscles.
+    const double effortScalingFactor = get_muscle_effort_scaling_factor();
+    const double aerobicFactor = get_aerobic_factor();
+    const bool useBhargavaRecruitment = get_use_Bhargava_recruitment_model();
+    const bool includeNegativeWork = get_include_negative_mechanical_work();
+    const bool forbidNegativePower = get_forbid_negative_total_power();
+    const bool activationMaintenanceOn = get_activation_maintenance_rate_on();
+    const bool shorteningOn = get_shortening_rate_on();
+    const bool mechanicalWorkOn = get_mechanical_work_rate_on();
+    const bool enforceMinimumHeatRate =
+        get_enforce_minimum_heat_rate_per_muscle();
+    const bool reportTotalOnly = get_report_total_metabolics_only();
+
+
+    // Loop through the muscles resolved in extendConnectToModel().
+    for (const MetabolicMuscle& mm : _metabolicMuscles)
     {
-        // Get the current muscle parameters from the MetabolicMuscleParameterSet
-        // and the corresponding OpenSim::Muscle pointer from the muscleMap.
-        Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameter& mm = 
-            get_Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet()[i];
-        const Muscle* m = mm.getMuscle();
+        const Muscle* m = mm.muscle;
+        const double muscleMass = mm.parameters->getMuscleMass();
+        double AMdot = 0, Sdot = 0, Wdot = 0;
 
         // Get some muscle properties at the current time state
         //const double max_isometric_force = m->getMaxIsometricForce();
         const double max_shortening_velocity = m->getMaxContractionVelocity();
-        const double activation = get_muscle_effort_scaling_factor()
-                                  * m->getActivation(s);
-        const double excitation = get_muscle_effort_scaling_factor()
-                                  * m->getControl(s);
-        double fiber_force_active = get_muscle_effort_scaling_factor()
+        const double activation = effortScalingFactor * m->getActivation(s);
+        const double excitation = effortScalingFactor * m->getControl(s);
+        double fiber_force_active = effortScalingFactor
                                     * m->getActiveFiberForce(s);
         const double fiber_length_normalized = m->getNormalizedFiberLength(s);
         const double fiber_velocity = m->getFiberVelocity(s);
@@ -288,11 +325,11 @@ SimTK::Vector Umberger2010MuscleMetabolicsProbe::computeProbeInputs(const State&
 
         // ---------------------------------------------------------------------------
         // NOT USED FOR THIS IMPLEMENTATION
-        //const double slow_twitch_excitation = mm.get_ratio_slow_twitch_fibers() * sin(Pi/2 * excitation);
-        //const double fast_twitch_excitation = (1 - mm.get_ratio_slow_twitch_fibers()) * (1 - cos(Pi/2 * excitation));
+        //const double slow_twitch_excitation = mm.parameters->get_ratio_slow_twitch_fibers() * sin(Pi/2 * excitation);
+        //const double fast_twitch_excitation = (1 - mm.parameters->get_ratio_slow_twitch_fibers()) * (1 - cos(Pi/2 * excitation));
 
         // Set normalized hill constants: A_rel and B_rel
-        //const double A_rel = 0.1 + 0.4*(1 - mm.get_ratio_slow_twitch_fibers());
+        //const double A_rel = 0.1 + 0.4*(1 - mm.parameters->get_ratio_slow_twitch_fibers());
         //const double B_rel = A_rel * max_shortening_velocity;
         // ---------------------------------------------------------------------------
 
@@ -317,23 +354,23 @@ SimTK::Vector Umberger2010MuscleMetabolicsProbe::computeProbeInputs(const State&
         // ACTIVATION & MAINTENANCE HEAT RATE for muscle i (W/kg)
         // --> depends on the normalized fiber length of the contractile element
         // -----------------------------------------------------------------------
-        double slowTwitchRatio = mm.get_ratio_slow_twitch_fibers();
-        if (get_use_Bhargava_recruitment_model()) {
+        double slowTwitchRatio =
+            mm.parameters->get_ratio_slow_twitch_fibers();
+        if (useBhargavaRecruitment) {
             const double uSlow = slowTwitchRatio * sin(0.5*Pi * excitation);
             const double uFast = (1 - slowTwitchRatio)
                                  * (1 - cos(0.5*Pi * excitation));
             slowTwitchRatio = (excitation == 0) ? 1.0 : uSlow / (uSlow + uFast);
         }
 
-        if (get_forbid_negative_total_power() ||
-            get_activation_maintenance_rate_on())
+        if (forbidNegativePower || activationMaintenanceOn)
         {
             const double unscaledAMdot = 128*(1 - slowTwitchRatio) + 25;
 
             if (fiber_length_normalized <= 1.0)
-                AMdot = get_aerobic_factor() * std::pow(A, 0.6) * unscaledAMdot;
+                AMdot = aerobicFactor * std::pow(A, 0.6) * unscaledAMdot;
             else
-                AMdot = get_aerobic_factor() * std::pow(A, 0.6) * ((0.4 * unscaledAMdot) + (0.6 * unscaledAMdot * F_iso));
+                AMdot = aerobicFactor * std::pow(A, 0.6) * ((0.4 * unscaledAMdot) + (0.6 * unscaledAMdot * F_iso));
         }
 
 
@@ -342,7 +379,7 @@ SimTK::Vector Umberger2010MuscleMetabolicsProbe::computeProbeInputs(const State&
         // --> depends on the normalized fiber length of the contractile element
         // --> note that we define Vm<0 as shortening and Vm>0 as lengthening
         // -----------------------------------------------------------------------
-        if (get_forbid_negative_total_power() || get_shortening_rate_on())
+        if (forbidNegativePower || shorteningOn)
         {
             const double Vmax_fasttwitch = max_shortening_velocity;
             const double Vmax_slowtwitch = max_shortening_velocity / 2.5;
@@ -366,15 +403,15 @@ SimTK::Vector Umberger2010MuscleMetabolicsProbe::computeProbeInputs(const State&
 
                 tmp_fastTwitch = alpha_shortening_fasttwitch * fiber_velocity_normalized * (1-slowTwitchRatio);
                 unscaledSdot = (tmp_slowTwitch * slowTwitchRatio) - tmp_fastTwitch;   // unscaled shortening heat rate: muscle shortening
-                Sdot = get_aerobic_factor() * std::pow(A, 2.0) * unscaledSdot;                      // scaled shortening heat rate: muscle shortening
+                Sdot = aerobicFactor * std::pow(A, 2.0) * unscaledSdot;                         // scaled shortening heat rate: muscle shortening
             }
 
             else    // eccentric contraction, Vm>0
             {
                 unscaledSdot =
-                    (get_include_negative_mechanical_work() ? 4.0 : 0.3)
+                    (includeNegativeWork ? 4.0 : 0.3)
                     * alpha_shortening_slowtwitch * fiber_velocity_normalized;  // unscaled shortening heat rate: muscle lengthening
-                Sdot = get_aerobic_factor() * A * unscaledSdot;                                // scaled shortening heat rate: muscle lengthening
+                Sdot = aerobicFactor * A * unscaledSdot;                                   // scaled shortening heat rate: muscle lengthening
             }
 
 
@@ -396,20 +433,20 @@ SimTK::Vector Umberger2010MuscleMetabolicsProbe::computeProbeInputs(const State&
         // MECHANICAL WORK RATE for the contractile element of muscle i (W/kg).
         // --> note that we define Vm<0 as shortening and Vm>0 as lengthening.
         // -------------------------------------------------------------------
-        if (get_forbid_negative_total_power() || get_mechanical_work_rate_on())
+        if (forbidNegativePower || mechanicalWorkOn)
         {
-            if (get_include_negative_mechanical_work() || fiber_velocity <= 0)
+            if (includeNegativeWork || fiber_velocity <= 0)
                 Wdot = -fiber_force_active*fiber_velocity;
             else
                 Wdot = 0;
 
-            Wdot /= mm.getMuscleMass();
+            Wdot /= muscleMass;
         }
 
 
         // If necessary, increase the shortening heat rate so that the total
         // power is non-negative.
-        if (get_forbid_negative_total_power()) {
+        if (forbidNegativePower) {
             const double Edot_Wkg_beforeClamp = AMdot + Sdot + Wdot;
             if (Edot_Wkg_beforeClamp < 0)
                 Sdot -= Edot_Wkg_beforeClamp;
@@ -431,12 +468,12 @@ SimTK::Vector Umberger2010MuscleMetabolicsProbe::computeProbeInputs(const State&
         // -----------------------------------------------------------------------
         double totalHeatRate = AMdot + Sdot;
 
-        if(get_enforce_minimum_heat_rate_per_muscle() && totalHeatRate < 1.0 
-            && get_activation_maintenance_rate_on() 
-            && get_shortening_rate_on()) {
+        if(enforceMinimumHeatRate && totalHeatRate < 1.0 
+            && activationMaintenanceOn 
+            && shorteningOn) {
                 //cout << "WARNING: " << getName() 
                 //    << "  (t = " << s.getTime() 
-                //    << "), the muscle '" << mm.getName() 
+                //    << "), the muscle '" << m->getName() 
                 //    << "' has a net metabolic energy rate of less than 1.0 W/kg." << endl; 
                 totalHeatRate = 1.0;            // not allowed to fall below 1.0 W.kg-1
         }
@@ -447,29 +484,29 @@ SimTK::Vector Umberger2010MuscleMetabolicsProbe::computeProbeInputs(const State&
         // ------------------------------------------
         double Edot = 0;
 
-        if (get_activation_maintenance_rate_on() && get_shortening_rate_on())
+        if (activationMaintenanceOn && shorteningOn)
             Edot += totalHeatRate;      // May have been clamped to 1.0 W/kg.
         else {
-            if (get_activation_maintenance_rate_on())
+            if (activationMaintenanceOn)
                 Edot += AMdot;
-            if (get_shortening_rate_on())
+            if (shorteningOn)
                 Edot += Sdot;
         }
-        if (get_mechanical_work_rate_on())
+        if (mechanicalWorkOn)
             Edot += Wdot;
-        Edot *= mm.getMuscleMass();
+        Edot *= muscleMass;
 
         EdotOutput(0) += Edot;       // Add to TOTAL metabolic power storage
-        if (!get_report_total_metabolics_only()) {
+        if (!reportTotalOnly) {
             // Metabolic power storage for muscle i
-            EdotOutput(i+2) = Edot;  
+            EdotOutput(mm.index+2) = Edot;  
         }                          
 
 
         
 
 #ifdef DEBUG_METABOLICS
-        cout << "muscle_mass = " << mm.getMuscleMass() << endl;
+        cout << "muscle_mass = " << muscleMass << endl;
         cout << "ratio_slow_twitch_fibers = " << slowTwitchRatio << endl;
         cout << "bodymass = " << _model->getMatterSubsystem().calcSystemMass(s) << endl;
         //cout << "max_isometric_force = " << max_isometric_force << endl;
@@ -617,6 +654,7 @@ void Umberger2010MuscleMetabolicsProbe::
     }
     clearConnections();
     upd_Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet().remove(k);
+    cacheMetabolicMuscles();
 }
 
 
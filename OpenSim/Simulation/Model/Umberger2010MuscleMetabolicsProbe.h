@@ -425,10 +425,25 @@ private:
     //--------------------------------------------------------------------------
     MuscleMap _muscleMap;
 
+    // The muscles in the MetabolicMuscleParameterSet, resolved in
+    // extendConnectToModel() so that computeProbeInputs() can iterate over
+    // them without looking up muscles by name. Rebuilt by
+    // cacheMetabolicMuscles() when a muscle is removed. The parameters are
+    // read from each muscle's parameter object when the probe is evaluated,
+    // so they can be edited after connecting.
+    struct MetabolicMuscle {
+        const Muscle* muscle;
+        const Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameter*
+            parameters;
+        int index;                      // Index in the parameter set.
+    };
+    std::vector<MetabolicMuscle> _metabolicMuscles;
+
     //--------------------------------------------------------------------------
     // ModelComponent Interface
     //--------------------------------------------------------------------------
     void extendConnectToModel(Model& aModel) override;
+    void cacheMetabolicMuscles();
     void connectIndividualMetabolicMuscle
        (Model& aModel, 
         Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameter& mm);
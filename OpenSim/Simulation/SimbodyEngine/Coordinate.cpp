@@ -642,6 +642,18 @@ void Coordinate::CoordinateStateVariable::
     throw Exception(msg);
 }
 
+SimTK::SystemYIndex Coordinate::CoordinateStateVariable::
+    calcSystemYIndex(const SimTK::State& state) const
+{
+    const Coordinate& owner = *((Coordinate *)&getOwner());
+    const MobilizedBody& mb = owner.getModel().getMatterSubsystem()
+                                .getMobilizedBody(owner.getBodyIndex());
+
+    return SimTK::SystemYIndex(int(state.getQStart())
+        + int(state.getQStart(getSubsysIndex()))
+        + int(mb.getFirstQIndex(state)) + owner.getMobilizerQIndex());
+}
+
 
 //-----------------------------------------------------------------------------
 // Coordinate::SpeedStateVariable
@@ -678,6 +690,18 @@ void Coordinate::SpeedStateVariable::
     throw Exception(msg);
 }
 
+SimTK::SystemYIndex Coordinate::SpeedStateVariable::
+    calcSystemYIndex(const SimTK::State& state) const
+{
+    const Coordinate& owner = *((Coordinate *)&getOwner());
+    const MobilizedBody& mb = owner.getModel().getMatterSubsystem()
+                                .getMobilizedBody(owner.getBodyIndex());
+
+    return SimTK::SystemYIndex(int(state.getUStart())
+        + int(state.getUStart(getSubsysIndex()))
+        + int(mb.getFirstUIndex(state)) + owner.getMobilizerQIndex());
+}
+
 //=============================================================================
 // XML Deserialization
 //=============================================================================
@@ -29,6 +29,7 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/LinearFunction.h>
+#include <OpenSim/Common/MultiplierFunction.h>
 #include "simbody/internal/MobilizedBody_FunctionBased.h"
 
 
@@ -86,6 +87,7 @@ void CustomJoint::constructProperties()
 {
     setAuthors("Frank C. Anderson, Ajay Seth");
     constructProperty_SpatialTransform(SpatialTransform());
+    constructProperty_use_native_mobilizer(true);
 }
 
 /*
@@ -123,6 +125,134 @@ void CustomJoint::extendConnectToModel(Model& aModel)
     // should be done here.
     /* Set up spatial transform for this custom joint. */
     updSpatialTransform().connectToJoint(*this);
+
+    findNativeMobilizer();
+}
+
+namespace {
+    // Whether the function is a Constant, possibly scaled (e.g., by
+    // SpatialTransform::scale()); if so, its value is returned in `value`.
+    bool isConstantFunction(const OpenSim::Function& f, double& value)
+    {
+        if (const auto* constant = dynamic_cast<const Constant*>(&f)) {
+            value = constant->getValue();
+            return true;
+        }
+        const auto* mf = dynamic_cast<const MultiplierFunction*>(&f);
+        if (mf && mf->getFunction() &&
+                isConstantFunction(*mf->getFunction(), value)) {
+            value *= mf->getScale();
+            return true;
+        }
+        return false;
+    }
+}
+
+void CustomJoint::findNativeMobilizer()
+{
+    _mobilizerType = "FunctionBased";
+    _nativeParentOffset = Transform();
+    _nativeChildOffset = Transform();
+    if (!get_use_native_mobilizer())
+        return;
+
+    const SpatialTransform& spatialTransform = getSpatialTransform();
+    const std::vector<std::vector<int> > coordinateIndices =
+        spatialTransform.getCoordinateIndices();
+    const double tol = 1e-10;
+
+    // Each coordinate must move the child about or along one axis, in the
+    // order of the coordinates. A slope of -1 is the same as a slope of 1
+    // about or along the opposite axis.
+    std::vector<Vec3> rotations, translations;
+    Vec3 fixedTranslation(0);
+    for (int i = 0; i < 6; ++i) {
+        const TransformAxis& transformAxis = spatialTransform[i];
+        if (!transformAxis.hasFunction())
+            return;
+        const OpenSim::Function& f = transformAxis.getFunction();
+        const Vec3& axis = transformAxis.getAxis();
+        // Translation axes must have unit length for a native mobilizer's
+        // translations to match.
+        if (i >= 3 && std::abs(axis.norm() - 1) > tol)
+            return;
+        double value = 0;
+        if (const auto* lf = dynamic_cast<const LinearFunction*>(&f)) {
+            const int nextCoord = int(rotations.size() + translations.size());
+            if (coordinateIndices[i].size() != 1 ||
+                    coordinateIndices[i][0] != nextCoord ||
+                    lf->getIntercept() != 0 || std::abs(lf->getSlope()) != 1)
+                return;
+            (i < 3 ? rotations : translations).push_back(lf->getSlope()*axis);
+        } else if (isConstantFunction(f, value)) {
+            // A fixed rotation would have to be composed with the others.
+            if (i < 3 && value != 0)
+                return;
+            if (i >= 3)
+                fixedTranslation += value*axis;
+        } else {
+            return;
+        }
+    }
+    if (int(rotations.size() + translations.size()) != numCoordinates())
+        return;
+
+    // The orientation of the native mobilizer's F and M frames such that its
+    // rotations are about (or its translations along) the axes above.
+    Rotation R;
+    std::string type;
+    if (rotations.size() == 1 && translations.empty()) {
+        R = Rotation(UnitVec3(rotations[0]), ZAxis);
+        type = "Pin";
+    } else if (rotations.empty() && translations.size() == 1) {
+        R = Rotation(UnitVec3(translations[0]), XAxis);
+        type = "Slider";
+    } else if (rotations.size() >= 2) {
+        const UnitVec3 x(rotations[0]);
+        const UnitVec3 y(rotations[1]);
+        if (std::abs(~x.asVec3()*y.asVec3()) > tol)
+            return;
+        R = Rotation(x, XAxis, y.asVec3(), YAxis);
+        if (rotations.size() == 2 && translations.empty()) {
+            type = "Universal";
+        } else if (rotations.size() == 3) {
+            const Vec3 z = UnitVec3(rotations[2]).asVec3();
+            if ((R.asMat33().col(2) - z).norm() > tol)
+                return;
+            if (translations.empty()) {
+                type = "Gimbal";
+            } else if (translations.size() == 3) {
+                for (int i = 0; i < 3; ++i) {
+                    if ((translations[i] - R.asMat33().col(i)).norm() > tol)
+                        return;
+                }
+                type = "Bushing";
+            }
+        }
+    }
+    if (type.empty())
+        return;
+
+    _mobilizerType = type;
+    _nativeParentOffset = Transform(R, fixedTranslation);
+    _nativeChildOffset = Transform(R);
+}
+
+void CustomJoint::printMobilizerReport(const Model& model, std::ostream& out)
+{
+    int numJoints = 0;
+    int numNative = 0;
+    out << "Mobilizers of the CustomJoints in model '" << model.getName()
+        << "':" << endl;
+    for (const auto& joint : model.getComponentList<CustomJoint>()) {
+        ++numJoints;
+        if (joint.getMobilizerType() != "FunctionBased")
+            ++numNative;
+        out << "  " << joint.getName() << ": " << joint.getMobilizerType()
+            << endl;
+    }
+    out << numNative << " of " << numJoints
+        << " CustomJoints use a native Simbody mobilizer." << endl;
 }
 
 void CustomJoint::extendScale(const SimTK::State& s, const ScaleSet& scaleSet)
@@ -228,6 +358,36 @@ void CustomJoint::extendAddToSystem(SimTK::MultibodySystem& system) const
         outb = getChildInternalRigidBody();
     }
 
+    SimTK::MobilizedBody::Direction dir =
+        SimTK::MobilizedBody::Direction(isReversed);
+
+    if (_mobilizerType != "FunctionBased") {
+        // The offsets belong to the parent and child frames, which are the
+        // outboard and inboard frames if the joint is reversed.
+        const Transform inbOffset =
+            isReversed ? _nativeChildOffset : _nativeParentOffset;
+        const Transform outbOffset =
+            isReversed ? _nativeParentOffset : _nativeChildOffset;
+        inbX = inbX*inbOffset;
+        outbX = outbX*outbOffset;
+
+        SimTK::MobilizedBody simtkBody;
+        if (_mobilizerType == "Pin")
+            simtkBody = MobilizedBody::Pin(inb, inbX, outb, outbX, dir);
+        else if (_mobilizerType == "Slider")
+            simtkBody = MobilizedBody::Slider(inb, inbX, outb, outbX, dir);
+        else if (_mobilizerType == "Universal")
+            simtkBody = MobilizedBody::Universal(inb, inbX, outb, outbX, dir);
+        else if (_mobilizerType == "Gimbal")
+            simtkBody = MobilizedBody::Gimbal(inb, inbX, outb, outbX, dir);
+        else
+            simtkBody = MobilizedBody::Bushing(inb, inbX, outb, outbX, dir);
+
+        assignSystemIndicesToBodyAndCoordinates(simtkBody, mobilized,
+                                                numCoordinates(), 0);
+        return;
+    }
+
     const Array<std::string>& coordNames = getSpatialTransform().getCoordinateNames();
 
     // Some initializations
@@ -261,9 +421,6 @@ void CustomJoint::extendAddToSystem(SimTK::MultibodySystem& system) const
         "%s::%s must specify 6 independent axes to span spatial motion.",
         getConcreteClassName().c_str(), getSpatialTransform().getConcreteClassName().c_str());
 
-    SimTK::MobilizedBody::Direction dir =
-        SimTK::MobilizedBody::Direction(isReversed);
-
     SimTK::MobilizedBody::FunctionBased
         simtkBody(inb, inbX, 
                   outb, outbX, 
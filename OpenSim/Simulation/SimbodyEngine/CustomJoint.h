@@ -47,6 +47,28 @@ first followed by translations. Subsequently, coupled motion (i.e., describing
 motion of two degrees of freedom as a function of one coordinate) is handled by
 transform axis functions that depend on the same coordinate(s).
 
+Many custom joints are conventional joints in disguise: each coordinate moves
+the child along or about a single axis (its transform axis function is a
+LinearFunction with a slope of 1 or -1 and an intercept of 0), and the
+remaining axes are held fixed (Constant functions). When the property
+use_native_mobilizer is true (the default), such joints are implemented with
+the equivalent native Simbody mobilizer rather than a FunctionBased one, which
+avoids evaluating the transform axis functions during a simulation. The
+coordinates (their order, values and speeds) are the same either way. The
+following joints are recognized:
+
+- one rotation: SimTK::MobilizedBody::Pin
+- one translation: SimTK::MobilizedBody::Slider
+- two perpendicular rotations: SimTK::MobilizedBody::Universal
+- three orthogonal, right-handed rotations: SimTK::MobilizedBody::Gimbal
+- three orthogonal, right-handed rotations and translations along the same
+  axes: SimTK::MobilizedBody::Bushing (unlike MobilizedBody::Free, its speeds
+  are the derivatives of its coordinates)
+
+Fixed rotations must be zero; fixed translations are allowed. Use
+getMobilizerType() or printMobilizerReport() to find out which joints were
+specialized.
+
 @author Ajay Seth, Frank C. Anderson
 */
 class OSIMSIMULATION_API CustomJoint : public Joint {
@@ -64,6 +86,11 @@ public:
         "Defines how the child body moves with respect to the parent as "
         "a function of the generalized coordinates.");
 
+    OpenSim_DECLARE_PROPERTY(use_native_mobilizer, bool,
+        "Flag (true or false) indicating whether to implement the joint with "
+        "an equivalent native Simbody mobilizer (e.g., Pin or Gimbal) when "
+        "its SpatialTransform allows it.");
+
 //==============================================================================
 // PUBLIC METHODS
 //==============================================================================
@@ -128,6 +155,19 @@ public:
         return upd_coordinates(idx);
     }
 
+    /** The type of SimTK::MobilizedBody that implements this joint:
+    "FunctionBased", or the name of the equivalent native mobilizer (e.g.,
+    "Pin"; see the class description). This is determined when the joint is
+    connected to its model (e.g., by Model::initSystem()). */
+    const std::string& getMobilizerType() const { return _mobilizerType; }
+
+    /** Print the type of mobilizer used for each CustomJoint in the model
+    (see getMobilizerType()), and how many of them use a native Simbody
+    mobilizer. The model must have been connected (e.g., by
+    Model::initSystem()). */
+    static void printMobilizerReport(const Model& model,
+                                     std::ostream& out = std::cout);
+
     // SCALE
     void extendScale(const SimTK::State& s, const ScaleSet& scaleSet) override;
 
@@ -146,6 +186,18 @@ private:
     // Construct coordinates according to the SpatialTransform of the CustomJoint
     void constructCoordinates();
 
+    // Determine whether the SpatialTransform is equivalent to a native
+    // Simbody mobilizer, and if so, the offsets of the native mobilizer's
+    // frames from the parent and child frames.
+    void findNativeMobilizer();
+
+    // See getMobilizerType().
+    std::string _mobilizerType{"FunctionBased"};
+    // The native mobilizer's F frame, in the parent frame, and its M frame,
+    // in the child frame.
+    SimTK::Transform _nativeParentOffset;
+    SimTK::Transform _nativeChildOffset;
+
     template <typename T>
     T createMobilizedBody(SimTK::MobilizedBody& inboard,
         const SimTK::Transform& inboardTransform,
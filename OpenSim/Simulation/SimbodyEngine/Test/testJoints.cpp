@@ -38,6 +38,7 @@
 //      8. FreeJoint against Simbody built-in Free mobilizer
 //      9. BallJoint against Simbody built-in Ball mobilizer
 //     10. Equivalent Spatial body force due to applied gen force.
+//     11. CustomJoints with native Simbody mobilizers versus FunctionBased
 //      
 //     Add tests here as new joint types are added to OpenSim
 //
@@ -165,6 +166,7 @@ void testGimbalJointAccessors();
 void testUniversalJointAccessors();
 void testMotionTypesForCustomJointCoordinates();
 void testNonzeroInterceptCustomJointVsPin();
+void testCustomJointNativeMobilizers();
 
 // Multibody tree constructions tests
 void testAddedFreeJointForBodyWithoutJoint();
@@ -302,6 +304,14 @@ int main()
         failures.push_back("testNonzeroInterceptCustomJointVsPin");
     }
 
+    // CustomJoints that are equivalent to native Simbody mobilizers must
+    // behave the same whether or not they use the native mobilizer.
+    try { ++itc; testCustomJointNativeMobilizers(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testCustomJointNativeMobilizers");
+    }
+
     // Test accessors.
     try { ++itc; testCustomJointAccessors(); }
     catch (const std::exception& e) {
@@ -2704,3 +2714,186 @@ void testNonzeroInterceptCustomJointVsPin()
         "of the coordinate value.");
 
 }
+
+void testCustomJointNativeMobilizers()
+{
+    using namespace SimTK;
+
+    cout << endl;
+    cout << "===========================================================" << endl;
+    cout << " CustomJoints with native mobilizers vs. FunctionBased     " << endl;
+    cout << "===========================================================" << endl;
+
+    // Set the coordinates of a transform axis: a linear function of one
+    // coordinate, or a constant.
+    auto setLinear = [](TransformAxis& axis, const std::string& coord,
+                        double slope, const Vec3& direction) {
+        axis.setCoordinateNames(OpenSim::Array<std::string>(coord, 1, 1));
+        axis.setFunction(new LinearFunction(slope, 0));
+        axis.setAxis(direction);
+    };
+    auto setConstant = [](TransformAxis& axis, double value,
+                          const Vec3& direction) {
+        axis.setCoordinateNames(OpenSim::Array<std::string>());
+        axis.setFunction(new Constant(value));
+        axis.setAxis(direction);
+    };
+
+    // A chain of bodies, each connected to the previous one by a different
+    // kind of CustomJoint.
+    Model model;
+    model.setName("native_mobilizers");
+    model.setGravity(gravity_vec);
+    std::map<std::string, std::string> expectedTypes;
+    const PhysicalFrame* parent = &model.getGround();
+    auto addBody = [&](const std::string& name, SpatialTransform& transform,
+                       const std::string& expectedType) {
+        auto body = new OpenSim::Body(name, tibiaMass.getMass(),
+                Vec3(0.01, -0.1, 0.02), tibiaMass.getInertia());
+        auto joint = new CustomJoint(name + "_joint",
+                *parent, Vec3(0.02, -0.2, 0.01), Vec3(0.1, -0.2, 0.3),
+                *body, Vec3(0, 0.18, -0.01), Vec3(-0.3, 0.1, 0.2), transform);
+        model.addBody(body);
+        model.addJoint(joint);
+        expectedTypes[joint->getName()] = expectedType;
+        parent = body;
+    };
+
+    // 6 dofs, rotations about z, x, y and translations along the same axes.
+    {
+        SpatialTransform transform;
+        setLinear(transform[0], "bushing_rz", 1, Vec3(0, 0, 1));
+        setLinear(transform[1], "bushing_rx", 1, Vec3(1, 0, 0));
+        setLinear(transform[2], "bushing_ry", -1, Vec3(0, -1, 0));
+        setLinear(transform[3], "bushing_tz", -1, Vec3(0, 0, -1));
+        setLinear(transform[4], "bushing_tx", 1, Vec3(1, 0, 0));
+        setLinear(transform[5], "bushing_ty", 1, Vec3(0, 1, 0));
+        addBody("bushing", transform, "Bushing");
+    }
+    // 3 rotations about oblique axes, with a fixed translation.
+    {
+        const Rotation R(BodyRotationSequence, 0.3, XAxis, -0.5, YAxis,
+                         0.7, ZAxis);
+        SpatialTransform transform;
+        setLinear(transform[0], "gimbal_r1", 1, R.y().asVec3());
+        setLinear(transform[1], "gimbal_r2", 1, R.z().asVec3());
+        setLinear(transform[2], "gimbal_r3", -1, -R.x().asVec3());
+        setConstant(transform[3], 0.05, Vec3(1, 0, 0));
+        setConstant(transform[4], -0.02, Vec3(0, 1, 0));
+        setConstant(transform[5], 0, Vec3(0, 0, 1));
+        addBody("gimbal", transform, "Gimbal");
+    }
+    // 2 rotations, with the unused rotation axis in between.
+    {
+        SpatialTransform transform;
+        setLinear(transform[0], "universal_r1", 1, Vec3(0, 0, 1));
+        setConstant(transform[1], 0, Vec3(0, 1, 0));
+        setLinear(transform[2], "universal_r2", 1, Vec3(1, 0, 0));
+        addBody("universal", transform, "Universal");
+    }
+    // 1 rotation about an oblique axis, as in an ankle.
+    {
+        SpatialTransform transform;
+        setLinear(transform[0], "pin_r", -1,
+                  Vec3(-0.10501355, -0.17402245, 0.97912632));
+        setConstant(transform[4], 0.01, Vec3(0, 1, 0));
+        addBody("pin", transform, "Pin");
+    }
+    // 1 translation.
+    {
+        SpatialTransform transform;
+        setLinear(transform[4], "slider_t", 1, Vec3(0, 0.6, 0.8));
+        addBody("slider", transform, "Slider");
+    }
+    // A knee-like joint with a coupled translation is not a native mobilizer.
+    {
+        SpatialTransform transform;
+        setLinear(transform[2], "coupled_r", 1, Vec3(0, 0, 1));
+        transform[3].setCoordinateNames(
+                OpenSim::Array<std::string>("coupled_r", 1, 1));
+        transform[3].setFunction(new LinearFunction(0.1, 0));
+        addBody("coupled", transform, "FunctionBased");
+    }
+    // 2 rotations about axes that are not perpendicular.
+    {
+        SpatialTransform transform;
+        setLinear(transform[0], "skewed_r1", 1, Vec3(0, 0, 1));
+        setLinear(transform[1], "skewed_r2", 1, Vec3(0.6, 0, 0.8));
+        addBody("skewed", transform, "FunctionBased");
+    }
+
+    model.finalizeConnections();
+    std::unique_ptr<Model> copy(model.clone());
+    Model& functionBasedModel = *copy;
+    for (auto& joint : functionBasedModel.updComponentList<CustomJoint>())
+        joint.set_use_native_mobilizer(false);
+
+    State& s = model.initSystem();
+    State& sFB = functionBasedModel.initSystem();
+
+    CustomJoint::printMobilizerReport(model);
+    for (const auto& joint : model.getComponentList<CustomJoint>()) {
+        const std::string& expected = expectedTypes.at(joint.getName());
+        ASSERT(joint.getMobilizerType() == expected, __FILE__, __LINE__,
+            joint.getName() + " uses " + joint.getMobilizerType() +
+            " but expected " + expected);
+    }
+    for (const auto& joint :
+            functionBasedModel.getComponentList<CustomJoint>()) {
+        ASSERT(joint.getMobilizerType() == "FunctionBased",
+               __FILE__, __LINE__);
+    }
+    ASSERT(s.getNQ() == sFB.getNQ() && s.getNU() == sFB.getNU());
+
+    // Same coordinate values and speeds must give the same kinematics and
+    // dynamics.
+    Random::Uniform random(-1, 1);
+    random.setSeed(37);
+    const auto& coords = model.getCoordinateSet();
+    const auto& coordsFB = functionBasedModel.getCoordinateSet();
+    for (int i = 0; i < coords.getSize(); ++i) {
+        const double value = random.getValue();
+        const double speed = random.getValue();
+        coords.get(i).setValue(s, value, false);
+        coords.get(i).setSpeedValue(s, speed);
+        coordsFB.get(coords.get(i).getName()).setValue(sFB, value, false);
+        coordsFB.get(coords.get(i).getName()).setSpeedValue(sFB, speed);
+    }
+    model.realizeAcceleration(s);
+    functionBasedModel.realizeAcceleration(sFB);
+
+    const double tol = 1e-10;
+    for (const auto& body : model.getComponentList<OpenSim::Body>()) {
+        const auto& bodyFB =
+            functionBasedModel.getBodySet().get(body.getName());
+        const Transform X = body.getTransformInGround(s);
+        const Transform XFB = bodyFB.getTransformInGround(sFB);
+        ASSERT_EQUAL(X.p(), XFB.p(), tol, __FILE__, __LINE__,
+            body.getName() + " position differs.");
+        const double angle =
+            (~X.R()*XFB.R()).convertRotationToAngleAxis()[0];
+        ASSERT(std::abs(angle) < tol, __FILE__, __LINE__,
+               body.getName() + " orientation differs.");
+        for (int k = 0; k < 2; ++k) {
+            ASSERT_EQUAL(body.getVelocityInGround(s)[k],
+                         bodyFB.getVelocityInGround(sFB)[k], tol,
+                         __FILE__, __LINE__,
+                         body.getName() + " velocity differs.");
+            ASSERT_EQUAL(body.getAccelerationInGround(s)[k],
+                         bodyFB.getAccelerationInGround(sFB)[k], 1e-8,
+                         __FILE__, __LINE__,
+                         body.getName() + " acceleration differs.");
+        }
+    }
+    for (int i = 0; i < coords.getSize(); ++i) {
+        const auto& coordFB = coordsFB.get(coords.get(i).getName());
+        ASSERT_EQUAL(coords.get(i).getValue(s), coordFB.getValue(sFB), tol,
+                     __FILE__, __LINE__);
+        ASSERT_EQUAL(coords.get(i).getSpeedValue(s), coordFB.getSpeedValue(sFB),
+                     tol, __FILE__, __LINE__);
+        ASSERT_EQUAL(coords.get(i).getAccelerationValue(s),
+                     coordFB.getAccelerationValue(sFB), 1e-8,
+                     __FILE__, __LINE__,
+                     coords.get(i).getName() + " acceleration differs.");
+    }
+}
@@ -0,0 +1,271 @@
+/* -------------------------------------------------------------------------- *
+ *               OpenSim:  SimulationOptimizationTarget.cpp                   *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimulationOptimizationTarget.h"
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Manager/Manager.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+
+using namespace OpenSim;
+
+namespace OpenSim {
+/** Evaluates parameter vectors with one copy of the model per task index;
+    each task takes the next parameter vector that has not been evaluated
+    until all of them have been. */
+class SimulationOptimizationTarget::EvaluationTask
+        : public SimTK::ParallelExecutor::Task {
+public:
+    EvaluationTask(const SimulationOptimizationTarget& target,
+            const std::vector<SimTK::Vector>& population,
+            std::vector<double>& objectives) :
+        _target(target), _population(population), _objectives(objectives) {}
+
+    void execute(int index) override {
+        PoolMember& member = _target._pool[index];
+        const int size = int(_population.size());
+        for (int i = _next++; i < size; i = _next++) {
+            try {
+                _objectives[i] = _target.simulate(member, _population[i]);
+            } catch (const std::exception& e) {
+                std::lock_guard<std::mutex> lock(_errorMutex);
+                if (_error.empty()) _error = e.what();
+            }
+        }
+    }
+
+    /** The message of the first exception thrown by a simulation, if any. */
+    const std::string& getError() const { return _error; }
+
+private:
+    const SimulationOptimizationTarget& _target;
+    const std::vector<SimTK::Vector>& _population;
+    std::vector<double>& _objectives;
+    std::atomic<int> _next{0};
+    std::mutex _errorMutex;
+    std::string _error;
+};
+}
+
+SimulationOptimizationTarget::SimulationOptimizationTarget(const Model& model,
+        const SimTK::State& initialState, int numParameters,
+        double initialTime, double finalTime, int numThreads) :
+    OptimizationTarget(numParameters),
+    _initialTime(initialTime),
+    _finalTime(finalTime)
+{
+    OPENSIM_THROW_IF(numParameters < 1, Exception,
+            "Expected at least one parameter, but got " +
+            std::to_string(numParameters) + ".");
+    OPENSIM_THROW_IF(finalTime <= initialTime, Exception,
+            "Expected the final time (" + std::to_string(finalTime) +
+            ") to be greater than the initial time (" +
+            std::to_string(initialTime) + ").");
+    setDX(1e-4);
+
+    if (numThreads < 1)
+        numThreads = SimTK::ParallelExecutor::getNumProcessors();
+    numThreads = std::max(1, numThreads);
+
+    // Create each copy's system once; every evaluation starts from a copy of
+    // the cached initial state.
+    _pool.resize(numThreads);
+    for (PoolMember& member : _pool) {
+        member.model.reset(model.clone());
+        member.model->initSystem();
+        member.initialState = initialState;
+    }
+    if (numThreads > 1)
+        _executor.reset(new SimTK::ParallelExecutor(numThreads));
+}
+
+SimulationOptimizationTarget::~SimulationOptimizationTarget() = default;
+
+//==============================================================================
+// EVALUATION
+//==============================================================================
+void SimulationOptimizationTarget::applyParameters(
+        const SimTK::Vector& parameters, Model& model,
+        SimTK::State& state) const
+{
+    OPENSIM_THROW_IF(parameters.size() != model.getNumControls(), Exception,
+            "Expected as many parameters as the model has controls (" +
+            std::to_string(model.getNumControls()) + "), but got " +
+            std::to_string(parameters.size()) + ". Override "
+            "applyParameters() to optimize other parameters.");
+    model.updDefaultControls() = parameters;
+}
+
+double SimulationOptimizationTarget::simulate(PoolMember& member,
+        const SimTK::Vector& parameters) const
+{
+    Model& model = *member.model;
+    SimTK::State s = member.initialState;
+    applyParameters(parameters, model, s);
+    s.setTime(_initialTime);
+
+    // Only the final state is needed.
+    Manager manager(model);
+    manager.setWriteToStorage(false);
+    manager.setPerformAnalyses(false);
+    manager.setIntegratorAccuracy(_accuracy);
+    manager.initialize(s);
+    const SimTK::State& finalState = manager.integrate(_finalTime);
+    return computeObjective(model, finalState);
+}
+
+double SimulationOptimizationTarget::evaluate(
+        const SimTK::Vector& parameters) const
+{
+    const auto start = std::chrono::steady_clock::now();
+    const double f = simulate(_pool[0], parameters);
+    addEvaluationTime(std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count(), 1);
+    return f;
+}
+
+std::vector<double> SimulationOptimizationTarget::evaluatePopulation(
+        const std::vector<SimTK::Vector>& population) const
+{
+    std::vector<double> objectives;
+    evaluateAll(population, objectives);
+    return objectives;
+}
+
+void SimulationOptimizationTarget::evaluateAll(
+        const std::vector<SimTK::Vector>& population,
+        std::vector<double>& objectives) const
+{
+    const auto start = std::chrono::steady_clock::now();
+    const int size = int(population.size());
+    objectives.assign(size, SimTK::NaN);
+    const int numTasks = std::min(int(_pool.size()), size);
+    if (numTasks <= 1) {
+        for (int i = 0; i < size; ++i)
+            objectives[i] = simulate(_pool[0], population[i]);
+    } else {
+        EvaluationTask task(*this, population, objectives);
+        _executor->execute(task, numTasks);
+        OPENSIM_THROW_IF(!task.getError().empty(), Exception,
+                "A simulation failed: " + task.getError());
+    }
+    addEvaluationTime(std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count(), size);
+}
+
+//==============================================================================
+// PERFORMANCE
+//==============================================================================
+void SimulationOptimizationTarget::addEvaluationTime(double seconds,
+        long long numEvaluations) const
+{
+    _evaluationTime += seconds;
+    _numEvaluations += numEvaluations;
+}
+
+double SimulationOptimizationTarget::getEvaluationsPerSecond() const
+{
+    return _evaluationTime > 0 ? _numEvaluations / _evaluationTime : 0;
+}
+
+void SimulationOptimizationTarget::resetPerformance()
+{
+    _numEvaluations = 0;
+    _evaluationTime = 0;
+}
+
+void SimulationOptimizationTarget::printPerformance(double *x)
+{
+    printPerformance(std::cout);
+}
+
+void SimulationOptimizationTarget::printPerformance(std::ostream& out) const
+{
+    out << _numEvaluations << " simulations in " << _evaluationTime
+        << " s (" << getEvaluationsPerSecond() << " per second) with "
+        << getNumThreads() << " thread(s)." << std::endl;
+}
+
+//==============================================================================
+// REQUIRED OPTIMIZATION TARGET METHODS
+//==============================================================================
+int SimulationOptimizationTarget::objectiveFunc(
+        const SimTK::Vector& parameters, bool new_parameters,
+        SimTK::Real& f) const
+{
+    f = evaluate(parameters);
+    _lastParameters = parameters;
+    _lastObjective = f;
+    return 0;
+}
+
+int SimulationOptimizationTarget::gradientFunc(
+        const SimTK::Vector& parameters, bool new_parameters,
+        SimTK::Vector& gradient) const
+{
+    const int n = getNumParameters();
+    gradient.resize(n);
+
+    SimTK::Real* lower = nullptr;
+    SimTK::Real* upper = nullptr;
+    if (getHasLimits()) getParameterLimits(&lower, &upper);
+
+    // Optimizers usually evaluate the objective at the same parameters just
+    // before the gradient; forward differences reuse that evaluation.
+    bool reuseObjective = !_central && _lastParameters.size() == n;
+    for (int p = 0; reuseObjective && p < n; ++p)
+        reuseObjective = _lastParameters[p] == parameters[p];
+
+    std::vector<SimTK::Vector> population;
+    std::vector<double> steps(n);
+    for (int p = 0; p < n; ++p) {
+        double h = _dx[p];
+        // Step backwards at the upper bound.
+        if (!_central && upper && parameters[p] + h > upper[p]) h = -h;
+        steps[p] = h;
+        population.push_back(parameters);
+        population.back()[p] += h;
+        if (_central) {
+            population.push_back(parameters);
+            population.back()[p] -= h;
+        }
+    }
+    if (!_central && !reuseObjective) population.push_back(parameters);
+
+    std::vector<double> objectives;
+    evaluateAll(population, objectives);
+
+    if (_central) {
+        for (int p = 0; p < n; ++p)
+            gradient[p] = (objectives[2*p] - objectives[2*p + 1]) /
+                          (2 * steps[p]);
+    } else {
+        const double f = reuseObjective ? _lastObjective : objectives[n];
+        for (int p = 0; p < n; ++p)
+            gradient[p] = (objectives[p] - f) / steps[p];
+    }
+    return 0;
+}
@@ -0,0 +1,215 @@
+#ifndef OPENSIM_SIMULATION_OPTIMIZATION_TARGET_H_
+#define OPENSIM_SIMULATION_OPTIMIZATION_TARGET_H_
+/* -------------------------------------------------------------------------- *
+ *                OpenSim:  SimulationOptimizationTarget.h                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimSimulationDLL.h"
+#include <OpenSim/Common/OptimizationTarget.h>
+#include <SimTKcommon/internal/State.h>
+
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+namespace SimTK {
+class ParallelExecutor;
+}
+
+namespace OpenSim {
+
+class Model;
+
+//==============================================================================
+//                      SIMULATION OPTIMIZATION TARGET
+//==============================================================================
+/**
+ * An OptimizationTarget whose objective is computed from a forward simulation
+ * of a Model, for optimizing parameters such as constant controls, initial
+ * conditions, or properties of the model.
+ *
+ * On construction, the Model is copied once per thread, each copy's system is
+ * created, and the initial state is copied into each copy; these are reused
+ * for every evaluation of the objective, rather than re-initializing the
+ * system (or the state) for each one. An evaluation applies the parameters to
+ * a copy of the model and of its cached initial state (see
+ * applyParameters()), simulates from the initial to the final time with a
+ * Manager, and computes the objective from the final state (see
+ * computeObjective()).
+ *
+ * gradientFunc() computes a finite-difference gradient, running the
+ * simulations for the perturbed parameters in parallel; enable it with
+ * `optimizer.useNumericalGradient(false)`. Derivative-free optimizers (or
+ * your own search) can evaluate a population of parameter vectors in
+ * parallel with evaluatePopulation().
+ *
+ * Derive from this class and implement computeObjective(); the default
+ * applyParameters() sets the default controls of the model (see
+ * Model::updDefaultControls()):
+ * @code
+ * class MaxHandVelocity : public SimulationOptimizationTarget {
+ * public:
+ *     MaxHandVelocity(const Model& model, const SimTK::State& s) :
+ *         SimulationOptimizationTarget(model, s, model.getNumControls(),
+ *                                      0.0, 0.25) {}
+ *     double computeObjective(const Model& model,
+ *                             const SimTK::State& s) const override {
+ *         const auto& hand = model.getComponent<Body>("r_ulna_radius_hand");
+ *         model.realizeVelocity(s);
+ *         return -hand.findStationVelocityInGround(s,
+ *                                                  hand.getMassCenter())[0];
+ *     }
+ * };
+ * @endcode
+ *
+ * The initial state must be a state of the given Model's current system
+ * (i.e., obtained from Model::initSystem() after the last change to the
+ * model). applyParameters() and computeObjective() are called concurrently
+ * from multiple threads, each with its own copy of the model and state; they
+ * must not modify anything else. The member functions of this class itself
+ * must not be called concurrently.
+ */
+class OSIMSIMULATION_API SimulationOptimizationTarget
+        : public OptimizationTarget {
+public:
+    /** Copy the model once per thread, and the initial state into each copy.
+    @param model          The model to simulate; it is not modified.
+    @param initialState   The state from which each simulation starts.
+    @param numParameters  Number of parameters being optimized.
+    @param initialTime    Time at which each simulation starts.
+    @param finalTime      Time at which each simulation ends.
+    @param numThreads     Number of copies of the model, and thus the number
+                          of simulations run concurrently; values less than 1
+                          use all available processors. */
+    SimulationOptimizationTarget(const Model& model,
+            const SimTK::State& initialState, int numParameters,
+            double initialTime, double finalTime, int numThreads = 0);
+    ~SimulationOptimizationTarget() override;
+
+    SimulationOptimizationTarget(const SimulationOptimizationTarget&) = delete;
+    SimulationOptimizationTarget& operator=(
+            const SimulationOptimizationTarget&) = delete;
+
+    /** The number of copies of the model, and thus the maximum number of
+    simulations run concurrently. */
+    int getNumThreads() const { return int(_pool.size()); }
+
+    /** Accuracy of the integrator of each simulation (see
+    Manager::setIntegratorAccuracy()). Default: 1e-5. */
+    void setIntegratorAccuracy(double accuracy) { _accuracy = accuracy; }
+    double getIntegratorAccuracy() const { return _accuracy; }
+
+    /** Use central rather than forward differences in gradientFunc().
+    Central differences need twice as many simulations. Default: false. The
+    perturbation of each parameter is set with setDX(); the default is
+    1e-4. */
+    void setUseCentralDifferences(bool central) { _central = central; }
+    bool getUseCentralDifferences() const { return _central; }
+
+    //--------------------------------------------------------------------------
+    // EVALUATION
+    //--------------------------------------------------------------------------
+    /** Simulate with the given parameters and return the objective. */
+    double evaluate(const SimTK::Vector& parameters) const;
+
+    /** Simulate with each of the given parameter vectors, in parallel, and
+    return the objectives in the same order. */
+    std::vector<double> evaluatePopulation(
+            const std::vector<SimTK::Vector>& population) const;
+
+    /** Apply the parameters to a copy of the model and to the state from
+    which it is simulated (a copy of the initial state). Modifying properties
+    of the model requires recreating its system, which defeats the purpose
+    of the cached copies; prefer parameters that can be applied to the state
+    or through defaults that do not invalidate the system. By default, sets
+    the default controls of the model to the parameters. */
+    virtual void applyParameters(const SimTK::Vector& parameters,
+            Model& model, SimTK::State& state) const;
+
+    /** Compute the objective (to be minimized) from the state at the end of
+    a simulation. */
+    virtual double computeObjective(const Model& model,
+            const SimTK::State& finalState) const = 0;
+
+    //--------------------------------------------------------------------------
+    // PERFORMANCE
+    //--------------------------------------------------------------------------
+    /** Number of simulations run since construction or the last call to
+    resetPerformance(). */
+    long long getNumEvaluations() const { return _numEvaluations; }
+    /** Number of simulations run per second of wall-clock time spent in
+    evaluate(), evaluatePopulation(), objectiveFunc() and gradientFunc(). */
+    double getEvaluationsPerSecond() const;
+    void resetPerformance();
+
+    /** Print the number of evaluations and evaluations per second. */
+    void printPerformance(double *x) override;
+    void printPerformance(std::ostream& out) const;
+
+    //--------------------------------------------------------------------------
+    // REQUIRED OPTIMIZATION TARGET METHODS
+    //--------------------------------------------------------------------------
+    int objectiveFunc(const SimTK::Vector& parameters, bool new_parameters,
+                      SimTK::Real& f) const override;
+    int gradientFunc(const SimTK::Vector& parameters, bool new_parameters,
+                     SimTK::Vector& gradient) const override;
+
+private:
+    class EvaluationTask;
+
+    /** A copy of the model and its cached initial state. */
+    struct PoolMember {
+        std::unique_ptr<Model> model;
+        SimTK::State initialState;
+    };
+
+    // Simulate with the given copy of the model.
+    double simulate(PoolMember& member,
+                    const SimTK::Vector& parameters) const;
+    // Evaluate all of the parameter vectors, in parallel.
+    void evaluateAll(const std::vector<SimTK::Vector>& population,
+                     std::vector<double>& objectives) const;
+    // Add to the wall-clock time and number of simulations reported by
+    // getEvaluationsPerSecond().
+    void addEvaluationTime(double seconds, long long numEvaluations) const;
+
+    mutable std::vector<PoolMember> _pool;
+    std::unique_ptr<SimTK::ParallelExecutor> _executor;
+    double _initialTime;
+    double _finalTime;
+    double _accuracy = 1e-5;
+    bool _central = false;
+
+    // The last parameters passed to objectiveFunc() and the objective, which
+    // forward differences reuse.
+    mutable SimTK::Vector _lastParameters;
+    mutable double _lastObjective = SimTK::NaN;
+
+    mutable long long _numEvaluations = 0;
+    mutable double _evaluationTime = 0;
+
+//==============================================================================
+};  // END of class SimulationOptimizationTarget
+//==============================================================================
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_SIMULATION_OPTIMIZATION_TARGET_H_
@@ -0,0 +1,126 @@
+/* -------------------------------------------------------------------------- *
+ *                  OpenSim:  testCustomJointMobilizers.cpp                   *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2017 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+//=============================================================================
+// testCustomJointMobilizers simulates gait2354 with its CustomJoints
+// specialized to native Simbody mobilizers and with every CustomJoint using
+// a FunctionBased mobilizer, verifies that both simulations produce the same
+// motion, and reports the time taken by each.
+//=============================================================================
+#include <OpenSim/Simulation/osimSimulation.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <OpenSim/Common/LoadOpenSimLibrary.h>
+#include <chrono>
+
+using namespace OpenSim;
+using namespace std;
+
+void testGait2354ForwardSimulation();
+
+int main()
+{
+    try {
+        LoadOpenSimLibrary("osimActuators");
+        testGait2354ForwardSimulation();
+    }
+    catch (const std::exception& e) {
+        cout << "\ntestCustomJointMobilizers FAILED " << e.what() << endl;
+        return 1;
+    }
+    cout << "\ntestCustomJointMobilizers PASSED" << endl;
+    return 0;
+}
+
+// Simulate the model and return the wall-clock time taken by the integration.
+double simulate(Model& model, SimTK::State& state, double finalTime)
+{
+    model.equilibrateMuscles(state);
+    Manager manager(model);
+    manager.setIntegratorAccuracy(1e-8);
+    state.setTime(0.0);
+    manager.initialize(state);
+
+    auto start = chrono::steady_clock::now();
+    state = manager.integrate(finalTime);
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+void testGait2354ForwardSimulation()
+{
+    const double finalTime = 0.1;
+
+    Model nativeModel("gait2354_simbody.osim");
+    Model functionBasedModel("gait2354_simbody.osim");
+    for (auto& joint : functionBasedModel.updComponentList<CustomJoint>())
+        joint.set_use_native_mobilizer(false);
+
+    SimTK::State& nativeState = nativeModel.initSystem();
+    SimTK::State& functionBasedState = functionBasedModel.initSystem();
+
+    CustomJoint::printMobilizerReport(nativeModel);
+
+    // The 6-dof pelvis, the hips and lumbar, and the pin joints of the feet
+    // have native equivalents; the knees, with their coupled translations,
+    // do not.
+    const auto& joints = nativeModel.getJointSet();
+    ASSERT(dynamic_cast<const CustomJoint&>(joints.get("ground_pelvis"))
+            .getMobilizerType() == "Bushing", __FILE__, __LINE__,
+            "Expected ground_pelvis to use a Bushing mobilizer.");
+    ASSERT(dynamic_cast<const CustomJoint&>(joints.get("hip_r"))
+            .getMobilizerType() == "Gimbal", __FILE__, __LINE__,
+            "Expected hip_r to use a Gimbal mobilizer.");
+    ASSERT(dynamic_cast<const CustomJoint&>(joints.get("knee_r"))
+            .getMobilizerType() == "FunctionBased", __FILE__, __LINE__,
+            "Expected knee_r to use a FunctionBased mobilizer.");
+    for (const auto& joint : functionBasedModel.getComponentList<CustomJoint>())
+        ASSERT(joint.getMobilizerType() == "FunctionBased", __FILE__,
+                __LINE__, "Expected " + joint.getName() +
+                " to use a FunctionBased mobilizer when the native mobilizer "
+                "is disabled.");
+
+    // The two models start from the same state.
+    ASSERT(nativeState.getNQ() == functionBasedState.getNQ(), __FILE__,
+            __LINE__, "Expected the models to have the same number of Qs.");
+
+    double nativeTime = simulate(nativeModel, nativeState, finalTime);
+    double functionBasedTime = simulate(functionBasedModel, functionBasedState,
+                                        finalTime);
+
+    cout << "Simulated " << finalTime << " s of gait2354:" << endl;
+    cout << "  native mobilizers:         " << nativeTime << " s" << endl;
+    cout << "  FunctionBased mobilizers:  " << functionBasedTime << " s"
+         << endl;
+    cout << "  speedup: " << functionBasedTime/nativeTime << endl;
+
+    // Compare the final coordinate values and speeds.
+    const double tol = 1e-5;
+    const CoordinateSet& coords = nativeModel.getCoordinateSet();
+    const CoordinateSet& fbCoords = functionBasedModel.getCoordinateSet();
+    for (int i = 0; i < coords.getSize(); ++i) {
+        ASSERT_EQUAL(fbCoords.get(i).getValue(functionBasedState),
+                coords.get(i).getValue(nativeState), tol, __FILE__, __LINE__,
+                "Value of " + coords.get(i).getName() + " differs.");
+        ASSERT_EQUAL(fbCoords.get(i).getSpeedValue(functionBasedState),
+                coords.get(i).getSpeedValue(nativeState), 10*tol, __FILE__,
+                __LINE__, "Speed of " + coords.get(i).getName() + " differs.");
+    }
+}
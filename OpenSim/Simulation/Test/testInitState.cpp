@@ -24,6 +24,7 @@
 #include <OpenSim/Simulation/Manager/Manager.h>
 #include <OpenSim/Simulation/Control/ControlSetController.h>
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/Muscle.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
@@ -42,6 +43,18 @@ void testStates(const string& modelFile);
 // cause the memory footprint of the process to increase significantly.
 //==============================================================================
 void testMemoryUsage(const string& modelFile);
+//==============================================================================
+// testWarmStartedEquilibrium tests that warm-starting the muscle equilibrium
+// solve from the previous solution yields the same fiber lengths as a cold
+// solve, in no more iterations.
+//==============================================================================
+void testWarmStartedEquilibrium(const string& modelFile);
+//==============================================================================
+// testStateVariableSystemIndices tests that writing state variable values
+// into the state's Y vector at the indices reported by the model is the same
+// as setting them with setStateVariableValues().
+//==============================================================================
+void testStateVariableSystemIndices(const string& modelFile);
 
 static const int MAX_N_TRIES = 100;
 
@@ -50,6 +63,8 @@ int main()
     try {
         LoadOpenSimLibrary("osimActuators");
         testStates("arm26.osim");
+        testWarmStartedEquilibrium("arm26.osim");
+        testStateVariableSystemIndices("arm26.osim");
         testMemoryUsage("arm26.osim");
         testMemoryUsage("PushUpToesOnGroundWithMuscles.osim");
     }
@@ -186,3 +201,82 @@ void testMemoryUsage(const string& modelFile)
     ASSERT((leak_percent) < 0.5, __FILE__, __LINE__,
         "testMemoryUsage: state initialization leak > 0.5% of model memory footprint.");
 }
+
+void testWarmStartedEquilibrium(const string& modelFile)
+{
+    using namespace SimTK;
+
+    Model model(modelFile);
+    State& state = model.initSystem();
+
+    // Nothing has been solved yet.
+    for (const auto& muscle : model.getComponentList<Muscle>()) {
+        ASSERT(muscle.getNumEquilibriumIterations(state) == -1,
+            __FILE__, __LINE__, "Expected no equilibrium iterations.");
+    }
+
+    model.equilibrateMuscles(state);
+
+    // Move the elbow a little, as between consecutive frames of a motion.
+    const Coordinate& elbow = model.getCoordinateSet().get("r_elbow_flex");
+    elbow.setValue(state, elbow.getValue(state) + 0.01);
+
+    State coldState(state);
+    model.equilibrateMuscles(coldState);
+    model.equilibrateMuscles(state, true);
+
+    for (const auto& muscle : model.getComponentList<Muscle>()) {
+        ASSERT_EQUAL(muscle.getFiberLength(coldState),
+            muscle.getFiberLength(state), 1e-6, __FILE__, __LINE__,
+            "Warm-started equilibrium of " + muscle.getName() +
+            " differs from the cold-started equilibrium.");
+        const int coldIterations =
+            muscle.getNumEquilibriumIterations(coldState);
+        const int warmIterations = muscle.getNumEquilibriumIterations(state);
+        cout << muscle.getName() << " equilibrium iterations: cold = "
+             << coldIterations << ", warm = " << warmIterations << endl;
+        ASSERT(warmIterations >= 0 && warmIterations <= coldIterations,
+            __FILE__, __LINE__, "Warm start of " + muscle.getName() +
+            " took more iterations than the cold start.");
+    }
+}
+
+void testStateVariableSystemIndices(const string& modelFile)
+{
+    using namespace SimTK;
+
+    Model model(modelFile);
+    State& state = model.initSystem();
+
+    const int nsv = model.getNumStateVariables();
+    const std::vector<SystemYIndex> yIndices =
+        model.getStateVariableSystemIndices(state);
+    ASSERT(int(yIndices.size()) == nsv, __FILE__, __LINE__,
+        "Expected one index per state variable.");
+
+    Vector values(nsv);
+    for (int k = 0; k < nsv; ++k)
+        values[k] = 0.1 + 0.01*k;
+
+    State setState(state);
+    model.setStateVariableValues(setState, values);
+
+    State yState(state);
+    Vector& y = yState.updY();
+    for (int k = 0; k < nsv; ++k) {
+        ASSERT(yIndices[k].isValid(), __FILE__, __LINE__,
+            "Expected every state variable of the model to be stored in Y.");
+        y[yIndices[k]] = values[k];
+    }
+
+    const Array<std::string> names = model.getStateVariableNames();
+    const Vector fromY = model.getStateVariableValues(yState);
+    for (int k = 0; k < nsv; ++k) {
+        ASSERT_EQUAL(values[k], fromY[k], 0.0, __FILE__, __LINE__,
+            "Value of " + names[k] + " was written to the wrong entry of Y.");
+    }
+    ASSERT(setState.getY().size() == yState.getY().size() &&
+           (setState.getY() - yState.getY()).normInf() == 0,
+        __FILE__, __LINE__,
+        "Writing Y directly differs from setStateVariableValues().");
+}
@@ -37,6 +37,10 @@ Manager Tests:
 4. testConstructors: Ensure different constructors work as intended.
 5. testIntegratorInterface: Ensure setting integrator options works as intended.
 6. testExceptions: Test that misuse actually triggers exceptions.
+7. testSimulationOptimizationTarget: Evaluate the objective and its
+   finite-difference gradient from simulations in parallel, and optimize.
+8. testCheckpoint: Continue a simulation from a checkpoint, and compare with
+   the uninterrupted simulation; report the cost of checkpoints.
 
 //=============================================================================*/
 #include <OpenSim/Simulation/Model/Model.h>
@@ -47,6 +51,14 @@ Manager Tests:
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 #include <OpenSim/Simulation/Control/PrescribedController.h>
 #include <OpenSim/Common/Constant.h>
+#include <OpenSim/Simulation/SimbodyEngine/SliderJoint.h>
+#include <OpenSim/Simulation/SimulationOptimizationTarget.h>
+#include <OpenSim/Actuators/CoordinateActuator.h>
+#include <OpenSim/Analyses/Kinematics.h>
+#include <OpenSim/Common/Reporter.h>
+
+#include <chrono>
+#include <fstream>
 
 using namespace OpenSim;
 using namespace std;
@@ -56,6 +68,8 @@ void testExcitationUpdatesWithManager();
 void testConstructors();
 void testIntegratorInterface();
 void testExceptions();
+void testSimulationOptimizationTarget();
+void testCheckpoint();
 
 int main()
 {
@@ -97,6 +111,18 @@ int main()
         failures.push_back("testExceptions");
     }
 
+    try { testSimulationOptimizationTarget(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testSimulationOptimizationTarget");
+    }
+
+    try { testCheckpoint(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testCheckpoint");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -478,3 +504,188 @@ void testExceptions()
     manager.setIntegratorAccuracy(1e-4);
     manager.setIntegratorMinimumStepSize(0.01);
 }
+
+// A unit mass on a slider, pushed by a CoordinateActuator with an optimal
+// force of 1 and a constant control u, is at x(T) = u*T^2/2 at time T.
+// Minimize (x(T) - 1)^2, for which u = 2/T^2.
+class SliderTarget : public SimulationOptimizationTarget {
+public:
+    SliderTarget(const Model& model, const SimTK::State& s, int numThreads) :
+        SimulationOptimizationTarget(model, s, 1, 0.0, 1.0, numThreads) {}
+    double computeObjective(const Model& model,
+                            const SimTK::State& s) const override {
+        const double x = model.getCoordinateSet()[0].getValue(s);
+        return (x - 1) * (x - 1);
+    }
+};
+
+void testSimulationOptimizationTarget()
+{
+    cout << "Running testSimulationOptimizationTarget" << endl;
+    Model model;
+    model.setGravity(SimTK::Vec3(0));
+    auto* body = new OpenSim::Body("block", 1.0, SimTK::Vec3(0),
+                                   SimTK::Inertia(1));
+    auto* slider = new SliderJoint("slider", model.getGround(), *body);
+    model.addBody(body);
+    model.addJoint(slider);
+    auto* actuator = new CoordinateActuator();
+    actuator->setName("actuator");
+    actuator->setCoordinate(&slider->updCoordinate());
+    actuator->setOptimalForce(1.0);
+    actuator->setMinControl(-10);
+    actuator->setMaxControl(10);
+    model.addForce(actuator);
+    SimTK::State& s = model.initSystem();
+
+    const double objectiveAt1 = 0.25; // x(1) = 0.5.
+    const double gradientAt1 = -0.5;  // d/du (u/2 - 1)^2 at u = 1.
+    SimTK::Vector u(1, 1.0);
+
+    SliderTarget serial(model, s, 1);
+    SliderTarget parallel(model, s, 4);
+    SimTK_TEST(serial.getNumThreads() == 1);
+    SimTK_TEST(parallel.getNumThreads() == 4);
+    for (SliderTarget* target : {&serial, &parallel}) {
+        SimTK::Real f;
+        target->objectiveFunc(u, true, f);
+        SimTK_TEST_EQ_TOL(f, objectiveAt1, 1e-6);
+
+        SimTK::Vector gradient;
+        target->gradientFunc(u, false, gradient);
+        SimTK_TEST_EQ_TOL(gradient[0], gradientAt1, 1e-3);
+        target->setUseCentralDifferences(true);
+        target->gradientFunc(u, false, gradient);
+        SimTK_TEST_EQ_TOL(gradient[0], gradientAt1, 1e-6);
+        target->setUseCentralDifferences(false);
+
+        // The objectives of a population are in the order of the population.
+        std::vector<SimTK::Vector> population;
+        for (int i = 0; i < 9; ++i)
+            population.push_back(SimTK::Vector(1, 0.5 * i));
+        const std::vector<double> objectives =
+                target->evaluatePopulation(population);
+        SimTK_TEST(objectives.size() == population.size());
+        for (int i = 0; i < 9; ++i) {
+            const double x = 0.25 * i;
+            SimTK_TEST_EQ_TOL(objectives[i], (x - 1) * (x - 1), 1e-6);
+        }
+        // 1 + 1 + 2 + 9 simulations.
+        SimTK_TEST(target->getNumEvaluations() == 13);
+        SimTK_TEST(target->getEvaluationsPerSecond() > 0);
+        target->printPerformance(cout);
+    }
+
+    // The original model is not used by the evaluations.
+    SimTK_TEST_EQ(model.getDefaultControls()[0], 0.0);
+
+    // Optimize with the parallel gradient.
+    parallel.resetPerformance();
+    SimTK_TEST(parallel.getNumEvaluations() == 0);
+    parallel.setParameterLimits(SimTK::Vector(1, -10.0),
+                                SimTK::Vector(1, 10.0));
+    SimTK::Optimizer optimizer(parallel, SimTK::LBFGSB);
+    optimizer.useNumericalGradient(false);
+    optimizer.setConvergenceTolerance(1e-8);
+    optimizer.setMaxIterations(50);
+    SimTK::Vector controls(1, 0.0);
+    optimizer.optimize(controls);
+    SimTK_TEST_EQ_TOL(controls[0], 2.0, 1e-3);
+    parallel.printPerformance(cout);
+
+    // Too many parameters for the default applyParameters().
+    ASSERT_THROW(Exception, serial.evaluate(SimTK::Vector(2, 1.0)));
+}
+
+void testCheckpoint()
+{
+    cout << "Running testCheckpoint" << endl;
+    LoadOpenSimLibrary("osimActuators");
+    Model model("arm26.osim");
+    auto* controller = new PrescribedController();
+    controller->setActuators(model.updActuators());
+    for (int i = 0; i < model.getActuators().getSize(); ++i)
+        controller->prescribeControlForActuator(i, new Constant(0.5));
+    model.addController(controller);
+    model.addAnalysis(new Kinematics(&model));
+    auto* reporter = new TableReporter();
+    reporter->setName("reporter");
+    reporter->set_report_time_interval(0.05);
+    reporter->addToReport(
+            model.getCoordinateSet().get("r_elbow_flex").getOutput("value"));
+    model.addComponent(reporter);
+    SimTK::State& initialState = model.initSystem();
+    model.equilibrateMuscles(initialState);
+
+    const double finalTime = 0.4;
+    const std::string file = "testManager_arm26.checkpoint";
+    auto& positions = *dynamic_cast<Kinematics&>(
+            model.updAnalysisSet().get(0)).getPositionStorage();
+
+    // Uninterrupted simulation.
+    Manager uninterrupted(model);
+    uninterrupted.setIntegratorAccuracy(1e-6);
+    uninterrupted.initialize(initialState);
+    auto start = std::chrono::steady_clock::now();
+    const SimTK::Vector finalY = uninterrupted.integrate(finalTime).getY();
+    const double simulationTime = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    const int numStates = uninterrupted.getStateStorage().getSize();
+    const int numPositions = positions.getSize();
+    const TimeSeriesTable report = reporter->getTable();
+
+    // Simulation that stops (as if it crashed) after writing checkpoints.
+    reporter->clearTable();
+    Manager interrupted(model);
+    interrupted.setIntegratorAccuracy(1e-6);
+    ASSERT_THROW(Exception, interrupted.setCheckpointInterval(-1));
+    interrupted.setCheckpointInterval(0.1);
+    interrupted.initialize(initialState);
+    ASSERT_THROW(Exception, interrupted.integrate(0.25));
+    interrupted.setCheckpointFile(file);
+    interrupted.integrate(0.25);
+
+    // Continue from the last checkpoint, near t = 0.2, in a new Manager; the
+    // records of the interrupted simulation are discarded.
+    reporter->clearTable();
+    positions.purge();
+    Manager resumed(model);
+    resumed.setIntegratorAccuracy(1e-6);
+    start = std::chrono::steady_clock::now();
+    resumed.initializeFromCheckpoint(initialState, file);
+    const double restoreTime = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    const double checkpointTime = resumed.getState().getTime();
+    SimTK_TEST(checkpointTime >= 0.2 && checkpointTime < 0.25);
+    ASSERT_THROW(Exception, resumed.writeCheckpoint(file));
+    const SimTK::Vector resumedY = resumed.integrate(finalTime).getY();
+
+    // The integration continues with the same steps.
+    SimTK_TEST_EQ_TOL(resumedY, finalY, 1e-9);
+    SimTK_TEST(resumed.getStateStorage().getSize() == numStates);
+    SimTK_TEST(positions.getSize() == numPositions);
+    const TimeSeriesTable& resumedReport = reporter->getTable();
+    SimTK_TEST(resumedReport.getNumRows() == report.getNumRows());
+    for (size_t i = 0; i < report.getNumRows(); ++i) {
+        SimTK_TEST_EQ(resumedReport.getIndependentColumn()[i],
+                      report.getIndependentColumn()[i]);
+        SimTK_TEST_EQ_TOL(resumedReport.getRowAtIndex(i)[0],
+                          report.getRowAtIndex(i)[0], 1e-9);
+    }
+
+    // Cost of writing and restoring a checkpoint.
+    start = std::chrono::steady_clock::now();
+    resumed.writeCheckpoint(file);
+    const double writeTime = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    std::ifstream checkpoint(file, std::ios::binary | std::ios::ate);
+    cout << "Simulated " << finalTime << " s in " << simulationTime
+         << " s. Checkpoint of " << numStates << " states: "
+         << checkpoint.tellg() << " bytes, written in " << writeTime
+         << " s, restored in " << restoreTime << " s." << endl;
+
+    // Not a checkpoint.
+    Manager other(model);
+    ASSERT_THROW(IOError,
+                 other.initializeFromCheckpoint(initialState, "arm26.osim"));
+}
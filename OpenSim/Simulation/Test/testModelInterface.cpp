@@ -25,13 +25,22 @@
 #include <OpenSim/Simulation/Model/PhysicalOffsetFrame.h>
 #include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/Model/Marker.h>
+#include <OpenSim/Simulation/Model/Muscle.h>
+#include <OpenSim/Simulation/Wrap/WrapCylinder.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
 
 using namespace OpenSim;
 using namespace std;
 
 void testModelFinalizePropertiesAndConnections();
 void testModelTopologyErrors();
+void testPathResolution();
+void testUpdateSystem();
+void testProfiling();
 
 int main() {
     LoadOpenSimLibrary("osimActuators");
@@ -39,6 +48,9 @@ int main() {
     SimTK_START_TEST("testModelInterface");
         SimTK_SUBTEST(testModelFinalizePropertiesAndConnections);
         SimTK_SUBTEST(testModelTopologyErrors);
+        SimTK_SUBTEST(testPathResolution);
+        SimTK_SUBTEST(testUpdateSystem);
+        SimTK_SUBTEST(testProfiling);
     SimTK_END_TEST();
 }
 
@@ -226,6 +238,245 @@ void testModelTopologyErrors()
     ASSERT_THROW(JointFramesHaveSameBaseFrame, degenerate.initSystem());
 }
 
+// Components and state variables found by path are remembered; the results
+// must follow renames and changes to the model.
+void testPathResolution()
+{
+    Model model("arm26.osim");
+    SimTK::State& state = model.initSystem();
+
+    const Body& humerus = model.getComponent<Body>("r_humerus");
+    ASSERT(&model.getComponent<Body>("r_humerus") == &humerus);
+    ASSERT(&model.getComponent<Body>(
+            model.getAbsolutePathString() + "/r_humerus") == &humerus);
+    const Joint& elbow = model.getComponent<Joint>("r_elbow");
+    ASSERT(&elbow.getComponent<Body>("../r_humerus") == &humerus);
+    ASSERT(&elbow.getComponent<Body>("../r_humerus") == &humerus);
+    ASSERT_THROW(ComponentNotFoundOnSpecifiedPath,
+                 model.getComponent<Joint>("r_humerus"));
+
+    // A renamed component is no longer found at its old path.
+    model.updComponent<Body>("r_humerus").setName("humerus");
+    ASSERT_THROW(ComponentNotFoundOnSpecifiedPath,
+                 model.getComponent<Body>("r_humerus"));
+    ASSERT_THROW(ComponentNotFoundOnSpecifiedPath,
+                 elbow.getComponent<Body>("../r_humerus"));
+    ASSERT(&model.getComponent<Body>("humerus") == &humerus);
+    model.updComponent<Body>("humerus").setName("r_humerus");
+    ASSERT(&model.getComponent<Body>("r_humerus") == &humerus);
+    state = model.initSystem();
+
+    // State variables by path.
+    const Coordinate& flexion =
+            model.getComponent<Coordinate>("r_elbow/r_elbow_flex");
+    const std::string path = "r_elbow/r_elbow_flex/value";
+    flexion.setValue(state, 0.3);
+    ASSERT_EQUAL(0.3, model.getStateVariableValue(state, path), 1e-15,
+                 __FILE__, __LINE__, "Wrong value of " + path + ".");
+    model.setStateVariableValue(state, path, 0.4);
+    ASSERT_EQUAL(0.4, flexion.getValue(state), 1e-15, __FILE__, __LINE__,
+                 "Wrong value of " + path + ".");
+
+    // Rebuilding the System recreates the state variables.
+    state = model.initSystem();
+    flexion.setValue(state, 0.5);
+    ASSERT_EQUAL(0.5, model.getStateVariableValue(state, path), 1e-15,
+                 __FILE__, __LINE__, "Wrong value of " + path + ".");
+
+    // Compare the time to get a state variable value by path to the time
+    // taken by the Coordinate accessor.
+    const int n = 100000;
+    double sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i)
+        sum += model.getStateVariableValue(state, path);
+    double pathTime = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i)
+        sum -= flexion.getValue(state);
+    double directTime = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    ASSERT_EQUAL(0.0, sum, 1e-6, __FILE__, __LINE__, "Values differ.");
+    cout << "Get " << path << " " << n << " times: by path " << pathTime
+         << " s, Coordinate::getValue() " << directTime << " s." << endl;
+}
+
+// The tendon force of each muscle of the model, with the muscles in
+// equilibrium.
+std::vector<double> computeMuscleForces(Model& model, SimTK::State& state)
+{
+    model.equilibrateMuscles(state);
+    model.realizeDynamics(state);
+    std::vector<double> forces;
+    for (const auto& muscle : model.getComponentList<Muscle>())
+        forces.push_back(muscle.getTendonForce(state));
+    return forces;
+}
 
+// Compare the muscle forces of the model to those of a copy of the model,
+// whose System is built from scratch.
+void compareToRebuiltModel(Model& model, SimTK::State& state)
+{
+    Model rebuilt(model);
+    SimTK::State& rebuiltState = rebuilt.initSystem();
+    const auto expected = computeMuscleForces(rebuilt, rebuiltState);
+    const auto forces = computeMuscleForces(model, state);
+    ASSERT(forces.size() == expected.size());
+    for (size_t i = 0; i < forces.size(); ++i)
+        ASSERT_EQUAL(expected[i], forces[i],
+                     1e-6*std::max(1.0, std::abs(expected[i])),
+                     __FILE__, __LINE__, "Muscle forces differ.");
+}
 
+void testUpdateSystem()
+{
+    Model model("arm26.osim");
+    model.initSystem();
+    const SimTK::MultibodySystem* system = &model.getMultibodySystem();
+
+    // Without edits, there is nothing to update.
+    SimTK::State* state = &model.updateSystem();
+    ASSERT(&model.getMultibodySystem() == system);
+
+    // Edits of the dimensions of a wrap cylinder are applied to the existing
+    // System.
+    auto& cylinder = *model.updComponentList<WrapCylinder>().begin();
+    cylinder.set_radius(1.2*cylinder.get_radius());
+    state = &model.updateSystem();
+    ASSERT(&model.getMultibodySystem() == system);
+    compareToRebuiltModel(model, *state);
+
+    // A negative radius is still rejected.
+    cylinder.set_radius(-1);
+    ASSERT_THROW(InvalidPropertyValue, model.updateSystem());
+    cylinder.set_radius(0.02);
+    model.updateSystem();
+
+    // Other components cache the maximum isometric forces of the muscles
+    // (e.g., metabolic probes), so editing them rebuilds the System.
+    for (auto& muscle : model.updComponentList<Muscle>())
+        muscle.set_max_isometric_force(1.5*muscle.get_max_isometric_force());
+    state = &model.updateSystem();
+    compareToRebuiltModel(model, *state);
+
+    // Structural edits require the System to be rebuilt.
+    auto& humerus = model.updComponent<Body>("r_humerus");
+    humerus.set_mass(2*humerus.get_mass());
+    state = &model.updateSystem();
+    double mass = 0;
+    for (const auto& body : model.getComponentList<Body>())
+        mass += body.get_mass();
+    ASSERT_EQUAL(mass, model.getTotalMass(*state), 1e-12, __FILE__, __LINE__,
+                 "The mass of the humerus was not updated.");
+    compareToRebuiltModel(model, *state);
+
+    Marker* marker = new Marker("marker", humerus, SimTK::Vec3(0.1, 0, 0));
+    model.addMarker(marker);
+    state = &model.updateSystem();
+    system = &model.getMultibodySystem();
+
+    // A marker can then be moved without rebuilding the System.
+    marker->set_location(SimTK::Vec3(0, -0.2, 0));
+    state = &model.updateSystem();
+    ASSERT(&model.getMultibodySystem() == system);
+    const SimTK::Vec3 expected = humerus.findStationLocationInGround(*state,
+            SimTK::Vec3(0, -0.2, 0));
+    ASSERT_EQUAL(expected, marker->getLocationInGround(*state),
+                 1e-12, __FILE__, __LINE__,
+                 "The location of the marker was not updated.");
+
+    // Time a sweep over the radius of the wrap cylinder, as when calibrating
+    // it, with and without rebuilding the System.
+    const int numSteps = 20;
+    auto sweep = [&](bool rebuild) {
+        double elapsed = 0;
+        for (int i = 0; i < numSteps; ++i) {
+            model.updComponentList<WrapCylinder>().begin()->set_radius(
+                    0.01 + 0.001*i);
+            auto start = std::chrono::steady_clock::now();
+            state = rebuild ? &model.initSystem() : &model.updateSystem();
+            elapsed += std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start).count();
+            computeMuscleForces(model, *state);
+        }
+        return elapsed;
+    };
+    double rebuildTime = sweep(true);
+    double updateTime = sweep(false);
+    compareToRebuiltModel(model, *state);
+    cout << "Sweep of " << numSteps << " wrap cylinder radii: "
+         << "initSystem() " << rebuildTime << " s, updateSystem() "
+         << updateTime << " s." << endl;
+}
 
+void testProfiling()
+{
+    Model model("arm26.osim");
+    ASSERT(!model.getProfilingEnabled());
+    model.setProfilingEnabled(true);
+    SimTK::State& state = model.initSystem();
+    ASSERT(model.getProfilingEnabled());
+    ComponentProfiler& profiler = *model.getProfiler();
+    profiler.setTraceEnabled(true);
+
+    Manager manager(model);
+    state.setTime(0);
+    manager.initialize(state);
+    manager.integrate(0.02);
+
+    const Muscle& muscle = model.getMuscles().get("TRIlong");
+    const GeometryPath& path = muscle.getGeometryPath();
+    path.getOutputValue<double>(manager.getState(), "length");
+
+    auto count = [&](const Component* comp, ComponentProfiler::Event event) {
+        long long total = 0;
+        for (const auto& rec : profiler.getRecords())
+            if ((!comp || rec.componentPath == comp->getAbsolutePathString())
+                    && rec.event == event)
+                total += rec.count;
+        return total;
+    };
+    // Simbody's calls are attributed to the components that handle them.
+    ASSERT(count(&muscle, ComponentProfiler::RealizeTopology) == 1);
+    ASSERT(count(&muscle, ComponentProfiler::ComputeForce) > 0);
+    ASSERT(count(&muscle,
+            ComponentProfiler::ComputeStateVariableDerivatives) > 0);
+    ASSERT(count(&path, ComponentProfiler::ComputePath) > 0);
+    ASSERT(count(&path, ComponentProfiler::EvaluateOutput) == 1);
+    ASSERT(count(nullptr, ComponentProfiler::WrapPathSegment) > 0);
+
+    const auto records = profiler.getRecords();
+    for (size_t i = 1; i < records.size(); ++i)
+        ASSERT(records[i - 1].totalTime >= records[i].totalTime);
+    ASSERT(!profiler.getTotalTimeByComponent().empty());
+
+    std::ostringstream report;
+    profiler.printReport(report, 10);
+    ASSERT(report.str().find("computeForce") != std::string::npos);
+
+    profiler.writeChromeTrace("testProfiling_trace.json");
+    std::ifstream traceFile("testProfiling_trace.json");
+    std::stringstream trace;
+    trace << traceFile.rdbuf();
+    ASSERT(trace.str().find("\"traceEvents\"") != std::string::npos);
+    ASSERT(trace.str().find("\"ph\":\"X\"") != std::string::npos);
+
+    // A copy of the model is not profiled.
+    Model copy(model);
+    ASSERT(!copy.getProfilingEnabled());
+    ASSERT(copy.getMuscles().get("TRIlong").getProfiler() == nullptr);
+
+    // Disabling profiling stops the recording but keeps the profile.
+    const long long numForces = count(&muscle, ComponentProfiler::ComputeForce);
+    model.setProfilingEnabled(false);
+    ASSERT(muscle.getProfiler() == nullptr);
+    manager.integrate(0.04);
+    ASSERT(count(&muscle, ComponentProfiler::ComputeForce) == numForces);
+
+    profiler.clear();
+    ASSERT(profiler.getRecords().empty());
+    profiler.setTraceEnabled(false);
+    ASSERT_THROW(OpenSim::Exception,
+                 profiler.writeChromeTrace("testProfiling_trace.json"));
+}
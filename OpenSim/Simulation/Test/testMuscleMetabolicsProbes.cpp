@@ -800,6 +800,26 @@ void testProbesUsingMillardMuscleSimulation()
     ASSERT(bhargavaTest->isUsingProvidedMass(muscle1->getName()), __FILE__,
         __LINE__, "Bhargava probe should be using provided muscle mass.");
 
+    // Changing a parameter of a muscle changes the output of the probe
+    // without connecting it again.
+    {
+        SimTK::State& state = model.initSystem();
+        model.equilibrateMuscles(state);
+        model.getMultibodySystem().realize(state, SimTK::Stage::Dynamics);
+        const double rate = bhargavaTest->computeProbeInputs(state)[0];
+        bhargavaTest->setActivationConstantFastTwitch(muscle1->getName(),
+                                                      2*133);
+        ASSERT(bhargavaTest->computeProbeInputs(state)[0] > rate, __FILE__,
+            __LINE__, "Bhargava probe ignored the new activation constant.");
+
+        // The same holds for a parameter set through its property.
+        const double rate2 = bhargavaTest->computeProbeInputs(state)[0];
+        bhargavaTest->upd_Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet()
+            .get(muscle1->getName()).set_maintenance_constant_fast_twitch(2*111);
+        ASSERT(bhargavaTest->computeProbeInputs(state)[0] > rate2, __FILE__,
+            __LINE__, "Bhargava probe ignored the new maintenance constant.");
+    }
+
     // Remove a muscle from the probe.
     bhargavaTest->removeMuscle(muscle1->getName());
     model.setup();
@@ -24,9 +24,14 @@
 #include <OpenSim/Simulation/osimSimulation.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
+#include <algorithm>
 #include <random>
+#include <chrono>
+#include <cstdint>
 #include <cstdio>
+#include <fstream>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <OpenSim/Auxiliary/getRSS.h>
 
 using namespace OpenSim;
 using namespace SimTK;
@@ -787,6 +792,180 @@ void testExport() {
             OpenSim::Exception);
 }
 
+// Time taken to access a coordinate value in every state of a trajectory.
+template <typename Trajectory>
+double timeIteration(const Trajectory& trajectory, const Coordinate& coord) {
+    double sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& state : trajectory)
+        sum += coord.getValue(state);
+    double elapsed = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    SimTK_TEST(!SimTK::isNaN(sum));
+    return elapsed;
+}
+
+void testCompactStates() {
+    Model gait("gait2354_simbody.osim");
+    gait.initSystem();
+    auto original = StatesTrajectory::createFromStatesStorage(gait,
+                                                              statesStoFname);
+    const auto& soleus = gait.getMuscles().get("soleus_r");
+
+    // Give each state a different discrete variable value.
+    StatesTrajectory states;
+    CompactStatesTrajectory compact(gait);
+    SimTK_TEST(compact.getNumDiscreteVariables() > 0);
+    for (size_t i = 0; i < original.getSize(); ++i) {
+        SimTK::State state = original[i];
+        soleus.setDiscreteVariableValue(state, "override_actuation",
+                                        10.0 * i);
+        states.append(state);
+        compact.append(state);
+    }
+    SimTK_TEST(compact.getSize() == states.getSize());
+    SimTK_TEST(compact.getNumY() == states[0].getNY());
+
+    auto statesMatch = [&](const CompactStatesTrajectory& other) {
+        SimTK_TEST(other.getSize() == states.getSize());
+        size_t i = 0;
+        for (const auto& state : other) {
+            SimTK_TEST(state.getTime() == states[i].getTime());
+            SimTK_TEST_EQ(state.getY(), states[i].getY());
+            SimTK_TEST(soleus.getDiscreteVariableValue(state,
+                    "override_actuation") == 10.0 * i);
+            ++i;
+        }
+        SimTK_TEST(i == states.getSize());
+    };
+    statesMatch(compact);
+
+    // Random access reuses the scratch state.
+    SimTK_TEST(&compact[0] == &compact.get(compact.getSize() - 1));
+    SimTK_TEST(compact.back().getTime() == states.back().getTime());
+    SimTK_TEST(compact.front().getTime() == states.front().getTime());
+    SimTK_TEST_MUST_THROW_EXC(compact.get(compact.getSize()),
+                              IndexOutOfRange);
+
+    // Appending states that are out of order or inconsistent.
+    {
+        CompactStatesTrajectory copy(compact);
+        SimTK::State state = states.back();
+        state.setTime(states.back().getTime() - 0.01);
+        SimTK_TEST_MUST_THROW(copy.append(state));
+
+        Model arm26("arm26.osim");
+        SimTK::State armState = arm26.initSystem();
+        armState.setTime(10.0);
+        SimTK_TEST_MUST_THROW_EXC(copy.append(armState),
+                                  StatesTrajectory::InconsistentState);
+    }
+
+    // Conversion to and from StatesTrajectory.
+    {
+        const StatesTrajectory full = compact.toStatesTrajectory();
+        SimTK_TEST(full.getSize() == states.getSize());
+        statesMatch(CompactStatesTrajectory::createFromStatesTrajectory(full,
+                                                                    &gait));
+    }
+
+    // Binary file round trip.
+    {
+        const std::string filename = "testStatesTrajectory_compact.bin";
+        compact.write(filename);
+        statesMatch(CompactStatesTrajectory::createFromBinaryFile(gait,
+                                                                  filename));
+        Model arm26("arm26.osim");
+        arm26.initSystem();
+        SimTK_TEST_MUST_THROW_EXC(
+                CompactStatesTrajectory::createFromBinaryFile(arm26, filename),
+                OpenSim::Exception);
+        SimTK_TEST_MUST_THROW_EXC(
+                CompactStatesTrajectory::createFromBinaryFile(gait,
+                                                              statesStoFname),
+                IOError);
+
+        // A corrupt number of states is rejected before any allocation.
+        {
+            std::fstream file(filename,
+                    std::ios::in | std::ios::out | std::ios::binary);
+            const std::uint64_t numStates = std::uint64_t(1) << 60;
+            file.seekp(8); // After the identifier of the format.
+            file.write(reinterpret_cast<const char*>(&numStates),
+                       sizeof(numStates));
+        }
+        SimTK_TEST_MUST_THROW_EXC(
+                CompactStatesTrajectory::createFromBinaryFile(gait, filename),
+                IOError);
+        remove(filename.c_str());
+    }
+
+    // Exported tables are identical to those of StatesTrajectory.
+    {
+        auto expected = states.exportToTable(gait);
+        auto table = compact.exportToTable(gait);
+        SimTK_TEST(table.getColumnLabels() == expected.getColumnLabels());
+        SimTK_TEST(table.getIndependentColumn() ==
+                   expected.getIndependentColumn());
+        SimTK_TEST_EQ(table.getMatrix(), expected.getMatrix());
+
+        std::vector<std::string> columns {"knee_r/knee_angle_r/value",
+                                          "soleus_r/activation"};
+        tableAndTrajectoryMatch(gait, compact.exportToTable(gait, columns),
+                                states, columns);
+
+        Model arm26("arm26.osim");
+        arm26.initSystem();
+        SimTK_TEST_MUST_THROW_EXC(compact.exportToTable(arm26),
+                                  StatesTrajectory::IncompatibleModel);
+        SimTK_TEST_MUST_THROW_EXC(
+                compact.exportToTable(gait, {"not_an_actual_state"}),
+                OpenSim::Exception);
+    }
+
+    // Compare the memory used and the time to iterate through a long
+    // trajectory.
+    const int numStates = 2000;
+    const auto& coord = gait.getCoordinateSet().get("knee_angle_r");
+
+    size_t memoryBefore = getCurrentRSS();
+    StatesTrajectory longStates;
+    {
+        SimTK::State state = states[0];
+        for (int i = 0; i < numStates; ++i) {
+            state.setTime(0.001 * i);
+            state.updY() = states[i % states.getSize()].getY();
+            longStates.append(state);
+        }
+    }
+    size_t fullMemory =
+            std::max(getCurrentRSS(), memoryBefore) - memoryBefore;
+    memoryBefore = getCurrentRSS();
+    auto longCompact = CompactStatesTrajectory::createFromStatesTrajectory(
+            longStates, &gait);
+    size_t compactMemory =
+            std::max(getCurrentRSS(), memoryBefore) - memoryBefore;
+    SimTK_TEST(longCompact.getSize() == longStates.getSize());
+
+    double fullTime = timeIteration(longStates, coord);
+    double compactTime = timeIteration(longCompact, coord);
+
+    std::cout << "Trajectory of " << numStates << " states of gait2354:"
+              << std::endl;
+    if (fullMemory > 0) {
+        std::cout << "  StatesTrajectory:        " << fullMemory / 1024
+                  << " kB resident" << std::endl;
+        std::cout << "  CompactStatesTrajectory: " << compactMemory / 1024
+                  << " kB resident" << std::endl;
+    }
+    std::cout << "  CompactStatesTrajectory stores "
+              << longCompact.getMemoryUsage() / 1024 << " kB of values."
+              << std::endl;
+    std::cout << "  iteration: StatesTrajectory " << fullTime
+              << " s, CompactStatesTrajectory " << compactTime << " s"
+              << std::endl;
+}
+
 int main() {
     SimTK_START_TEST("testStatesTrajectory");
 
@@ -822,5 +1001,8 @@ int main() {
         // Export to data table.
         SimTK_SUBTEST(testExport);
 
+        // Compact trajectory.
+        SimTK_SUBTEST(testCompactStates);
+
     SimTK_END_TEST();
 }
@@ -118,6 +118,25 @@ void WrapCylinder::extendFinalizeFromProperties()
     Super::extendFinalizeFromProperties();
 
     // maybe set a parent pointer, _body = aBody;
+    checkDimensions();
+}
+
+bool WrapCylinder::canUpdateSystemForProperty(const std::string& name) const
+{
+    return name == "radius" || name == "length" ||
+            Super::canUpdateSystemForProperty(name);
+}
+
+void WrapCylinder::extendUpdateSystemFromProperties(
+        const std::vector<std::string>& changedProperties)
+{
+    Super::extendUpdateSystemFromProperties(changedProperties);
+
+    checkDimensions();
+}
+
+void WrapCylinder::checkDimensions() const
+{
     OPENSIM_THROW_IF_FRMOBJ(
         get_radius() < 0,
         InvalidPropertyValue,
@@ -75,8 +75,15 @@ protected:
 
     void extendFinalizeFromProperties() override;
 
+    /** The radius and length are only used to wrap paths and to draw the
+    cylinder, so they can be changed without rebuilding the System. */
+    bool canUpdateSystemForProperty(const std::string& name) const override;
+    void extendUpdateSystemFromProperties(
+            const std::vector<std::string>& changedProperties) override;
+
 private:
     void constructProperties();
+    void checkDimensions() const;
 
     void _make_spiral_path(SimTK::Vec3& aPoint1, SimTK::Vec3& aPoint2,
                                                  bool far_side_wrap,WrapResult& aWrapResult) const;
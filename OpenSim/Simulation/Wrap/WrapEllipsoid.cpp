@@ -32,6 +32,8 @@
 #include <OpenSim/Common/ModelDisplayHints.h>
 #include <OpenSim/Common/ScaleSet.h>
 
+#include <algorithm>
+
 //=============================================================================
 // STATICS
 //=============================================================================
@@ -48,6 +50,8 @@ static const char* wrapTypeName = "ellipsoid";
 #define NUM_DISPLAY_SAMPLES   30
 #define N_STEPS               16
 #define SV_BOUNDARY_BLEND     0.3
+#define NUM_CLOSEST_POINT_ITERATIONS 8 // bounded solver: Newton iterations per closest point
+#define CLOSEST_POINT_BLOCK_SIZE     8 // bounded solver: closest points solved together
 
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
@@ -96,6 +100,7 @@ WrapEllipsoid::WrapEllipsoid(const WrapEllipsoid& aWrapEllipsoid) :
 */
 void WrapEllipsoid::setNull()
 {
+    _useBoundedSolver = false;
 }
 
 //_____________________________________________________________________________
@@ -171,6 +176,7 @@ void WrapEllipsoid::extendScale(const SimTK::State& s, const ScaleSet& scaleSet)
 void WrapEllipsoid::copyData(const WrapEllipsoid& aWrapEllipsoid)
 {
     _dimensions = aWrapEllipsoid._dimensions;
+    _useBoundedSolver = aWrapEllipsoid._useBoundedSolver;
 }
 
 //_____________________________________________________________________________
@@ -469,24 +475,56 @@ int WrapEllipsoid::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::
             for (i = 0; i < 3; i++)
                 t_sv[2][i] = aWrapResult.r1[i] + 0.5 * r1r2[i];
 
-            for (i = 1; i < NUM_FAN_SAMPLES - 1; i++)
+            if (_useBoundedSolver)
+            {
+                // Find the closest points for all of the samples together,
+                // then add up the normalized fan blade vectors.
+                const int numSamples = NUM_FAN_SAMPLES - 2;
+                double px[numSamples], py[numSamples], pz[numSamples];
+                double cx[numSamples], cy[numSamples], cz[numSamples];
+
+                for (i = 0; i < numSamples; i++)
+                {
+                    double tt = (double) (i + 1) / NUM_FAN_SAMPLES;
+
+                    px[i] = aWrapResult.r1[0] + tt * r1r2[0];
+                    py[i] = aWrapResult.r1[1] + tt * r1r2[1];
+                    pz[i] = aWrapResult.r1[2] + tt * r1r2[2];
+                }
+
+                findClosestPoints(a, numSamples, px, py, pz, cx, cy, cz);
+
+                for (i = 0; i < numSamples; i++)
+                {
+                    double dx = cx[i] - px[i], dy = cy[i] - py[i], dz = cz[i] - pz[i];
+                    double scale = 1.0 / sqrt(dx*dx + dy*dy + dz*dz);
+
+                    v_sum[0] += dx * scale;
+                    v_sum[1] += dy * scale;
+                    v_sum[2] += dz * scale;
+                }
+            }
+            else
             {
-                SimTK::Vec3 v;
-                double tt = (double) i / NUM_FAN_SAMPLES;
+                for (i = 1; i < NUM_FAN_SAMPLES - 1; i++)
+                {
+                    SimTK::Vec3 v;
+                    double tt = (double) i / NUM_FAN_SAMPLES;
 
-                for (j = 0; j < 3; j++)
-                    t_sv[0][j] = aWrapResult.r1[j] + tt * r1r2[j];
+                    for (j = 0; j < 3; j++)
+                        t_sv[0][j] = aWrapResult.r1[j] + tt * r1r2[j];
 
-                findClosestPoint(a[0], a[1], a[2], t_sv[0][0], t_sv[0][1], t_sv[0][2], &t_c1[0][0], &t_c1[0][1], &t_c1[0][2]);
+                    findClosestPoint(a[0], a[1], a[2], t_sv[0][0], t_sv[0][1], t_sv[0][2], &t_c1[0][0], &t_c1[0][1], &t_c1[0][2]);
 
-                MAKE_3DVECTOR21(t_c1[0], t_sv[0], v);
+                    MAKE_3DVECTOR21(t_c1[0], t_sv[0], v);
 
-                Mtx::Normalize(3, v, v);
+                    Mtx::Normalize(3, v, v);
 
-                // add sv->c1 "fan blade" vector to the running total
-                for (j = 0; j < 3; j++)
-                    v_sum[j] += v[j];
+                    // add sv->c1 "fan blade" vector to the running total
+                    for (j = 0; j < 3; j++)
+                        v_sum[j] += v[j];
 
+                }
             }
             // use vector sum to determine c1
             Mtx::Normalize(3, v_sum, v_sum);
@@ -656,7 +694,8 @@ calc_wrap_path:
  * Adjust a point (r1) such that the point remains in
  * a specified plane (vs, vs4), and creates a tangent line segment connecting
  * it to a specified point (p1) outside of the ellipsoid. All quantities
- * are normalized.
+ * are normalized. If the bounded solver is in use, this calls
+ * calcTangentPointBounded() instead.
  *
  * @param p1e Ellipsoid parameter for 'p1'?
  * @param r1 Point to be adjusted to satisfy tangency-within-a-plane constraint
@@ -675,6 +714,9 @@ int WrapEllipsoid::calcTangentPoint(double p1e, SimTK::Vec3& r1, SimTK::Vec3& p1
     double d1, v[4], ee[4], ssqo, ssq, pcos, dedth[4][4];
     double fakt, alpha=0.01, dedth2[4][4], diag[4], ddinv2[4][4], vt[4], dd;
 
+    if (_useBoundedSolver)
+        return calcTangentPointBounded(p1e, r1, p1, m, a, vs, vs4);
+
     if (fabs(p1e) < 0.0001)
     {
         for (i = 0; i < 3; i++)
@@ -1034,6 +1076,8 @@ void WrapEllipsoid::CalcDistanceOnEllipsoid(SimTK::Vec3& r1, SimTK::Vec3& r2, Si
  * Output:  Closest point (x,y,z) on ellipsoid to (u,v,w), function returns
  *          the distance sqrt((x-u)^2+(y-v)^2+(z-w)^2).
  *
+ * If the bounded solver is in use, this calls findClosestPoints() instead.
+ *
  * @param a X dimension of the ellipsoid
  * @param b Y dimension of the ellipsoid
  * @param c Z dimension of the ellipsoid
@@ -1056,6 +1100,12 @@ double WrapEllipsoid::findClosestPoint(double a, double b, double c,
     // is not stable for points near the coordinate planes.  The first part
     // of this code handles those points separately.
     int i,j;
+
+    if (_useBoundedSolver)
+    {
+        findClosestPoints(Vec3(a, b, c), 1, &u, &v, &w, x, y, z, specialCaseAxis);
+        return sqrt(SQR(*x - u) + SQR(*y - v) + SQR(*z - w));
+    }
     
     // handle points near the coordinate planes by reducing the problem
     // to a 2-dimensional pt-to-ellipse.
@@ -1292,6 +1342,229 @@ double WrapEllipsoid::closestPointToEllipse(double a, double b, double u,
 
     return sqrt(dx*dx + dy*dy);
 }
+
+//_____________________________________________________________________________
+/**
+ * Calculate the points on an ellipsoid that are closest to each of n points
+ * in 3D space, with a fixed amount of work per point. This is the bounded
+ * solver's version of findClosestPoint().
+ *
+ * The closest point (x,y,z) to (u,v,w) is (a^2 u/(t+a^2), b^2 v/(t+b^2),
+ * c^2 w/(t+c^2)), where t is the largest root of
+ * F(t) = (a u/(t+a^2))^2 + (b v/(t+b^2))^2 + (c w/(t+c^2))^2 - 1.
+ * F is decreasing and convex to the right of its poles, and F >= 0 at
+ * t0 = max(a|u| - a^2, b|v| - b^2, c|w| - c^2), so Newton's method from t0
+ * increases monotonically to the root without overshooting; a fixed number of
+ * iterations converges to roundoff. The point is then scaled onto the surface.
+ * The points are solved in blocks whose inner loops have no branches, so that
+ * the compiler can vectorize them. Points near a coordinate plane are handled
+ * as in findClosestPoint(): the problem is reduced to the elliptical
+ * cross-section in that plane.
+ *
+ * @param a Dimensions of the ellipsoid
+ * @param n Number of points
+ * @param u X coordinates of the points in space
+ * @param v Y coordinates of the points in space
+ * @param w Z coordinates of the points in space
+ * @param x X coordinates of the closest points
+ * @param y Y coordinates of the closest points
+ * @param z Z coordinates of the closest points
+ * @param specialCaseAxis For dealing with uvw points near a major axis
+ */
+void WrapEllipsoid::findClosestPoints(const SimTK::Vec3& a, int n,
+                                      const double u[], const double v[], const double w[],
+                                      double x[], double y[], double z[],
+                                      int specialCaseAxis) const
+{
+    const double a2[3] = { a[0]*a[0], a[1]*a[1], a[2]*a[2] };
+    const double* p[3] = { u, v, w };
+    double* q[3] = { x, y, z };
+    double ap[3][CLOSEST_POINT_BLOCK_SIZE], t[CLOSEST_POINT_BLOCK_SIZE];
+    int axis[CLOSEST_POINT_BLOCK_SIZE];
+    int i, k, iter, first, size;
+
+    for (first = 0; first < n; first += CLOSEST_POINT_BLOCK_SIZE)
+    {
+        size = std::min(CLOSEST_POINT_BLOCK_SIZE, n - first);
+
+        for (k = 0; k < size; k++)
+        {
+            // if uvw is close to more than one coordinate plane, use the
+            // elliptical cross-section with the narrowest radius.
+            axis[k] = specialCaseAxis;
+
+            if (axis[k] < 0)
+            {
+                double minEllipseRadiiSum = SimTK::Infinity;
+
+                for (i = 0; i < 3; i++)
+                {
+                    double ellipseRadiiSum = a[0] + a[1] + a[2] - a[i];
+
+                    if (EQUAL_WITHIN_ERROR(0.0, p[i][first + k]) &&
+                        ellipseRadiiSum < minEllipseRadiiSum)
+                    {
+                        axis[k] = i;
+                        minEllipseRadiiSum = ellipseRadiiSum;
+                    }
+                }
+            }
+
+            // Leave the special-case axis out of the problem. Move the point
+            // slightly off of any other coordinate plane, so that a point
+            // inside the ellipsoid that is closest to the end of an axis
+            // does not end up on the plane.
+            t[k] = -SimTK::Infinity;
+
+            for (i = 0; i < 3; i++)
+            {
+                double pi = p[i][first + k];
+
+                if (i == axis[k])
+                    pi = 0.0;
+                else if (EQUAL_WITHIN_ERROR(0.0, pi))
+                    pi = (pi < 0.0 ? -ROUNDOFF_ERROR : ROUNDOFF_ERROR);
+
+                ap[i][k] = a[i] * pi;
+
+                if (i != axis[k])
+                    t[k] = std::max(t[k], fabs(ap[i][k]) - a2[i]);
+            }
+        }
+
+        // fill the rest of the last block with a point that is easy to solve
+        for (k = size; k < CLOSEST_POINT_BLOCK_SIZE; k++)
+        {
+            ap[0][k] = a2[0];
+            ap[1][k] = ap[2][k] = 0.0;
+            t[k] = 0.0;
+        }
+
+        for (iter = 0; iter < NUM_CLOSEST_POINT_ITERATIONS; iter++)
+        {
+            for (k = 0; k < CLOSEST_POINT_BLOCK_SIZE; k++)
+            {
+                // The term for the special-case axis is zero; keep its
+                // denominator positive.
+                double P = std::max(t[k] + a2[0], SimTK::TinyReal);
+                double Q = std::max(t[k] + a2[1], SimTK::TinyReal);
+                double R = std::max(t[k] + a2[2], SimTK::TinyReal);
+                double fu = ap[0][k] / P, fv = ap[1][k] / Q, fw = ap[2][k] / R;
+                double f = fu*fu + fv*fv + fw*fw - 1.0;
+                double fp = fu*fu / P + fv*fv / Q + fw*fw / R;
+
+                t[k] += 0.5 * f / fp;
+            }
+        }
+
+        for (k = 0; k < size; k++)
+        {
+            double c[3], scale = 0.0;
+
+            for (i = 0; i < 3; i++)
+            {
+                c[i] = a[i] * ap[i][k] / std::max(t[k] + a2[i], SimTK::TinyReal);
+                scale += SQR(c[i] / a[i]);
+            }
+
+            scale = 1.0 / sqrt(scale);
+
+            for (i = 0; i < 3; i++)
+                q[i][first + k] = (i == axis[k] ? p[i][first + k] : c[i] * scale);
+        }
+    }
+}
+
+//_____________________________________________________________________________
+/**
+ * Calculate the point (r1) in a specified plane (vs, vs4) at which a line
+ * segment from a specified point (p1) outside of the ellipsoid is tangent to
+ * the ellipsoid. This is the bounded solver's version of calcTangentPoint(),
+ * and uses the same normalized quantities.
+ *
+ * The points at which lines from p1 are tangent to the ellipsoid lie in the
+ * polar plane of p1, sum((r[i]-m[i]) * (p1[i]-m[i]) / a[i]^2) = 1, so the
+ * tangent points in the plane (vs, vs4) are where the line along which the
+ * two planes intersect meets the ellipsoid. Of these two points, r1 is set to
+ * the one nearest to its current value (c1), from which calcTangentPoint()
+ * starts its search.
+ *
+ * @param p1e Ellipsoid parameter for 'p1'
+ * @param r1 Starting point, set to the tangent point
+ * @param p1 Point outside of ellipsoid
+ * @param m Ellipsoid origin
+ * @param a Ellipsoid axis
+ * @param vs Plane vector
+ * @param vs4 Plane coefficient
+ * @return '1' if the point was adjusted, '0' otherwise
+ */
+int WrapEllipsoid::calcTangentPointBounded(double p1e, SimTK::Vec3& r1,
+    const SimTK::Vec3& p1, const SimTK::Vec3& m, const SimTK::Vec3& a,
+    const SimTK::Vec3& vs, double vs4) const
+{
+    int i;
+    Vec3 np, dir, np_dir, dir_vs, r0;
+    double dd, h1, h2, aa, bb, cc, disc, s0, s1, s2;
+
+    if (fabs(p1e) < 0.0001)
+    {
+        for (i = 0; i < 3; i++)
+            r1[i] = p1[i];
+
+        return 1;
+    }
+
+    // normal of the polar plane of p1
+    for (i = 0; i < 3; i++)
+        np[i] = (p1[i] - m[i]) / SQR(a[i]);
+
+    Mtx::CrossProduct(vs, np, dir);
+    dd = Mtx::DotProduct(3, dir, dir);
+
+    // the planes are parallel; leave r1 where it is
+    if (dd < ELLIPSOID_TINY * ELLIPSOID_TINY)
+        return 0;
+
+    // r0: the point on the line of intersection closest to the origin
+    h1 = -vs4;
+    h2 = 1.0 + Mtx::DotProduct(3, np, m);
+    Mtx::CrossProduct(np, dir, np_dir);
+    Mtx::CrossProduct(dir, vs, dir_vs);
+
+    for (i = 0; i < 3; i++)
+        r0[i] = (h1 * np_dir[i] + h2 * dir_vs[i]) / dd;
+
+    // intersect r0 + s * dir with the ellipsoid
+    aa = 0.0;
+    bb = 0.0;
+    cc = -1.0;
+
+    for (i = 0; i < 3; i++)
+    {
+        aa += SQR(dir[i] / a[i]);
+        bb += 2.0 * (r0[i] - m[i]) * dir[i] / SQR(a[i]);
+        cc += SQR((r0[i] - m[i]) / a[i]);
+    }
+
+    // if the line just misses the ellipsoid, use the point where it is
+    // closest to it
+    disc = std::max(SQR(bb) - 4.0 * aa * cc, 0.0);
+    s1 = (-bb + sqrt(disc)) / (2.0 * aa);
+    s2 = (-bb - sqrt(disc)) / (2.0 * aa);
+
+    s0 = 0.0;
+    for (i = 0; i < 3; i++)
+        s0 += (r1[i] - r0[i]) * dir[i] / dd;
+
+    if (fabs(s2 - s0) < fabs(s1 - s0))
+        s1 = s2;
+
+    for (i = 0; i < 3; i++)
+        r1[i] = r0[i] + s1 * dir[i];
+
+    return 1;
+}
+
 // Implement generateDecorations by WrapEllipsoid to replace the previous out of place implementation 
 // in ModelVisualizer
 void WrapEllipsoid::generateDecorations(bool fixed, const ModelDisplayHints& hints, const SimTK::State& state,
@@ -60,6 +60,9 @@ protected:
     PropertyDblArray _dimensionsProp;
     Array<double>& _dimensions;
 
+    // Whether wrapLine() uses the bounded-iteration solver.
+    bool _useBoundedSolver;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -79,6 +82,20 @@ public:
     std::string getDimensionsString() const override;
         SimTK::Vec3 getRadii() const;
 
+    /** Use a solver whose cost does not depend on the configuration of the
+    path (default: false). The default solver searches for each of the closest
+    points that define the wrapping plane, and for each tangent point, with
+    iterations that stop once converged, so its cost can vary by orders of
+    magnitude from one configuration to the next. The bounded solver instead
+    finds the closest points with a fixed number of Newton iterations over
+    blocks of points, which the compiler can vectorize, and computes the
+    tangent points in closed form. The resulting paths agree with those of the
+    default solver to within its convergence tolerance. This is not a property
+    and is not serialized. */
+    void setUseBoundedSolver(bool useBoundedSolver)
+    {   _useBoundedSolver = useBoundedSolver; }
+    bool getUseBoundedSolver() const { return _useBoundedSolver; }
+
     /** Scale the ellipsoid's dimensions. The base class (WrapObject) scales the
         origin of the ellipsoid in the body's reference frame. */
     void extendScale(const SimTK::State& s, const ScaleSet& scaleSet) override;
@@ -106,6 +123,12 @@ private:
         int specialCaseAxis = -1) const;
     double closestPointToEllipse(double a, double b, double u,
         double v, double* x, double* y) const;
+    void findClosestPoints(const SimTK::Vec3& a, int n,
+        const double u[], const double v[], const double w[],
+        double x[], double y[], double z[], int specialCaseAxis = -1) const;
+    int calcTangentPointBounded(double p1e, SimTK::Vec3& r1,
+        const SimTK::Vec3& p1, const SimTK::Vec3& m, const SimTK::Vec3& a,
+        const SimTK::Vec3& vs, double vs4) const;
 //=============================================================================
 };  // END of class WrapEllipsoid
 //=============================================================================
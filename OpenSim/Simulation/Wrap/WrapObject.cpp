@@ -145,6 +145,8 @@ int WrapObject::wrapPathSegment(const SimTK::State& s,
                                 const PathWrap& aPathWrap, 
                                 WrapResult& aWrapResult) const
 {
+    ComponentProfiler::Scope scope(getProfiler(), *this,
+                                   ComponentProfiler::WrapPathSegment);
    int return_code = noWrap;
     bool p_flag;
     Vec3 pt1(0.0);
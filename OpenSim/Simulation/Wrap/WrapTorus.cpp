@@ -34,6 +34,8 @@
 #include <OpenSim/Simulation/Model/PhysicalFrame.h>
 #include <OpenSim/Common/ScaleSet.h>
 
+#include <algorithm>
+
 //=============================================================================
 // STATICS
 //=============================================================================
@@ -44,6 +46,7 @@ using SimTK::Vec3;
 static const char* wrapTypeName = "torus";
 
 #define CYL_LENGTH 10000.0
+#define NUM_CIRCLE_ITERATIONS 12 // bounded solver: Newton iterations per pass
 
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
@@ -95,6 +98,7 @@ WrapTorus::WrapTorus(const WrapTorus& aWrapTorus) :
  */
 void WrapTorus::setNull()
 {
+    _useBoundedSolver = false;
 }
 
 //_____________________________________________________________________________
@@ -181,6 +185,7 @@ void WrapTorus::copyData(const WrapTorus& aWrapTorus)
 {
     _innerRadius = aWrapTorus._innerRadius;
     _outerRadius = aWrapTorus._outerRadius;
+    _useBoundedSolver = aWrapTorus._useBoundedSolver;
 }
 
 //_____________________________________________________________________________
@@ -358,10 +363,13 @@ int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
 
    q[0] = 0.0;
 
-   lmdif_C(calcCircleResids, numResid, numQs, q, resid,
-           ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
-           nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
-           wa1, wa2, wa3, wa4, (void*)&cb);
+   if (_useBoundedSolver)
+      q[0] = findCircleResidRoot(cb);
+   else
+      lmdif_C(calcCircleResids, numResid, numQs, q, resid,
+              ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
+              nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
+              wa1, wa2, wa3, wa4, (void*)&cb);
 
    u = q[0];
 
@@ -393,10 +401,13 @@ int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
 
    q[0] = 0.0;
 
-   lmdif_C(calcCircleResids, numResid, numQs, q, resid,
-           ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
-           nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
-           wa1, wa2, wa3, wa4, (void*)&cb);
+   if (_useBoundedSolver)
+      q[0] = findCircleResidRoot(cb);
+   else
+      lmdif_C(calcCircleResids, numResid, numQs, q, resid,
+              ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
+              nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
+              wa1, wa2, wa3, wa4, (void*)&cb);
 
    u = q[0];
 
@@ -510,6 +521,56 @@ void WrapTorus::calcCircleResids(int numResid, int numQs, double q[],
 }
 
 
+//_____________________________________________________________________________
+/**
+ * Find the distance along the line from p1 toward p2 at which the residual
+ * calculated by calcCircleResids() is zero, using a fixed number of Newton
+ * iterations. This is the bounded solver's replacement for lmdif_C() in
+ * findClosestPoint(). Like lmdif_C(), it starts at p1; each step is limited
+ * to the length of the line segment. The residual is the derivative of the
+ * squared distance from the line to a circle of twice the radius; the same
+ * residual is used here so that both solvers choose the same point.
+ *
+ * @param cb Data structure containing the line and circle radius
+ * @return The distance along the line from p1
+ */
+double WrapTorus::findCircleResidRoot(const CircleCallback& cb)
+{
+   double mag, nx, ny, nz, u, c2, c3, c4, c5;
+   double rho, drho, resid, dresid, step;
+   int i;
+
+   mag = sqrt((cb.p2[0]-cb.p1[0])*(cb.p2[0]-cb.p1[0]) + (cb.p2[1]-cb.p1[1])*(cb.p2[1]-cb.p1[1]) +
+      (cb.p2[2]-cb.p1[2])*(cb.p2[2]-cb.p1[2]));
+
+   nx = (cb.p2[0]-cb.p1[0]) / mag;
+   ny = (cb.p2[1]-cb.p1[1]) / mag;
+   nz = (cb.p2[2]-cb.p1[2]) / mag;
+
+   c2 = 2.0 * (cb.p1[0]*nx + cb.p1[1]*ny + cb.p1[2]*nz);
+   c3 = cb.p1[0]*nx + cb.p1[1]*ny;
+   c4 = nx*nx + ny*ny;
+   c5 = cb.p1[0]*cb.p1[0] + cb.p1[1]*cb.p1[1];
+
+   u = 0.0;
+
+   for (i = 0; i < NUM_CIRCLE_ITERATIONS; i++)
+   {
+      // rho is the distance from the point on the line to the Z axis
+      rho = sqrt(std::max(u * u * c4 + 2.0 * c3 * u + c5, SimTK::TinyReal));
+      drho = (c4 * u + c3) / rho;
+
+      resid = c2 + 2.0 * u - 4.0 * cb.r * drho;
+      dresid = 2.0 - 4.0 * cb.r * (c4 - drho * drho) / rho;
+
+      step = (dresid != 0.0 ? -resid / dresid : 0.0);
+      u += std::max(-mag, std::min(mag, step));
+   }
+
+   return u;
+}
+
+
 // Implement generateDecorations by WrapTorus to replace the previous out of place implementation 
 // in ModelVisualizer, not implemented yet in API visualizer
 void WrapTorus::generateDecorations(bool fixed, const ModelDisplayHints& hints, const SimTK::State& state,
@@ -60,6 +60,9 @@ private:
     PropertyDbl _outerRadiusProp;
     double& _outerRadius;
 
+    // Whether wrapLine() uses the bounded-iteration solver.
+    bool _useBoundedSolver;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -80,6 +83,17 @@ public:
     SimTK::Real getInnerRadius() const;
     SimTK::Real getOuterRadius() const;
 
+    /** Use a solver whose cost does not depend on the configuration of the
+    path (default: false). The default solver finds the point on the circle
+    at the center of the torus's tube that is closest to the path with the
+    Levenberg-Marquardt solver, whose number of iterations varies from one
+    configuration to the next. The bounded solver instead uses a fixed number
+    of Newton iterations from the same starting points. This is not a
+    property and is not serialized. */
+    void setUseBoundedSolver(bool useBoundedSolver)
+    {   _useBoundedSolver = useBoundedSolver; }
+    bool getUseBoundedSolver() const { return _useBoundedSolver; }
+
     /** Scale the torus's dimensions. The base class (WrapObject) scales the
         origin of the torus in the body's reference frame. */
     void extendScale(const SimTK::State& s, const ScaleSet& scaleSet) override;
@@ -100,6 +114,7 @@ private:
         int wrap_sign, int wrap_axis) const;
     static void calcCircleResids(int numResid, int numQs, double q[],
         double resid[], int *flag2, void *ptr);
+    static double findCircleResidRoot(const CircleCallback& cb);
 
 //=============================================================================
 };  // END of class WrapTorus
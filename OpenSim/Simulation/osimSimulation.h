@@ -119,6 +119,8 @@
 #include "Reference.h"
 #include "Solver.h"
 #include "StatesTrajectory.h"
+#include "CompactStatesTrajectory.h"
+#include "SimulationOptimizationTarget.h"
 #include "StatesTrajectoryReporter.h"
 
 #include "SimulationUtilities.h"
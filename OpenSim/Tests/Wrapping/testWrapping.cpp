@@ -28,6 +28,7 @@
 #include "simbody/internal/CablePath.h"
 #include "simbody/internal/Force_Custom.h"
 
+#include <chrono>
 #include <set>
 #include <string>
 #include <iostream>
@@ -48,6 +49,8 @@ public:
 
 void testWrapCylinder();
 void testWrapObjectUpdateFromXMLNode30515();
+void testWrapEllipsoidBoundedSolver();
+void testWrapTorusBoundedSolver();
 void simulate(Model& osimModel, State& si, double initialTime, double finalTime);
 void simulateModelWithMusclesNoViz(const string &modelFile, double finalTime, double activation=0.5);
 void simulateModelWithPassiveMuscles(const string &modelFile, double finalTime);
@@ -74,6 +77,20 @@ int main()
          failures.push_back("testWrapObjectUpdateFromXMLNode30515");
     }
 
+    try{
+        testWrapEllipsoidBoundedSolver();
+    } catch (const std::exception& e) {
+         std::cout << "Exception: " << e.what() << std::endl;
+         failures.push_back("testWrapEllipsoidBoundedSolver");
+    }
+
+    try{
+        testWrapTorusBoundedSolver();
+    } catch (const std::exception& e) {
+         std::cout << "Exception: " << e.what() << std::endl;
+         failures.push_back("testWrapTorusBoundedSolver");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -405,6 +422,134 @@ void testWrapCylinder()
 }
 
 
+// Build a model with a spring from a point on ground to a point on a body that
+// rotates about ground's Z axis, wrapping over the given wrap object on ground.
+void buildWrappingModel(Model& model, WrapObject* wrapObject,
+        const Vec3& originInGround, const Vec3& insertionInBody)
+{
+    auto body = new OpenSim::Body("body", 1, Vec3(0), Inertia(0.1, 0.1, 0.01));
+    model.addComponent(body);
+
+    auto joint = new PinJoint("pin", model.getGround(), *body);
+    model.addComponent(joint);
+
+    model.updGround().addWrapObject(wrapObject);
+
+    PathSpring* spring = new PathSpring("spring", 1.0, 0.1, 0.01);
+    spring->updGeometryPath().
+        appendNewPathPoint("origin", model.updGround(), originInGround);
+    spring->updGeometryPath().
+        appendNewPathPoint("insert", *body, insertionInBody);
+    spring->updGeometryPath().addPathWrap(*wrapObject);
+    model.addComponent(spring);
+}
+
+// Compute the length of the model's spring at each of the given angles of its
+// pin joint. Each path is computed a few times; the fastest is taken as the
+// time to compute that path. Returns the longest of these times and sets
+// meanTime to their mean (both in seconds).
+double computeWrappedLengths(Model& model, const std::vector<double>& angles,
+        std::vector<double>& lengths, double& meanTime)
+{
+    const int numRepeats = 3;
+    SimTK::State& s = model.initSystem();
+    const auto& coord = model.getComponent<PinJoint>("pin").getCoordinate();
+    const auto& spring = model.getComponent<PathSpring>("spring");
+
+    lengths.clear();
+    meanTime = 0;
+    double worstTime = 0;
+    for (double angle : angles) {
+        double length = SimTK::NaN;
+        double time = SimTK::Infinity;
+        for (int r = 0; r < numRepeats; ++r) {
+            // Invalidates the path.
+            coord.setValue(s, angle);
+            const auto start = std::chrono::steady_clock::now();
+            model.realizePosition(s);
+            length = spring.getLength(s);
+            time = std::min(time, std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start).count());
+        }
+        lengths.push_back(length);
+        meanTime += time / angles.size();
+        worstTime = std::max(worstTime, time);
+    }
+    return worstTime;
+}
+
+void testWrapEllipsoidBoundedSolver()
+{
+    const double dimensions[] = { 0.05, 0.08, 0.06 };
+    const Vec3 origin(-0.15, 0.02, 0.01);
+    const Vec3 insertion(0.15, 0.03, -0.01);
+
+    std::vector<double> angles;
+    for (int i = 0; i <= 200; ++i)
+        angles.push_back(-SimTK::Pi/2 + i*SimTK::Pi/200);
+
+    std::vector<double> lengths[2];
+    double meanTime[2], worstTime[2];
+    for (int b = 0; b < 2; ++b) {
+        Model model;
+        model.setName("testWrapEllipsoidBoundedSolver");
+        WrapEllipsoid* ellipsoid = new WrapEllipsoid();
+        ellipsoid->setName("ellipsoid");
+        ellipsoid->getPropertySet().get("dimensions")->
+            setValue(3, dimensions);
+        ellipsoid->setUseBoundedSolver(b == 1);
+        buildWrappingModel(model, ellipsoid, origin, insertion);
+        worstTime[b] =
+            computeWrappedLengths(model, angles, lengths[b], meanTime[b]);
+    }
+
+    // The two solvers find tangent points to within the reference solver's
+    // tolerances, which are looser than those of the bounded solver.
+    for (size_t i = 0; i < angles.size(); ++i)
+        ASSERT_EQUAL<double>(lengths[0][i], lengths[1][i], 5e-4);
+
+    cout << "WrapEllipsoid path time (us), mean / worst case:" << endl;
+    cout << "  reference: " << 1e6*meanTime[0] << " / " << 1e6*worstTime[0]
+         << endl;
+    cout << "  bounded:   " << 1e6*meanTime[1] << " / " << 1e6*worstTime[1]
+         << endl;
+}
+
+void testWrapTorusBoundedSolver()
+{
+    // The path threads the torus's hole.
+    const Vec3 origin(0.085, 0, -0.15);
+    const Vec3 insertion(0.085, 0, 0.15);
+
+    std::vector<double> angles;
+    for (int i = 0; i <= 100; ++i)
+        angles.push_back(-1.0 + i*0.02);
+
+    std::vector<double> lengths[2];
+    double meanTime[2], worstTime[2];
+    for (int b = 0; b < 2; ++b) {
+        Model model;
+        model.setName("testWrapTorusBoundedSolver");
+        WrapTorus* torus = new WrapTorus();
+        torus->setName("torus");
+        torus->getPropertySet().get("inner_radius")->setValue(0.02);
+        torus->getPropertySet().get("outer_radius")->setValue(0.1);
+        torus->setUseBoundedSolver(b == 1);
+        buildWrappingModel(model, torus, origin, insertion);
+        worstTime[b] =
+            computeWrappedLengths(model, angles, lengths[b], meanTime[b]);
+    }
+
+    for (size_t i = 0; i < angles.size(); ++i)
+        ASSERT_EQUAL<double>(lengths[0][i], lengths[1][i], 1e-6);
+
+    cout << "WrapTorus path time (us), mean / worst case:" << endl;
+    cout << "  reference: " << 1e6*meanTime[0] << " / " << 1e6*worstTime[0]
+         << endl;
+    cout << "  bounded:   " << 1e6*meanTime[1] << " / " << 1e6*worstTime[1]
+         << endl;
+}
+
 void simulateModelWithMusclesNoViz(const string &modelFile, double finalTime, double activation)
 {
     // Create a new OpenSim model
@@ -26,6 +26,7 @@
 #include "OpenSim/Simulation/SimbodyEngine/PinJoint.h"
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <chrono>
 
 using namespace OpenSim;
 using namespace std;
@@ -519,6 +520,82 @@ void testComponentListComparisonOperators() {
     SimTK_TEST(mutIt != constIt);
 }
 
+// The components of a ComponentList are gathered once into an array, which
+// must be rebuilt when the tree changes.
+void testComponentListCache() {
+    using SimTK::Vec3;
+    using SimTK::Inertia;
+
+    Model model(modelFilename);
+
+    // The muscles of arm26 are all in the ForceSet.
+    auto checkMuscles = [&model]() {
+        std::vector<const Muscle*> expected, found;
+        const ForceSet& forces = model.getForceSet();
+        for (int i = 0; i < forces.getSize(); ++i)
+            if (auto muscle = dynamic_cast<const Muscle*>(&forces.get(i)))
+                expected.push_back(muscle);
+        for (const auto& muscle : model.getComponentList<Muscle>())
+            found.push_back(&muscle);
+        ASSERT(found == expected, __FILE__, __LINE__,
+                "ComponentList<Muscle> differs from the ForceSet.");
+    };
+    checkMuscles();
+    ASSERT(model.countNumComponents() == unsigned(expectedNumComponents),
+            __FILE__, __LINE__, "Number of Components mismatch.");
+    const unsigned numBodies = model.countNumComponents<OpenSim::Body>();
+    ASSERT(numBodies == unsigned(model.getNumBodies()), __FILE__, __LINE__,
+            "Number of Bodies mismatch.");
+
+    // Adding a body and a joint must be reflected in the lists.
+    auto body = new OpenSim::Body("extra_body", 1, Vec3(0), Inertia(1));
+    auto joint = new OpenSim::PinJoint("extra_joint",
+            model.getGround(), Vec3(0), Vec3(0), *body, Vec3(0), Vec3(0));
+    model.addBody(body);
+    model.addJoint(joint);
+    model.initSystem();
+    ASSERT(model.countNumComponents<OpenSim::Body>() == numBodies + 1,
+            __FILE__, __LINE__, "Expected the new body in the list.");
+    ASSERT(model.countNumComponents() > unsigned(expectedNumComponents),
+            __FILE__, __LINE__, "Expected the new components in the list.");
+    checkMuscles();
+
+    // The lists of a subcomponent are up to date as well.
+    const Joint& extraJoint = model.getJointSet().get("extra_joint");
+    ASSERT(extraJoint.countNumComponents<Coordinate>() == 1, __FILE__,
+            __LINE__, "Expected one Coordinate in the new joint.");
+
+    // Finalizing components while iterating over them does not invalidate
+    // the iterators.
+    unsigned count = 0;
+    for (auto& b : model.updComponentList<OpenSim::Body>()) {
+        b.finalizeFromProperties();
+        ++count;
+    }
+    ASSERT(count == numBodies + 1, __FILE__, __LINE__,
+            "Expected to visit every body.");
+
+    // The first iteration after the tree changes gathers the muscles; later
+    // iterations only walk through the array.
+    model.initSystem();
+    double sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& muscle : model.getComponentList<Muscle>())
+        sum += muscle.get_max_isometric_force();
+    double firstTime = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    const int numReps = 10000;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numReps; ++i)
+        for (const auto& muscle : model.getComponentList<Muscle>())
+            sum += muscle.get_max_isometric_force();
+    double laterTime = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count() / numReps;
+    cout << "Iterating over the muscles: " << firstTime << " s the first "
+         << "time, " << laterTime << " s afterwards (sum " << sum << ")."
+         << endl;
+}
+
 int main() {
     LoadOpenSimLibrary("osimActuators");
     SimTK_START_TEST("testIterators");
@@ -527,6 +604,7 @@ int main() {
         SimTK_SUBTEST(testComponentListNonConstWithNonConstIterator);
         SimTK_SUBTEST(testComponentListComparisonOperators);
         SimTK_SUBTEST(testNestedComponentListConsistency);
+        SimTK_SUBTEST(testComponentListCache);
     SimTK_END_TEST();
 }
 
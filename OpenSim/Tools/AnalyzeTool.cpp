@@ -22,6 +22,7 @@
 #include <OpenSim/Common/XMLDocument.h>
 #include "AnalyzeTool.h"
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/LogManager.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 
 #include <OpenSim/Simulation/Control/ControlLinear.h>
@@ -31,13 +32,90 @@
 #include <OpenSim/Simulation/Model/BodySet.h>
 #include <OpenSim/Simulation/Model/ForceSet.h>
 #include <OpenSim/Analyses/MuscleAnalysis.h>
+#include <OpenSim/Analyses/JointReaction.h>
+#include <OpenSim/Analyses/StaticOptimization.h>
 #include <OpenSim/Analyses/ProbeReporter.h>
 #include <OpenSim/Simulation/Model/PrescribedForce.h>
 #include <OpenSim/Actuators/Thelen2003Muscle.h>
+#include <memory>
 
 using namespace OpenSim;
 using namespace std;
 
+namespace {
+// Whether Model::assemble() is needed to make the configuration (and, for
+// coordinates that are locked or prescribed, the speeds) of s satisfy the
+// model's constraints. The tolerances are those used by Model::assemble().
+bool needsAssembly(const Model& model, SimTK::State& s)
+{
+    const bool hasConstraints = model.getConstraintSet().getSize() > 0;
+    bool constrained = hasConstraints;
+    const CoordinateSet& coords = model.getCoordinateSet();
+    for (int i = 0; i < coords.getSize() && !constrained; ++i)
+        constrained = coords[i].isConstrained(s);
+    if (!constrained)
+        return false;
+
+    const SimTK::MultibodySystem& system = model.getMultibodySystem();
+    system.realize(s, SimTK::Stage::Position);
+    const double qTol = hasConstraints ? model.get_assembly_accuracy() : 1e-10;
+    if (s.getNQErr() > 0 && s.getQErr().normInf() > qTol)
+        return true;
+
+    // Without a ConstraintSet, Model::assemble() also projects the speeds.
+    if (!hasConstraints) {
+        system.realize(s, SimTK::Stage::Velocity);
+        if (s.getNUErr() > 0 && s.getUErr().normInf() > 1e-10)
+            return true;
+    }
+    return false;
+}
+
+// Sets the number of threads of the JointReaction and StaticOptimization
+// analyses of a set, and restores their previous numbers when it goes out of
+// scope, even if the replay throws.
+class AnalysisThreadsGuard {
+public:
+    AnalysisThreadsGuard(AnalysisSet& analysisSet, int numThreads)
+    {
+        for(int i=0;i<analysisSet.getSize();i++) {
+            auto* jr = dynamic_cast<JointReaction*>(&analysisSet.get(i));
+            if(jr) {
+                _jointReactions.emplace_back(jr, jr->getNumThreads());
+                jr->setNumThreads(numThreads);
+            }
+            auto* so = dynamic_cast<StaticOptimization*>(&analysisSet.get(i));
+            if(so) {
+                _staticOptimizations.emplace_back(so, so->getNumThreads());
+                so->setNumThreads(numThreads);
+            }
+        }
+    }
+    ~AnalysisThreadsGuard()
+    {
+        for(const auto& jr : _jointReactions)
+            jr.first->setNumThreads(jr.second);
+        for(const auto& so : _staticOptimizations)
+            so.first->setNumThreads(so.second);
+    }
+    AnalysisThreadsGuard(const AnalysisThreadsGuard&) = delete;
+    AnalysisThreadsGuard& operator=(const AnalysisThreadsGuard&) = delete;
+
+    // Compute the frames that the analyses queued during the replay.
+    void recordQueuedFrames()
+    {
+        for(const auto& jr : _jointReactions)
+            jr.first->recordQueuedFrames();
+        for(const auto& so : _staticOptimizations)
+            so.first->recordQueuedFrames();
+    }
+
+private:
+    std::vector<std::pair<JointReaction*, int>> _jointReactions;
+    std::vector<std::pair<StaticOptimization*, int>> _staticOptimizations;
+};
+}
+
 
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
@@ -59,6 +137,8 @@ AnalyzeTool::AnalyzeTool() :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
+    _fastReplay(_fastReplayProp.getValueBool()),
     _printResultFiles(true),
     _loadModelAndInput(false)
 {
@@ -79,6 +159,8 @@ AnalyzeTool::AnalyzeTool(const string &aFileName, bool aLoadModelAndInput) :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
+    _fastReplay(_fastReplayProp.getValueBool()),
     _printResultFiles(true),
     _loadModelAndInput(aLoadModelAndInput)
 {
@@ -111,6 +193,8 @@ AnalyzeTool::AnalyzeTool(Model& aModel) :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
+    _fastReplay(_fastReplayProp.getValueBool()),
     _printResultFiles(true),
     _loadModelAndInput(false)
 {
@@ -171,6 +255,8 @@ AnalyzeTool(const AnalyzeTool &aTool) :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
+    _fastReplay(_fastReplayProp.getValueBool()),
     _loadModelAndInput(false)
 {
     setNull();
@@ -191,6 +277,8 @@ setNull()
     _coordinatesFileName = "";
     _speedsFileName = "";
     _lowpassCutoffFrequency = -1.0;
+    _numThreads = 1;
+    _fastReplay = false;
 
     _statesStore = NULL;
 
@@ -236,6 +324,24 @@ void AnalyzeTool::setupProperties()
     _lowpassCutoffFrequencyProp.setName("lowpass_cutoff_frequency_for_coordinates");
     _propertySet.append( &_lowpassCutoffFrequencyProp );
 
+    comment = "Number of threads used by JointReaction and StaticOptimization analyses to compute the time frames. "
+                 "The default value of 1 computes each frame as it is replayed. Values greater than 1 "
+                 "compute the frames in parallel once all of them have been replayed; "
+                 "values less than 1 use all available processors.";
+    _numThreadsProp.setComment(comment);
+    _numThreadsProp.setName("num_threads");
+    _numThreadsProp.setValue(1);
+    _propertySet.append( &_numThreadsProp );
+
+    comment = "Flag (true or false) indicating whether to write the values of each time frame directly into the state, "
+                 "and to assemble the model only if the values do not satisfy its constraints. "
+                 "This is faster than setting the values one at a time and assembling every frame. "
+                 "The default value is false.";
+    _fastReplayProp.setComment(comment);
+    _fastReplayProp.setName("fast_replay");
+    _fastReplayProp.setValue(false);
+    _propertySet.append( &_fastReplayProp );
+
 }
 
 
@@ -259,6 +365,8 @@ operator=(const AnalyzeTool &aTool)
     _coordinatesFileName = aTool._coordinatesFileName;
     _speedsFileName = aTool._speedsFileName;
     _lowpassCutoffFrequency= aTool._lowpassCutoffFrequency;
+    _numThreads = aTool._numThreads;
+    _fastReplay = aTool._fastReplay;
     _statesStore = aTool._statesStore;
     _printResultFiles = aTool._printResultFiles;
     return(*this);
@@ -580,7 +688,8 @@ bool AnalyzeTool::run(bool plotting)
     //}
 
     cout<<"Executing the analyses from "<<ti<<" to "<<tf<<"..."<<endl;
-    run(s, *_model, iInitial, iFinal, *_statesStore, _solveForEquilibriumForAuxiliaryStates);
+    run(s, *_model, iInitial, iFinal, *_statesStore, _solveForEquilibriumForAuxiliaryStates,
+        _fastReplay, _numThreads);
     _model->getMultibodySystem().realize(s, SimTK::Stage::Position );
     } catch (const Exception& x) {
         x.print(cout);
@@ -602,7 +711,7 @@ bool AnalyzeTool::run(bool plotting)
 //=============================================================================
 // HELPER
 //=============================================================================
-void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium)
+void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium, bool aFastReplay, int numThreads)
 {
     AnalysisSet& analysisSet = aModel.updAnalysisSet();
 
@@ -610,6 +719,12 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
         analysisSet.get(i).setStatesStore(aStatesStore);
     }
 
+    // JointReactions and StaticOptimizations queue the frames and compute
+    // them in parallel after the replay.
+    std::unique_ptr<AnalysisThreadsGuard> threadsGuard;
+    if(numThreads != 1)
+        threadsGuard.reset(new AnalysisThreadsGuard(analysisSet, numThreads));
+
 
     // PERFORM THE ANALYSES
     double /*tPrev=0.0,*/t=0.0/*,dt=0.0*/;
@@ -652,6 +767,32 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
     // model defaults.
     SimTK::Vector stateValues = aModel.getStateVariableValues(s);
 
+    // For fast replay, find where each state variable is stored in the
+    // state's Y vector so that all of the values can be written at once.
+    // Fall back to setStateVariableValues() if any of them is not in Y.
+    // As setStateVariableValues() does, keep the values of locked
+    // coordinates rather than the stored ones.
+    std::vector<SimTK::SystemYIndex> yIndices;
+    std::vector<std::pair<const Coordinate*, double>> lockedValues;
+    if (aFastReplay) {
+        aModel.getMultibodySystem().realize(s, SimTK::Stage::Model);
+        yIndices = aModel.getStateVariableSystemIndices(s);
+        for (const SimTK::SystemYIndex& yix : yIndices) {
+            if (!yix.isValid()) {
+                yIndices.clear();
+                break;
+            }
+        }
+        const CoordinateSet& coords = aModel.getCoordinateSet();
+        for (int k = 0; k < coords.getSize(); ++k) {
+            if (coords[k].getLocked(s))
+                lockedValues.emplace_back(&coords[k], coords[k].getValue(s));
+        }
+    }
+
+    // Limits the warnings about muscles that cannot be equilibrated, per run.
+    LogRateLimiter equilibriumLimiter;
+
     for(int i=iInitial;i<=iFinal;i++) {
         // tPrev = t;
         aStatesStore.getTime(i,s.updTime()); // time
@@ -665,10 +806,27 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
         for (int k=0; k < nsData; ++k) {
             stateValues[dataToModel[k]] = stateData[k];
         }
-        aModel.setStateVariableValues(s, stateValues);
-       
-        // Adjust configuration to match constraints and other goals
-        aModel.assemble(s);
+        if (!yIndices.empty()) {
+            SimTK::Vector& y = s.updY();
+            for (int k = 0; k < stateValues.size(); ++k) {
+                y[yIndices[k]] = stateValues[k];
+            }
+            for (const auto& locked : lockedValues) {
+                const Coordinate& coord = *locked.first;
+                aModel.getMatterSubsystem().getMobilizedBody(
+                    coord.getBodyIndex()).setOneQ(s,
+                        coord.getMobilizerQIndex(), locked.second);
+            }
+        }
+        else {
+            aModel.setStateVariableValues(s, stateValues);
+        }
+
+        // Adjust configuration to match constraints and other goals. Frames
+        // that already satisfy the constraints are left as they are; other
+        // frames are tracked from the stored values.
+        if (!aFastReplay || needsAssembly(aModel, s))
+            aModel.assemble(s);
 
         // equilibrateMuscles before realization as it may affect forces
         if(aSolveForEquilibrium){
@@ -676,12 +834,16 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
                 // a non-physical pose. For example, a pose where the 
                 // muscle length is shorter than the tendon slack-length.
                 // the muscle will throw an Exception in this case.
-                aModel.equilibrateMuscles(s);
+                // Consecutive frames are close, so start each muscle's
+                // solve from its solution at the previous frame.
+                aModel.equilibrateMuscles(s, i > iInitial);
             }
             catch (const std::exception& e) {
-                cout << "WARNING- AnalyzeTool::run() unable to equilibrate muscles ";
-                cout << "at time = " << t <<"." << endl;
-                cout << "Reason: " << e.what() << endl;
+                // This can fail at every frame; don't flood the log.
+                OPENSIM_LOG_RATE_LIMITED(LogLevel::Warn, equilibriumLimiter,
+                    "WARNING- AnalyzeTool::run() unable to equilibrate muscles "
+                    << "at time = " << t << ".\n"
+                    << "Reason: " << e.what());
             }
         }
         // Make sure model is at least ready to provide kinematics
@@ -696,4 +858,7 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
             analysisSet.step(s,i);
         }
     }
+
+    if(threadsGuard)
+        threadsGuard->recordQueuedFrames();
 }
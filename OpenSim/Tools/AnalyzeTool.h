@@ -68,6 +68,14 @@ private:
     /** Low-pass cut-off frequency for filtering the coordinates (does not apply to states). */
     PropertyDbl _lowpassCutoffFrequencyProp;
     double &_lowpassCutoffFrequency;
+    /** Number of threads across which the JointReaction and
+    StaticOptimization analyses compute the time frames. */
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
+    /** Whether to write the stored values directly into the state and
+    assemble the model only when they do not satisfy its constraints. */
+    PropertyBool _fastReplayProp;
+    bool &_fastReplay;
 
     /** Storage for the model states. */
     Storage *_statesStore;
@@ -119,6 +127,10 @@ public:
     void setSpeedsFileName(const std::string &aFileName) { _speedsFileName = aFileName; }
     double getLowpassCutoffFrequency() const { return _lowpassCutoffFrequency; }
     void setLowpassCutoffFrequency(double aLowpassCutoffFrequency) { _lowpassCutoffFrequency = aLowpassCutoffFrequency; }
+    int getNumThreads() const { return _numThreads; }
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    bool getFastReplay() const { return _fastReplay; }
+    void setFastReplay(bool fastReplay) { _fastReplay = fastReplay; }
     const bool getLoadModelAndInput() const { return _loadModelAndInput; }
     void setLoadModelAndInput(bool b) { _loadModelAndInput = b; }
 
@@ -140,7 +152,18 @@ public:
     // HELPER
     //--------------------------------------------------------------------------
 #ifndef SWIG
-    static void run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium);
+    /** Replay the states in rows iInitial through iFinal of aStatesStore
+    through the analyses of aModel. With aFastReplay, the stored values are
+    written directly into the state (see
+    Component::getStateVariableSystemIndices()), and the model is assembled
+    only if it has constraints or constrained coordinates that the stored
+    values do not already satisfy. As with Model::setStateVariableValues(),
+    locked coordinates keep their values. Otherwise, each frame is set with
+    Model::setStateVariableValues() and assembled with Model::assemble().
+    If numThreads is not 1, the JointReaction and StaticOptimization analyses
+    compute the frames in parallel once all of them have been replayed (see
+    JointReaction::setNumThreads() and StaticOptimization::setNumThreads()). */
+    static void run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium, bool aFastReplay=false, int numThreads=1);
 #endif
 //=============================================================================
 };  // END of class AnalyzeTool
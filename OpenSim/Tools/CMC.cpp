@@ -31,6 +31,7 @@
 //=============================================================================
 #include "CMC.h"
 #include "VectorFunctionForActuators.h"
+#include <OpenSim/Common/LogManager.h>
 #include <OpenSim/Common/RootSolver.h>
 #include <OpenSim/Simulation/Control/ControlConstant.h>
 #include <OpenSim/Simulation/Control/ControlLinear.h>
@@ -156,6 +157,7 @@ void CMC::copyData( const CMC &aCmc )
    _verbose               = aCmc._verbose;
    _predictor             = aCmc._predictor;
    _f                     = aCmc._f;
+   _smallForceRangeLimiter = aCmc._smallForceRangeLimiter;
    _taskSet               = aCmc._taskSet;
 
 }
@@ -515,6 +517,7 @@ computeInitialStates(SimTK::State& s, double &rTI)
     Array<double> xmin(0.01,N),forces(0.0,N);
 
     double tiReal = rTI;
+    _smallForceRangeLimiter.reset();
     if( _verbose ) {
         cout<<"\n\n=============================================\n";
         cout<<"enter CMC.computeInitialStates: ti="<< rTI << "  q's=" << s.getQ() <<endl;
@@ -706,7 +709,7 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
     double tiReal = s.getTime(); 
     double tfReal = _tf; 
 
-    cout<<"CMC.computeControls:  t = "<<s.getTime()<<endl;
+    OPENSIM_LOG(LogLevel::Info, "CMC.computeControls:  t = " << s.getTime());
     if(_verbose) { 
         cout<<"\n\n----------------------------------\n";
         cout<<"integration step size = "<<_targetDT<<",  target time = "<<_tf<<endl;
@@ -846,9 +849,10 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
     for(i=0;i<N;i++) {
         range = fmax[i] - fmin[i];
         if(range<1.0) {
-            cout << "CMC::computeControls WARNING- small force range for "
+            OPENSIM_LOG_RATE_LIMITED(LogLevel::Warn, _smallForceRangeLimiter,
+                 "CMC::computeControls WARNING- small force range for "
                  << getActuatorSet()[i].getName()
-                 << " ("<<fmin[i]<<" to "<<fmax[i]<<")\n" << endl;
+                 << " ("<<fmin[i]<<" to "<<fmax[i]<<")\n");
             // if the force range is so small it means the control value, x, 
             // is inconsequential and we might as well choose the smallest control
             // value possible, or else the RootSolver will choose the last value
@@ -32,6 +32,7 @@
 // INCLUDE
 //============================================================================
 #include "osimToolsDLL.h"
+#include <OpenSim/Common/LogManager.h>
 #include <OpenSim/Simulation/Control/ControlSet.h>
 #include <OpenSim/Simulation/Control/TrackingController.h>
 
@@ -134,6 +135,10 @@ protected:
     VectorFunctionForActuators *_predictor;
     /** Array of actuator forces for achieving the desired accelerations. */
     Array<double> _f;
+    /** Limits the warnings about small force ranges logged by
+    computeControls(). It is reset by computeInitialStates() at the start of
+    each run. */
+    LogRateLimiter _smallForceRangeLimiter;
 
 
 //=============================================================================
@@ -88,6 +88,10 @@ protected:
     PropertyStr _outputBodyForcesAtJointsFileNameProp;
     std::string &_outputBodyForcesAtJointsFileName;
 
+    /** Number of threads across which time frames are distributed. */
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -156,6 +160,16 @@ public:
     void setLowpassCutoffFrequency(double aFrequency) {
         _lowpassCutoffFrequency = aFrequency;
     }
+
+    /**
+     * get/set the number of threads used to solve the time frames. 1 (the
+     * default) solves the frames serially and steps the model's analyses.
+     * Values other than 1 solve the frames in parallel (see
+     * InverseDynamicsSolver::solveInParallel()); values less than 1 use as
+     * many threads as there are processors.
+     */
+    int getNumThreads() const { return _numThreads; }
+    void setNumThreads(int aNumThreads) { _numThreads = aNumThreads; }
     //--------------------------------------------------------------------------
     // INTERFACE
     //--------------------------------------------------------------------------
@@ -28,6 +28,7 @@
 #include <OpenSim/Simulation/InverseKinematicsSolver.h>
 
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/LogManager.h>
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Common/FunctionSet.h>
 #include <OpenSim/Common/GCVSplineSet.h>
@@ -384,11 +385,12 @@ bool InverseKinematicsTool::run()
                 markerErrors.set(2, sqrt(maxSquaredMarkerError));
                 modelMarkerErrors->append(s.getTime(), 3, &markerErrors[0]);
 
-                cout << "Frame " << i << " (t=" << s.getTime() << "):\t"
+                OPENSIM_LOG(LogLevel::Info,
+                    "Frame " << i << " (t=" << s.getTime() << "):\t"
                     << "total squared error = " << totalSquaredMarkerError
                     << ", marker error: RMS=" << rms << ", max="
-                    << sqrt(maxSquaredMarkerError) << " (" 
-                    << ikSolver.getMarkerNameForIndex(worst) << ")" << endl;
+                    << sqrt(maxSquaredMarkerError) << " ("
+                    << ikSolver.getMarkerNameForIndex(worst) << ")");
             }
 
             if(_reportMarkerLocations){
@@ -126,6 +126,8 @@ public:
 
     //---- Setters and getters for various attributes
     void setModel(Model& aModel) { _model = &aModel; };
+    void setModelFileName(const std::string& aFileName) { _modelFileName = aFileName; };
+    const std::string& getModelFileName() const { return _modelFileName; };
     void setStartTime(double d) { _timeRange[0] = d; };
     double getStartTime() const {return  _timeRange[0]; };
 
@@ -28,6 +28,7 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Common/MarkerData.h>
 #include <OpenSim/Common/IO.h>
+#include <chrono>
 
 //=============================================================================
 // STATICS
@@ -222,6 +223,13 @@ ModelScaler& ModelScaler::operator=(const ModelScaler &aModelScaler)
  */
 bool ModelScaler::processModel(Model* aModel, const string& aPathToSubject,
         double aSubjectMass) const
+{
+    ScalingPhaseTimes times;
+    return processModel(aModel, aPathToSubject, aSubjectMass, times);
+}
+
+bool ModelScaler::processModel(Model* aModel, const string& aPathToSubject,
+        double aSubjectMass, ScalingPhaseTimes& times) const
 {
     if (!getApply()) return false;
 
@@ -242,6 +250,7 @@ bool ModelScaler::processModel(Model* aModel, const string& aPathToSubject,
         theScaleSet.adoptAndAppend(segmentScale);
     }
 
+    auto start = std::chrono::steady_clock::now();
     SimTK::State& s = aModel->initSystem();
     aModel->getMultibodySystem().realize(s, SimTK::Stage::Position);
 
@@ -308,8 +317,15 @@ bool ModelScaler::processModel(Model* aModel, const string& aPathToSubject,
             }
         }
 
+        auto end = std::chrono::steady_clock::now();
+        times.computeScaleFactors +=
+                std::chrono::duration<double>(end - start).count();
+
         /* Now scale the model. */
+        start = end;
         aModel->scale(s, theScaleSet, _preserveMassDist, aSubjectMass);
+        times.scaleModel += std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
 
         if(_printResultFiles) {
             std::string savedCwd = IO::getCwd();
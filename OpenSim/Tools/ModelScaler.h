@@ -37,6 +37,22 @@ namespace OpenSim {
 class MarkerData;
 class Model;
 
+#ifndef SWIG
+/** Wall-clock time, in seconds, spent in each phase of scaling a model to a
+subject (see ScaleTool::run()). */
+struct ScalingPhaseTimes {
+    /** Loading or copying the generic model. */
+    double createModel = 0;
+    /** Computing the scale factors from measurements and manual scales. */
+    double computeScaleFactors = 0;
+    /** Scaling the model (Model::scale()), including the muscle lengths. */
+    double scaleModel = 0;
+    /** Placing the markers, including the inverse kinematics of the static
+    pose. */
+    double placeMarkers = 0;
+};
+#endif
+
 //=============================================================================
 //=============================================================================
 /**
@@ -113,6 +129,12 @@ public:
 
     bool processModel(Model* aModel, const std::string& aPathToSubject="",
             double aFinalMass = -1.0) const;
+#ifndef SWIG
+    /** Same as above, and add the time spent computing the scale factors and
+    scaling the model to \a times. */
+    bool processModel(Model* aModel, const std::string& aPathToSubject,
+            double aFinalMass, ScalingPhaseTimes& times) const;
+#endif
     /* Register types to be used when reading a ModelScaler object from xml file. */
     static void registerTypes();
 
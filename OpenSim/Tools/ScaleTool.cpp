@@ -26,8 +26,11 @@
 //=============================================================================
 #include "ScaleTool.h"
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/LogManager.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include "GenericModelMaker.h"
+#include <algorithm>
+#include <chrono>
 
 //=============================================================================
 // STATICS
@@ -246,16 +249,26 @@ Model* ScaleTool::createModel() const
 }
 
 bool ScaleTool::run() const {
+    _phaseTimes = ScalingPhaseTimes();
+    auto start = std::chrono::steady_clock::now();
     std::unique_ptr<Model> model(createModel());
+    _phaseTimes.createModel = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
 
     if(model == nullptr) { 
         throw Exception("scale: ERROR- No model specified.",__FILE__,__LINE__);
     }
 
+    return processModel(*model, _phaseTimes);
+}
+
+bool ScaleTool::processModel(Model& model, ScalingPhaseTimes& times) const
+{
     if (!isDefaultModelScaler() && getModelScaler().getApply())
     {
         const ModelScaler& scaler = getModelScaler();
-        if(!scaler.processModel(model.get(), getPathToSubject(), getSubjectMass())) {
+        if(!scaler.processModel(&model, getPathToSubject(), getSubjectMass(),
+                                times)) {
             return false;
         }
     }
@@ -267,7 +280,11 @@ bool ScaleTool::run() const {
     if (!isDefaultMarkerPlacer())
     {
         const MarkerPlacer& placer = getMarkerPlacer();
-        if(!placer.processModel(model.get(), getPathToSubject())) {
+        auto start = std::chrono::steady_clock::now();
+        bool placed = placer.processModel(&model, getPathToSubject());
+        times.placeMarkers += std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+        if(!placed) {
             return false;
         }
     }
@@ -277,3 +294,81 @@ bool ScaleTool::run() const {
     }
     return true;
 }
+
+namespace {
+// Scales the model of one subject per task index, capturing the output of
+// each subject so that it can be logged in order afterwards.
+class ScaleSubjectTask : public SimTK::ParallelExecutor::Task {
+public:
+    ScaleSubjectTask(const std::vector<std::unique_ptr<ScaleTool>>& tools,
+            std::vector<std::unique_ptr<Model>>& models,
+            std::vector<ScalingPhaseTimes>& times,
+            std::vector<std::string>& outs, std::vector<std::string>& errs) :
+        _tools(tools), _models(models), _times(times),
+        _outs(outs), _errs(errs) {}
+
+    void execute(int index) override {
+        LogCapture capture(_outs[index], _errs[index]);
+        try {
+            if (!_tools[index]->processModel(*_models[index],
+                                            _times[index]))
+                _models[index].reset();
+        }
+        catch (const std::exception& x) {
+            cout << "ScaleTool: ERROR- Failed to scale subject '"
+                 << _tools[index]->getName() << "': " << x.what() << endl;
+            _models[index].reset();
+        }
+    }
+
+private:
+    const std::vector<std::unique_ptr<ScaleTool>>& _tools;
+    std::vector<std::unique_ptr<Model>>& _models;
+    std::vector<ScalingPhaseTimes>& _times;
+    std::vector<std::string>& _outs;
+    std::vector<std::string>& _errs;
+};
+} // anonymous namespace
+
+std::vector<std::unique_ptr<Model>> ScaleTool::runBatch(
+        const Model& genericModel,
+        const std::vector<const ScaleTool*>& subjects,
+        int numThreads, std::vector<ScalingPhaseTimes>* times)
+{
+    const int numSubjects = int(subjects.size());
+    std::vector<std::unique_ptr<ScaleTool>> tools;
+    std::vector<std::unique_ptr<Model>> models;
+    std::vector<ScalingPhaseTimes> phaseTimes(numSubjects);
+
+    // Copy the generic model on this thread, so that it is not read by
+    // several threads at once. Each subject also gets its own copy of its
+    // ScaleTool, which must not write files.
+    for (int i = 0; i < numSubjects; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        tools.emplace_back(new ScaleTool(*subjects[i]));
+        tools.back()->setPathToSubject(subjects[i]->getPathToSubject());
+        tools.back()->setPrintResultFiles(false);
+        models.emplace_back(genericModel.clone());
+        models.back()->setName(subjects[i]->getName());
+        phaseTimes[i].createModel = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+    }
+
+    if (numSubjects > 0) {
+        if (numThreads < 1)
+            numThreads = SimTK::ParallelExecutor::getNumProcessors();
+        numThreads = std::max(1, std::min(numThreads, numSubjects));
+
+        std::vector<std::string> outs(numSubjects), errs(numSubjects);
+        ScaleSubjectTask task(tools, models, phaseTimes, outs, errs);
+        SimTK::ParallelExecutor executor(numThreads);
+        executor.execute(task, numSubjects);
+
+        for (int i = 0; i < numSubjects; ++i)
+            LogCapture::write(outs[i], errs[i]);
+    }
+
+    if (times)
+        *times = phaseTimes;
+    return models;
+}
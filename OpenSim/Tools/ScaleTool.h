@@ -31,6 +31,8 @@
 #include <OpenSim/Common/PropertyDbl.h>
 #include "ModelScaler.h"
 #include "MarkerPlacer.h"
+#include <memory>
+#include <vector>
 
 namespace OpenSim {
 
@@ -81,6 +83,11 @@ protected:
      */
     std::string  _pathToSubject;    
 
+#ifndef SWIG
+    /** Time spent in each phase of the last call to run(). */
+    mutable ScalingPhaseTimes _phaseTimes;
+#endif
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -115,6 +122,39 @@ public:
      * @returns whether or not the scale procedure was successful. */
     bool run() const;
 
+#ifndef SWIG
+    /** Time spent in each phase of the last call to run(). */
+    const ScalingPhaseTimes& getPhaseTimes() const { return _phaseTimes; }
+
+    /** Run the ModelScaler and then the MarkerPlacer of this subject on
+     * \a model, e.g., a copy of a generic model that was loaded once, and add
+     * the time spent in each phase to \a times.
+     * @returns whether or not the scale procedure was successful. */
+    bool processModel(Model& model, ScalingPhaseTimes& times) const;
+
+    /** Scale a copy of \a genericModel for each of the \a subjects, running
+     * the subjects concurrently. The generic model is loaded once, by the
+     * caller, instead of by the GenericModelMaker of each subject; the
+     * ModelScaler and MarkerPlacer of each subject are then applied as by
+     * run(). Since the working directory is shared by all threads, no result
+     * files are written; print the returned models instead. The output of
+     * each subject is logged once all of the subjects have been scaled, in
+     * the order of the subjects.
+     * @param genericModel  the model to scale; it is only copied.
+     * @param subjects      the subjects to scale the model to.
+     * @param numThreads    the number of threads to use; values less than 1
+     *                      use as many threads as there are processors.
+     * @param times         if not null, receives the time spent in each phase
+     *                      for each subject.
+     * @returns the scaled model of each subject, in the order of the
+     * subjects; the model of a subject that could not be scaled is null. */
+    static std::vector<std::unique_ptr<Model>> runBatch(
+            const Model& genericModel,
+            const std::vector<const ScaleTool*>& subjects,
+            int numThreads = 0,
+            std::vector<ScalingPhaseTimes>* times = nullptr);
+#endif
+
     bool isDefaultGenericModelMaker() const
     { return _genericModelMakerProp.getValueIsDefault(); }
     bool isDefaultModelScaler() const
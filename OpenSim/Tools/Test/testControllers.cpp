@@ -30,12 +30,15 @@
 //  2. Test a PrescribedController on a block with an ideal actuator
 //  3. Test a CorrectionController tracking a block with an ideal actuator
 //  4. Test a PrescribedController on the arm26 model with reserves.
+//  5. Test the precomputed control routing of a ControlSetController on
+//     the arm26 model with reserves against looking controls up by name.
 //     Add tests here as new controller types are added to OpenSim
 //
 //=============================================================================
 
 #include <OpenSim/OpenSim.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <chrono>
 
 using namespace OpenSim;
 using namespace std;
@@ -46,6 +49,9 @@ void testCorrectionControllerOnBlock();
 void testPrescribedControllerFromFile(const std::string& modelFile,
                                       const std::string& actuatorsFile,
                                       const std::string& controlsFile);
+void testControlSetControllerRouting(const std::string& modelFile,
+                                     const std::string& actuatorsFile,
+                                     const std::string& controlsFile);
 
 int main()
 {
@@ -60,6 +66,9 @@ int main()
         cout << "Testing PrescribedController from File" << endl;
         testPrescribedControllerFromFile("arm26.osim", "arm26_Reserve_Actuators.xml",
                                          "arm26_controls.xml");
+        cout << "Testing ControlSetController control routing" << endl;
+        testControlSetControllerRouting("arm26.osim",
+                "arm26_Reserve_Actuators.xml", "arm26_controls.xml");
     }   
     catch (const Exception& e) {
         e.print(cerr);
@@ -413,3 +422,101 @@ void testPrescribedControllerFromFile(const std::string& modelFile,
      
     osimModel.disownAllComponents();
 }
+
+void testControlSetControllerRouting(const std::string& modelFile,
+                                     const std::string& actuatorsFile,
+                                     const std::string& controlsFile)
+{
+    Model osimModel(modelFile);
+    ForceSet* forceSet = new ForceSet(osimModel, actuatorsFile);
+    osimModel.updForceSet().append(*forceSet);
+
+    ControlSetController* csc = new ControlSetController();
+    ControlSet* cs = new ControlSet(controlsFile);
+    csc->setControlSet(cs);
+    osimModel.addController(csc);
+    SimTK::State& s = osimModel.initSystem();
+
+    // The controls as computed by looking up each actuator's control by name.
+    auto computeByName = [&](double t, SimTK::Vector& controls) {
+        const auto& actuators = csc->getActuatorSet();
+        for (int i = 0; i < actuators.getSize(); ++i) {
+            int index = cs->getIndex(actuators[i].getName());
+            if (index < 0)
+                index = cs->getIndex(actuators[i].getName() + ".excitation");
+            if (index >= 0) {
+                SimTK::Vector actControls(1, cs->get(index).getControlValue(t));
+                actuators[i].addInControls(actControls, controls);
+            }
+        }
+    };
+
+    // Sample before, between and after the nodes, and at each node.
+    auto compare = [&](const std::string& msg) {
+        const double firstTime = csc->getFirstTime();
+        const double lastTime = csc->getLastTime();
+        const int numSamples = 400;
+        std::vector<double> times;
+        for (int k = 0; k <= numSamples; ++k)
+            times.push_back(firstTime - 0.1 +
+                            (lastTime - firstTime + 0.2)*k/numSamples);
+        const ControlLinear& control = dynamic_cast<ControlLinear&>(cs->get(1));
+        for (int k = 0; k < control.getNumParameters(); ++k)
+            times.push_back(control.getParameterTime(k));
+
+        for (double t : times) {
+            s.setTime(t);
+            SimTK::Vector routed(osimModel.getNumControls(), 0.0);
+            SimTK::Vector byName(osimModel.getNumControls(), 0.0);
+            csc->computeControls(s, routed);
+            computeByName(t, byName);
+            for (int i = 0; i < routed.size(); ++i)
+                ASSERT_EQUAL(byName[i], routed[i], 1e-14, __FILE__, __LINE__,
+                    msg + ": control " + std::to_string(i) + " differs at t=" +
+                    std::to_string(t) + ".");
+        }
+    };
+    compare("Routed controls");
+
+    // Adding a node to a control after the routes were built makes its
+    // nodes differ from the shared ones.
+    ControlLinear& edited = dynamic_cast<ControlLinear&>(cs->get(0));
+    edited.setControlValue(0.5*(edited.getFirstTime() +
+                                edited.getParameterTime(1)), 0.5);
+    compare("Routed controls after adding a node");
+
+    // Replacing or renaming controls after the routes were built, without
+    // changing the number of controls, must not use the old routes.
+    ControlLinear* replacement =
+            dynamic_cast<ControlLinear*>(cs->get(1).clone());
+    replacement->setControlValue(replacement->getParameterTime(0), 0.25);
+    cs->set(1, replacement);
+    compare("Routed controls after replacing a control");
+    const std::string name2 = cs->get(2).getName();
+    cs->get(2).setName(cs->get(3).getName());
+    cs->get(3).setName(name2);
+    compare("Routed controls after renaming controls");
+
+    // Setting the ControlSet again builds the routes for the edited controls.
+    csc->setControlSet(cs);
+    compare("Routed controls after setting the ControlSet again");
+
+    // Time both ways of computing the controls.
+    const int numReps = 2000;
+    SimTK::Vector controls(osimModel.getNumControls(), 0.0);
+    auto start = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < numReps; ++rep) {
+        s.setTime(0.03 + 0.9*rep/numReps);
+        csc->computeControls(s, controls);
+    }
+    double routedTime = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < numReps; ++rep)
+        computeByName(0.03 + 0.9*rep/numReps, controls);
+    double byNameTime = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    cout << "Computing " << osimModel.getNumControls() << " controls:" << endl;
+    cout << "  routed:  " << 1e6*routedTime/numReps << " us" << endl;
+    cout << "  by name: " << 1e6*byNameTime/numReps << " us" << endl;
+}